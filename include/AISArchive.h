@@ -0,0 +1,161 @@
+/**
+ *	@file AISArchive.h
+ *	@brief Types shared by AISArchiveWriter and AISArchiveReader
+ *
+ *   Columnar archive of decoded AIS position reports.
+ *
+ *   An archive file is a 16 byte file header followed by blocks. A block
+ *   holds up to a few thousand position reports of one time partition,
+ *   sorted by MMSI then time, and stores them as seven columns:
+ *
+ *   - MMSI: delta from the previous row, varint
+ *   - Time: delta from the previous row, zigzag varint
+ *   - Longitude and latitude in 1/600000 degree: delta from the previous
+ *     row, zigzag varint
+ *   - Speed and course in 0.1 units, heading in degrees: offset from the
+ *     block minimum, bit-packed with the width of the block range
+ *
+ *   Sorting by MMSI makes consecutive rows successive reports of the same
+ *   vessel, so deltas are small and most values take one or two bytes. A
+ *   block header carries the row count, column sizes and the minimum and
+ *   maximum of every column, which lets readers skip blocks outside a query
+ *   without decoding them. Integers are stored in host byte order, which is
+ *   little endian on every supported target.
+ */
+
+#ifndef AISARCHIVE_H_
+#define AISARCHIVE_H_
+
+#include <cstdint>
+#include <sys/types.h>
+
+/**
+ * @brief Decoded position report stored in an archive.
+ */
+struct AISArchiveRecord
+{
+	uint mmsi; //!< 9 decimal digits ID
+	int64_t timestamp; //!< Time of the position report
+	float longitude; //!< Longitude
+	float latitude; //!< Latitude
+	float speedOverGround; //!< Speed Over Ground
+	float courseOverGround; //!< Course Over Ground
+	uint trueHeading; //!< True Heading
+};
+
+/**
+ * @brief Statistics of an archive block.
+ */
+struct AISArchiveBlockInfo
+{
+	uint records; //!< Number of position reports
+	int64_t minTimestamp; //!< Earliest time
+	int64_t maxTimestamp; //!< Latest time
+	uint minMmsi; //!< Smallest MMSI
+	uint maxMmsi; //!< Largest MMSI
+	float minLongitude; //!< West border of the positions
+	float maxLongitude; //!< East border of the positions
+	float minLatitude; //!< South border of the positions
+	float maxLatitude; //!< North border of the positions
+	float maxSpeedOverGround; //!< Largest Speed Over Ground
+};
+
+/**
+ * @brief Columns of an archive block, in storage order.
+ */
+enum AISArchiveColumn
+{
+	AISArchiveColumn_Mmsi, //!< Varint deltas
+	AISArchiveColumn_Timestamp, //!< Zigzag varint deltas
+	AISArchiveColumn_Longitude, //!< Zigzag varint deltas
+	AISArchiveColumn_Latitude, //!< Zigzag varint deltas
+	AISArchiveColumn_SpeedOverGround, //!< Bit-packed offsets
+	AISArchiveColumn_CourseOverGround, //!< Bit-packed offsets
+	AISArchiveColumn_TrueHeading, //!< Bit-packed offsets
+	AISArchiveColumn_Count //!< Number of columns
+};
+
+/**
+ * @brief Archive file header, at offset 0.
+ */
+struct AISArchiveFileHeader
+{
+	char magic[8]; //!< "AISARCHV"
+	uint32_t version; //!< Format version, 1
+	uint32_t reserved; //!< Zero
+};
+
+/**
+ * @brief Archive block header, followed by the columns in storage order.
+ */
+struct AISArchiveBlockHeader
+{
+	uint32_t magic; //!< "ABLK" read as a little endian integer
+	uint32_t records; //!< Number of rows
+	uint32_t payloadBytes; //!< Bytes of all columns
+	uint32_t reserved; //!< Zero
+	int64_t minTimestamp; //!< Earliest time
+	int64_t maxTimestamp; //!< Latest time
+	uint32_t minMmsi; //!< Smallest MMSI
+	uint32_t maxMmsi; //!< Largest MMSI
+	int32_t minLongitude; //!< Smallest longitude in 1/600000 degree
+	int32_t maxLongitude; //!< Largest longitude in 1/600000 degree
+	int32_t minLatitude; //!< Smallest latitude in 1/600000 degree
+	int32_t maxLatitude; //!< Largest latitude in 1/600000 degree
+	uint16_t minSpeed; //!< Smallest speed in 0.1 knot, offset of the column
+	uint16_t maxSpeed; //!< Largest speed in 0.1 knot
+	uint16_t minCourse; //!< Smallest course in 0.1 degree, offset of the column
+	uint16_t maxCourse; //!< Largest course in 0.1 degree
+	uint16_t minHeading; //!< Smallest heading, offset of the column
+	uint16_t maxHeading; //!< Largest heading
+	uint8_t speedBits; //!< Bits per packed speed
+	uint8_t courseBits; //!< Bits per packed course
+	uint8_t headingBits; //!< Bits per packed heading
+	uint8_t padding; //!< Zero
+	uint32_t columnBytes[AISArchiveColumn_Count]; //!< Bytes of every column
+	uint32_t padding2; //!< Zero
+};
+
+/**
+ * @brief Value of AISArchiveBlockHeader::magic
+ */
+const uint32_t AIS_ARCHIVE_BLOCK_MAGIC = 0x4B4C4241;
+
+/**
+ * @brief Current value of AISArchiveFileHeader::version
+ */
+const uint32_t AIS_ARCHIVE_VERSION = 1;
+
+/**
+ * @brief Checks a block header, used by the reader to index blocks and by
+ * the writer to find the end of the last complete block
+ *
+ * @param [in] header Block header
+ * @param [in] available Bytes after the block header up to the end of the file
+ *
+ * @return False if the block is incomplete or corrupt.
+ */
+inline bool isValidAISArchiveBlock(const AISArchiveBlockHeader& header,
+		uint64_t available)
+{
+	uint64_t columns = 0;
+	for (int i = 0; i < AISArchiveColumn_Count; ++i)
+	{
+		columns += header.columnBytes[i];
+	}
+	return header.magic == AIS_ARCHIVE_BLOCK_MAGIC && header.records != 0
+			&& columns == header.payloadBytes
+			&& header.payloadBytes <= available && header.speedBits <= 16
+			&& header.courseBits <= 16 && header.headingBits <= 16
+			&& header.columnBytes[AISArchiveColumn_SpeedOverGround]
+					== (static_cast<uint64_t>(header.records)
+							* header.speedBits + 7) / 8
+			&& header.columnBytes[AISArchiveColumn_CourseOverGround]
+					== (static_cast<uint64_t>(header.records)
+							* header.courseBits + 7) / 8
+			&& header.columnBytes[AISArchiveColumn_TrueHeading]
+					== (static_cast<uint64_t>(header.records)
+							* header.headingBits + 7) / 8;
+}
+
+#endif /* AISARCHIVE_H_ */
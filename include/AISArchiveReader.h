@@ -0,0 +1,138 @@
+/**
+ *	@file AISArchiveReader.h
+ *	@brief Header for AISArchiveReader class
+ *
+ *   Queries a columnar archive of AIS position reports through mmap.
+ */
+
+#ifndef AISARCHIVEREADER_H_
+#define AISARCHIVEREADER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include <boost/noncopyable.hpp>
+#include "AISArchive.h"
+
+/**
+ * @brief Reader of AIS archive files written by AISArchiveWriter.
+ *
+ * The file is memory mapped and its block headers indexed when opened;
+ * nothing else is read until a query touches a block. Queries skip every
+ * block whose statistics fall outside the requested time range, area or
+ * MMSI. In the remaining blocks the position columns are decoded first and
+ * filtered eight rows at a time with AVX2 when the CPU supports it; the
+ * other columns are only decoded for blocks with matching rows.
+ *
+ * A block cut short at the end of the file, left by a writer that did not
+ * finish, ends the archive. Queries are const and may run concurrently.
+ */
+class AISArchiveReader: private boost::noncopyable
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	AISArchiveReader();
+
+	/**
+	 * @brief Destructor, unmaps the file
+	 */
+	~AISArchiveReader();
+
+	/**
+	 * @brief Maps an archive
+	 *
+	 * @param [in] path File path
+	 *
+	 * @return False if the file cannot be mapped or is not an archive.
+	 */
+	bool open(const std::string& path);
+
+	/**
+	 * @brief Unmaps the archive
+	 */
+	void close();
+
+	/**
+	 * @brief Number of blocks
+	 *
+	 * @return Block count.
+	 */
+	std::size_t blockCount() const;
+
+	/**
+	 * @brief Statistics of a block
+	 *
+	 * @param [in] block Block index
+	 *
+	 * @return Block statistics.
+	 */
+	const AISArchiveBlockInfo& blockInfo(std::size_t block) const;
+
+	/**
+	 * @brief Number of position reports in the archive
+	 *
+	 * @return Record count.
+	 */
+	uint64_t records() const;
+
+	/**
+	 * @brief Decodes a whole block
+	 *
+	 * @param [in] block Block index
+	 * @param [out] records Position reports sorted by MMSI then time, appended
+	 *
+	 * @return False if the block is corrupt.
+	 */
+	bool readBlock(std::size_t block,
+			std::vector<AISArchiveRecord>& records) const;
+
+	/**
+	 * @brief Finds the position reports of an area and time range
+	 *
+	 * @param [in] begin Earliest time, inclusive
+	 * @param [in] end Latest time, exclusive
+	 * @param [in] minLongitude West border
+	 * @param [in] minLatitude South border
+	 * @param [in] maxLongitude East border
+	 * @param [in] maxLatitude North border
+	 * @param [out] records Matching reports, by block then MMSI, appended
+	 * @param [in] vectorized Use AVX2 when supported, false forces scalar code
+	 *
+	 * @return Number of reports appended.
+	 */
+	std::size_t scan(int64_t begin, int64_t end, float minLongitude,
+			float minLatitude, float maxLongitude, float maxLatitude,
+			std::vector<AISArchiveRecord>& records,
+			bool vectorized = true) const;
+
+	/**
+	 * @brief Finds the position reports of a vessel in a time range
+	 *
+	 * @param [in] mmsi MMSI
+	 * @param [in] begin Earliest time, inclusive
+	 * @param [in] end Latest time, exclusive
+	 * @param [out] records Matching reports, by block then time, appended
+	 *
+	 * @return Number of reports appended.
+	 */
+	std::size_t scan(uint mmsi, int64_t begin, int64_t end,
+			std::vector<AISArchiveRecord>& records) const;
+
+private:
+	/**
+	 * @brief Private Implementation
+	 */
+	class impl;
+
+	const uint8_t* data; //!< Mapped file, nullptr if closed
+	std::size_t length; //!< Mapped length
+	std::vector<std::size_t> offsets; //!< File offset of every block header
+	std::vector<AISArchiveBlockInfo> infos; //!< Statistics of every block
+	uint64_t recordCount; //!< Reports in the archive
+};
+
+#endif /* AISARCHIVEREADER_H_ */
@@ -0,0 +1,175 @@
+/**
+ *	@file AISArchiveWriter.h
+ *	@brief Header for AISArchiveWriter class
+ *
+ *   Appends decoded AIS position reports to a columnar archive file.
+ */
+
+#ifndef AISARCHIVEWRITER_H_
+#define AISARCHIVEWRITER_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include <boost/noncopyable.hpp>
+#include "AISArchive.h"
+#include "NmeaEnums.h"
+
+/**
+ * @brief Append-only writer of AIS archive files, format in AISArchive.h.
+ *
+ * Position reports are buffered until the block is full or a report of
+ * another time partition arrives, then sorted, encoded and written as one
+ * block. Reports are expected in roughly increasing time order; late ones
+ * go to the current block, whatever its partition. Opening an existing
+ * archive appends new blocks after the existing ones.
+ *
+ * Positions are stored at the AIS wire resolution of 1/600000 degree,
+ * speed and course at 0.1 knot and degree, heading at 1 degree. Timestamps
+ * are in milliseconds.
+ */
+class AISArchiveWriter: private boost::noncopyable
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] blockRecords Maximum position reports per block
+	 * @param [in] partition Time partition length in milliseconds, 0 for none
+	 */
+	AISArchiveWriter(uint blockRecords = 8192, int64_t partition = 3600000);
+
+	/**
+	 * @brief Destructor, writes pending reports and closes the file
+	 */
+	~AISArchiveWriter();
+
+	/**
+	 * @brief Opens an archive, created if it does not exist
+	 *
+	 * An incomplete or corrupt block left by an interrupted writer is cut
+	 * off before appending.
+	 *
+	 * @param [in] path File path
+	 *
+	 * @return False if the file cannot be opened or is not an archive.
+	 */
+	bool open(const std::string& path);
+
+	/**
+	 * @brief Appends a position report
+	 *
+	 * @param [in] mmsi MMSI
+	 * @param [in] longitude Longitude
+	 * @param [in] latitude Latitude
+	 * @param [in] speedOverGround Speed Over Ground
+	 * @param [in] courseOverGround Course Over Ground
+	 * @param [in] trueHeading True Heading
+	 * @param [in] timestamp Time of the position report
+	 *
+	 * @return False if no archive is open or the block could not be written.
+	 */
+	bool append(uint mmsi, float longitude, float latitude,
+			float speedOverGround, float courseOverGround, uint trueHeading,
+			int64_t timestamp);
+
+	/**
+	 * @brief Appends a Class A position report
+	 *
+	 * @param [in] data Decoded position report
+	 * @param [in] timestamp Time of the position report
+	 *
+	 * @return False if no archive is open or the block could not be written.
+	 */
+	bool append(const AISPositionReportClassA& data, int64_t timestamp);
+
+	/**
+	 * @brief Appends a Class B position report
+	 *
+	 * @param [in] data Decoded position report
+	 * @param [in] timestamp Time of the position report
+	 *
+	 * @return False if no archive is open or the block could not be written.
+	 */
+	bool append(const AISStandardClassBCSPositionReport& data,
+			int64_t timestamp);
+
+	/**
+	 * @brief Appends an extended Class B position report
+	 *
+	 * @param [in] data Decoded position report
+	 * @param [in] timestamp Time of the position report
+	 *
+	 * @return False if no archive is open or the block could not be written.
+	 */
+	bool append(const AISExtendedClassBCSPositionReport& data,
+			int64_t timestamp);
+
+	/**
+	 * @brief Writes pending reports as a block and flushes the file
+	 *
+	 * @return False if the block could not be written.
+	 */
+	bool flush();
+
+	/**
+	 * @brief Writes pending reports and closes the file
+	 *
+	 * @return False if the last block could not be written.
+	 */
+	bool close();
+
+	/**
+	 * @brief Position reports written since open()
+	 *
+	 * @return Record count, pending reports excluded.
+	 */
+	uint64_t records() const;
+
+	/**
+	 * @brief Blocks written since open()
+	 *
+	 * @return Block count.
+	 */
+	uint64_t blocks() const;
+
+private:
+	/**
+	 * @brief Private Implementation
+	 */
+	class impl;
+
+	/**
+	 * @brief Position report in wire units
+	 */
+	struct Row
+	{
+		int64_t timestamp; //!< Time
+		uint mmsi; //!< MMSI
+		int32_t longitude; //!< Longitude in 1/600000 degree
+		int32_t latitude; //!< Latitude in 1/600000 degree
+		uint16_t speedOverGround; //!< Speed Over Ground in 0.1 knot
+		uint16_t courseOverGround; //!< Course Over Ground in 0.1 degree
+		uint16_t trueHeading; //!< True Heading in degrees
+	};
+
+	/**
+	 * @brief Encodes and writes the pending reports
+	 *
+	 * @return False on write error.
+	 */
+	bool writeBlock();
+
+	std::FILE* file; //!< Archive file, nullptr if closed
+	uint blockRecords; //!< Maximum reports per block
+	int64_t partition; //!< Time partition length
+	int64_t currentPartition; //!< Partition of the pending reports
+	std::vector<Row> rows; //!< Pending reports
+	std::vector<uint8_t> buffer; //!< Encoded block
+	uint64_t recordCount; //!< Reports written
+	uint64_t blockCount; //!< Blocks written
+};
+
+#endif /* AISARCHIVEWRITER_H_ */
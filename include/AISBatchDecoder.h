@@ -0,0 +1,93 @@
+/**
+ *	@file AISBatchDecoder.h
+ *	@brief Header for AISBatchDecoder class
+ *
+ *   AISBatchDecoder class decodes many AIS payloads into column buffers.
+ */
+
+#ifndef AISBATCHDECODER_H_
+#define AISBATCHDECODER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+#include <boost/utility/string_ref.hpp>
+
+/**
+ * @brief Column buffers filled by AISBatchDecoder::decodePositionReports().
+ *
+ * Every buffer holds one element per payload. Buffers set to nullptr are
+ * not written, so callers only pay for the columns they use. validMask holds
+ * one bit per payload, bit (row % 64) of word (row / 64), and must be set.
+ */
+struct AISPositionColumns {
+	uint* mmsi; //!< 9 decimal digits ID
+	uint8_t* messageType; //!< Nmea_AisMessageType
+	float* longitude; //!< Longitude
+	float* latitude; //!< Latitude
+	float* speedOverGround; //!< Speed Over Ground
+	float* courseOverGround; //!< Course Over Ground
+	uint16_t* trueHeading; //!< True Heading
+	uint64_t* validMask; //!< Row validity, (count + 63) / 64 words
+};
+
+/**
+ * @brief State-less class for static methods used for decoding AIS payloads in batches.
+ *
+ * Payloads are de-armored with SSE2 when available, 16 characters per
+ * instruction, and fields are read with word shifts instead of one bit at a
+ * time. Rows are processed in blocks of 64: raw integers are extracted first
+ * and scaled to floating point in a second loop over the block, which the
+ * compiler vectorizes.
+ */
+class AISBatchDecoder
+{
+public:
+	/**
+	 * @brief Decodes position reports of types 1, 2, 3, 18 and 19
+	 *
+	 * Decoded values are the same as those of
+	 * NmeaParser::parseAISPositionReportClassA(),
+	 * NmeaParser::parseAISStandardClassBCSPositionReport() and
+	 * NmeaParser::parseAISExtendedClassBEquipmentPositionReport(). A row is
+	 * valid if the payload is one of those types, is long enough for the
+	 * matching parser and its first 23 characters, which hold every decoded
+	 * field, are armor characters. Characters past those are not checked.
+	 * Columns of invalid rows are set to zero.
+	 *
+	 * @param [in] encodedData AIS Binary Encoded Data, @p count payloads
+	 * @param [in] count Number of payloads
+	 * @param [out] columns Column buffers
+	 *
+	 * @return Number of valid rows.
+	 */
+	static std::size_t decodePositionReports(const std::string* encodedData,
+			std::size_t count, const AISPositionColumns& columns);
+
+	/**
+	 * @brief Decodes position reports of types 1, 2, 3, 18 and 19
+	 *
+	 * @param [in] encodedData AIS Binary Encoded Data, @p count payloads
+	 * @param [in] count Number of payloads
+	 * @param [out] columns Column buffers
+	 *
+	 * @return Number of valid rows.
+	 */
+	static std::size_t decodePositionReports(
+			const boost::string_ref* encodedData, std::size_t count,
+			const AISPositionColumns& columns);
+
+private:
+	/**
+	 * @brief Private Implementation
+	 */
+	class impl;
+
+	/**
+	 * @brief Private Constructor. Class cannot be instantiated.
+	 */
+	AISBatchDecoder();
+};
+
+#endif /* AISBATCHDECODER_H_ */
@@ -0,0 +1,365 @@
+/**
+ *	@file AISBitBuffer.h
+ *	@brief Header for AIS bit buffer classes
+ *
+ *   Word oriented bit buffers used to build and read AIS binary payloads.
+ */
+
+#ifndef AISBITBUFFER_H_
+#define AISBITBUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+#include <boost/utility/string_ref.hpp>
+#include "AISFixedString.h"
+
+/**
+ * @brief Converts an armor character to its six-bit value
+ *
+ * @param [in] c Armor character, '0' to 'W' or '`' to 'w'
+ *
+ * @return Six-bit value, meaningless for characters that are not armor.
+ */
+inline uint aisArmorToSixBit(char c)
+{
+	uint v = static_cast<unsigned char>(c) - 48;
+	if (v > 39)
+	{
+		v -= 8;
+	}
+	return v & 0x3F;
+}
+
+/**
+ * @brief Reads a six-bit ASCII text field
+ *
+ * Trailing '@' and spaces are removed, as NmeaParser does.
+ *
+ * @param [in] reader Any payload reader with getUInt(position, bits)
+ * @param [in] position Offset of the first bit
+ * @param [in] chars Field width in characters, at most N are kept
+ * @param [out] value Text
+ */
+template<typename Reader, std::size_t N>
+void aisReadSixBitText(const Reader& reader, int position, int chars,
+		AISFixedString<N>& value)
+{
+	value.clear();
+	for (int i = 0; i < chars; ++i)
+	{
+		value.push_back(aisSixBitToAscii(reader.getUInt(position + i * 6, 6)));
+	}
+	value.trimSixBit();
+}
+
+/**
+ * @brief Writes AIS payload bits MSB first into 64 bit words.
+ *
+ * Fields are shifted into an accumulator word, which is stored when full,
+ * so writing a field costs a couple of shifts instead of one operation per
+ * bit. The buffer is sized for the largest AIS message (5 slots, 1008 bits).
+ * Writing past the end sets the overflow flag and the extra bits are dropped.
+ */
+class AISBitWriter
+{
+public:
+	/**
+	 * @brief Maximum number of bits in a payload
+	 */
+	static const int MAX_BITS = 1024;
+
+	/**
+	 * @brief Constructor, starts with an empty payload
+	 */
+	AISBitWriter();
+
+	/**
+	 * @brief Discards the written bits
+	 */
+	void clear();
+
+	/**
+	 * @brief Writes an unsigned field
+	 *
+	 * @param [in] value Value, only the lowest @p bits are written
+	 * @param [in] bits Field width, 1 to 32
+	 */
+	void putUInt(uint value, int bits);
+
+	/**
+	 * @brief Writes a two's complement signed field
+	 *
+	 * @param [in] value Value, only the lowest @p bits are written
+	 * @param [in] bits Field width, 1 to 32
+	 */
+	void putInt(int value, int bits);
+
+	/**
+	 * @brief Writes a single bit flag
+	 *
+	 * @param [in] value Flag
+	 */
+	void putBool(bool value);
+
+	/**
+	 * @brief Writes zero bits for spare or reserved fields
+	 *
+	 * @param [in] bits Number of bits
+	 */
+	void putSpare(int bits);
+
+	/**
+	 * @brief Writes a six-bit ASCII text field
+	 *
+	 * Lower case letters are written upper case, characters without a six-bit
+	 * code are written as spaces and the field is padded with '@'.
+	 *
+	 * @param [in] value Text, truncated to @p chars characters
+	 * @param [in] chars Field width in characters
+	 */
+	void putString(boost::string_ref value, int chars);
+
+	/**
+	 * @brief Number of bits written
+	 *
+	 * @return Bits written
+	 */
+	int size() const;
+
+	/**
+	 * @brief Whether more than MAX_BITS bits were written
+	 *
+	 * @return True on overflow.
+	 */
+	bool overflow() const;
+
+	/**
+	 * @brief Converts the payload to six-bit armored characters
+	 *
+	 * @param [out] encodedData Armored payload, as found in VDM/VDO sentences
+	 *
+	 * @return Number of fill bits added to complete the last character.
+	 */
+	int armor(std::string& encodedData) const;
+
+private:
+	/**
+	 * @brief Stores the accumulator and starts the next word
+	 */
+	void flush();
+
+	static const int WORD_BITS = 64; //!< Bits per storage word
+
+	uint64_t words[MAX_BITS / WORD_BITS]; //!< Completed words
+	uint64_t current; //!< Word being filled, MSB first
+	int wordCount; //!< Number of completed words
+	int used; //!< Bits used in current
+	bool overflowed; //!< More than MAX_BITS bits were written
+};
+
+inline void AISBitWriter::flush()
+{
+	if (wordCount < MAX_BITS / WORD_BITS)
+	{
+		words[wordCount++] = current;
+	}
+	else
+	{
+		overflowed = true;
+	}
+	current = 0;
+	used = 0;
+}
+
+inline void AISBitWriter::putUInt(uint value, int bits)
+{
+	const uint64_t v = static_cast<uint64_t>(value)
+			& ((static_cast<uint64_t>(1) << bits) - 1);
+	const int available = WORD_BITS - used;
+
+	if (bits < available)
+	{
+		current |= v << (available - bits);
+		used += bits;
+	}
+	else
+	{
+		const int rest = bits - available;
+		current |= v >> rest;
+		flush();
+		if (rest > 0)
+		{
+			current = v << (WORD_BITS - rest);
+			used = rest;
+		}
+	}
+}
+
+inline void AISBitWriter::putInt(int value, int bits)
+{
+	putUInt(static_cast<uint>(value), bits);
+}
+
+inline void AISBitWriter::putBool(bool value)
+{
+	putUInt(value ? 1 : 0, 1);
+}
+
+inline void AISBitWriter::putSpare(int bits)
+{
+	while (bits > 32)
+	{
+		putUInt(0, 32);
+		bits -= 32;
+	}
+	if (bits > 0)
+	{
+		putUInt(0, bits);
+	}
+}
+
+inline int AISBitWriter::size() const
+{
+	return wordCount * WORD_BITS + used;
+}
+
+inline bool AISBitWriter::overflow() const
+{
+	return overflowed;
+}
+
+/**
+ * @brief Reads AIS payload bits from 64 bit words.
+ *
+ * The armored payload is converted once into MSB first words; any field
+ * is then extracted with two shifts, whatever its offset. Bits past the end
+ * of the payload read as zero.
+ */
+class AISBitReader
+{
+public:
+	/**
+	 * @brief Maximum number of bits in a payload
+	 */
+	static const int MAX_BITS = 1024;
+
+	/**
+	 * @brief Constructor, starts with an empty payload
+	 */
+	AISBitReader();
+
+	/**
+	 * @brief Converts an armored payload
+	 *
+	 * Characters past MAX_BITS are ignored.
+	 *
+	 * @param [in] encodedData Armored payload, as found in VDM/VDO sentences
+	 * @param [in] length Number of characters
+	 *
+	 * @return False if a character is not a valid six-bit armor character.
+	 */
+	bool assign(const char* encodedData, std::size_t length);
+
+	/**
+	 * @brief Converts an armored payload
+	 *
+	 * @param [in] encodedData Armored payload, as found in VDM/VDO sentences
+	 *
+	 * @return False if a character is not a valid six-bit armor character.
+	 */
+	bool assign(const std::string& encodedData);
+
+	/**
+	 * @brief Reads an unsigned field
+	 *
+	 * @param [in] position Offset of the first bit
+	 * @param [in] bits Field width, 1 to 32
+	 *
+	 * @return Field value.
+	 */
+	uint getUInt(int position, int bits) const;
+
+	/**
+	 * @brief Reads a two's complement signed field
+	 *
+	 * @param [in] position Offset of the first bit
+	 * @param [in] bits Field width, 1 to 32
+	 *
+	 * @return Field value.
+	 */
+	int getInt(int position, int bits) const;
+
+	/**
+	 * @brief Reads a single bit flag
+	 *
+	 * @param [in] position Offset of the bit
+	 *
+	 * @return Flag.
+	 */
+	bool getBool(int position) const;
+
+	/**
+	 * @brief Reads a six-bit ASCII text field, see aisReadSixBitText()
+	 *
+	 * @param [in] position Offset of the first bit
+	 * @param [in] chars Field width in characters
+	 * @param [out] value Text
+	 */
+	template<std::size_t N>
+	void getString(int position, int chars, AISFixedString<N>& value) const
+	{
+		aisReadSixBitText(*this, position, chars, value);
+	}
+
+	/**
+	 * @brief Number of bits in the payload, including fill bits
+	 *
+	 * @return Payload bits.
+	 */
+	int size() const;
+
+private:
+	static const int WORD_BITS = 64; //!< Bits per storage word
+
+	uint64_t words[MAX_BITS / WORD_BITS + 1]; //!< Payload, one trailing zero word
+	int bitCount; //!< Number of bits in the payload
+};
+
+inline uint AISBitReader::getUInt(int position, int bits) const
+{
+	const int index = position / WORD_BITS;
+	const int offset = position % WORD_BITS;
+
+	if (index >= MAX_BITS / WORD_BITS)
+	{
+		return 0;
+	}
+
+	uint64_t value = words[index] << offset;
+	if (offset + bits > WORD_BITS)
+	{
+		value |= words[index + 1] >> (WORD_BITS - offset);
+	}
+	return static_cast<uint>(value >> (WORD_BITS - bits));
+}
+
+inline int AISBitReader::getInt(int position, int bits) const
+{
+	const uint value = getUInt(position, bits);
+	const int64_t sign = static_cast<int64_t>(1) << (bits - 1);
+	return static_cast<int>((value ^ sign) - sign);
+}
+
+inline bool AISBitReader::getBool(int position) const
+{
+	return getUInt(position, 1) != 0;
+}
+
+inline int AISBitReader::size() const
+{
+	return bitCount;
+}
+
+#endif /* AISBITBUFFER_H_ */
@@ -0,0 +1,145 @@
+/**
+ *	@file AISDuplicateFilter.h
+ *	@brief Header for AISDuplicateFilter class
+ *
+ *   Drops AIS payloads already received within a time window.
+ */
+
+#ifndef AISDUPLICATEFILTER_H_
+#define AISDUPLICATEFILTER_H_
+
+#include <cstdint>
+#include <vector>
+#include <sys/types.h>
+#include <boost/utility/string_ref.hpp>
+
+/**
+ * @brief Counters kept by AISDuplicateFilter.
+ */
+struct AISDuplicateFilterStatistics
+{
+	uint64_t messages; //!< Payloads checked
+	uint64_t duplicates; //!< Payloads reported as duplicates
+
+	/**
+	 * @brief Ratio of duplicates over checked payloads
+	 *
+	 * @return Duplicate ratio in [0, 1], 0 before the first payload.
+	 */
+	double duplicateRatio() const;
+};
+
+/**
+ * @brief Time windowed duplicate filter for AIS payloads.
+ *
+ * Meant to run before decoding when merging several receivers, which
+ * deliver the same message a few times within seconds. Payloads are hashed
+ * as armored text, which identifies the de-armored bits just as well, and
+ * recorded in two Bloom filters: the current generation and the previous
+ * one. Every @c window milliseconds the previous generation is cleared and
+ * becomes the current one, so a payload is remembered for at least one and
+ * at most two windows. Memory is fixed at construction.
+ *
+ * A Bloom filter has no false negatives: a repeated payload inside the
+ * window is always dropped. A new payload is wrongly dropped with the
+ * probability returned by falsePositiveRate().
+ */
+class AISDuplicateFilter
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] window Generation length, in timestamp units (milliseconds)
+	 * @param [in] expectedMessages Distinct payloads expected per window
+	 * @param [in] targetFalsePositiveRate False positive rate at @p expectedMessages, 0 to 1
+	 */
+	AISDuplicateFilter(int64_t window, uint expectedMessages,
+			double targetFalsePositiveRate = 0.001);
+
+	/**
+	 * @brief Checks a payload and remembers it
+	 *
+	 * Timestamps are supplied by the caller, usually the reception time, and
+	 * must not go backwards.
+	 *
+	 * @param [in] encodedData AIS Binary Encoded Data
+	 * @param [in] timestamp Reception time
+	 *
+	 * @return True if the payload was seen within the window.
+	 */
+	bool isDuplicate(boost::string_ref encodedData, int64_t timestamp);
+
+	/**
+	 * @brief Forgets every payload, statistics are kept
+	 */
+	void clear();
+
+	/**
+	 * @brief Estimated probability that a new payload is reported as duplicate
+	 *
+	 * Computed from the bits currently set in both generations.
+	 *
+	 * @return False positive rate in [0, 1].
+	 */
+	double falsePositiveRate() const;
+
+	/**
+	 * @brief Checked and duplicate counters
+	 *
+	 * @return Statistics.
+	 */
+	const AISDuplicateFilterStatistics& statistics() const;
+
+	/**
+	 * @brief Sets every counter to zero
+	 */
+	void resetStatistics();
+
+	/**
+	 * @brief Number of bits of each generation
+	 *
+	 * @return Bits per generation.
+	 */
+	std::size_t bits() const;
+
+	/**
+	 * @brief Number of bits set for each payload
+	 *
+	 * @return Hash count.
+	 */
+	uint hashCount() const;
+
+private:
+	/**
+	 * @brief Private Implementation
+	 */
+	class impl;
+
+	/**
+	 * @brief One Bloom filter
+	 */
+	struct Generation
+	{
+		std::vector<uint64_t> words; //!< Filter bits
+		std::size_t bitsSet; //!< Number of bits set
+	};
+
+	/**
+	 * @brief Starts a new generation if the current one is over
+	 *
+	 * @param [in] timestamp Reception time
+	 */
+	void rotate(int64_t timestamp);
+
+	int64_t window; //!< Generation length
+	int64_t generationStart; //!< Start time of the current generation
+	bool started; //!< A payload was checked since the last clear
+	uint hashes; //!< Bits set per payload
+	std::size_t mask; //!< Bits per generation - 1
+	Generation generations[2]; //!< Current and previous filters
+	uint current; //!< Index of the current generation
+	AISDuplicateFilterStatistics stats; //!< Counters
+};
+
+#endif /* AISDUPLICATEFILTER_H_ */
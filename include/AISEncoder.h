@@ -0,0 +1,190 @@
+/**
+ *	@file AISEncoder.h
+ *	@brief Header for AISEncoder class
+ *
+ *   AISEncoder class with all AIS payload encoding methods.
+ */
+
+#ifndef AISENCODER_H_
+#define AISENCODER_H_
+
+#include <string>
+#include <vector>
+#include "NmeaEnums.h"
+
+/**
+ * @brief State-less class for static methods used for encoding AIS messages.
+ *
+ * Every encoder mirrors the NmeaParser AIS decoder of the same message, so
+ * that decoding the armored payload gives back the encoded values within
+ * the resolution of each field. Values out of range are clamped to the
+ * field, and not available values (NaN) are written with the AIS not
+ * available code of the field.
+ */
+class AISEncoder
+{
+public:
+	/**
+	 * @brief Maximum armored characters per VDM sentence
+	 *
+	 * Keeps sentences within the 82 characters NMEA limit.
+	 */
+	static const int MAX_FRAGMENT_CHARS = 60;
+
+	/**
+	 * @brief Encode AIS Position Report Class A - Types 1, 2 and 3
+	 *
+	 * @param [in] data Message to encode
+	 * @param [in] messageType Message type 1, 2 or 3
+	 * @param [out] encodedData AIS Binary Encoded Data
+	 * @param [out] fillBits Number of fill bits
+	 *
+	 * @return True if message type is valid.
+	 */
+	static bool encodeAISPositionReportClassA(
+			const AISPositionReportClassA& data,
+			Nmea_AisMessageType messageType, std::string& encodedData,
+			int& fillBits);
+
+	/**
+	 * @brief Encode AIS Base Station Report - Type 4
+	 *
+	 * @param [in] data Message to encode
+	 * @param [out] encodedData AIS Binary Encoded Data
+	 * @param [out] fillBits Number of fill bits
+	 *
+	 * @return True on success.
+	 */
+	static bool encodeAISBaseStationReport(const AISBaseStationReport& data,
+			std::string& encodedData, int& fillBits);
+
+	/**
+	 * @brief Encode AIS Static And Voyage Related Data - Type 5
+	 *
+	 * Draught is written as read by NmeaParser::parseAISStaticAndVoyageRelatedData(),
+	 * in tenths of meter.
+	 *
+	 * @param [in] data Message to encode
+	 * @param [out] encodedData AIS Binary Encoded Data
+	 * @param [out] fillBits Number of fill bits
+	 *
+	 * @return True on success.
+	 */
+	static bool encodeAISStaticAndVoyageRelatedData(
+			const AISStaticAndVoyageRelatedData& data,
+			std::string& encodedData, int& fillBits);
+
+	/**
+	 * @brief Encode AIS Standard Class B CS Position Report - Type 18
+	 *
+	 * @param [in] data Message to encode
+	 * @param [out] encodedData AIS Binary Encoded Data
+	 * @param [out] fillBits Number of fill bits
+	 *
+	 * @return True on success.
+	 */
+	static bool encodeAISStandardClassBCSPositionReport(
+			const AISStandardClassBCSPositionReport& data,
+			std::string& encodedData, int& fillBits);
+
+	/**
+	 * @brief Encode AIS Extended Class B CS Position Report - Type 19
+	 *
+	 * @param [in] data Message to encode
+	 * @param [out] encodedData AIS Binary Encoded Data
+	 * @param [out] fillBits Number of fill bits
+	 *
+	 * @return True on success.
+	 */
+	static bool encodeAISExtendedClassBEquipmentPositionReport(
+			const AISExtendedClassBCSPositionReport& data,
+			std::string& encodedData, int& fillBits);
+
+	/**
+	 * @brief Encode AIS Aid-to-Navigation Report - Type 21
+	 *
+	 * Names longer than 20 characters are written with the name extension,
+	 * up to 14 more characters.
+	 *
+	 * @param [in] data Message to encode
+	 * @param [out] encodedData AIS Binary Encoded Data
+	 * @param [out] fillBits Number of fill bits
+	 *
+	 * @return True on success.
+	 */
+	static bool encodeAISAidToNavigationReport(
+			const AISAidToNavigationReport& data, std::string& encodedData,
+			int& fillBits);
+
+	/**
+	 * @brief Encode AIS Static Data Report - Type 24
+	 *
+	 * @param [in] data Message to encode, partNumber selects part A or part B
+	 * @param [out] encodedData AIS Binary Encoded Data
+	 * @param [out] fillBits Number of fill bits
+	 *
+	 * @return True if part number is valid.
+	 */
+	static bool encodeAISStaticDataReport(const AISStaticDataReport& data,
+			std::string& encodedData, int& fillBits);
+
+	/**
+	 * @brief Number of VDM sentences needed for a payload
+	 *
+	 * @param [in] encodedData AIS Binary Encoded Data
+	 *
+	 * @return Number of fragments.
+	 */
+	static int fragmentCount(const std::string& encodedData);
+
+	/**
+	 * @brief Writes a payload as one or more VDM sentences
+	 *
+	 * Payloads longer than MAX_FRAGMENT_CHARS are split in fragments sharing
+	 * the sequential message identifier. Fill bits are written in the last
+	 * fragment only. Sentences are written one after the other, each one
+	 * ending in CR LF, followed by a null character.
+	 *
+	 * @param [out] buffer Buffer receiving the sentences
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two characters
+	 * @param [in] sequenceIdentifier Sequential message identifier 0 to 9, used for multi-sentence messages
+	 * @param [in] aisChannel AIS Channel
+	 * @param [in] encodedData AIS Binary Encoded Data
+	 * @param [in] fillBits Number of fill bits
+	 *
+	 * @return Total length of the sentences, 0 if the buffer was too small.
+	 */
+	static std::size_t writeVDM(char* buffer, std::size_t size,
+			const std::string& talkerId, int sequenceIdentifier,
+			char aisChannel, const std::string& encodedData, int fillBits);
+
+	/**
+	 * @brief Writes a payload as one or more VDM sentences
+	 *
+	 * @param [out] sentences Sentences are appended, without CR LF
+	 * @param [in] talkerId Talker Id, two characters
+	 * @param [in] sequenceIdentifier Sequential message identifier 0 to 9, used for multi-sentence messages
+	 * @param [in] aisChannel AIS Channel
+	 * @param [in] encodedData AIS Binary Encoded Data
+	 * @param [in] fillBits Number of fill bits
+	 *
+	 * @return Number of sentences appended.
+	 */
+	static int writeVDM(std::vector<std::string>& sentences,
+			const std::string& talkerId, int sequenceIdentifier,
+			char aisChannel, const std::string& encodedData, int fillBits);
+
+private:
+	/**
+	 * @brief Private Implementation
+	 */
+	class impl;
+
+	/**
+	 * @brief Private Constructor. Class cannot be instantiated.
+	 */
+	AISEncoder();
+};
+
+#endif /* AISENCODER_H_ */
@@ -0,0 +1,321 @@
+/**
+ *	@file AISFixedString.h
+ *	@brief Header for AISFixedString class template
+ *
+ *   Fixed capacity inline string used for AIS six-bit text fields.
+ */
+
+#ifndef AISFIXEDSTRING_H_
+#define AISFIXEDSTRING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <sys/types.h>
+#include <boost/utility/string_ref.hpp>
+
+/**
+ * @brief Converts a six-bit AIS character code to ASCII
+ *
+ * @param [in] value Six-bit code, 0 to 63
+ *
+ * @return ASCII character, '@' to '_' for 0 to 31 and ' ' to '?' for 32 to 63.
+ */
+inline char aisSixBitToAscii(uint value)
+{
+	static const char table[65] =
+			"@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_ !\"#$%&'()*+,-./0123456789:;<=>?";
+	return table[value & 0x3F];
+}
+
+/**
+ * @brief String of at most N characters stored inline.
+ *
+ * AIS text fields have a small fixed maximum length, so they are kept in
+ * a char array inside the owning struct: copying and decoding never
+ * allocate and the structs stay trivially copyable. The text is always
+ * null terminated. Assigning or appending more than N characters keeps the
+ * first N.
+ */
+template<std::size_t N>
+class AISFixedString
+{
+public:
+	/**
+	 * @brief Maximum number of characters
+	 */
+	static const std::size_t CAPACITY = N;
+
+	/**
+	 * @brief Constructor, empty string
+	 */
+	AISFixedString() :
+			count(0)
+	{
+		text[0] = '\0';
+	}
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] value Null terminated text, truncated to N characters
+	 */
+	AISFixedString(const char* value)
+	{
+		assign(value, std::strlen(value));
+	}
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] value Text, truncated to N characters
+	 */
+	AISFixedString(const std::string& value)
+	{
+		assign(value.data(), value.size());
+	}
+
+	/**
+	 * @brief Replaces the text
+	 *
+	 * @param [in] value Characters
+	 * @param [in] length Number of characters, truncated to N
+	 */
+	void assign(const char* value, std::size_t length)
+	{
+		count = static_cast<uint8_t>(length < N ? length : N);
+		std::memcpy(text, value, count);
+		text[count] = '\0';
+	}
+
+	/**
+	 * @brief Appends characters
+	 *
+	 * @param [in] value Characters
+	 * @param [in] length Number of characters, truncated to the remaining capacity
+	 */
+	void append(const char* value, std::size_t length)
+	{
+		const std::size_t room = N - count;
+		const std::size_t added = length < room ? length : room;
+		std::memcpy(text + count, value, added);
+		count = static_cast<uint8_t>(count + added);
+		text[count] = '\0';
+	}
+
+	/**
+	 * @brief Appends one character, ignored when full
+	 *
+	 * @param [in] c Character
+	 */
+	void push_back(char c)
+	{
+		if (count < N)
+		{
+			text[count++] = c;
+			text[count] = '\0';
+		}
+	}
+
+	/**
+	 * @brief Removes leading and trailing spaces, then trailing '@'
+	 *
+	 * Six-bit text fields are padded with '@', and often with spaces.
+	 */
+	void trimSixBit()
+	{
+		std::size_t end = count;
+		while (end > 0 && text[end - 1] == ' ')
+		{
+			--end;
+		}
+		std::size_t begin = 0;
+		while (begin < end && text[begin] == ' ')
+		{
+			++begin;
+		}
+		while (end > begin && text[end - 1] == '@')
+		{
+			--end;
+		}
+		count = static_cast<uint8_t>(end - begin);
+		std::memmove(text, text + begin, count);
+		text[count] = '\0';
+	}
+
+	/**
+	 * @brief Removes every character
+	 */
+	void clear()
+	{
+		count = 0;
+		text[0] = '\0';
+	}
+
+	/**
+	 * @brief Null terminated text
+	 *
+	 * @return Text.
+	 */
+	const char* c_str() const
+	{
+		return text;
+	}
+
+	/**
+	 * @brief Characters
+	 *
+	 * @return Text.
+	 */
+	const char* data() const
+	{
+		return text;
+	}
+
+	/**
+	 * @brief Number of characters
+	 *
+	 * @return Size.
+	 */
+	std::size_t size() const
+	{
+		return count;
+	}
+
+	/**
+	 * @brief Number of characters
+	 *
+	 * @return Size.
+	 */
+	std::size_t length() const
+	{
+		return count;
+	}
+
+	/**
+	 * @brief Whether there are no characters
+	 *
+	 * @return True if empty.
+	 */
+	bool empty() const
+	{
+		return count == 0;
+	}
+
+	/**
+	 * @brief Character access
+	 *
+	 * @param [in] i Index, less than size()
+	 *
+	 * @return Character.
+	 */
+	char operator[](std::size_t i) const
+	{
+		return text[i];
+	}
+
+	/**
+	 * @brief Copy of the text
+	 *
+	 * @return Text.
+	 */
+	std::string str() const
+	{
+		return std::string(text, count);
+	}
+
+	/**
+	 * @brief Reference to the text
+	 *
+	 * @return Text.
+	 */
+	operator boost::string_ref() const
+	{
+		return boost::string_ref(text, count);
+	}
+
+private:
+	static_assert(N < 256, "AISFixedString length is stored in one byte");
+
+	uint8_t count; //!< Number of characters
+	char text[N + 1]; //!< Characters, null terminated
+};
+
+template<std::size_t N>
+const std::size_t AISFixedString<N>::CAPACITY;
+
+/**
+ * @brief Equality operator
+ * @param a First string.
+ * @param b Second string.
+ * @return True if both hold the same text.
+ */
+template<std::size_t N, std::size_t M>
+bool operator==(const AISFixedString<N>& a, const AISFixedString<M>& b)
+{
+	return boost::string_ref(a) == boost::string_ref(b);
+}
+
+/**
+ * @brief Equality operator
+ * @param a First string.
+ * @param b Second string.
+ * @return True if both hold the same text.
+ */
+template<std::size_t N>
+bool operator==(const AISFixedString<N>& a, const std::string& b)
+{
+	return boost::string_ref(a) == boost::string_ref(b);
+}
+
+/**
+ * @brief Equality operator
+ * @param a First string.
+ * @param b Second string.
+ * @return True if both hold the same text.
+ */
+template<std::size_t N>
+bool operator==(const std::string& a, const AISFixedString<N>& b)
+{
+	return b == a;
+}
+
+/**
+ * @brief Equality operator
+ * @param a First string.
+ * @param b Second string, null terminated.
+ * @return True if both hold the same text.
+ */
+template<std::size_t N>
+bool operator==(const AISFixedString<N>& a, const char* b)
+{
+	return boost::string_ref(a) == boost::string_ref(b);
+}
+
+/**
+ * @brief Inequality operator
+ * @param a First string.
+ * @param b Second string.
+ * @return True if the strings hold different text.
+ */
+template<std::size_t N, typename T>
+bool operator!=(const AISFixedString<N>& a, const T& b)
+{
+	return !(a == b);
+}
+
+/**
+ * @brief Operator writes the text.
+ * @param out ostream to write the string.
+ * @param val string.
+ * @return ostream to concatenate output.
+ */
+template<std::size_t N>
+std::ostream& operator<<(std::ostream& out, const AISFixedString<N>& val)
+{
+	return out << boost::string_ref(val.data(), val.size());
+}
+
+#endif /* AISFIXEDSTRING_H_ */
@@ -0,0 +1,189 @@
+/**
+ *	@file AISGeofence.h
+ *	@brief Header for AISGeofence class
+ *
+ *   Polygon zones raising enter and exit events for AIS targets.
+ */
+
+#ifndef AISGEOFENCE_H_
+#define AISGEOFENCE_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <sys/types.h>
+#include "AISGeometry.h"
+#include "AISMmsiMap.h"
+#include "NmeaEnums.h"
+
+/**
+ * @brief Polygon vertex.
+ */
+struct AISGeofenceVertex
+{
+	float longitude; //!< Longitude
+	float latitude; //!< Latitude
+};
+
+/**
+ * @brief Zone boundary crossing, output of AISGeofence::update().
+ */
+struct AISGeofenceEvent
+{
+	uint mmsi; //!< 9 decimal digits ID
+	uint zone; //!< Zone index returned by AISGeofence::addZone()
+	bool entered; //!< True on entry, false on exit
+	int64_t timestamp; //!< Time of the position report
+};
+
+/**
+ * @brief Geofence engine over AIS position reports.
+ *
+ * Zones are simple polygons in longitude and latitude; they must not cross
+ * the antimeridian. Every zone is registered in the cells of a coarse grid
+ * overlapped by its bounding box, so a position update only tests the few
+ * zones of its cell: bounding box first, then an even-odd point in polygon
+ * test. The zones each MMSI was inside are remembered to report entries and
+ * exits; an update costs O(1) on average whatever the number of zones, as
+ * long as few of them share a cell.
+ *
+ * Vessels are keyed by MMSI through AISMmsiMap with a fixed capacity.
+ */
+class AISGeofence
+{
+public:
+	/**
+	 * @brief Maximum number of overlapping zones a vessel is reported inside
+	 */
+	static const std::size_t MAX_OVERLAP = 64;
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] capacity Maximum number of vessels
+	 * @param [in] cellSize Grid cell side in degrees
+	 */
+	AISGeofence(uint capacity, float cellSize = 1.0f);
+
+	/**
+	 * @brief Adds a zone
+	 *
+	 * Vessels already tracked are checked against the zone on their next
+	 * update.
+	 *
+	 * @param [in] polygon Vertices, at least 3, closing edge implied
+	 *
+	 * @return Zone index, AISMmsiMap::NPOS if the polygon has less than 3 vertices.
+	 */
+	uint addZone(const std::vector<AISGeofenceVertex>& polygon);
+
+	/**
+	 * @brief Whether a point is inside a zone
+	 *
+	 * @param [in] zone Zone index
+	 * @param [in] longitude Longitude
+	 * @param [in] latitude Latitude
+	 *
+	 * @return True if inside.
+	 */
+	bool contains(uint zone, float longitude, float latitude) const;
+
+	/**
+	 * @brief Processes a vessel position
+	 *
+	 * Positions outside [-180, 180] x [-90, 90], such as the AIS not
+	 * available values, are ignored.
+	 *
+	 * @param [in] mmsi MMSI
+	 * @param [in] longitude Longitude
+	 * @param [in] latitude Latitude
+	 * @param [in] timestamp Time of the position report
+	 * @param [out] events Entry and exit events, appended
+	 *
+	 * @return Number of events appended.
+	 */
+	std::size_t update(uint mmsi, float longitude, float latitude,
+			int64_t timestamp, std::vector<AISGeofenceEvent>& events);
+
+	/**
+	 * @brief Processes a Class A position report
+	 *
+	 * @param [in] data Decoded position report
+	 * @param [in] timestamp Time of the position report
+	 * @param [out] events Entry and exit events, appended
+	 *
+	 * @return Number of events appended.
+	 */
+	std::size_t update(const AISPositionReportClassA& data, int64_t timestamp,
+			std::vector<AISGeofenceEvent>& events);
+
+	/**
+	 * @brief Processes a Class B position report
+	 *
+	 * @param [in] data Decoded position report
+	 * @param [in] timestamp Time of the position report
+	 * @param [out] events Entry and exit events, appended
+	 *
+	 * @return Number of events appended.
+	 */
+	std::size_t update(const AISStandardClassBCSPositionReport& data,
+			int64_t timestamp, std::vector<AISGeofenceEvent>& events);
+
+	/**
+	 * @brief Processes an extended Class B position report
+	 *
+	 * @param [in] data Decoded position report
+	 * @param [in] timestamp Time of the position report
+	 * @param [out] events Entry and exit events, appended
+	 *
+	 * @return Number of events appended.
+	 */
+	std::size_t update(const AISExtendedClassBCSPositionReport& data,
+			int64_t timestamp, std::vector<AISGeofenceEvent>& events);
+
+	/**
+	 * @brief Zones a vessel is inside
+	 *
+	 * @param [in] mmsi MMSI
+	 *
+	 * @return Zone indexes, empty if the vessel is unknown.
+	 */
+	const std::vector<uint>& zonesOf(uint mmsi) const;
+
+	/**
+	 * @brief Forgets a vessel, without events
+	 *
+	 * @param [in] mmsi MMSI
+	 *
+	 * @return True if the vessel was known.
+	 */
+	bool erase(uint mmsi);
+
+	/**
+	 * @brief Number of zones
+	 *
+	 * @return Zone count.
+	 */
+	uint zoneCount() const;
+
+private:
+	/**
+	 * @brief Zone polygon and bounding box
+	 */
+	struct Zone
+	{
+		std::vector<AISGeofenceVertex> polygon; //!< Vertices
+		float minLongitude; //!< Bounding box west border
+		float minLatitude; //!< Bounding box south border
+		float maxLongitude; //!< Bounding box east border
+		float maxLatitude; //!< Bounding box north border
+	};
+
+	AISMmsiMap index; //!< MMSI to slot
+	std::vector<std::vector<uint> > membership; //!< Zones each slot is inside, sorted
+	std::vector<Zone> zones; //!< Zones
+	std::unordered_map<uint, std::vector<uint> > cells; //!< Zones overlapping each non empty cell
+	AISGrid grid; //!< Cells of the zone lists
+};
+
+#endif /* AISGEOFENCE_H_ */
@@ -0,0 +1,94 @@
+/**
+ *	@file AISGeometry.h
+ *	@brief Position helpers shared by the AIS spatial classes
+ *
+ *   Validity of decoded AIS positions and motion, and the longitude /
+ *   latitude grid used by AISSpatialIndex and AISGeofence.
+ */
+
+#ifndef AISGEOMETRY_H_
+#define AISGEOMETRY_H_
+
+#include <algorithm>
+#include <cmath>
+#include <sys/types.h>
+
+/**
+ * @brief Whether a decoded position is a real one
+ *
+ * AIS sends longitude 181 and latitude 91 when the position is not
+ * available; NaN is not a position either.
+ *
+ * @param [in] longitude Longitude
+ * @param [in] latitude Latitude
+ *
+ * @return True if inside [-180, 180] x [-90, 90].
+ */
+inline bool aisValidPosition(float longitude, float latitude)
+{
+	return longitude >= -180.0f && longitude <= 180.0f && latitude >= -90.0f
+			&& latitude <= 90.0f;
+}
+
+/**
+ * @brief Whether decoded speed and course describe a motion
+ *
+ * AIS sends speed 102.3 and course 360 when they are not available.
+ *
+ * @param [in] speedOverGround Speed Over Ground in knots
+ * @param [in] courseOverGround Course Over Ground in degrees
+ *
+ * @return True if both are available.
+ */
+inline bool aisValidMotion(float speedOverGround, float courseOverGround)
+{
+	return speedOverGround >= 0.0f && speedOverGround < 102.3f
+			&& courseOverGround >= 0.0f && courseOverGround < 360.0f;
+}
+
+/**
+ * @brief Grid of square cells over [-180, 180] x [-90, 90], row major.
+ *
+ * Positions on or past the borders fall in the border cells.
+ */
+struct AISGrid
+{
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] cellSize Cell side in degrees, 180 should be close to a multiple of it
+	 */
+	explicit AISGrid(float cellSize) :
+			cellSize(cellSize), columns(
+					std::max(1,
+							static_cast<int>(std::ceil(
+									360.0f / cellSize - 1e-3f)))), rows(
+					std::max(1,
+							static_cast<int>(std::ceil(
+									180.0f / cellSize - 1e-3f))))
+	{
+	}
+
+	/**
+	 * @brief Cell of a position
+	 *
+	 * @param [in] longitude Longitude
+	 * @param [in] latitude Latitude
+	 *
+	 * @return Cell index, row * columns + column.
+	 */
+	uint cellOf(float longitude, float latitude) const
+	{
+		const int column = std::min(columns - 1,
+				std::max(0, static_cast<int>((longitude + 180.0f) / cellSize)));
+		const int row = std::min(rows - 1,
+				std::max(0, static_cast<int>((latitude + 90.0f) / cellSize)));
+		return static_cast<uint>(row * columns + column);
+	}
+
+	float cellSize; //!< Cell side in degrees
+	int columns; //!< Cells along longitude
+	int rows; //!< Cells along latitude
+};
+
+#endif /* AISGEOMETRY_H_ */
@@ -0,0 +1,191 @@
+/**
+ *	@file AISLogIndex.h
+ *	@brief Header for AISLogIndex class
+ *
+ *   Sidecar MMSI index of raw NMEA/AIS log files.
+ */
+
+#ifndef AISLOGINDEX_H_
+#define AISLOGINDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include <boost/noncopyable.hpp>
+#include <boost/utility/string_ref.hpp>
+#include "NmeaMappedFile.h"
+
+/**
+ * @brief AIS message located by AISLogIndex, 16 bytes.
+ */
+struct AISLogIndexEntry
+{
+	uint64_t offset; //!< Log offset of the first sentence of the message
+	uint32_t length; //!< Bytes up to the end of the last fragment, terminator included
+	uint8_t messageType; //!< Nmea_AisMessageType
+	uint8_t reserved[3]; //!< Zero
+};
+
+/**
+ * @brief MMSI inverted index over a raw NMEA/AIS log file.
+ *
+ * build() scans a log once. It reads the message type and MMSI of every
+ * !--VDM and !--VDO message from the first 7 payload characters, through
+ * AISMessageView, without decoding anything else. Lines may start with a
+ * TAG block. The index is written to a sidecar file holding:
+ *
+ * - For every MMSI, the sorted list of its messages as AISLogIndexEntry:
+ *   log offset, length and message type. Multi-sentence messages are one
+ *   entry spanning from the first to the last fragment.
+ * - The log cut in blocks of about @c blockBytes at line boundaries, each
+ *   with a Bloom filter of the MMSIs it contains, for queries over many
+ *   vessels that scan candidate blocks instead of merging postings.
+ *
+ * open() maps the sidecar; queries binary search the MMSI table and touch
+ * only the postings of the vessel. messages() then returns the matching
+ * sentences straight from the mapped log, so only those are parsed.
+ *
+ * The index describes the log as it was when built; bytes appended later
+ * are not indexed. build() keeps every posting in memory, 24 bytes per AIS
+ * message, before writing them sorted by MMSI.
+ */
+class AISLogIndex: private boost::noncopyable
+{
+public:
+	/**
+	 * @brief Indexes a log file
+	 *
+	 * @param [in] logPath Log file path
+	 * @param [in] indexPath Index file path, overwritten
+	 * @param [in] blockBytes Target block size in bytes
+	 *
+	 * @return False if the log cannot be read or the index written.
+	 */
+	static bool build(const std::string& logPath, const std::string& indexPath,
+			uint64_t blockBytes = 1 << 20);
+
+	/**
+	 * @brief Constructor
+	 */
+	AISLogIndex();
+
+	/**
+	 * @brief Maps an index file
+	 *
+	 * @param [in] indexPath Index file path
+	 *
+	 * @return False if the file cannot be mapped or is not an index.
+	 */
+	bool open(const std::string& indexPath);
+
+	/**
+	 * @brief Unmaps the index
+	 */
+	void close();
+
+	/**
+	 * @brief Size of the log when it was indexed
+	 *
+	 * @return Bytes.
+	 */
+	uint64_t logSize() const;
+
+	/**
+	 * @brief Number of distinct MMSI
+	 *
+	 * @return MMSI count.
+	 */
+	std::size_t mmsiCount() const;
+
+	/**
+	 * @brief Messages of a vessel
+	 *
+	 * @param [in] mmsi MMSI
+	 * @param [out] entries Messages in log order, appended
+	 *
+	 * @return Number of entries appended.
+	 */
+	std::size_t find(uint mmsi, std::vector<AISLogIndexEntry>& entries) const;
+
+	/**
+	 * @brief Sentences of the messages of a vessel
+	 *
+	 * Every view holds the sentences of one message, fragments included,
+	 * separated and terminated by their line terminators.
+	 *
+	 * @param [in] mmsi MMSI
+	 * @param [in] log Mapped log file the index was built from
+	 * @param [out] messages Views into @p log, in log order, appended
+	 *
+	 * @return Number of messages appended.
+	 */
+	std::size_t messages(uint mmsi, const NmeaMappedFile& log,
+			std::vector<boost::string_ref>& messages) const;
+
+	/**
+	 * @brief Number of blocks
+	 *
+	 * @return Block count.
+	 */
+	std::size_t blockCount() const;
+
+	/**
+	 * @brief Log offset of a block
+	 *
+	 * @param [in] block Block index
+	 *
+	 * @return Offset of the first line of the block.
+	 */
+	uint64_t blockOffset(std::size_t block) const;
+
+	/**
+	 * @brief Length of a block
+	 *
+	 * @param [in] block Block index
+	 *
+	 * @return Bytes, whole lines.
+	 */
+	uint64_t blockLength(std::size_t block) const;
+
+	/**
+	 * @brief Checks the Bloom filter of a block
+	 *
+	 * @param [in] block Block index
+	 * @param [in] mmsi MMSI
+	 *
+	 * @return False if the block has no message of @p mmsi, true if it may have.
+	 */
+	bool mayContain(std::size_t block, uint mmsi) const;
+
+	/**
+	 * @brief Blocks that may hold messages of any of a set of vessels
+	 *
+	 * @param [in] mmsis MMSI set
+	 * @param [out] blocks Block indexes in log order, appended
+	 *
+	 * @return Number of blocks appended.
+	 */
+	std::size_t candidateBlocks(const std::vector<uint>& mmsis,
+			std::vector<std::size_t>& blocks) const;
+
+private:
+	/**
+	 * @brief Private Implementation
+	 */
+	class impl;
+
+	NmeaMappedFile file; //!< Mapped index
+	const uint64_t* blocks; //!< Offset and length of every block
+	const uint64_t* blooms; //!< Bloom filter words of every block
+	const uint32_t* mmsis; //!< MMSI, count and first entry, 16 bytes per MMSI
+	const AISLogIndexEntry* entries; //!< Postings sorted by MMSI then offset
+	uint64_t indexedSize; //!< Log size when indexed
+	uint64_t blockTotal; //!< Number of blocks
+	uint64_t bloomWords; //!< Bloom filter words per block
+	uint64_t mmsiTotal; //!< Number of MMSI
+	uint32_t hashes; //!< Bloom filter hash count
+};
+
+#endif /* AISLOGINDEX_H_ */
@@ -0,0 +1,260 @@
+/**
+ *	@file AISMessageView.h
+ *	@brief Header for AISMessageView class
+ *
+ *   AISMessageView class reads AIS fields on demand from an armored payload.
+ */
+
+#ifndef AISMESSAGEVIEW_H_
+#define AISMESSAGEVIEW_H_
+
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+#include <boost/utility/string_ref.hpp>
+#include "NmeaEnums.h"
+#include "AISBitBuffer.h"
+
+/**
+ * @brief Lazy view over an armored AIS payload.
+ *
+ * Nothing is decoded up front: every accessor reads only the armor
+ * characters holding its field. Routing on message type and MMSI touches
+ * the first 7 characters of the payload.
+ *
+ * The view does not copy the payload, which must outlive it. Bits past the
+ * end of the payload read as zero. Accessors for fields the message type
+ * does not carry return the AIS not available value of the field.
+ */
+class AISMessageView
+{
+public:
+	/**
+	 * @brief Constructor, empty view
+	 */
+	AISMessageView();
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] encodedData AIS Binary Encoded Data
+	 */
+	explicit AISMessageView(boost::string_ref encodedData);
+
+	/**
+	 * @brief Points the view to another payload
+	 *
+	 * @param [in] encodedData AIS Binary Encoded Data
+	 */
+	void assign(boost::string_ref encodedData);
+
+	/**
+	 * @brief Number of bits in the payload, including fill bits
+	 *
+	 * @return Payload bits.
+	 */
+	int size() const;
+
+	/**
+	 * @brief Message Type
+	 *
+	 * @return Message type, Nmea_AisMessageType_NA if the view is empty.
+	 */
+	Nmea_AisMessageType messageType() const;
+
+	/**
+	 * @brief Message repeat count
+	 *
+	 * @return Repeat indicator.
+	 */
+	int repeatIndicator() const;
+
+	/**
+	 * @brief 9 decimal digits ID
+	 *
+	 * @return MMSI.
+	 */
+	uint mmsi() const;
+
+	/**
+	 * @brief Whether the message carries a position and is long enough for it
+	 *
+	 * Types 1, 2, 3, 4, 18, 19 and 21.
+	 *
+	 * @return True if position is available.
+	 */
+	bool hasPosition() const;
+
+	/**
+	 * @brief Longitude
+	 *
+	 * @return Longitude, 181 if not carried by the message type.
+	 */
+	float longitude() const;
+
+	/**
+	 * @brief Latitude
+	 *
+	 * @return Latitude, 91 if not carried by the message type.
+	 */
+	float latitude() const;
+
+	/**
+	 * @brief Speed Over Ground, types 1, 2, 3, 18 and 19
+	 *
+	 * @return Speed Over Ground, 102.3 if not carried by the message type.
+	 */
+	float speedOverGround() const;
+
+	/**
+	 * @brief Course Over Ground, types 1, 2, 3, 18 and 19
+	 *
+	 * @return Course Over Ground, 360 if not carried by the message type.
+	 */
+	float courseOverGround() const;
+
+	/**
+	 * @brief True Heading, types 1, 2, 3, 18 and 19
+	 *
+	 * @return True Heading, 511 if not carried by the message type.
+	 */
+	uint trueHeading() const;
+
+	/**
+	 * @brief Navigation Status, types 1, 2 and 3
+	 *
+	 * @return Navigation Status, Nmea_NavigationStatus_NotDefined if not carried by the message type.
+	 */
+	Nmea_NavigationStatus navigationStatus() const;
+
+	/**
+	 * @brief Vessel Name, types 5, 19 and 24 part A, or Name, type 21
+	 *
+	 * @return Name, empty if not carried by the message type.
+	 */
+	AISFixedString<34> vesselName() const;
+
+	/**
+	 * @brief Call Sign, types 5 and 24 part B
+	 *
+	 * @return Call Sign, empty if not carried by the message type.
+	 */
+	AISFixedString<7> callsign() const;
+
+	/**
+	 * @brief Destination, type 5
+	 *
+	 * @return Destination, empty if not carried by the message type.
+	 */
+	AISFixedString<20> destination() const;
+
+	/**
+	 * @brief Ship Type, types 5, 19 and 24 part B
+	 *
+	 * @return Ship Type, Nmea_ShipType_NotAvailable if not carried by the message type.
+	 */
+	Nmea_ShipType shipType() const;
+
+	/**
+	 * @brief Reads an unsigned field
+	 *
+	 * @param [in] position Offset of the first bit
+	 * @param [in] bits Field width, 1 to 32
+	 *
+	 * @return Field value.
+	 */
+	uint getUInt(int position, int bits) const;
+
+	/**
+	 * @brief Reads a two's complement signed field
+	 *
+	 * @param [in] position Offset of the first bit
+	 * @param [in] bits Field width, 1 to 32
+	 *
+	 * @return Field value.
+	 */
+	int getInt(int position, int bits) const;
+
+	/**
+	 * @brief Reads a six-bit ASCII text field, see aisReadSixBitText()
+	 *
+	 * @param [in] position Offset of the first bit
+	 * @param [in] chars Field width in characters
+	 * @param [out] value Text
+	 */
+	template<std::size_t N>
+	void getString(int position, int chars, AISFixedString<N>& value) const
+	{
+		aisReadSixBitText(*this, position, chars, value);
+	}
+
+private:
+	/**
+	 * @brief Six-bit value of an armor character
+	 *
+	 * @param [in] index Character index
+	 *
+	 * @return Value, 0 past the end of the payload.
+	 */
+	uint sixBit(std::size_t index) const;
+
+	/**
+	 * @brief Offset of Longitude for the message type
+	 *
+	 * @return Bit offset, -1 if not carried by the message type.
+	 */
+	int longitudeOffset() const;
+
+	/**
+	 * @brief Offset of Speed Over Ground for the message type
+	 *
+	 * Course Over Ground and True Heading follow at fixed distances.
+	 *
+	 * @return Bit offset, -1 if not carried by the message type.
+	 */
+	int speedOffset() const;
+
+	boost::string_ref data; //!< Armored payload
+};
+
+inline uint AISMessageView::sixBit(std::size_t index) const
+{
+	return index < data.size() ? aisArmorToSixBit(data[index]) : 0;
+}
+
+inline uint AISMessageView::getUInt(int position, int bits) const
+{
+	const int first = position / 6;
+	const int last = (position + bits - 1) / 6;
+
+	uint64_t value = 0;
+	for (int i = first; i <= last; ++i)
+	{
+		value = (value << 6) | sixBit(i);
+	}
+
+	const int trailing = (last + 1) * 6 - (position + bits);
+	return static_cast<uint>((value >> trailing)
+			& ((static_cast<uint64_t>(1) << bits) - 1));
+}
+
+inline int AISMessageView::getInt(int position, int bits) const
+{
+	const int64_t value = getUInt(position, bits);
+	const int64_t sign = static_cast<int64_t>(1) << (bits - 1);
+	return static_cast<int>((value ^ sign) - sign);
+}
+
+inline Nmea_AisMessageType AISMessageView::messageType() const
+{
+	return data.empty() ?
+			Nmea_AisMessageType_NA :
+			static_cast<Nmea_AisMessageType>(sixBit(0));
+}
+
+inline uint AISMessageView::mmsi() const
+{
+	return getUInt(8, 30);
+}
+
+#endif /* AISMESSAGEVIEW_H_ */
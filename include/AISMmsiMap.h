@@ -0,0 +1,124 @@
+/**
+ *	@file AISMmsiMap.h
+ *	@brief Header for AISMmsiMap class
+ *
+ *   Fixed capacity map from MMSI to a stable slot index.
+ */
+
+#ifndef AISMMSIMAP_H_
+#define AISMMSIMAP_H_
+
+#include <vector>
+#include <sys/types.h>
+
+/**
+ * @brief Fixed capacity open addressing map from MMSI to slot index.
+ *
+ * Every inserted MMSI is given a slot in [0, capacity) that stays the same
+ * until the MMSI is erased, so callers keep their per-vessel records in
+ * plain arrays indexed by slot. All memory is allocated by the constructor:
+ * lookups, insertions and deletions never allocate.
+ *
+ * Buckets are probed linearly and kept at most half full. Deletions shift
+ * the following buckets back, so there are no tombstones and lookups stay
+ * short after heavy churn.
+ */
+class AISMmsiMap
+{
+public:
+	/**
+	 * @brief Value returned when there is no slot
+	 */
+	static const uint NPOS = 0xFFFFFFFF;
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] capacity Maximum number of MMSI in the map
+	 */
+	explicit AISMmsiMap(uint capacity);
+
+	/**
+	 * @brief Finds the slot of a MMSI
+	 *
+	 * @param [in] mmsi MMSI
+	 *
+	 * @return Slot index, NPOS if not found.
+	 */
+	uint find(uint mmsi) const;
+
+	/**
+	 * @brief Finds the slot of a MMSI, inserting it if not found
+	 *
+	 * @param [in] mmsi MMSI
+	 * @param [out] inserted True if the MMSI was not in the map
+	 *
+	 * @return Slot index, NPOS if the map is full.
+	 */
+	uint insert(uint mmsi, bool& inserted);
+
+	/**
+	 * @brief Removes a MMSI and releases its slot
+	 *
+	 * @param [in] mmsi MMSI
+	 *
+	 * @return True if the MMSI was in the map.
+	 */
+	bool erase(uint mmsi);
+
+	/**
+	 * @brief Removes every MMSI
+	 */
+	void clear();
+
+	/**
+	 * @brief MMSI owning a slot
+	 *
+	 * @param [in] slot Slot index
+	 *
+	 * @return MMSI, NPOS if the slot is free.
+	 */
+	uint mmsiAt(uint slot) const;
+
+	/**
+	 * @brief Number of MMSI in the map
+	 *
+	 * @return Size.
+	 */
+	uint size() const;
+
+	/**
+	 * @brief Maximum number of MMSI in the map
+	 *
+	 * @return Capacity.
+	 */
+	uint capacity() const;
+
+private:
+	/**
+	 * @brief Hash table bucket
+	 */
+	struct Bucket
+	{
+		uint mmsi; //!< MMSI, NPOS if empty
+		uint slot; //!< Slot given to the MMSI
+	};
+
+	/**
+	 * @brief Home bucket of a MMSI
+	 *
+	 * @param [in] mmsi MMSI
+	 *
+	 * @return Bucket index.
+	 */
+	uint home(uint mmsi) const;
+
+	std::vector<Bucket> buckets; //!< Hash table, size is a power of two
+	std::vector<uint> slotMmsi; //!< MMSI owning each slot
+	std::vector<uint> freeSlots; //!< Stack of free slots
+	uint mask; //!< Bucket count - 1
+	uint shift; //!< Shift applied to the multiplicative hash
+	uint count; //!< Number of MMSI in the map
+};
+
+#endif /* AISMMSIMAP_H_ */
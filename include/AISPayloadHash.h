@@ -0,0 +1,34 @@
+/**
+ *	@file AISPayloadHash.h
+ *	@brief Hash of AIS payloads and text fields
+ */
+
+#ifndef AISPAYLOADHASH_H_
+#define AISPAYLOADHASH_H_
+
+#include <cstdint>
+#include <boost/utility/string_ref.hpp>
+
+/**
+ * @brief 64 bit FNV-1a hash of a payload
+ *
+ * Fast on the short armored strings of AIS sentences. Callers needing
+ * well spread bits, such as Bloom filters, mix the result further.
+ *
+ * @param [in] encodedData AIS Binary Encoded Data, or any text
+ *
+ * @return Hash.
+ */
+inline uint64_t aisPayloadHash(boost::string_ref encodedData)
+{
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	for (boost::string_ref::const_iterator it = encodedData.begin();
+			it != encodedData.end(); ++it)
+	{
+		hash ^= static_cast<unsigned char>(*it);
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+#endif /* AISPAYLOADHASH_H_ */
@@ -0,0 +1,178 @@
+/**
+ *	@file AISSpatialIndex.h
+ *	@brief Header for AISSpatialIndex class
+ *
+ *   Uniform grid index of AIS target positions.
+ */
+
+#ifndef AISSPATIALINDEX_H_
+#define AISSPATIALINDEX_H_
+
+#include <cstddef>
+#include <vector>
+#include <sys/types.h>
+#include "AISGeometry.h"
+#include "AISMmsiMap.h"
+
+/**
+ * @brief Spatial index of vessel positions for viewport and range queries.
+ *
+ * The globe is divided into square cells of a fixed size in degrees. Each
+ * cell holds an intrusive doubly linked list of the vessels inside it, so
+ * moving a vessel is O(1): unlink from the old cell, link into the new one,
+ * or only store the coordinates when it stays in the same cell. Queries
+ * visit the cells overlapping the area and test the vessels in them, which
+ * costs the number of results plus the vessels sharing the border cells.
+ *
+ * Vessels are keyed by MMSI through AISMmsiMap; capacity is fixed at
+ * construction and updates never allocate.
+ */
+class AISSpatialIndex
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] capacity Maximum number of vessels
+	 * @param [in] cellSize Cell side in degrees, 180 must be close to a multiple of it
+	 */
+	AISSpatialIndex(uint capacity, float cellSize = 0.25f);
+
+	/**
+	 * @brief Sets the position of a vessel, adding it if needed
+	 *
+	 * Positions outside [-180, 180] x [-90, 90], such as the AIS not
+	 * available values 181 and 91, remove the vessel.
+	 *
+	 * @param [in] mmsi MMSI
+	 * @param [in] longitude Longitude
+	 * @param [in] latitude Latitude
+	 *
+	 * @return False if the index is full.
+	 */
+	bool update(uint mmsi, float longitude, float latitude);
+
+	/**
+	 * @brief Removes a vessel
+	 *
+	 * @param [in] mmsi MMSI
+	 *
+	 * @return True if the vessel was in the index.
+	 */
+	bool erase(uint mmsi);
+
+	/**
+	 * @brief Removes every vessel
+	 */
+	void clear();
+
+	/**
+	 * @brief Position of a vessel
+	 *
+	 * @param [in] mmsi MMSI
+	 * @param [out] longitude Longitude
+	 * @param [out] latitude Latitude
+	 *
+	 * @return False if the vessel is not in the index.
+	 */
+	bool find(uint mmsi, float& longitude, float& latitude) const;
+
+	/**
+	 * @brief Vessels inside a bounding box, borders included
+	 *
+	 * A box with @p minLongitude greater than @p maxLongitude crosses the
+	 * antimeridian.
+	 *
+	 * @param [in] minLongitude West border
+	 * @param [in] minLatitude South border
+	 * @param [in] maxLongitude East border
+	 * @param [in] maxLatitude North border
+	 * @param [out] mmsi MMSI of the vessels found, in no particular order
+	 *
+	 * @return Number of vessels found.
+	 */
+	std::size_t queryBox(float minLongitude, float minLatitude,
+			float maxLongitude, float maxLatitude,
+			std::vector<uint>& mmsi) const;
+
+	/**
+	 * @brief Vessels within a great circle distance
+	 *
+	 * @param [in] longitude Center longitude
+	 * @param [in] latitude Center latitude
+	 * @param [in] radius Distance in nautical miles
+	 * @param [out] mmsi MMSI of the vessels found, in no particular order
+	 *
+	 * @return Number of vessels found.
+	 */
+	std::size_t queryRadius(float longitude, float latitude, float radius,
+			std::vector<uint>& mmsi) const;
+
+	/**
+	 * @brief Number of vessels in the index
+	 *
+	 * @return Size.
+	 */
+	uint size() const;
+
+	/**
+	 * @brief Maximum number of vessels
+	 *
+	 * @return Capacity.
+	 */
+	uint capacity() const;
+
+private:
+	/**
+	 * @brief Private Implementation
+	 */
+	class impl;
+
+	/**
+	 * @brief Vessel entry, indexed by slot
+	 */
+	struct Node
+	{
+		float longitude; //!< Longitude
+		float latitude; //!< Latitude
+		uint cell; //!< Cell holding the vessel
+		uint prev; //!< Previous slot in the cell, NPOS if first
+		uint next; //!< Next slot in the cell, NPOS if last
+	};
+
+	/**
+	 * @brief Removes a slot from its cell list
+	 *
+	 * @param [in] slot Slot index
+	 */
+	void unlink(uint slot);
+
+	/**
+	 * @brief Adds a slot to a cell list
+	 *
+	 * @param [in] slot Slot index
+	 * @param [in] cell Cell index
+	 */
+	void link(uint slot, uint cell);
+
+	/**
+	 * @brief Visits the cells of a rectangle and tests their vessels
+	 *
+	 * @param [in] minColumn First column, may be negative or past the last to wrap
+	 * @param [in] maxColumn Last column
+	 * @param [in] minRow First row
+	 * @param [in] maxRow Last row
+	 * @param [in] accept Test applied to every vessel in the cells
+	 * @param [out] mmsi MMSI of the vessels accepted
+	 */
+	template<typename Accept>
+	void scan(int minColumn, int maxColumn, int minRow, int maxRow,
+			const Accept& accept, std::vector<uint>& mmsi) const;
+
+	AISMmsiMap index; //!< MMSI to slot
+	std::vector<Node> nodes; //!< Vessel entries
+	std::vector<uint> cells; //!< First slot of each cell, NPOS if empty
+	AISGrid grid; //!< Cells of the vessel lists
+};
+
+#endif /* AISSPATIALINDEX_H_ */
@@ -0,0 +1,168 @@
+/**
+ *	@file AISStaticDataCache.h
+ *	@brief Header for AISStaticDataCache class
+ *
+ *   Memoizes decoded AIS static data messages by MMSI and payload hash.
+ */
+
+#ifndef AISSTATICDATACACHE_H_
+#define AISSTATICDATACACHE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AISMmsiMap.h"
+#include "NmeaEnums.h"
+
+/**
+ * @brief Counters kept by AISStaticDataCache.
+ */
+struct AISStaticDataCacheStatistics
+{
+	uint64_t hits; //!< Payloads answered from the cache
+	uint64_t misses; //!< Payloads decoded, including failed decodes
+	uint64_t evictions; //!< Records dropped to make room for another MMSI
+
+	/**
+	 * @brief Ratio of hits over all lookups
+	 *
+	 * @return Hit rate in [0, 1], 0 before the first lookup.
+	 */
+	double hitRate() const;
+};
+
+/**
+ * @brief Decoding cache for AIS static data, types 5 and 24.
+ *
+ * Vessels rebroadcast the same static data every few minutes. The cache
+ * keeps the last decoded record of every MMSI together with a 64 bit
+ * FNV-1a hash of its payload: when a vessel sends the same payload again the
+ * cached record is returned without decoding bits or building strings.
+ * Type 24 part A and part B are cached separately.
+ *
+ * Memory is bounded by the capacity given at construction, per message
+ * kind. When full, the record to drop is chosen by the CLOCK policy: a
+ * hand sweeps the slots, sparing once those used since its last pass.
+ */
+class AISStaticDataCache
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] capacity Maximum number of vessels per message kind, 0 is raised to 1
+	 */
+	explicit AISStaticDataCache(uint capacity);
+
+	/**
+	 * @brief Decodes a Static And Voyage Related Data message, type 5
+	 *
+	 * @param [in] encodedData AIS Binary Encoded Data
+	 *
+	 * @return Decoded record, nullptr if the message is not valid. The record
+	 * stays valid until the next call for the same message kind.
+	 */
+	const AISStaticAndVoyageRelatedData* parseAISStaticAndVoyageRelatedData(
+			const std::string& encodedData);
+
+	/**
+	 * @brief Decodes a Static And Voyage Related Data message, type 5
+	 *
+	 * Same as NmeaParser::parseAISStaticAndVoyageRelatedData().
+	 *
+	 * @param [in] encodedData AIS Binary Encoded Data
+	 * @param [out] data Decoded data
+	 *
+	 * @return True if the message is valid.
+	 */
+	bool parseAISStaticAndVoyageRelatedData(const std::string& encodedData,
+			AISStaticAndVoyageRelatedData& data);
+
+	/**
+	 * @brief Decodes a Static Data Report message, type 24
+	 *
+	 * @param [in] encodedData AIS Binary Encoded Data
+	 *
+	 * @return Decoded record, nullptr if the message is not valid. The record
+	 * stays valid until the next call for the same message kind.
+	 */
+	const AISStaticDataReport* parseAISStaticDataReport(
+			const std::string& encodedData);
+
+	/**
+	 * @brief Decodes a Static Data Report message, type 24
+	 *
+	 * Same as NmeaParser::parseAISStaticDataReport().
+	 *
+	 * @param [in] encodedData AIS Binary Encoded Data
+	 * @param [out] data Decoded data
+	 *
+	 * @return True if the message is valid.
+	 */
+	bool parseAISStaticDataReport(const std::string& encodedData,
+			AISStaticDataReport& data);
+
+	/**
+	 * @brief Drops every cached record, statistics are kept
+	 */
+	void clear();
+
+	/**
+	 * @brief Number of cached records, all message kinds
+	 *
+	 * @return Size.
+	 */
+	uint size() const;
+
+	/**
+	 * @brief Maximum number of vessels per message kind
+	 *
+	 * @return Capacity.
+	 */
+	uint capacity() const;
+
+	/**
+	 * @brief Hit and miss counters
+	 *
+	 * @return Statistics.
+	 */
+	const AISStaticDataCacheStatistics& statistics() const;
+
+	/**
+	 * @brief Sets every counter to zero
+	 */
+	void resetStatistics();
+
+private:
+	/**
+	 * @brief Private Implementation
+	 */
+	class impl;
+
+	/**
+	 * @brief Cached records of one message kind
+	 */
+	template<typename Record>
+	struct Table
+	{
+		/**
+		 * @brief Constructor
+		 *
+		 * @param [in] capacity Maximum number of vessels
+		 */
+		explicit Table(uint capacity);
+
+		AISMmsiMap index; //!< MMSI to slot
+		std::vector<uint64_t> hash; //!< Payload hash per slot
+		std::vector<Record> record; //!< Decoded record per slot
+		std::vector<bool> referenced; //!< Used since the last pass of the hand
+		uint hand; //!< Next slot considered for eviction
+	};
+
+	Table<AISStaticAndVoyageRelatedData> voyage; //!< Type 5
+	Table<AISStaticDataReport> partA; //!< Type 24 part A
+	Table<AISStaticDataReport> partB; //!< Type 24 part B
+	AISStaticDataCacheStatistics stats; //!< Counters
+};
+
+#endif /* AISSTATICDATACACHE_H_ */
@@ -0,0 +1,132 @@
+/**
+ *	@file AISStringPool.h
+ *	@brief Header for AISStringPool class
+ *
+ *   Interning pool giving 32 bit handles to repeated AIS text.
+ */
+
+#ifndef AISSTRINGPOOL_H_
+#define AISSTRINGPOOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <sys/types.h>
+#include <boost/utility/string_ref.hpp>
+
+/**
+ * @brief Fixed capacity string interning pool.
+ *
+ * Destinations, vessel names and vendor ids repeat across many vessels.
+ * intern() stores every distinct text once and returns a 32 bit handle, so
+ * per-vessel records can keep four byte handles instead of the text. The
+ * AIS text fields of NmeaEnums.h convert to boost::string_ref and can be
+ * interned right after decoding.
+ *
+ * One thread interns; any number of threads resolve handles with get()
+ * without locks: text and offsets are written before the entry count is
+ * published with release ordering, and never change afterwards. Text
+ * memory and entries are allocated by the constructor and never move, so
+ * references returned by get() stay valid for the life of the pool.
+ *
+ * Handle 0 is the empty string.
+ */
+class AISStringPool
+{
+public:
+	/**
+	 * @brief Value returned when the pool is full
+	 */
+	static const uint NPOS = 0xFFFFFFFF;
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] maxStrings Maximum number of distinct strings
+	 * @param [in] maxBytes Maximum number of characters over all strings
+	 */
+	AISStringPool(uint maxStrings, std::size_t maxBytes);
+
+	/**
+	 * @brief Finds the handle of a text, adding it if not found
+	 *
+	 * Writer thread only.
+	 *
+	 * @param [in] text Text
+	 *
+	 * @return Handle, NPOS if the pool is full.
+	 */
+	uint intern(boost::string_ref text);
+
+	/**
+	 * @brief Finds the handle of a text
+	 *
+	 * Writer thread only.
+	 *
+	 * @param [in] text Text
+	 *
+	 * @return Handle, NPOS if not found.
+	 */
+	uint find(boost::string_ref text) const;
+
+	/**
+	 * @brief Text of a handle
+	 *
+	 * Any thread, lock-free.
+	 *
+	 * @param [in] handle Handle
+	 *
+	 * @return Text, empty if the handle is not valid.
+	 */
+	boost::string_ref get(uint handle) const;
+
+	/**
+	 * @brief Number of distinct strings, including the empty string
+	 *
+	 * @return Size.
+	 */
+	uint size() const;
+
+	/**
+	 * @brief Characters stored
+	 *
+	 * @return Bytes of text.
+	 */
+	std::size_t textBytes() const;
+
+	/**
+	 * @brief Memory allocated by the pool
+	 *
+	 * @return Bytes.
+	 */
+	std::size_t memoryUsage() const;
+
+private:
+	/**
+	 * @brief Text location of a handle
+	 */
+	struct Entry
+	{
+		uint32_t offset; //!< First character in text
+		uint32_t length; //!< Number of characters
+	};
+
+	/**
+	 * @brief Finds the bucket of a text
+	 *
+	 * @param [in] text Text
+	 *
+	 * @return Bucket holding the text, or the empty bucket where it goes.
+	 */
+	uint probe(boost::string_ref text) const;
+
+	std::vector<char> text; //!< Characters of every string
+	std::vector<Entry> entries; //!< Text location per handle
+	std::vector<uint> buckets; //!< Hash table, handle + 1, 0 if empty
+	std::atomic<uint> count; //!< Published handles
+	std::size_t used; //!< Characters used in text
+	uint mask; //!< Bucket count - 1
+};
+
+#endif /* AISSTRINGPOOL_H_ */
@@ -0,0 +1,202 @@
+/**
+ *	@file AISTrackHistory.h
+ *	@brief Header for AISTrackHistory class
+ *
+ *   Fixed memory per-MMSI history of the last positions of every vessel.
+ */
+
+#ifndef AISTRACKHISTORY_H_
+#define AISTRACKHISTORY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <sys/types.h>
+#include "AISGeometry.h"
+#include "AISMmsiMap.h"
+#include "NmeaEnums.h"
+
+/**
+ * @brief Stored track point, 16 bytes.
+ *
+ * Values keep the AIS wire resolution: 1/600000 degree for positions and
+ * 0.1 knot or degree for speed and course.
+ */
+struct AISTrackPoint
+{
+	int32_t longitude; //!< Longitude in 1/600000 degree
+	int32_t latitude; //!< Latitude in 1/600000 degree
+	uint32_t timeDelta; //!< Time since the track base time
+	uint16_t speedOverGround; //!< Speed Over Ground in 0.1 knot
+	uint16_t courseOverGround; //!< Course Over Ground in 0.1 degree
+};
+
+/**
+ * @brief Decoded track point.
+ */
+struct AISTrackPosition
+{
+	float longitude; //!< Longitude
+	float latitude; //!< Latitude
+	float speedOverGround; //!< Speed Over Ground
+	float courseOverGround; //!< Course Over Ground
+	int64_t timestamp; //!< Time of the position report
+};
+
+/**
+ * @brief Last positions of every vessel in fixed memory.
+ *
+ * Every MMSI gets a ring of the same number of AISTrackPoint; all rings
+ * live in one slab allocated by the constructor, indexed by the AISMmsiMap
+ * slot, so memory is capacity * (pointsPerTrack * 16 + 16) bytes plus the
+ * MMSI map: 1M vessels of 64 points take 1.04 GB. Appending never
+ * allocates and overwrites the oldest point of a full ring.
+ *
+ * Timestamps are stored as 32 bit deltas from a per track base time. When
+ * a delta would overflow the base moves to the oldest point; points more
+ * than 2^32 timestamp units (49 days in milliseconds) older than the new
+ * one are dropped. Timestamps of a vessel must not go backwards.
+ */
+class AISTrackHistory
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] capacity Maximum number of vessels
+	 * @param [in] pointsPerTrack Points kept per vessel, 1 to 65535
+	 */
+	AISTrackHistory(uint capacity, uint pointsPerTrack);
+
+	/**
+	 * @brief Appends a position to the track of a vessel
+	 *
+	 * Positions not available (longitude 181 or latitude 91) are ignored.
+	 *
+	 * @param [in] mmsi MMSI
+	 * @param [in] longitude Longitude
+	 * @param [in] latitude Latitude
+	 * @param [in] speedOverGround Speed Over Ground
+	 * @param [in] courseOverGround Course Over Ground
+	 * @param [in] timestamp Time of the position report
+	 *
+	 * @return False if the position was ignored or the store is full.
+	 */
+	bool append(uint mmsi, float longitude, float latitude,
+			float speedOverGround, float courseOverGround, int64_t timestamp);
+
+	/**
+	 * @brief Appends a Class A position report
+	 *
+	 * @param [in] data Decoded position report
+	 * @param [in] timestamp Time of the position report
+	 *
+	 * @return False if the position was ignored or the store is full.
+	 */
+	bool append(const AISPositionReportClassA& data, int64_t timestamp);
+
+	/**
+	 * @brief Appends a Class B position report
+	 *
+	 * @param [in] data Decoded position report
+	 * @param [in] timestamp Time of the position report
+	 *
+	 * @return False if the position was ignored or the store is full.
+	 */
+	bool append(const AISStandardClassBCSPositionReport& data,
+			int64_t timestamp);
+
+	/**
+	 * @brief Appends an extended Class B position report
+	 *
+	 * @param [in] data Decoded position report
+	 * @param [in] timestamp Time of the position report
+	 *
+	 * @return False if the position was ignored or the store is full.
+	 */
+	bool append(const AISExtendedClassBCSPositionReport& data,
+			int64_t timestamp);
+
+	/**
+	 * @brief Number of points of a vessel
+	 *
+	 * @param [in] mmsi MMSI
+	 *
+	 * @return Points, 0 if the vessel is unknown.
+	 */
+	std::size_t trackSize(uint mmsi) const;
+
+	/**
+	 * @brief Track of a vessel, oldest point first
+	 *
+	 * @param [in] mmsi MMSI
+	 * @param [out] track Decoded points
+	 *
+	 * @return Number of points.
+	 */
+	std::size_t track(uint mmsi, std::vector<AISTrackPosition>& track) const;
+
+	/**
+	 * @brief Forgets a vessel
+	 *
+	 * @param [in] mmsi MMSI
+	 *
+	 * @return True if the vessel was known.
+	 */
+	bool erase(uint mmsi);
+
+	/**
+	 * @brief Number of vessels
+	 *
+	 * @return Size.
+	 */
+	uint size() const;
+
+	/**
+	 * @brief Maximum number of vessels
+	 *
+	 * @return Capacity.
+	 */
+	uint capacity() const;
+
+	/**
+	 * @brief Points kept per vessel
+	 *
+	 * @return Ring size.
+	 */
+	uint pointsPerTrack() const;
+
+	/**
+	 * @brief Memory used by the points and track headers
+	 *
+	 * @return Bytes.
+	 */
+	std::size_t memoryUsage() const;
+
+private:
+	/**
+	 * @brief Ring state of a vessel
+	 */
+	struct Track
+	{
+		int64_t baseTime; //!< Time deltas are relative to this
+		uint16_t first; //!< Ring index of the oldest point
+		uint16_t count; //!< Number of points
+		uint32_t reserved; //!< Padding
+	};
+
+	/**
+	 * @brief Moves the base time to the oldest point, dropping points too old
+	 *
+	 * @param [in] slot Track slot
+	 * @param [in] timestamp Time of the point being appended
+	 */
+	void rebase(uint slot, int64_t timestamp);
+
+	AISMmsiMap index; //!< MMSI to slot
+	uint ring; //!< Points per track
+	std::vector<Track> tracks; //!< Ring state per slot
+	std::vector<AISTrackPoint> points; //!< Slab, ring of slot s at s * ring
+};
+
+#endif /* AISTRACKHISTORY_H_ */
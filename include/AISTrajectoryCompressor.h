@@ -0,0 +1,177 @@
+/**
+ *	@file AISTrajectoryCompressor.h
+ *	@brief Header for AISTrajectoryCompressor class
+ *
+ *   Online dead reckoning simplification of AIS tracks.
+ */
+
+#ifndef AISTRAJECTORYCOMPRESSOR_H_
+#define AISTRAJECTORYCOMPRESSOR_H_
+
+#include <cstdint>
+#include <vector>
+#include <sys/types.h>
+#include "AISGeometry.h"
+#include "AISMmsiMap.h"
+#include "NmeaEnums.h"
+
+/**
+ * @brief Counters kept by AISTrajectoryCompressor.
+ */
+struct AISTrajectoryCompressorStatistics
+{
+	uint64_t points; //!< Positions checked
+	uint64_t kept; //!< Positions reported as significant
+	float maxError; //!< Largest dead reckoning error of a dropped position, in nautical miles
+
+	/**
+	 * @brief Ratio of checked over kept positions
+	 *
+	 * @return Compression ratio, 1 before the first position.
+	 */
+	double compressionRatio() const;
+};
+
+/**
+ * @brief Streaming trajectory compressor for AIS position reports.
+ *
+ * Meant to run after the position report decoders and before the archive.
+ * For every MMSI only the last kept position is remembered, with its speed
+ * and course. A new position is predicted from it by dead reckoning and is
+ * dropped when the prediction is within @c tolerance nautical miles; it is
+ * kept otherwise, and when @c maxInterval has passed since the last kept
+ * position. Replaying the kept positions by dead reckoning therefore
+ * reproduces every dropped position within the tolerance.
+ *
+ * Unlike Douglas-Peucker nothing is buffered: each position is decided when
+ * it arrives, with O(1) memory per vessel fixed at construction. Speeds of
+ * 102.3 knots and over or courses of 360 degrees and over, the AIS not
+ * available values, predict a vessel not moving. Timestamps are in
+ * milliseconds.
+ */
+class AISTrajectoryCompressor
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] capacity Maximum number of vessels
+	 * @param [in] tolerance Largest dead reckoning error of a dropped position, in nautical miles
+	 * @param [in] maxInterval Longest time between kept positions in milliseconds, 0 for no limit
+	 */
+	AISTrajectoryCompressor(uint capacity, float tolerance = 0.01f,
+			int64_t maxInterval = 0);
+
+	/**
+	 * @brief Decides whether a position is significant
+	 *
+	 * Positions not available (longitude 181 or latitude 91) are never
+	 * significant. The first position of a vessel always is. When the store
+	 * is full, positions of new vessels are significant but not tracked.
+	 *
+	 * @param [in] mmsi MMSI
+	 * @param [in] longitude Longitude
+	 * @param [in] latitude Latitude
+	 * @param [in] speedOverGround Speed Over Ground in knots
+	 * @param [in] courseOverGround Course Over Ground in degrees
+	 * @param [in] timestamp Time of the position report
+	 *
+	 * @return True if the position must be kept.
+	 */
+	bool update(uint mmsi, float longitude, float latitude,
+			float speedOverGround, float courseOverGround, int64_t timestamp);
+
+	/**
+	 * @brief Decides whether a Class A position report is significant
+	 *
+	 * @param [in] data Decoded position report
+	 * @param [in] timestamp Time of the position report
+	 *
+	 * @return True if the position must be kept.
+	 */
+	bool update(const AISPositionReportClassA& data, int64_t timestamp);
+
+	/**
+	 * @brief Decides whether a Class B position report is significant
+	 *
+	 * @param [in] data Decoded position report
+	 * @param [in] timestamp Time of the position report
+	 *
+	 * @return True if the position must be kept.
+	 */
+	bool update(const AISStandardClassBCSPositionReport& data,
+			int64_t timestamp);
+
+	/**
+	 * @brief Decides whether an extended Class B position report is significant
+	 *
+	 * @param [in] data Decoded position report
+	 * @param [in] timestamp Time of the position report
+	 *
+	 * @return True if the position must be kept.
+	 */
+	bool update(const AISExtendedClassBCSPositionReport& data,
+			int64_t timestamp);
+
+	/**
+	 * @brief Forgets a vessel, its next position will be kept
+	 *
+	 * @param [in] mmsi MMSI
+	 *
+	 * @return True if the vessel was known.
+	 */
+	bool erase(uint mmsi);
+
+	/**
+	 * @brief Number of vessels
+	 *
+	 * @return Size.
+	 */
+	uint size() const;
+
+	/**
+	 * @brief Statistics
+	 *
+	 * @return Statistics.
+	 */
+	const AISTrajectoryCompressorStatistics& statistics() const;
+
+	/**
+	 * @brief Sets every counter to zero
+	 */
+	void resetStatistics();
+
+private:
+	/**
+	 * @brief Last kept position of a vessel
+	 */
+	struct Anchor
+	{
+		int64_t timestamp; //!< Time
+		float longitude; //!< Longitude
+		float latitude; //!< Latitude
+		float velocityEast; //!< Velocity east in nautical miles per millisecond
+		float velocityNorth; //!< Velocity north in nautical miles per millisecond
+	};
+
+	/**
+	 * @brief Stores a kept position
+	 *
+	 * @param [out] anchor Vessel state
+	 * @param [in] longitude Longitude
+	 * @param [in] latitude Latitude
+	 * @param [in] speedOverGround Speed Over Ground in knots
+	 * @param [in] courseOverGround Course Over Ground in degrees
+	 * @param [in] timestamp Time of the position report
+	 */
+	static void keep(Anchor& anchor, float longitude, float latitude,
+			float speedOverGround, float courseOverGround, int64_t timestamp);
+
+	AISMmsiMap index; //!< MMSI to slot
+	std::vector<Anchor> anchors; //!< Last kept position per slot
+	float tolerance; //!< Largest error of a dropped position
+	int64_t maxInterval; //!< Longest time between kept positions, 0 for no limit
+	AISTrajectoryCompressorStatistics stats; //!< Counters
+};
+
+#endif /* AISTRAJECTORYCOMPRESSOR_H_ */
@@ -0,0 +1,329 @@
+/**
+ *	@file AISVesselTable.h
+ *	@brief Header for AISVesselTable class
+ *
+ *   Per-MMSI vessel state merged from decoded AIS messages.
+ */
+
+#ifndef AISVESSELTABLE_H_
+#define AISVESSELTABLE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "AISMmsiMap.h"
+#include "AISStringPool.h"
+#include "NmeaEnums.h"
+
+/**
+ * @brief Dynamic vessel data, updated by every position report.
+ *
+ * Kept small so that scans over positions touch as few cache lines as
+ * possible.
+ */
+struct AISVesselPosition
+{
+	uint mmsi; //!< 9 decimal digits ID
+	float longitude; //!< Longitude
+	float latitude; //!< Latitude
+	float speedOverGround; //!< Speed Over Ground
+	float courseOverGround; //!< Course Over Ground
+	float rateOfTurn; //!< Rate of Turn, Class A only
+	uint16_t trueHeading; //!< True Heading
+	uint8_t navigationStatus; //!< Nmea_NavigationStatus, Class A only
+	uint8_t messageType; //!< Nmea_AisMessageType of the last position report
+	bool valid; //!< True once a position report was merged
+	int64_t timestamp; //!< Time of the last position report
+};
+
+/**
+ * @brief Static and voyage vessel data, updated by types 5, 19 and 24,
+ * except text fields.
+ */
+struct AISVesselStaticBase
+{
+	uint mmsi; //!< 9 decimal digits ID
+	int imoNumber; //!< IMO Ship ID number
+	Nmea_ShipType shipType; //!< Ship Type
+	AISDimension dimension; //!< Ship Dimension
+	Nmea_EPFDFix epfd; //!< EPFD Fix
+	float draught; //!< Draught
+	int etaMonth; //!< ETA Month
+	int etaDay; //!< ETA Day
+	int etaHour; //!< ETA Hour
+	int etaMinute; //!< ETA Minute
+	bool valid; //!< True once a static report was merged
+	int64_t timestamp; //!< Time of the last static report
+};
+
+/**
+ * @brief Static and voyage vessel data with inline text.
+ *
+ * Text fields are stored inline so that updates do not allocate.
+ */
+struct AISVesselStatic: AISVesselStaticBase
+{
+	AISFixedString<7> callsign; //!< 7 characters Call Sign
+	AISFixedString<20> vesselName; //!< 20 characters Vessel Name
+	AISFixedString<20> destination; //!< 20 characters Destination
+	AISFixedString<3> vendorId; //!< 3 characters Vendor Id
+};
+
+/**
+ * @brief Static and voyage vessel data with text as AISStringPool handles.
+ *
+ * Used by AISVesselTable when it is given a string pool. Names and
+ * destinations shared by many vessels are stored once, in the pool.
+ */
+struct AISVesselStaticHandles: AISVesselStaticBase
+{
+	uint callsign; //!< Call Sign handle
+	uint vesselName; //!< Vessel Name handle
+	uint destination; //!< Destination handle
+	uint vendorId; //!< Vendor Id handle
+};
+
+/**
+ * @brief Vessel state table keyed by MMSI.
+ *
+ * Merges decoded AIS position reports (types 1, 2, 3, 18 and 19) and static
+ * reports (types 5, 19 and 24) into one record per vessel. Records live in
+ * two arrays indexed by the slot given by AISMmsiMap: position data, read
+ * and written on every report, and static data, written a few times per
+ * hour. Capacity is fixed at construction and updates never allocate.
+ *
+ * Timestamps are supplied by the caller, usually the reception time in
+ * milliseconds, and are only compared with each other; any value, zero or
+ * negative included, is a valid time. Class A only fields go back to not
+ * available when a Class B report follows a Class A one.
+ *
+ * Given an AISStringPool, the table keeps AISVesselStaticHandles records
+ * instead of AISVesselStatic ones and interns text fields into the pool;
+ * findStaticHandles() and staticHandles() replace findStatic() and
+ * statics(). The pool must outlive the table, and updates that find it
+ * full merge the other fields and store AISStringPool::NPOS.
+ */
+class AISVesselTable
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] capacity Maximum number of vessels
+	 * @param [in] pool String pool for text fields, nullptr to store them inline
+	 */
+	explicit AISVesselTable(uint capacity, AISStringPool* pool = nullptr);
+
+	/**
+	 * @brief Merges a Position Report Class A - Types 1, 2 and 3
+	 *
+	 * @param [in] data Decoded message
+	 * @param [in] messageType Message type 1, 2 or 3
+	 * @param [in] timestamp Reception time
+	 *
+	 * @return False if the table is full.
+	 */
+	bool update(const AISPositionReportClassA& data,
+			Nmea_AisMessageType messageType, int64_t timestamp);
+
+	/**
+	 * @brief Merges a Standard Class B CS Position Report - Type 18
+	 *
+	 * @param [in] data Decoded message
+	 * @param [in] timestamp Reception time
+	 *
+	 * @return False if the table is full.
+	 */
+	bool update(const AISStandardClassBCSPositionReport& data,
+			int64_t timestamp);
+
+	/**
+	 * @brief Merges an Extended Class B CS Position Report - Type 19
+	 *
+	 * Updates both position and static data.
+	 *
+	 * @param [in] data Decoded message
+	 * @param [in] timestamp Reception time
+	 *
+	 * @return False if the table or the string pool is full.
+	 */
+	bool update(const AISExtendedClassBCSPositionReport& data,
+			int64_t timestamp);
+
+	/**
+	 * @brief Merges Static And Voyage Related Data - Type 5
+	 *
+	 * @param [in] data Decoded message
+	 * @param [in] timestamp Reception time
+	 *
+	 * @return False if the table or the string pool is full.
+	 */
+	bool update(const AISStaticAndVoyageRelatedData& data, int64_t timestamp);
+
+	/**
+	 * @brief Merges a Static Data Report - Type 24, part A or part B
+	 *
+	 * @param [in] data Decoded message
+	 * @param [in] timestamp Reception time
+	 *
+	 * @return False if the table or the string pool is full or the part
+	 * number is invalid.
+	 */
+	bool update(const AISStaticDataReport& data, int64_t timestamp);
+
+	/**
+	 * @brief Decodes an AIS payload and merges it
+	 *
+	 * @param [in] encodedData AIS Binary Encoded Data
+	 * @param [in] timestamp Reception time
+	 *
+	 * @return False if the message type is not merged by the table, the
+	 * payload cannot be decoded or the table is full.
+	 */
+	bool update(const std::string& encodedData, int64_t timestamp);
+
+	/**
+	 * @brief Position data of a vessel
+	 *
+	 * @param [in] mmsi MMSI
+	 *
+	 * @return Record, nullptr if the vessel is unknown or has no position.
+	 */
+	const AISVesselPosition* findPosition(uint mmsi) const;
+
+	/**
+	 * @brief Static data of a vessel
+	 *
+	 * @param [in] mmsi MMSI
+	 *
+	 * @return Record, nullptr if the vessel is unknown, has no static data or
+	 * the table has a string pool.
+	 */
+	const AISVesselStatic* findStatic(uint mmsi) const;
+
+	/**
+	 * @brief Static data of a vessel, text as string pool handles
+	 *
+	 * @param [in] mmsi MMSI
+	 *
+	 * @return Record, nullptr if the vessel is unknown, has no static data or
+	 * the table has no string pool.
+	 */
+	const AISVesselStaticHandles* findStaticHandles(uint mmsi) const;
+
+	/**
+	 * @brief Removes a vessel
+	 *
+	 * @param [in] mmsi MMSI
+	 *
+	 * @return True if the vessel was in the table.
+	 */
+	bool erase(uint mmsi);
+
+	/**
+	 * @brief Removes vessels without reports since a given time
+	 *
+	 * @param [in] timestamp Vessels last updated before this time are removed
+	 *
+	 * @return Number of vessels removed.
+	 */
+	uint expire(int64_t timestamp);
+
+	/**
+	 * @brief Number of vessels
+	 *
+	 * @return Size.
+	 */
+	uint size() const;
+
+	/**
+	 * @brief Maximum number of vessels
+	 *
+	 * @return Capacity.
+	 */
+	uint capacity() const;
+
+	/**
+	 * @brief Position records indexed by slot, for sequential scans
+	 *
+	 * Free slots have mmsi set to AISMmsiMap::NPOS.
+	 *
+	 * @return First record, capacity() records.
+	 */
+	const AISVesselPosition* positions() const;
+
+	/**
+	 * @brief Static records indexed by slot, for sequential scans
+	 *
+	 * Free slots have mmsi set to AISMmsiMap::NPOS.
+	 *
+	 * @return First record, capacity() records, nullptr if the table has a
+	 * string pool.
+	 */
+	const AISVesselStatic* statics() const;
+
+	/**
+	 * @brief Static records with text handles indexed by slot, for
+	 * sequential scans
+	 *
+	 * Free slots have mmsi set to AISMmsiMap::NPOS.
+	 *
+	 * @return First record, capacity() records, nullptr if the table has no
+	 * string pool.
+	 */
+	const AISVesselStaticHandles* staticHandles() const;
+
+private:
+	/**
+	 * @brief Finds or creates the slot of a vessel
+	 *
+	 * @param [in] mmsi MMSI
+	 *
+	 * @return Slot index, AISMmsiMap::NPOS if the table is full.
+	 */
+	uint acquire(uint mmsi);
+
+	/**
+	 * @brief Clears the records of a slot
+	 *
+	 * @param [in] slot Slot index
+	 * @param [in] mmsi MMSI written in the records
+	 */
+	void reset(uint slot, uint mmsi);
+
+	/**
+	 * @brief Static record of a slot, without text
+	 *
+	 * @param [in] slot Slot index
+	 *
+	 * @return Record in cold or coldHandles.
+	 */
+	AISVesselStaticBase& staticRecord(uint slot);
+
+	/**
+	 * @brief Const static record of a slot, without text
+	 *
+	 * @param [in] slot Slot index
+	 *
+	 * @return Record in cold or coldHandles.
+	 */
+	const AISVesselStaticBase& staticRecord(uint slot) const;
+
+	/**
+	 * @brief Interns a text field into the string pool
+	 *
+	 * @param [in] text Text
+	 * @param [in,out] interned Set to false if the pool is full
+	 *
+	 * @return Handle, AISStringPool::NPOS if the pool is full.
+	 */
+	uint intern(boost::string_ref text, bool& interned);
+
+	AISMmsiMap index; //!< MMSI to slot
+	AISStringPool* pool; //!< Pool of text fields, nullptr if stored inline
+	std::vector<AISVesselPosition> hot; //!< Position records
+	std::vector<AISVesselStatic> cold; //!< Static records, inline text
+	std::vector<AISVesselStaticHandles> coldHandles; //!< Static records, pooled text
+};
+
+#endif /* AISVESSELTABLE_H_ */
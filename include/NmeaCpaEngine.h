@@ -0,0 +1,203 @@
+/**
+ *	@file NmeaCpaEngine.h
+ *	@brief Header for NmeaCpaEngine class
+ *
+ *   NmeaCpaEngine class computes CPA and TCPA of many targets in one batch.
+ */
+
+#ifndef NMEACPAENGINE_H_
+#define NMEACPAENGINE_H_
+
+#include <cstddef>
+#include <vector>
+#include "NmeaEnums.h"
+
+/**
+ * @brief Closest Point of Approach engine over AIS, TTM and TTD targets.
+ *
+ * Targets are stored as structure of arrays: position relative to own ship
+ * in nautical miles (east, north) and true velocity in knots (east, north).
+ * compute() evaluates every target against own ship in one pass, eight
+ * targets per instruction with AVX2 when the CPU supports it, and falls
+ * back to scalar code otherwise. Both paths produce the same results.
+ *
+ * A processing cycle is: setOwnShip(), clear(), addTarget() for every
+ * target, compute(). Positions and relative motion are resolved against the
+ * own ship given when the target is added.
+ *
+ * CPA is in nautical miles and TCPA in minutes. A negative TCPA means the
+ * closest point is already past. Targets with no relative motion have a
+ * TCPA of 0 and a CPA equal to their current range.
+ *
+ * Targets added by position are checked against the AIS not available
+ * values. A target without a position is not added. A target whose speed
+ * or course is not available has unknown motion, its CPA and TCPA are NaN.
+ */
+class NmeaCpaEngine
+{
+public:
+	/**
+	 * @brief Value returned when a target is not added
+	 */
+	static const std::size_t NPOS = static_cast<std::size_t>(-1);
+
+	/**
+	 * @brief Constructor, own ship stopped at 0, 0
+	 */
+	NmeaCpaEngine();
+
+	/**
+	 * @brief Sets own ship position and motion
+	 *
+	 * @param [in] longitude Longitude
+	 * @param [in] latitude Latitude
+	 * @param [in] speedOverGround Speed Over Ground in knots
+	 * @param [in] courseOverGround Course Over Ground in degrees
+	 * @param [in] heading Heading in degrees, reference of relative bearings
+	 */
+	void setOwnShip(float longitude, float latitude, float speedOverGround,
+			float courseOverGround, float heading);
+
+	/**
+	 * @brief Removes every target
+	 */
+	void clear();
+
+	/**
+	 * @brief Adds a target by position and true motion
+	 *
+	 * @param [in] longitude Longitude
+	 * @param [in] latitude Latitude
+	 * @param [in] speedOverGround Speed Over Ground in knots
+	 * @param [in] courseOverGround Course Over Ground in degrees
+	 *
+	 * @return Target index, NPOS if the position is not available.
+	 */
+	std::size_t addTarget(float longitude, float latitude,
+			float speedOverGround, float courseOverGround);
+
+	/**
+	 * @brief Adds an AIS Class A target
+	 *
+	 * @param [in] data Decoded position report
+	 *
+	 * @return Target index, NPOS if the position is not available.
+	 */
+	std::size_t addTarget(const AISPositionReportClassA& data);
+
+	/**
+	 * @brief Adds an AIS Class B target
+	 *
+	 * @param [in] data Decoded position report
+	 *
+	 * @return Target index, NPOS if the position is not available.
+	 */
+	std::size_t addTarget(const AISStandardClassBCSPositionReport& data);
+
+	/**
+	 * @brief Adds an AIS extended Class B target
+	 *
+	 * @param [in] data Decoded position report
+	 *
+	 * @return Target index, NPOS if the position is not available.
+	 */
+	std::size_t addTarget(const AISExtendedClassBCSPositionReport& data);
+
+	/**
+	 * @brief Adds a radar target from TTD track data
+	 *
+	 * @param [in] track Decoded track
+	 *
+	 * @return Target index.
+	 */
+	std::size_t addTarget(const NmeaTrackData& track);
+
+	/**
+	 * @brief Adds a radar target from TTM fields, as output by NmeaParser::parseTTM()
+	 *
+	 * @param [in] targetDistance Target distance
+	 * @param [in] targetBearing Target bearing in degrees
+	 * @param [in] targetBearingReference True, or Relative to own heading
+	 * @param [in] targetSpeed Target speed
+	 * @param [in] targetCourse Target course in degrees
+	 * @param [in] targetCourseReference True motion, or Relative motion
+	 * @param [in] speedDistanceUnits Units of distance and speed
+	 *
+	 * @return Target index.
+	 */
+	std::size_t addTarget(double targetDistance, double targetBearing,
+			Nmea_AngleReference targetBearingReference, double targetSpeed,
+			double targetCourse, Nmea_AngleReference targetCourseReference,
+			Nmea_SpeedDistanceUnits speedDistanceUnits);
+
+	/**
+	 * @brief Computes CPA and TCPA of every target
+	 *
+	 * @param [in] vectorized Use AVX2 when supported, false forces scalar code
+	 */
+	void compute(bool vectorized = true);
+
+	/**
+	 * @brief Number of targets
+	 *
+	 * @return Size.
+	 */
+	std::size_t size() const;
+
+	/**
+	 * @brief CPA of every target, valid after compute()
+	 *
+	 * @return size() distances in nautical miles.
+	 */
+	const float* cpa() const;
+
+	/**
+	 * @brief TCPA of every target, valid after compute()
+	 *
+	 * @return size() times in minutes.
+	 */
+	const float* tcpa() const;
+
+	/**
+	 * @brief Whether compute() can use AVX2 on this CPU
+	 *
+	 * @return True if supported.
+	 */
+	static bool avx2Supported();
+
+private:
+	/**
+	 * @brief Private Implementation
+	 */
+	class impl;
+
+	/**
+	 * @brief Adds a target from its relative position and true velocity
+	 *
+	 * @param [in] east Position east of own ship in nautical miles
+	 * @param [in] north Position north of own ship in nautical miles
+	 * @param [in] velocityEast True velocity east in knots
+	 * @param [in] velocityNorth True velocity north in knots
+	 *
+	 * @return Target index.
+	 */
+	std::size_t push(float east, float north, float velocityEast,
+			float velocityNorth);
+
+	float ownLongitude; //!< Own ship longitude
+	float ownLatitude; //!< Own ship latitude
+	float ownHeading; //!< Own ship heading
+	float ownVelocityEast; //!< Own ship velocity east in knots
+	float ownVelocityNorth; //!< Own ship velocity north in knots
+
+	std::size_t count; //!< Number of targets
+	std::vector<float> east; //!< Position east of own ship
+	std::vector<float> north; //!< Position north of own ship
+	std::vector<float> velocityEast; //!< True velocity east
+	std::vector<float> velocityNorth; //!< True velocity north
+	std::vector<float> cpaValues; //!< Computed CPA
+	std::vector<float> tcpaValues; //!< Computed TCPA
+	std::vector<std::size_t> unknownMotion; //!< Targets with no speed or course
+};
+
+#endif /* NMEACPAENGINE_H_ */
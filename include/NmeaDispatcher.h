@@ -0,0 +1,908 @@
+/**
+ *	@file NmeaDispatcher.h
+ *	@brief Header for NmeaDispatcher class template
+ *
+ *   NmeaDispatcher parses sentences and hands the results to handler methods
+ *   resolved at compile time.
+ */
+
+#ifndef NMEADISPATCHER_H_
+#define NMEADISPATCHER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include "NmeaParser.h"
+#include "AISMessageView.h"
+
+/**
+ * @brief ZDA fields, see NmeaParser::parseZDA()
+ */
+struct NmeaZDAView
+{
+	boost::posix_time::time_duration mtime; //!< UTC time
+	int day; //!< UTC Day
+	int month; //!< UTC Month
+	int year; //!< UTC Year
+	int localZoneHours; //!< Local time zone Hours
+	int localZoneMinutes; //!< Local time zone Minutes
+	NmeaParserResult result; //!< Validity of each field, as returned by the parser
+};
+
+/**
+ * @brief GLL fields, see NmeaParser::parseGLL()
+ */
+struct NmeaGLLView
+{
+	double latitude; //!< Latitude
+	double longitude; //!< Longitude
+	boost::posix_time::time_duration mtime; //!< UTC time
+	char status; //!< Status A: Valid V: Invalid
+	char modeIndicator; //!< Mode Indicator
+	NmeaParserResult result; //!< Validity of each field, as returned by the parser
+};
+
+/**
+ * @brief GGA fields, see NmeaParser::parseGGA()
+ */
+struct NmeaGGAView
+{
+	boost::posix_time::time_duration mtime; //!< UTC time
+	double latitude; //!< Latitude
+	double longitude; //!< Longitude
+	Nmea_GPSQualityIndicator quality; //!< Quality Indicator
+	int numSV; //!< SVs in use
+	double hdop; //!< HDOP
+	double orthometricheight; //!< Orthometric height (MSL reference)
+	double geoidseparation; //!< Geoid separation measured in meters
+	double agediffgps; //!< Age of differential GPS data record
+	std::string refid; //!< Reference station ID
+	NmeaParserResult result; //!< Validity of each field, as returned by the parser
+};
+
+/**
+ * @brief VTG fields, see NmeaParser::parseVTG()
+ */
+struct NmeaVTGView
+{
+	double coursetrue; //!< Course Over Ground
+	double coursemagnetic; //!< Course Over Ground (relative magnetic north)
+	double speedknots; //!< Speed in knots
+	double speedkph; //!< Speed in Kph
+	NmeaParserResult result; //!< Validity of each field, as returned by the parser
+};
+
+/**
+ * @brief RMC fields, see NmeaParser::parseRMC()
+ */
+struct NmeaRMCView
+{
+	boost::posix_time::time_duration mtime; //!< UTC time
+	double latitude; //!< Latitude
+	double longitude; //!< Longitude
+	double speedknots; //!< Speed in knots
+	double coursetrue; //!< Course Over Ground
+	boost::gregorian::date mdate; //!< UTC Date
+	double magneticvar; //!< Magnetic variation
+	NmeaParserResult result; //!< Validity of each field, as returned by the parser
+};
+
+/**
+ * @brief HDT fields, see NmeaParser::parseHDT()
+ */
+struct NmeaHDTView
+{
+	double headingDegreesTrue; //!< Heading in degrees True
+	NmeaParserResult result; //!< Validity of each field, as returned by the parser
+};
+
+/**
+ * @brief HDG fields, see NmeaParser::parseHDG()
+ */
+struct NmeaHDGView
+{
+	double magneticSensorHeadingInDegrees; //!< Magnetic sensor heading
+	double magneticDeviationDegrees; //!< Magnetic deviation
+	char magneticDeviationDirection; //!< Magnetic deviation direction E or W
+	double magneticVariationDegrees; //!< Magnetic variation
+	char magneticVariationDirection; //!< Magnetic variation direction E or W
+	NmeaParserResult result; //!< Validity of each field, as returned by the parser
+};
+
+/**
+ * @brief ROT fields, see NmeaParser::parseROT()
+ */
+struct NmeaROTView
+{
+	double rateOfTurn; //!< Rate of turn
+	NmeaParserResult result; //!< Validity of each field, as returned by the parser
+};
+
+/**
+ * @brief MWV fields, see NmeaParser::parseMWV()
+ */
+struct NmeaMWVView
+{
+	double windAngle; //!< Wind angle
+	Nmea_AngleReference reference; //!< Wind angle reference
+	double windSpeed; //!< Wind speed
+	char windSpeedUnits; //!< Wind speed units
+	char sensorStatus; //!< Sensor status
+	NmeaParserResult result; //!< Validity of each field, as returned by the parser
+};
+
+/**
+ * @brief DPT fields, see NmeaParser::parseDPT()
+ */
+struct NmeaDPTView
+{
+	double waterDepthRelativeToTheTransducer; //!< Water depth relative to the transducer
+	double offsetFromTransducer; //!< Offset from transducer
+	double maximumRangeScaleInUse; //!< Maximum range scale in use
+	NmeaParserResult result; //!< Validity of each field, as returned by the parser
+};
+
+/**
+ * @brief VHW fields, see NmeaParser::parseVHW()
+ */
+struct NmeaVHWView
+{
+	double headingTrue; //!< Heading True
+	double headingMagnetic; //!< Heading Magnetic
+	double speedInKnots; //!< Speed through water in knots
+	double speedInKmH; //!< Speed through water in Km/h
+	NmeaParserResult result; //!< Validity of each field, as returned by the parser
+};
+
+/**
+ * @brief TTM fields, see NmeaParser::parseTTM()
+ */
+struct NmeaTTMView
+{
+	int targetNumber; //!< Target number
+	double targetDistance; //!< Target distance
+	double targetBearing; //!< Target bearing
+	Nmea_AngleReference targetBearingReference; //!< Target bearing reference
+	double targetSpeed; //!< Target speed
+	double targetCourse; //!< Target course
+	Nmea_AngleReference targetCourseReference; //!< Target course reference
+	Nmea_SpeedDistanceUnits speedDistanceUnits; //!< Speed and distance units
+	std::string targetName; //!< Target name
+	Nmea_TargetStatus targetStatus; //!< Target status
+	boost::posix_time::time_duration timeOfData; //!< UTC time of data
+	Nmea_TypeOfAcquisition typeOfAcquisition; //!< Type of acquisition
+	NmeaParserResult result; //!< Validity of each field, as returned by the parser
+};
+
+/**
+ * @brief Non template part of NmeaDispatcher: sentence identification and AIS fragment assembly.
+ */
+class NmeaDispatcherBase: private boost::noncopyable
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	NmeaDispatcherBase();
+
+	/**
+	 * @brief Sentences given to dispatch()
+	 *
+	 * @return Sentence count.
+	 */
+	uint64_t sentences() const;
+
+	/**
+	 * @brief Sentences parsed because the handler takes their results
+	 *
+	 * @return Parsed sentence count, the rest were skipped without parsing.
+	 */
+	uint64_t parsed() const;
+
+	/**
+	 * @brief Whether the AIS message being handled came in a VDO sentence
+	 *
+	 * @return True for own vessel reports, false for VDM.
+	 */
+	bool ownVessel() const;
+
+	/**
+	 * @brief Drops the AIS fragments waiting for the rest of their message
+	 */
+	void reset();
+
+protected:
+	/**
+	 * @brief Sentences with a handler
+	 */
+	enum Sentence
+	{
+		Sentence_Other, //!< Any other sentence, handled by onOther()
+		Sentence_ZDA, //!< ZDA
+		Sentence_GLL, //!< GLL
+		Sentence_GGA, //!< GGA
+		Sentence_VTG, //!< VTG
+		Sentence_RMC, //!< RMC
+		Sentence_HDT, //!< HDT
+		Sentence_HDG, //!< HDG
+		Sentence_ROT, //!< ROT
+		Sentence_MWV, //!< MWV
+		Sentence_DPT, //!< DPT
+		Sentence_VHW, //!< VHW
+		Sentence_TTM, //!< TTM
+		Sentence_TTD, //!< TTD
+		Sentence_VDM, //!< VDM
+		Sentence_VDO //!< VDO
+	};
+
+	/**
+	 * @brief Identifies a sentence from its 3 letter id
+	 *
+	 * @param [in] nmea String with NMEA Sentence, optionally after a TAG block
+	 * @param [out] start Offset of the sentence past the TAG block
+	 *
+	 * @return Sentence, Sentence_Other if it is not one with a handler.
+	 */
+	static Sentence identify(const std::string& nmea, std::size_t& start);
+
+	/**
+	 * @brief Sentence without its TAG block, as the parsers expect it
+	 *
+	 * @param [in] nmea String with NMEA Sentence
+	 * @param [in] start Offset returned by identify()
+	 * @param [out] buffer Storage used when there is a TAG block
+	 *
+	 * @return nmea or buffer.
+	 */
+	static const std::string& body(const std::string& nmea, std::size_t start,
+			std::string& buffer);
+
+	/**
+	 * @brief Whether a handler method is declared by the handler class
+	 *
+	 * Called with the method named through the handler class and the
+	 * default method, only their types are compared.
+	 *
+	 * @return True if the handler class declares its own method.
+	 */
+	template<typename T, typename U>
+	static constexpr bool overridden(T, U)
+	{
+		return !std::is_same<T, U>::value;
+	}
+
+	/**
+	 * @brief Adds a VDM or VDO sentence to its message
+	 *
+	 * @param [in] sentence VDM or VDO sentence without TAG block
+	 * @param [in] own True for VDO
+	 * @param [out] encodedData Payload of the whole message
+	 *
+	 * @return True once the message is complete.
+	 */
+	bool assemble(const std::string& sentence, bool own,
+			std::string& encodedData);
+
+	uint64_t lines; //!< Sentences given to dispatch()
+	uint64_t parsedLines; //!< Sentences parsed
+
+private:
+	/**
+	 * @brief Private Implementation
+	 */
+	class impl;
+
+	/**
+	 * @brief Message waiting for its next fragment
+	 */
+	struct Fragments
+	{
+		int totalLines; //!< Lines of the message
+		int nextLine; //!< Line expected next
+		std::string encodedData; //!< Payload so far
+	};
+
+	std::map<uint, Fragments> pending; //!< Key from sequence id, channel and VDM or VDO
+	bool own; //!< Last AIS message came in a VDO sentence
+};
+
+/**
+ * @brief Sentence dispatcher calling handler methods resolved at compile time.
+ *
+ * The handler class derives from NmeaDispatcher<Handler> and declares the
+ * handler methods it wants, with the same signature as the defaults below:
+ *
+ * @code
+ * class Plotter: public NmeaDispatcher<Plotter>
+ * {
+ * public:
+ *     void onGGA(const NmeaGGAView& view);
+ *     void onAISPositionReportClassA(const AISPositionReportClassA& data);
+ * };
+ * @endcode
+ *
+ * dispatch() calls the handler methods directly, so the compiler can inline
+ * them into it. Sentences and AIS messages the handler class has no method
+ * for are not parsed at all: they cost the 3 letter sentence id compare, and
+ * for AIS the fragment assembly and the 6 message type bits. The results are
+ * handed by const reference from dispatch() locals, handlers copy only what
+ * they keep.
+ *
+ * Handler methods must be public. A handler class can hold any state and is
+ * noncopyable.
+ */
+template<typename Handler>
+class NmeaDispatcher: public NmeaDispatcherBase
+{
+public:
+	/**
+	 * @brief Parses a sentence and calls its handler method
+	 *
+	 * @param [in] nmea String with NMEA Sentence, optionally after a TAG block
+	 *
+	 * @return True if a handler method was called.
+	 */
+	bool dispatch(const std::string& nmea);
+
+	/**
+	 * @brief ZDA handler, the default does nothing
+	 */
+	void onZDA(const NmeaZDAView&)
+	{
+	}
+
+	/**
+	 * @brief GLL handler, the default does nothing
+	 */
+	void onGLL(const NmeaGLLView&)
+	{
+	}
+
+	/**
+	 * @brief GGA handler, the default does nothing
+	 */
+	void onGGA(const NmeaGGAView&)
+	{
+	}
+
+	/**
+	 * @brief VTG handler, the default does nothing
+	 */
+	void onVTG(const NmeaVTGView&)
+	{
+	}
+
+	/**
+	 * @brief RMC handler, the default does nothing
+	 */
+	void onRMC(const NmeaRMCView&)
+	{
+	}
+
+	/**
+	 * @brief HDT handler, the default does nothing
+	 */
+	void onHDT(const NmeaHDTView&)
+	{
+	}
+
+	/**
+	 * @brief HDG handler, the default does nothing
+	 */
+	void onHDG(const NmeaHDGView&)
+	{
+	}
+
+	/**
+	 * @brief ROT handler, the default does nothing
+	 */
+	void onROT(const NmeaROTView&)
+	{
+	}
+
+	/**
+	 * @brief MWV handler, the default does nothing
+	 */
+	void onMWV(const NmeaMWVView&)
+	{
+	}
+
+	/**
+	 * @brief DPT handler, the default does nothing
+	 */
+	void onDPT(const NmeaDPTView&)
+	{
+	}
+
+	/**
+	 * @brief VHW handler, the default does nothing
+	 */
+	void onVHW(const NmeaVHWView&)
+	{
+	}
+
+	/**
+	 * @brief TTM handler, the default does nothing
+	 */
+	void onTTM(const NmeaTTMView&)
+	{
+	}
+
+	/**
+	 * @brief TTD handler, called once per track, the default does nothing
+	 */
+	void onTrack(const NmeaTrackData&)
+	{
+	}
+
+	/**
+	 * @brief Handler of every complete AIS message, before the typed handler
+	 *
+	 * The view decodes nothing up front, see AISMessageView.
+	 */
+	void onAISMessage(const AISMessageView&)
+	{
+	}
+
+	/**
+	 * @brief AIS types 1, 2 and 3 handler, the default does nothing
+	 */
+	void onAISPositionReportClassA(const AISPositionReportClassA&)
+	{
+	}
+
+	/**
+	 * @brief AIS type 4 handler, the default does nothing
+	 */
+	void onAISBaseStationReport(const AISBaseStationReport&)
+	{
+	}
+
+	/**
+	 * @brief AIS type 5 handler, the default does nothing
+	 */
+	void onAISStaticAndVoyageRelatedData(const AISStaticAndVoyageRelatedData&)
+	{
+	}
+
+	/**
+	 * @brief AIS type 18 handler, the default does nothing
+	 */
+	void onAISStandardClassBCSPositionReport(
+			const AISStandardClassBCSPositionReport&)
+	{
+	}
+
+	/**
+	 * @brief AIS type 19 handler, the default does nothing
+	 */
+	void onAISExtendedClassBCSPositionReport(
+			const AISExtendedClassBCSPositionReport&)
+	{
+	}
+
+	/**
+	 * @brief AIS type 21 handler, the default does nothing
+	 */
+	void onAISAidToNavigationReport(const AISAidToNavigationReport&)
+	{
+	}
+
+	/**
+	 * @brief AIS type 24 handler, the default does nothing
+	 */
+	void onAISStaticDataReport(const AISStaticDataReport&)
+	{
+	}
+
+	/**
+	 * @brief Handler of sentences without a handler of their own, the default does nothing
+	 */
+	void onOther(const std::string&)
+	{
+	}
+
+private:
+	/**
+	 * @brief Handler object
+	 *
+	 * @return This, as the handler class.
+	 */
+	Handler& handler()
+	{
+		return static_cast<Handler&>(*this);
+	}
+
+	/**
+	 * @brief Whether the handler class takes any AIS message
+	 *
+	 * @return True if one of the AIS handler methods is declared.
+	 */
+	static constexpr bool handlesAIS()
+	{
+		return overridden(&Handler::onAISMessage, &NmeaDispatcher::onAISMessage)
+				|| overridden(&Handler::onAISPositionReportClassA,
+						&NmeaDispatcher::onAISPositionReportClassA)
+				|| overridden(&Handler::onAISBaseStationReport,
+						&NmeaDispatcher::onAISBaseStationReport)
+				|| overridden(&Handler::onAISStaticAndVoyageRelatedData,
+						&NmeaDispatcher::onAISStaticAndVoyageRelatedData)
+				|| overridden(&Handler::onAISStandardClassBCSPositionReport,
+						&NmeaDispatcher::onAISStandardClassBCSPositionReport)
+				|| overridden(&Handler::onAISExtendedClassBCSPositionReport,
+						&NmeaDispatcher::onAISExtendedClassBCSPositionReport)
+				|| overridden(&Handler::onAISAidToNavigationReport,
+						&NmeaDispatcher::onAISAidToNavigationReport)
+				|| overridden(&Handler::onAISStaticDataReport,
+						&NmeaDispatcher::onAISStaticDataReport);
+	}
+
+	/**
+	 * @brief Decodes a complete AIS message and calls its handler methods
+	 *
+	 * @param [in] encodedData AIS Binary Encoded Data
+	 *
+	 * @return True if a handler method was called.
+	 */
+	bool dispatchAIS(const std::string& encodedData);
+};
+
+template<typename Handler>
+bool NmeaDispatcher<Handler>::dispatch(const std::string& nmea)
+{
+	++lines;
+	std::size_t start;
+	std::string buffer;
+	const Sentence sentence = identify(nmea, start);
+
+	switch (sentence)
+	{
+	case Sentence_ZDA:
+		if (overridden(&Handler::onZDA, &NmeaDispatcher::onZDA))
+		{
+			++parsedLines;
+			NmeaZDAView view = NmeaZDAView();
+			view.result = NmeaParser::parseZDA(body(nmea, start, buffer),
+					view.mtime, view.day, view.month, view.year,
+					view.localZoneHours, view.localZoneMinutes);
+			if (!view.result.all())
+			{
+				handler().onZDA(view);
+				return true;
+			}
+		}
+		return false;
+	case Sentence_GLL:
+		if (overridden(&Handler::onGLL, &NmeaDispatcher::onGLL))
+		{
+			++parsedLines;
+			NmeaGLLView view = NmeaGLLView();
+			view.result = NmeaParser::parseGLL(body(nmea, start, buffer),
+					view.latitude, view.longitude, view.mtime, view.status,
+					view.modeIndicator);
+			if (!view.result.all())
+			{
+				handler().onGLL(view);
+				return true;
+			}
+		}
+		return false;
+	case Sentence_GGA:
+		if (overridden(&Handler::onGGA, &NmeaDispatcher::onGGA))
+		{
+			++parsedLines;
+			NmeaGGAView view = NmeaGGAView();
+			view.result = NmeaParser::parseGGA(body(nmea, start, buffer),
+					view.mtime, view.latitude, view.longitude, view.quality,
+					view.numSV, view.hdop, view.orthometricheight,
+					view.geoidseparation, view.agediffgps, view.refid);
+			if (!view.result.all())
+			{
+				handler().onGGA(view);
+				return true;
+			}
+		}
+		return false;
+	case Sentence_VTG:
+		if (overridden(&Handler::onVTG, &NmeaDispatcher::onVTG))
+		{
+			++parsedLines;
+			NmeaVTGView view = NmeaVTGView();
+			view.result = NmeaParser::parseVTG(body(nmea, start, buffer),
+					view.coursetrue, view.coursemagnetic, view.speedknots,
+					view.speedkph);
+			if (!view.result.all())
+			{
+				handler().onVTG(view);
+				return true;
+			}
+		}
+		return false;
+	case Sentence_RMC:
+		if (overridden(&Handler::onRMC, &NmeaDispatcher::onRMC))
+		{
+			++parsedLines;
+			NmeaRMCView view = NmeaRMCView();
+			view.result = NmeaParser::parseRMC(body(nmea, start, buffer),
+					view.mtime, view.latitude, view.longitude, view.speedknots,
+					view.coursetrue, view.mdate, view.magneticvar);
+			if (!view.result.all())
+			{
+				handler().onRMC(view);
+				return true;
+			}
+		}
+		return false;
+	case Sentence_HDT:
+		if (overridden(&Handler::onHDT, &NmeaDispatcher::onHDT))
+		{
+			++parsedLines;
+			NmeaHDTView view = NmeaHDTView();
+			view.result = NmeaParser::parseHDT(body(nmea, start, buffer),
+					view.headingDegreesTrue);
+			if (!view.result.all())
+			{
+				handler().onHDT(view);
+				return true;
+			}
+		}
+		return false;
+	case Sentence_HDG:
+		if (overridden(&Handler::onHDG, &NmeaDispatcher::onHDG))
+		{
+			++parsedLines;
+			NmeaHDGView view = NmeaHDGView();
+			view.result = NmeaParser::parseHDG(body(nmea, start, buffer),
+					view.magneticSensorHeadingInDegrees,
+					view.magneticDeviationDegrees,
+					view.magneticDeviationDirection,
+					view.magneticVariationDegrees,
+					view.magneticVariationDirection);
+			if (!view.result.all())
+			{
+				handler().onHDG(view);
+				return true;
+			}
+		}
+		return false;
+	case Sentence_ROT:
+		if (overridden(&Handler::onROT, &NmeaDispatcher::onROT))
+		{
+			++parsedLines;
+			NmeaROTView view = NmeaROTView();
+			view.result = NmeaParser::parseROT(body(nmea, start, buffer),
+					view.rateOfTurn);
+			if (!view.result.all())
+			{
+				handler().onROT(view);
+				return true;
+			}
+		}
+		return false;
+	case Sentence_MWV:
+		if (overridden(&Handler::onMWV, &NmeaDispatcher::onMWV))
+		{
+			++parsedLines;
+			NmeaMWVView view = NmeaMWVView();
+			view.result = NmeaParser::parseMWV(body(nmea, start, buffer),
+					view.windAngle, view.reference, view.windSpeed,
+					view.windSpeedUnits, view.sensorStatus);
+			if (!view.result.all())
+			{
+				handler().onMWV(view);
+				return true;
+			}
+		}
+		return false;
+	case Sentence_DPT:
+		if (overridden(&Handler::onDPT, &NmeaDispatcher::onDPT))
+		{
+			++parsedLines;
+			NmeaDPTView view = NmeaDPTView();
+			view.result = NmeaParser::parseDPT(body(nmea, start, buffer),
+					view.waterDepthRelativeToTheTransducer,
+					view.offsetFromTransducer, view.maximumRangeScaleInUse);
+			if (!view.result.all())
+			{
+				handler().onDPT(view);
+				return true;
+			}
+		}
+		return false;
+	case Sentence_VHW:
+		if (overridden(&Handler::onVHW, &NmeaDispatcher::onVHW))
+		{
+			++parsedLines;
+			NmeaVHWView view = NmeaVHWView();
+			view.result = NmeaParser::parseVHW(body(nmea, start, buffer),
+					view.headingTrue, view.headingMagnetic, view.speedInKnots,
+					view.speedInKmH);
+			if (!view.result.all())
+			{
+				handler().onVHW(view);
+				return true;
+			}
+		}
+		return false;
+	case Sentence_TTM:
+		if (overridden(&Handler::onTTM, &NmeaDispatcher::onTTM))
+		{
+			++parsedLines;
+			NmeaTTMView view = NmeaTTMView();
+			view.result = NmeaParser::parseTTM(body(nmea, start, buffer),
+					view.targetNumber, view.targetDistance, view.targetBearing,
+					view.targetBearingReference, view.targetSpeed,
+					view.targetCourse, view.targetCourseReference,
+					view.speedDistanceUnits, view.targetName,
+					view.targetStatus, view.timeOfData,
+					view.typeOfAcquisition);
+			if (!view.result.all())
+			{
+				handler().onTTM(view);
+				return true;
+			}
+		}
+		return false;
+	case Sentence_TTD:
+		if (overridden(&Handler::onTrack, &NmeaDispatcher::onTrack))
+		{
+			++parsedLines;
+			int totalLines;
+			int lineCount;
+			int sequenceIdentifier;
+			std::string trackData;
+			int fillBits;
+			std::vector<NmeaTrackData> tracks;
+			const NmeaParserResult result = NmeaParser::parseTTD(
+					body(nmea, start, buffer), totalLines, lineCount,
+					sequenceIdentifier, trackData, fillBits);
+			if (!result[3] && NmeaParser::parseTTDPayload(trackData, tracks)
+					&& !tracks.empty())
+			{
+				for (std::size_t i = 0; i < tracks.size(); ++i)
+				{
+					handler().onTrack(tracks[i]);
+				}
+				return true;
+			}
+		}
+		return false;
+	case Sentence_VDM:
+	case Sentence_VDO:
+		if (handlesAIS())
+		{
+			++parsedLines;
+			std::string encodedData;
+			return assemble(body(nmea, start, buffer),
+					sentence == Sentence_VDO, encodedData)
+					&& dispatchAIS(encodedData);
+		}
+		return false;
+	default:
+		if (overridden(&Handler::onOther, &NmeaDispatcher::onOther))
+		{
+			handler().onOther(nmea);
+			return true;
+		}
+		return false;
+	}
+}
+
+template<typename Handler>
+bool NmeaDispatcher<Handler>::dispatchAIS(const std::string& encodedData)
+{
+	bool handled = false;
+	if (overridden(&Handler::onAISMessage, &NmeaDispatcher::onAISMessage))
+	{
+		handler().onAISMessage(AISMessageView(encodedData));
+		handled = true;
+	}
+
+	Nmea_AisMessageType messageType;
+	if (!NmeaParser::parseAISMessageType(encodedData, messageType))
+	{
+		return handled;
+	}
+
+	switch (messageType)
+	{
+	case Nmea_AisMessageType_PositionReportClassA:
+	case Nmea_AisMessageType_PositionReportClassA_AssignedSchedule:
+	case Nmea_AisMessageType_PositionReportClassA_ResponseToInterrogation:
+		if (overridden(&Handler::onAISPositionReportClassA,
+				&NmeaDispatcher::onAISPositionReportClassA))
+		{
+			AISPositionReportClassA data;
+			if (NmeaParser::parseAISPositionReportClassA(encodedData, data))
+			{
+				handler().onAISPositionReportClassA(data);
+				handled = true;
+			}
+		}
+		break;
+	case Nmea_AisMessageType_BaseStationReport:
+		if (overridden(&Handler::onAISBaseStationReport,
+				&NmeaDispatcher::onAISBaseStationReport))
+		{
+			AISBaseStationReport data;
+			if (NmeaParser::parseAISBaseStationReport(encodedData, data))
+			{
+				handler().onAISBaseStationReport(data);
+				handled = true;
+			}
+		}
+		break;
+	case Nmea_AisMessageType_StaticAndVoyageRelatedData:
+		if (overridden(&Handler::onAISStaticAndVoyageRelatedData,
+				&NmeaDispatcher::onAISStaticAndVoyageRelatedData))
+		{
+			AISStaticAndVoyageRelatedData data;
+			if (NmeaParser::parseAISStaticAndVoyageRelatedData(encodedData,
+					data))
+			{
+				handler().onAISStaticAndVoyageRelatedData(data);
+				handled = true;
+			}
+		}
+		break;
+	case Nmea_AisMessageType_StandardClassBCSPositionReport:
+		if (overridden(&Handler::onAISStandardClassBCSPositionReport,
+				&NmeaDispatcher::onAISStandardClassBCSPositionReport))
+		{
+			AISStandardClassBCSPositionReport data;
+			if (NmeaParser::parseAISStandardClassBCSPositionReport(
+					encodedData, data))
+			{
+				handler().onAISStandardClassBCSPositionReport(data);
+				handled = true;
+			}
+		}
+		break;
+	case Nmea_AisMessageType_ExtendedClassBEquipmentPositionReport:
+		if (overridden(&Handler::onAISExtendedClassBCSPositionReport,
+				&NmeaDispatcher::onAISExtendedClassBCSPositionReport))
+		{
+			AISExtendedClassBCSPositionReport data;
+			if (NmeaParser::parseAISExtendedClassBEquipmentPositionReport(
+					encodedData, data))
+			{
+				handler().onAISExtendedClassBCSPositionReport(data);
+				handled = true;
+			}
+		}
+		break;
+	case Nmea_AisMessageType_AidToNavigationReport:
+		if (overridden(&Handler::onAISAidToNavigationReport,
+				&NmeaDispatcher::onAISAidToNavigationReport))
+		{
+			AISAidToNavigationReport data;
+			if (NmeaParser::parseAISAidToNavigationReport(encodedData, data))
+			{
+				handler().onAISAidToNavigationReport(data);
+				handled = true;
+			}
+		}
+		break;
+	case Nmea_AisMessageType_StaticDataReport:
+		if (overridden(&Handler::onAISStaticDataReport,
+				&NmeaDispatcher::onAISStaticDataReport))
+		{
+			AISStaticDataReport data;
+			if (NmeaParser::parseAISStaticDataReport(encodedData, data))
+			{
+				handler().onAISStaticDataReport(data);
+				handled = true;
+			}
+		}
+		break;
+	default:
+		break;
+	}
+	return handled;
+}
+
+#endif /* NMEADISPATCHER_H_ */
@@ -10,6 +10,8 @@
 #define SRC_NMEAENUMS_H_
 
 #include <iostream>
+#include <boost/utility/string_ref.hpp>
+#include "AISFixedString.h"
 
 /**
  * @brief GPS Quality Indicator in NMEA Sentence GGA. Used in NmeaParser::parseGGA().
@@ -30,6 +32,21 @@ enum Nmea_GPSQualityIndicator {
  */
 std::ostream& operator<< (std::ostream & out, Nmea_GPSQualityIndicator val);
 
+/**
+ * @brief Converts enumerator value to its name using a constant lookup table.
+ * @param val enumerator value Nmea_GPSQualityIndicator.
+ * @return enumerator name, empty when the value is out of range.
+ */
+boost::string_ref toStringRef(Nmea_GPSQualityIndicator val);
+
+/**
+ * @brief Converts an enumerator name back to its value.
+ * @param str enumerator name as returned by toStringRef().
+ * @param val enumerator value Nmea_GPSQualityIndicator.
+ * @return True on success.
+ */
+bool fromString(boost::string_ref str, Nmea_GPSQualityIndicator& val);
+
 /**
  * @brief Speed Distance Units in NMEA Sentence TTM. Used in NmeaParser::parseTTM().
  */
@@ -47,6 +64,21 @@ enum Nmea_SpeedDistanceUnits {
  */
 std::ostream& operator<< (std::ostream & out, Nmea_SpeedDistanceUnits val);
 
+/**
+ * @brief Converts enumerator value to its name using a constant lookup table.
+ * @param val enumerator value Nmea_SpeedDistanceUnits.
+ * @return enumerator name, empty when the value is out of range.
+ */
+boost::string_ref toStringRef(Nmea_SpeedDistanceUnits val);
+
+/**
+ * @brief Converts an enumerator name back to its value.
+ * @param str enumerator name as returned by toStringRef().
+ * @param val enumerator value Nmea_SpeedDistanceUnits.
+ * @return True on success.
+ */
+bool fromString(boost::string_ref str, Nmea_SpeedDistanceUnits& val);
+
 /**
  * @brief Target Status in NMEA Sentence TTM. Used in NmeaParser::parseTTM().
  */
@@ -64,6 +96,21 @@ enum Nmea_TargetStatus {
  */
 std::ostream& operator<< (std::ostream & out, Nmea_TargetStatus val);
 
+/**
+ * @brief Converts enumerator value to its name using a constant lookup table.
+ * @param val enumerator value Nmea_TargetStatus.
+ * @return enumerator name, empty when the value is out of range.
+ */
+boost::string_ref toStringRef(Nmea_TargetStatus val);
+
+/**
+ * @brief Converts an enumerator name back to its value.
+ * @param str enumerator name as returned by toStringRef().
+ * @param val enumerator value Nmea_TargetStatus.
+ * @return True on success.
+ */
+bool fromString(boost::string_ref str, Nmea_TargetStatus& val);
+
 /**
  * @brief Type Of Acquisition in NMEA Sentence TTM. Used in NmeaParser::parseTTM().
  */
@@ -81,6 +128,21 @@ enum Nmea_TypeOfAcquisition {
  */
 std::ostream& operator<< (std::ostream & out, Nmea_TypeOfAcquisition val);
 
+/**
+ * @brief Converts enumerator value to its name using a constant lookup table.
+ * @param val enumerator value Nmea_TypeOfAcquisition.
+ * @return enumerator name, empty when the value is out of range.
+ */
+boost::string_ref toStringRef(Nmea_TypeOfAcquisition val);
+
+/**
+ * @brief Converts an enumerator name back to its value.
+ * @param str enumerator name as returned by toStringRef().
+ * @param val enumerator value Nmea_TypeOfAcquisition.
+ * @return True on success.
+ */
+bool fromString(boost::string_ref str, Nmea_TypeOfAcquisition& val);
+
 /**
  * @brief Angle Reference in NMEA Sentence TTM. Used in NmeaParser::parseTTM().
  */
@@ -97,6 +159,21 @@ enum Nmea_AngleReference {
  */
 std::ostream& operator<< (std::ostream & out, Nmea_AngleReference val);
 
+/**
+ * @brief Converts enumerator value to its name using a constant lookup table.
+ * @param val enumerator value Nmea_AngleReference.
+ * @return enumerator name, empty when the value is out of range.
+ */
+boost::string_ref toStringRef(Nmea_AngleReference val);
+
+/**
+ * @brief Converts an enumerator name back to its value.
+ * @param str enumerator name as returned by toStringRef().
+ * @param val enumerator value Nmea_AngleReference.
+ * @return True on success.
+ */
+bool fromString(boost::string_ref str, Nmea_AngleReference& val);
+
 /**
  * @brief Track Status in struct NmeaTrackData for NMEA Sentence TTD. Used in NmeaParser::parseTTD().
  */
@@ -119,6 +196,21 @@ enum Nmea_TrackStatus {
  */
 std::ostream& operator<< (std::ostream & out, Nmea_TrackStatus val);
 
+/**
+ * @brief Converts enumerator value to its name using a constant lookup table.
+ * @param val enumerator value Nmea_TrackStatus.
+ * @return enumerator name, empty when the value is out of range.
+ */
+boost::string_ref toStringRef(Nmea_TrackStatus val);
+
+/**
+ * @brief Converts an enumerator name back to its value.
+ * @param str enumerator name as returned by toStringRef().
+ * @param val enumerator value Nmea_TrackStatus.
+ * @return True on success.
+ */
+bool fromString(boost::string_ref str, Nmea_TrackStatus& val);
+
 /**
  * @brief Operation in struct NmeaTrackData for NMEA Sentence TTD. Used in NmeaParser::parseTTD().
  */
@@ -135,6 +227,21 @@ enum Nmea_Operation {
  */
 std::ostream& operator<< (std::ostream & out, Nmea_Operation val);
 
+/**
+ * @brief Converts enumerator value to its name using a constant lookup table.
+ * @param val enumerator value Nmea_Operation.
+ * @return enumerator name, empty when the value is out of range.
+ */
+boost::string_ref toStringRef(Nmea_Operation val);
+
+/**
+ * @brief Converts an enumerator name back to its value.
+ * @param str enumerator name as returned by toStringRef().
+ * @param val enumerator value Nmea_Operation.
+ * @return True on success.
+ */
+bool fromString(boost::string_ref str, Nmea_Operation& val);
+
 /**
  * @brief Speed Mode in struct NmeaTrackData for NMEA Sentence TTD. Used in NmeaParser::parseTTD().
  */
@@ -151,6 +258,21 @@ enum Nmea_SpeedMode {
  */
 std::ostream& operator<< (std::ostream & out, Nmea_SpeedMode val);
 
+/**
+ * @brief Converts enumerator value to its name using a constant lookup table.
+ * @param val enumerator value Nmea_SpeedMode.
+ * @return enumerator name, empty when the value is out of range.
+ */
+boost::string_ref toStringRef(Nmea_SpeedMode val);
+
+/**
+ * @brief Converts an enumerator name back to its value.
+ * @param str enumerator name as returned by toStringRef().
+ * @param val enumerator value Nmea_SpeedMode.
+ * @return True on success.
+ */
+bool fromString(boost::string_ref str, Nmea_SpeedMode& val);
+
 /**
  * @brief Stabilization Mode in struct NmeaTrackData for NMEA Sentence TTD. Used in NmeaParser::parseTTD().
  */
@@ -167,6 +289,21 @@ enum Nmea_StabilisationMode {
  */
 std::ostream& operator<< (std::ostream & out, Nmea_StabilisationMode val);
 
+/**
+ * @brief Converts enumerator value to its name using a constant lookup table.
+ * @param val enumerator value Nmea_StabilisationMode.
+ * @return enumerator name, empty when the value is out of range.
+ */
+boost::string_ref toStringRef(Nmea_StabilisationMode val);
+
+/**
+ * @brief Converts an enumerator name back to its value.
+ * @param str enumerator name as returned by toStringRef().
+ * @param val enumerator value Nmea_StabilisationMode.
+ * @return True on success.
+ */
+bool fromString(boost::string_ref str, Nmea_StabilisationMode& val);
+
 /**
  * @brief Nmea Track Data struct used for parsing TTD binary message. Used in NmeaParser::parseTTD().
  */
@@ -226,6 +363,21 @@ enum Nmea_AisMessageType {
  */
 std::ostream& operator<<(std::ostream & out, Nmea_AisMessageType val);
 
+/**
+ * @brief Converts enumerator value to its name using a constant lookup table.
+ * @param val enumerator value Nmea_AisMessageType.
+ * @return enumerator name, empty when the value is out of range.
+ */
+boost::string_ref toStringRef(Nmea_AisMessageType val);
+
+/**
+ * @brief Converts an enumerator name back to its value.
+ * @param str enumerator name as returned by toStringRef().
+ * @param val enumerator value Nmea_AisMessageType.
+ * @return True on success.
+ */
+bool fromString(boost::string_ref str, Nmea_AisMessageType& val);
+
 /**
  * @brief Navigation Status for AIS Class A. Used in AISPositionReportClassA
  */
@@ -256,6 +408,21 @@ enum Nmea_NavigationStatus {
  */
 std::ostream& operator<<(std::ostream & out, Nmea_NavigationStatus val);
 
+/**
+ * @brief Converts enumerator value to its name using a constant lookup table.
+ * @param val enumerator value Nmea_NavigationStatus.
+ * @return enumerator name, empty when the value is out of range.
+ */
+boost::string_ref toStringRef(Nmea_NavigationStatus val);
+
+/**
+ * @brief Converts an enumerator name back to its value.
+ * @param str enumerator name as returned by toStringRef().
+ * @param val enumerator value Nmea_NavigationStatus.
+ * @return True on success.
+ */
+bool fromString(boost::string_ref str, Nmea_NavigationStatus& val);
+
 /**
  * @brief Position Accuracy for AIS. Used in AISPositionReportClassA, AISBaseStationReport and AISStandardClassBCSPositionReport.
  */
@@ -272,6 +439,21 @@ enum Nmea_PositionAccuracy {
  */
 std::ostream& operator<<(std::ostream & out, Nmea_PositionAccuracy val);
 
+/**
+ * @brief Converts enumerator value to its name using a constant lookup table.
+ * @param val enumerator value Nmea_PositionAccuracy.
+ * @return enumerator name, empty when the value is out of range.
+ */
+boost::string_ref toStringRef(Nmea_PositionAccuracy val);
+
+/**
+ * @brief Converts an enumerator name back to its value.
+ * @param str enumerator name as returned by toStringRef().
+ * @param val enumerator value Nmea_PositionAccuracy.
+ * @return True on success.
+ */
+bool fromString(boost::string_ref str, Nmea_PositionAccuracy& val);
+
 /**
  * @brief Maneuver Indicator for AIS. Used in AISPositionReportClassA.
  */
@@ -289,6 +471,21 @@ enum Nmea_ManeuverIndicator {
  */
 std::ostream& operator<<(std::ostream & out, Nmea_ManeuverIndicator val);
 
+/**
+ * @brief Converts enumerator value to its name using a constant lookup table.
+ * @param val enumerator value Nmea_ManeuverIndicator.
+ * @return enumerator name, empty when the value is out of range.
+ */
+boost::string_ref toStringRef(Nmea_ManeuverIndicator val);
+
+/**
+ * @brief Converts an enumerator name back to its value.
+ * @param str enumerator name as returned by toStringRef().
+ * @param val enumerator value Nmea_ManeuverIndicator.
+ * @return True on success.
+ */
+bool fromString(boost::string_ref str, Nmea_ManeuverIndicator& val);
+
 /**
  * @brief RAIM for AIS. Used in AISPositionReportClassA and AISBaseStationReport.
  */
@@ -305,6 +502,21 @@ enum Nmea_RAIM {
  */
 std::ostream& operator<<(std::ostream & out, Nmea_RAIM val);
 
+/**
+ * @brief Converts enumerator value to its name using a constant lookup table.
+ * @param val enumerator value Nmea_RAIM.
+ * @return enumerator name, empty when the value is out of range.
+ */
+boost::string_ref toStringRef(Nmea_RAIM val);
+
+/**
+ * @brief Converts an enumerator name back to its value.
+ * @param str enumerator name as returned by toStringRef().
+ * @param val enumerator value Nmea_RAIM.
+ * @return True on success.
+ */
+bool fromString(boost::string_ref str, Nmea_RAIM& val);
+
 /**
  * @brief EPFDFix for AIS. Used in AISBaseStationReport and AISStaticAndVoyageRelatedData.
  */
@@ -328,6 +540,21 @@ enum Nmea_EPFDFix {
  */
 std::ostream& operator<<(std::ostream & out, Nmea_EPFDFix val);
 
+/**
+ * @brief Converts enumerator value to its name using a constant lookup table.
+ * @param val enumerator value Nmea_EPFDFix.
+ * @return enumerator name, empty when the value is out of range.
+ */
+boost::string_ref toStringRef(Nmea_EPFDFix val);
+
+/**
+ * @brief Converts an enumerator name back to its value.
+ * @param str enumerator name as returned by toStringRef().
+ * @param val enumerator value Nmea_EPFDFix.
+ * @return True on success.
+ */
+bool fromString(boost::string_ref str, Nmea_EPFDFix& val);
+
 /**
  * @brief Ship Type for AIS. Used in AISStaticAndVoyageRelatedData and AISStaticDataReport
  */
@@ -442,6 +669,21 @@ enum Nmea_ShipType {
  */
 std::ostream& operator<<(std::ostream & out, Nmea_ShipType val);
 
+/**
+ * @brief Converts enumerator value to its name using a constant lookup table.
+ * @param val enumerator value Nmea_ShipType.
+ * @return enumerator name, empty when the value is out of range.
+ */
+boost::string_ref toStringRef(Nmea_ShipType val);
+
+/**
+ * @brief Converts an enumerator name back to its value.
+ * @param str enumerator name as returned by toStringRef().
+ * @param val enumerator value Nmea_ShipType.
+ * @return True on success.
+ */
+bool fromString(boost::string_ref str, Nmea_ShipType& val);
+
 /**
  * @brief Navigation Aid Type for AIS. Used in AISAidtoNavigationReport
  */
@@ -488,6 +730,21 @@ enum Nmea_NavigationAidType {
  */
 std::ostream& operator<<(std::ostream & out, Nmea_NavigationAidType val);
 
+/**
+ * @brief Converts enumerator value to its name using a constant lookup table.
+ * @param val enumerator value Nmea_NavigationAidType.
+ * @return enumerator name, empty when the value is out of range.
+ */
+boost::string_ref toStringRef(Nmea_NavigationAidType val);
+
+/**
+ * @brief Converts an enumerator name back to its value.
+ * @param str enumerator name as returned by toStringRef().
+ * @param val enumerator value Nmea_NavigationAidType.
+ * @return True on success.
+ */
+bool fromString(boost::string_ref str, Nmea_NavigationAidType& val);
+
 /**
  * @brief Struct used to store Dimension from Ais Messages
  */
@@ -545,8 +802,8 @@ struct AISStaticAndVoyageRelatedData {
 	uint mmsi; //!< 9 decimal digits ID
 	int aisVersion; //!< AIS Version
 	int imoNumber; //!< IMO Ship ID number
-	std::string callsign; //!< 7 characters Call Sign
-	std::string vesselName; //!< 20 characters Vessel Name
+	AISFixedString<7> callsign; //!< 7 characters Call Sign
+	AISFixedString<20> vesselName; //!< 20 characters Vessel Name
 	Nmea_ShipType shipType; //!< Ship Type
 	AISDimension dimension; //!< Ship Dimension
 	Nmea_EPFDFix epfd; //!< EPFD Fix
@@ -555,7 +812,7 @@ struct AISStaticAndVoyageRelatedData {
 	int hour; //!< ETA Hour
 	int minute; //!< ETA Minute
 	float draught; //!< Draught
-	std::string destination; //!< 20 characters Destination
+	AISFixedString<20> destination; //!< 20 characters Destination
 };
 
 /**
@@ -573,6 +830,27 @@ struct AISStandardClassBCSPositionReport {
 	uint timestapUTCSecond; //!< Timestamp UTC second
 };
 
+/**
+ * @brief Struct used to parse Extended Class B CS Position Report Ais Message. Used in NmeaParser::parseAISExtendedClassBEquipmentPositionReport().
+ */
+struct AISExtendedClassBCSPositionReport {
+	int repeatIndicator; //!< Message repeat count
+	uint mmsi; //!< 9 decimal digits ID
+	float speedOverGround; //!< Speed Over Ground
+	Nmea_PositionAccuracy positionAccuracy; //!< Position Accuracy
+	float longitude; //!< Longitude
+	float latitude; //!< Latitude
+	float courseOverGround; //!< Course Over Ground
+	uint trueHeading; //!< True Heading
+	uint timestapUTCSecond; //!< Timestamp UTC second
+	AISFixedString<20> vesselName; //!< 20 characters Vessel Name
+	Nmea_ShipType shipType; //!< Ship Type
+	AISDimension dimension; //!< Ship Dimension
+	Nmea_EPFDFix epfd; //!< EPFD Fix
+	Nmea_RAIM raim; //!< RAIM
+	bool assigned; //!< Assigned-mode flag
+};
+
 /**
  * @brief Struct used to parse Static Data Report Ais Message. Used in NmeaParser::parseAISStaticDataReport().
  */
@@ -582,15 +860,15 @@ struct AISStaticDataReport {
 	int partNumber; //!< Indicates which part is valid.  Part A or Part B
 
 	struct {
-		std::string vesselName; //!< 20 characters Vessel Name
+		AISFixedString<20> vesselName; //!< 20 characters Vessel Name
 	} partA; //!< Message Part A
 
 	struct {
 		Nmea_ShipType shipType; //!< Ship Type
-		std::string vendorId; //!< 3 characters Vendor Id
+		AISFixedString<3> vendorId; //!< 3 characters Vendor Id
 		int unitModelCode; //!< Unit model code
 		int serialNumber; //!< Serial Number
-		std::string callsign; //!< 7 characters Call Sign
+		AISFixedString<7> callsign; //!< 7 characters Call Sign
 		AISDimension dimension; //!< Ship Dimension
 	} partB; //!< Message Part B
 };
@@ -612,7 +890,7 @@ struct AISAidToNavigationReport {
 	int repeatIndicator; //!< Message repeat count
 	uint mmsi; //!< 9 decimal digits ID
 	Nmea_NavigationAidType navigationAidType; //!< Navigation Aid Type
-	std::string name; //!< 20 characters Name
+	AISFixedString<34> name; //!< 20 characters Name, up to 14 more with the Name Extension
 	Nmea_PositionAccuracy positionAccuracy; //!< Position Accuracy
 	float longitude; //!< Longitude
 	float latitude; //!< Latitude
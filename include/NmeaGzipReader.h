@@ -0,0 +1,130 @@
+/**
+ *	@file NmeaGzipReader.h
+ *	@brief Header for NmeaGzipReader class
+ *
+ *   Line reader of gzip compressed NMEA logs, inflating on worker threads.
+ */
+
+#ifndef NMEAGZIPREADER_H_
+#define NMEAGZIPREADER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include <boost/utility/string_ref.hpp>
+#include "NmeaMappedFile.h"
+
+/**
+ * @brief Reads the lines of a gzip compressed NMEA log.
+ *
+ * The compressed file is memory mapped and inflated with zlib away from
+ * the reading thread, into a ring of chunks the reader frames into lines:
+ *
+ * - BGZF files, the block compressed gzip of bgzip and samtools, are made
+ *   of independent members whose sizes are in their headers. The blocks
+ *   are listed when the file is opened and inflated by @c threads workers
+ *   at once, a run of blocks per chunk, checking their CRC.
+ * - Other gzip files, single or multi-member, are inflated by one thread
+ *   since where a member ends is only known once it is inflated. Reading
+ *   still overlaps inflating.
+ * - Files without gzip header are read as they are.
+ *
+ * Workers stay at most @c ring chunks ahead of the reader, so memory is
+ * bounded by ring * chunk bytes whatever the size of the file.
+ */
+class NmeaGzipReader: private boost::noncopyable
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] threads Inflate threads for BGZF files, 0 for one per core
+	 * @param [in] chunkBytes Uncompressed bytes per chunk
+	 */
+	explicit NmeaGzipReader(unsigned threads = 0,
+			std::size_t chunkBytes = 1 << 20);
+
+	/**
+	 * @brief Destructor, stops the workers
+	 */
+	~NmeaGzipReader();
+
+	/**
+	 * @brief Opens a file and starts inflating
+	 *
+	 * @param [in] path File path
+	 *
+	 * @return False if the file cannot be mapped.
+	 */
+	bool open(const std::string& path);
+
+	/**
+	 * @brief Stops the workers and closes the file
+	 */
+	void close();
+
+	/**
+	 * @brief Reads the next line
+	 *
+	 * @param [out] line Line without its CR LF or LF terminator, valid until the next call
+	 *
+	 * @return False at the end of the file or on corrupt data.
+	 */
+	bool next(boost::string_ref& line);
+
+	/**
+	 * @brief Whether the file is BGZF, inflated in parallel
+	 *
+	 * @return True for BGZF.
+	 */
+	bool blocked() const;
+
+	/**
+	 * @brief Whether inflating failed
+	 *
+	 * @return True if the compressed data is corrupt or truncated.
+	 */
+	bool failed() const;
+
+private:
+	/**
+	 * @brief Private Implementation
+	 */
+	class impl;
+
+	/**
+	 * @brief Uncompressed chunk
+	 */
+	struct Chunk
+	{
+		std::vector<char> data; //!< Uncompressed bytes
+		uint64_t sequence; //!< Position of the chunk in the file
+		bool ready; //!< True once inflated
+	};
+
+	unsigned threads; //!< Inflate threads for BGZF
+	std::size_t chunkBytes; //!< Uncompressed bytes per chunk
+	NmeaMappedFile file; //!< Compressed file
+	std::vector<uint64_t> blocks; //!< BGZF block offsets, then the end offset
+	std::vector<Chunk> ring; //!< Chunks being inflated or read
+	std::vector<std::thread> workers; //!< Inflate threads
+	mutable std::mutex mutex; //!< Guards the ring state
+	std::condition_variable inflated; //!< Signals a chunk ready
+	std::condition_variable consumed; //!< Signals a chunk read
+	uint64_t nextJob; //!< Next BGZF chunk to inflate
+	uint64_t reading; //!< Chunk the reader is at
+	uint64_t end; //!< Number of chunks, once known
+	bool stopping; //!< Set by close()
+	bool corrupt; //!< Set on inflate error
+	const Chunk* current; //!< Chunk being framed, nullptr before the first
+	std::size_t position; //!< Offset in the current chunk
+	std::string carry; //!< Line spanning chunks
+	bool carried; //!< True if the last line returned is in carry
+};
+
+#endif /* NMEAGZIPREADER_H_ */
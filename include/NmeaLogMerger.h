@@ -0,0 +1,117 @@
+/**
+ *	@file NmeaLogMerger.h
+ *	@brief Header for NmeaLogMerger class
+ *
+ *   Time ordered merge of several NMEA log files.
+ */
+
+#ifndef NMEALOGMERGER_H_
+#define NMEALOGMERGER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include <boost/utility/string_ref.hpp>
+#include "NmeaMappedFile.h"
+#include "NmeaTimeExtractor.h"
+
+/**
+ * @brief Line of the merged stream.
+ */
+struct NmeaMergedLine
+{
+	boost::string_ref line; //!< Line without terminator, view into the source mapping
+	boost::string_ref sentence; //!< TAG block and sentence of the line, without the logger receive time
+	int64_t timestamp; //!< Milliseconds since the UNIX epoch
+	std::size_t source; //!< Index of the source, in add() order
+	uint64_t offset; //!< Offset of the line in the source
+	bool timed; //!< False if the time was carried from a previous line
+};
+
+/**
+ * @brief Streaming k-way merge of NMEA log files by time.
+ *
+ * Each source is a log recorded from one port, in time order. Line times
+ * come from NmeaTimeExtractor, one per source: TAG block timestamps,
+ * receive times written by the logger, or ZDA, RMC and GGA with the date
+ * carried from the last ZDA or RMC. Lines without time, AIS sentences for
+ * example, keep the time of the line before them so they stay after it;
+ * lines before the first time of a source take that first time.
+ *
+ * A binary heap holds the next line of every source, so each line costs
+ * O(log N) comparisons. Lines with the same time come out in source order.
+ *
+ * Sources are memory mapped. Reading is done in chunks: the chunk after
+ * the current one is prefetched and chunks already read are released, so
+ * resident memory stays around two chunks per source whatever the size of
+ * the files. Views returned by next() stay valid until close(), released
+ * pages are read again from the file if needed.
+ */
+class NmeaLogMerger: private boost::noncopyable
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] chunkBytes Bytes read ahead and released at once per source
+	 */
+	explicit NmeaLogMerger(uint64_t chunkBytes = 1 << 20);
+
+	/**
+	 * @brief Adds a log file, before the first call to next()
+	 *
+	 * @param [in] path Log file path
+	 *
+	 * @return False if the file cannot be mapped or lines were already read.
+	 */
+	bool add(const std::string& path);
+
+	/**
+	 * @brief Reads the next line in time order
+	 *
+	 * @param [out] line Line and its time
+	 *
+	 * @return False when every source is exhausted.
+	 */
+	bool next(NmeaMergedLine& line);
+
+	/**
+	 * @brief Number of sources
+	 *
+	 * @return Sources added.
+	 */
+	std::size_t sourceCount() const;
+
+	/**
+	 * @brief Unmaps every source
+	 */
+	void close();
+
+private:
+	/**
+	 * @brief Private Implementation
+	 */
+	class impl;
+
+	/**
+	 * @brief Read position of a source
+	 */
+	struct Cursor
+	{
+		uint64_t offset; //!< Offset of the next line not in the heap
+		uint64_t chunk; //!< Chunk being read
+		int64_t timestamp; //!< Time carried to lines without time
+		NmeaTimeExtractor extractor; //!< Date carried between lines
+	};
+
+	uint64_t chunkBytes; //!< Read ahead unit
+	bool started; //!< True once next() was called
+	std::deque<NmeaMappedFile> files; //!< Mapped sources
+	std::vector<Cursor> cursors; //!< Read position per source
+	std::vector<NmeaMergedLine> heap; //!< Next line of every source, earliest on top
+};
+
+#endif /* NMEALOGMERGER_H_ */
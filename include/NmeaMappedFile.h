@@ -0,0 +1,129 @@
+/**
+ *	@file NmeaMappedFile.h
+ *	@brief Header for NmeaMappedFile class
+ *
+ *   Read only memory mapped NMEA log file, read line by line.
+ */
+
+#ifndef NMEAMAPPEDFILE_H_
+#define NMEAMAPPEDFILE_H_
+
+#include <cstdint>
+#include <string>
+#include <boost/noncopyable.hpp>
+#include <boost/utility/string_ref.hpp>
+
+/**
+ * @brief NMEA log file mapped in memory.
+ *
+ * Lines are returned as views into the mapping, without copy and without
+ * their CR LF or LF terminator. Offsets are byte offsets from the start of
+ * the file, so a line can be found again from an offset stored in an index.
+ */
+class NmeaMappedFile: private boost::noncopyable
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	NmeaMappedFile();
+
+	/**
+	 * @brief Destructor, unmaps the file
+	 */
+	~NmeaMappedFile();
+
+	/**
+	 * @brief Maps a file
+	 *
+	 * @param [in] path File path
+	 * @param [in] sequential True if read front to back, false for random
+	 * access such as binary searches, turns kernel read ahead on or off
+	 *
+	 * @return False if the file cannot be opened or mapped.
+	 */
+	bool open(const std::string& path, bool sequential = true);
+
+	/**
+	 * @brief Unmaps the file
+	 */
+	void close();
+
+	/**
+	 * @brief Maps the file again if its size changed, for logs still being written
+	 *
+	 * Views and pointers obtained before are invalid after a remap.
+	 *
+	 * @return False if the file can no longer be mapped, it is then closed.
+	 */
+	bool refresh();
+
+	/**
+	 * @brief Whether a file is mapped
+	 *
+	 * @return True if open.
+	 */
+	bool isOpen() const;
+
+	/**
+	 * @brief Mapped bytes
+	 *
+	 * @return Start of the file, nullptr if the file is empty or closed.
+	 */
+	const char* data() const;
+
+	/**
+	 * @brief File size when mapped
+	 *
+	 * @return Size in bytes.
+	 */
+	uint64_t size() const;
+
+	/**
+	 * @brief Reads the line starting at an offset
+	 *
+	 * The last line of the file is returned even without a terminator.
+	 *
+	 * @param [in] offset Offset of the first character of the line
+	 * @param [out] line Line without terminator, empty at the end of the file
+	 *
+	 * @return Offset of the next line, size() at the end of the file.
+	 */
+	uint64_t line(uint64_t offset, boost::string_ref& line) const;
+
+	/**
+	 * @brief Asks the kernel to read a range ahead of use
+	 *
+	 * @param [in] offset First byte
+	 * @param [in] length Bytes, clipped to the end of the file
+	 */
+	void prefetch(uint64_t offset, uint64_t length) const;
+
+	/**
+	 * @brief Drops a range already read from memory
+	 *
+	 * The range stays mapped, it is read again from the file if accessed.
+	 *
+	 * @param [in] offset First byte
+	 * @param [in] length Bytes, clipped to the end of the file
+	 */
+	void release(uint64_t offset, uint64_t length) const;
+
+private:
+	/**
+	 * @brief Gives the kernel advice on a range
+	 *
+	 * @param [in] offset First byte
+	 * @param [in] bytes Bytes, clipped to the end of the file
+	 * @param [in] advice madvise() advice
+	 */
+	void advise(uint64_t offset, uint64_t bytes, int advice) const;
+
+	std::string filePath; //!< Path given to open()
+	const char* mapped; //!< Mapping, nullptr if empty or closed
+	uint64_t length; //!< Mapped length
+	bool sequential; //!< Access pattern given to open()
+	bool opened; //!< True if a file is open
+};
+
+#endif /* NMEAMAPPEDFILE_H_ */
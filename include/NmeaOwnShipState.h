@@ -0,0 +1,165 @@
+/**
+ *	@file NmeaOwnShipState.h
+ *	@brief Header for NmeaOwnShipState class
+ *
+ *   Own ship navigation state published to many reader threads.
+ */
+
+#ifndef NMEAOWNSHIPSTATE_H_
+#define NMEAOWNSHIPSTATE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "NmeaParser.h"
+
+/**
+ * @brief Own ship navigation fields.
+ */
+enum Nmea_OwnShipField {
+	Nmea_OwnShipField_Latitude,          //!< Latitude, decimal degrees (GGA, RMC)
+	Nmea_OwnShipField_Longitude,         //!< Longitude, decimal degrees (GGA, RMC)
+	Nmea_OwnShipField_SpeedOverGround,   //!< Speed over ground, knots (RMC, VTG)
+	Nmea_OwnShipField_CourseOverGround,  //!< Course over ground, degrees true (RMC, VTG)
+	Nmea_OwnShipField_Heading,           //!< Heading, degrees true (HDT, VHW)
+	Nmea_OwnShipField_RateOfTurn,        //!< Rate of turn, degrees per minute (ROT)
+	Nmea_OwnShipField_SpeedThroughWater, //!< Speed through water, knots (VHW)
+	Nmea_OwnShipField_Altitude,          //!< Antenna altitude above mean sea level, meters (GGA)
+	Nmea_OwnShipField_Hdop,              //!< Horizontal dilution of precision (GGA)
+	Nmea_OwnShipField_SatelliteCount,    //!< Number of satellites in use (GGA)
+	Nmea_OwnShipField_FixQuality,        //!< Nmea_GPSQualityIndicator (GGA)
+	Nmea_OwnShipField_UtcTime,           //!< UTC time of position, seconds since midnight (GGA, RMC)
+	Nmea_OwnShipField_Count              //!< Number of fields
+};
+
+/**
+ * @brief Consistent copy of the own ship state.
+ */
+struct NmeaOwnShipSnapshot {
+	double value[Nmea_OwnShipField_Count]; //!< Last valid value of each field
+	int64_t timestamp[Nmea_OwnShipField_Count]; //!< Time of the last valid value, 0 if never received
+	uint64_t validMask; //!< Bit per field, set if the last sentence carrying the field had it valid
+	uint32_t version; //!< Number of publications, increases with every ingested sentence
+
+	/**
+	 * @brief Whether the last sentence carrying a field had it valid
+	 *
+	 * @param [in] field Field
+	 *
+	 * @return True if valid.
+	 */
+	bool isValid(Nmea_OwnShipField field) const
+	{
+		return (validMask >> field) & 1;
+	}
+
+	/**
+	 * @brief Time elapsed since the last valid value of a field
+	 *
+	 * @param [in] field Field
+	 * @param [in] now Current time, same units as the ingest timestamps
+	 *
+	 * @return Age, -1 if the field was never received.
+	 */
+	int64_t age(Nmea_OwnShipField field, int64_t now) const
+	{
+		return timestamp[field] == 0 ? -1 : now - timestamp[field];
+	}
+};
+
+/**
+ * @brief Own ship state assembled from GGA, RMC, VTG, HDT, ROT and VHW.
+ *
+ * One ingest thread feeds sentences and every ingest publishes a new
+ * state through a sequence lock: the writer never waits for readers and
+ * readers never block the writer, they retry the copy if a publication
+ * happened while they were reading.
+ *
+ * A field whose bit is set in the NmeaParserResult keeps its last valid
+ * value and timestamp, and is flagged invalid in the snapshot.
+ */
+class NmeaOwnShipState
+{
+public:
+	/**
+	 * @brief Constructor, no field received
+	 */
+	NmeaOwnShipState();
+
+	/**
+	 * @brief Parses a sentence and publishes the updated state
+	 *
+	 * Must always be called from the same thread.
+	 *
+	 * @param [in] nmea NMEA sentence, GGA, RMC, VTG, HDT, ROT or VHW
+	 * @param [in] timestamp Reception time, must not be 0
+	 *
+	 * @return True if the sentence was recognized and published.
+	 */
+	bool ingest(const std::string& nmea, int64_t timestamp);
+
+	/**
+	 * @brief Copies the last published state
+	 *
+	 * Safe to call from any number of threads.
+	 *
+	 * @param [out] snapshot Copy of the state
+	 */
+	void snapshot(NmeaOwnShipSnapshot& snapshot) const;
+
+	/**
+	 * @brief Copies the last published state without retrying
+	 *
+	 * For readers that cannot spin: fails if a publication is in progress or
+	 * happened during the copy.
+	 *
+	 * @param [out] snapshot Copy of the state, undefined on failure
+	 *
+	 * @return True if the copy is consistent.
+	 */
+	bool trySnapshot(NmeaOwnShipSnapshot& snapshot) const;
+
+	/**
+	 * @brief Number of publications
+	 *
+	 * Readers poll it to know whether the state changed.
+	 *
+	 * @return Version of the last published state.
+	 */
+	uint32_t version() const;
+
+private:
+	/**
+	 * @brief Updates a field of the pending state
+	 *
+	 * @param [in] field Field
+	 * @param [in] value Value
+	 * @param [in] valid False if the parser flagged the field
+	 * @param [in] timestamp Reception time
+	 */
+	void set(Nmea_OwnShipField field, double value, bool valid,
+			int64_t timestamp);
+
+	/**
+	 * @brief Publishes the pending state
+	 */
+	void publish();
+
+	/**
+	 * @brief Reads the published words
+	 *
+	 * @param [out] snapshot Copy of the state
+	 * @param [out] version Sequence read before the copy
+	 *
+	 * @return True if the copy is consistent.
+	 */
+	bool read(NmeaOwnShipSnapshot& snapshot, uint32_t& version) const;
+
+	static const int WORD_COUNT = 2 * Nmea_OwnShipField_Count + 1; //!< Values, timestamps and validity
+
+	NmeaOwnShipSnapshot pending; //!< State owned by the ingest thread
+	std::atomic<uint32_t> sequence; //!< Odd while a publication is in progress
+	std::atomic<uint64_t> words[WORD_COUNT]; //!< Published state
+};
+
+#endif /* NMEAOWNSHIPSTATE_H_ */
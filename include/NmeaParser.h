@@ -996,6 +996,18 @@ public:
 			const std::string& encodedData,
 			AISStandardClassBCSPositionReport& data);
 
+	/**
+	 * @brief Parse AIS Extended Class B CS Position Report - Type 19
+	 *
+	 * @param [in] encodedData AIS Binary Encoded Data
+	 * @param [out] data Struct filled with the decoded data
+	 *
+	 * @return True on success.
+	 */
+	static bool parseAISExtendedClassBEquipmentPositionReport(
+			const std::string& encodedData,
+			AISExtendedClassBCSPositionReport& data);
+
 	/**
 	 * @brief Parse AIS Static Data Report - Type 24
 	 *
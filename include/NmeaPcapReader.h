@@ -0,0 +1,135 @@
+/**
+ *	@file NmeaPcapReader.h
+ *	@brief Header for NmeaPcapReader class
+ *
+ *   Reads NMEA lines carried over UDP from pcap and pcapng captures.
+ */
+
+#ifndef NMEAPCAPREADER_H_
+#define NMEAPCAPREADER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include <boost/utility/string_ref.hpp>
+#include "NmeaMappedFile.h"
+
+/**
+ * @brief NMEA line found in a captured UDP datagram.
+ */
+struct NmeaCapturedLine
+{
+	boost::string_ref line; //!< Line without terminator, view into the capture
+	int64_t timestamp; //!< Capture time in microseconds since the UNIX epoch
+	uint32_t sourceAddress; //!< IPv4 source address, host byte order
+	uint32_t destinationAddress; //!< IPv4 destination address, host byte order
+	uint16_t sourcePort; //!< UDP source port
+	uint16_t destinationPort; //!< UDP destination port
+	bool udpbc; //!< True if the datagram had the IEC 61162-450 UdPbC header
+};
+
+/**
+ * @brief Capture counters.
+ */
+struct NmeaPcapStatistics
+{
+	uint64_t packets; //!< Packets read
+	uint64_t datagrams; //!< UDP datagrams holding NMEA
+	uint64_t skipped; //!< Packets not IPv4 UDP, fragments, other payloads or filtered out
+	uint64_t truncated; //!< Packets cut by the capture snap length
+};
+
+/**
+ * @brief Reads NMEA from a tcpdump or Wireshark capture, without libpcap.
+ *
+ * The capture is memory mapped and walked in place: pcap with microsecond
+ * or nanosecond timestamps in either byte order, and pcapng with any
+ * number of sections and interfaces. Link layers are Ethernet with 802.1Q
+ * tags, Linux cooked captures v1 and v2 (tcpdump -i any), raw IP and BSD
+ * loopback. IPv4 UDP datagrams are kept; fragments are skipped.
+ *
+ * Datagrams starting with the IEC 61162-450 "UdPbC" header, or directly
+ * with '$', '!' or a TAG block, are split into lines. Other 61162-450
+ * datagrams, binary images and network messages, are skipped. Lines are
+ * views into the mapping, valid until close(), and carry the capture time
+ * to be used as receive time.
+ */
+class NmeaPcapReader: private boost::noncopyable
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	NmeaPcapReader();
+
+	/**
+	 * @brief Opens a capture
+	 *
+	 * @param [in] path pcap or pcapng file path
+	 *
+	 * @return False if the file cannot be mapped or is not a capture.
+	 */
+	bool open(const std::string& path);
+
+	/**
+	 * @brief Closes the capture
+	 */
+	void close();
+
+	/**
+	 * @brief Keeps only datagrams sent to a port
+	 *
+	 * @param [in] port UDP destination port, 0 for every port
+	 */
+	void setPort(uint16_t port);
+
+	/**
+	 * @brief Reads the next NMEA line
+	 *
+	 * @param [out] line Line, capture time and addresses
+	 *
+	 * @return False at the end of the capture or at a corrupt record.
+	 */
+	bool next(NmeaCapturedLine& line);
+
+	/**
+	 * @brief Counters since open()
+	 *
+	 * @return Statistics.
+	 */
+	const NmeaPcapStatistics& statistics() const;
+
+private:
+	/**
+	 * @brief Private Implementation
+	 */
+	class impl;
+
+	/**
+	 * @brief pcapng interface
+	 */
+	struct Interface
+	{
+		uint16_t linkType; //!< LINKTYPE_ value
+		bool binary; //!< Timestamp resolution is 2^-exponent instead of 10^-exponent
+		uint8_t exponent; //!< Timestamp resolution exponent
+		int64_t offset; //!< Seconds added to timestamps
+	};
+
+	NmeaMappedFile file; //!< Capture
+	bool ng; //!< True for pcapng
+	bool swapped; //!< True if the file byte order is not the host one
+	bool nanoseconds; //!< True for pcap with nanosecond timestamps
+	uint16_t linkType; //!< pcap link type
+	std::vector<Interface> interfaces; //!< pcapng interfaces of the current section
+	uint64_t offset; //!< Offset of the next record
+	uint16_t port; //!< Destination port filter, 0 for none
+	NmeaCapturedLine datagram; //!< Time and addresses of the datagram being split
+	const char* payload; //!< Rest of the datagram being split
+	std::size_t remaining; //!< Bytes left in payload
+	NmeaPcapStatistics counters; //!< Counters
+};
+
+#endif /* NMEAPCAPREADER_H_ */
@@ -0,0 +1,173 @@
+/**
+ *	@file NmeaReplay.h
+ *	@brief Header for NmeaReplay class
+ *
+ *   Replay of recorded NMEA logs at their recorded rate.
+ */
+
+#ifndef NMEAREPLAY_H_
+#define NMEAREPLAY_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include <boost/noncopyable.hpp>
+#include <boost/utility/string_ref.hpp>
+#include "NmeaLogMerger.h"
+
+/**
+ * @brief Replay counters.
+ */
+struct NmeaReplayStatistics
+{
+	uint64_t lines; //!< Lines sent
+	uint64_t dropped; //!< Lines a sink could not take, counted once per line
+	uint64_t scheduled; //!< Lines sent against a deadline, jitter recorded
+	int64_t maxJitter; //!< Largest lateness in nanoseconds
+};
+
+/**
+ * @brief Replays NMEA lines at the rate they were recorded.
+ *
+ * Lines come from a NmeaLogMerger, one or several logs, with the time of
+ * each line from its NmeaTimeExtractor. The first line is sent at once and
+ * sets the origin; a line recorded t milliseconds later is due t / speed
+ * after it. Lines without time are sent right after the line before them.
+ *
+ * The thread sleeps with clock_nanosleep() on an absolute CLOCK_MONOTONIC
+ * deadline, so errors do not add up over a long log, then spins for the
+ * last microseconds to absorb the wake up latency of the scheduler. The
+ * lateness of every send against its deadline goes into a histogram of
+ * 1 us buckets up to 10 ms, read with jitterPercentile().
+ *
+ * Lines go to every sink opened as NMEA: TAG block and sentence, without
+ * the receive time a logger may have written, and with CR LF. Sinks are a
+ * pseudo terminal for programs expecting a serial port, a UDP socket, and
+ * a callback. Sinks do
+ * not block: a line a sink cannot take at once is dropped and counted, so
+ * a slow consumer shows up in the statistics instead of in the timing. A
+ * line the pseudo terminal takes only in part is not dropped: its tail is
+ * written before anything else, so the slave never reads a broken line.
+ */
+class NmeaReplay: private boost::noncopyable
+{
+public:
+	/**
+	 * @brief Callback receiving every sentence sent and its recorded time
+	 */
+	typedef std::function<void(boost::string_ref line, int64_t timestamp)> Callback;
+
+	/**
+	 * @brief Constructor, 1x speed, 100 us spin, no sink
+	 */
+	NmeaReplay();
+
+	/**
+	 * @brief Destructor, closes the sinks
+	 */
+	~NmeaReplay();
+
+	/**
+	 * @brief Opens a pseudo terminal sink
+	 *
+	 * The terminal is raw, lines are read from the slave as written.
+	 *
+	 * @param [out] name Slave device path, /dev/pts/N, to give to the program under test
+	 *
+	 * @return False if no pseudo terminal can be opened.
+	 */
+	bool openPty(std::string& name);
+
+	/**
+	 * @brief Opens a UDP sink, one datagram per line
+	 *
+	 * @param [in] address IPv4 address, 127.0.0.1 for loopback
+	 * @param [in] port UDP port
+	 *
+	 * @return False if the address is invalid or no socket can be opened.
+	 */
+	bool openUdp(const std::string& address, uint16_t port);
+
+	/**
+	 * @brief Sets the callback sink
+	 *
+	 * @param [in] callback Called from replay(), empty to remove
+	 */
+	void setCallback(const Callback& callback);
+
+	/**
+	 * @brief Closes every sink
+	 */
+	void close();
+
+	/**
+	 * @brief Sets the replay speed
+	 *
+	 * @param [in] speed Multiple of the recorded rate, 0 for as fast as possible
+	 */
+	void setSpeed(double speed);
+
+	/**
+	 * @brief Sets how long before a deadline sleeping gives way to spinning
+	 *
+	 * @param [in] nanoseconds Spin time, 0 to only sleep
+	 */
+	void setSpin(int64_t nanoseconds);
+
+	/**
+	 * @brief Sends lines at their time until the merger is exhausted or stop() is called
+	 *
+	 * @param [in] merger Lines to replay
+	 *
+	 * @return Lines sent.
+	 */
+	uint64_t replay(NmeaLogMerger& merger);
+
+	/**
+	 * @brief Makes replay() return after the line in progress, from any thread
+	 */
+	void stop();
+
+	/**
+	 * @brief Counters since the last reset
+	 *
+	 * @return Statistics.
+	 */
+	NmeaReplayStatistics statistics() const;
+
+	/**
+	 * @brief Scheduling jitter percentile
+	 *
+	 * @param [in] percentile Percentile, 0 to 100
+	 *
+	 * @return Upper bound of the lateness in nanoseconds, with 1 us resolution,
+	 * the largest lateness beyond 10 ms, 0 without scheduled line.
+	 */
+	int64_t jitterPercentile(double percentile) const;
+
+	/**
+	 * @brief Clears the counters and the histogram
+	 */
+	void resetStatistics();
+
+private:
+	/**
+	 * @brief Private Implementation
+	 */
+	class impl;
+
+	int ptyFd; //!< Pseudo terminal master, -1 if closed
+	int udpFd; //!< UDP socket, -1 if closed
+	Callback callback; //!< Callback sink
+	double speed; //!< Multiple of the recorded rate
+	int64_t spin; //!< Spin time before a deadline
+	std::atomic<bool> stopping; //!< Set by stop()
+	std::string buffer; //!< Line with terminator
+	std::string ptyPending; //!< Tail of a line the pseudo terminal has not taken yet
+	NmeaReplayStatistics counters; //!< Counters
+	std::vector<uint64_t> histogram; //!< Lateness in 1 us buckets, last one for 10 ms and more
+};
+
+#endif /* NMEAREPLAY_H_ */
@@ -0,0 +1,193 @@
+/**
+ *	@file NmeaSharedRing.h
+ *	@brief Types shared by NmeaSharedRingWriter and NmeaSharedRingReader
+ *
+ *   Ring of decoded records in POSIX shared memory, one writer process,
+ *   any number of reader processes.
+ *
+ *   The shared memory object is a 128 byte header followed by slotCount
+ *   slots. A slot is a sequence word, a word holding the record type and
+ *   size, a timestamp word and the record itself, padded to a multiple of
+ *   64 bytes so neighbour slots do not share a cache line. Every word is a
+ *   std::atomic<uint64_t>, lock free and address free on every supported
+ *   target, so processes can share them.
+ *
+ *   Record n goes to slot n % slotCount. The writer sets the slot sequence
+ *   to 2n + 1 while copying and 2n + 2 once done, then publishes head =
+ *   n + 1. Readers keep their own cursor, copy a slot and check its
+ *   sequence did not change; a reader more than slotCount records behind
+ *   head, or whose slot was overwritten while copying, has been overrun
+ *   and skips to the oldest record still in the ring. The writer never
+ *   waits for readers.
+ */
+
+#ifndef NMEASHAREDRING_H_
+#define NMEASHAREDRING_H_
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include "NmeaEnums.h"
+#include "NmeaOwnShipState.h"
+
+/**
+ * @brief Record types of the library structs.
+ */
+enum NmeaSharedRecordType
+{
+	NmeaSharedRecord_OwnShipSnapshot = 1, //!< NmeaOwnShipSnapshot
+	NmeaSharedRecord_TrackData, //!< NmeaTrackData
+	NmeaSharedRecord_PositionReportClassA, //!< AISPositionReportClassA
+	NmeaSharedRecord_BaseStationReport, //!< AISBaseStationReport
+	NmeaSharedRecord_StaticAndVoyageRelatedData, //!< AISStaticAndVoyageRelatedData
+	NmeaSharedRecord_StandardClassBCSPositionReport, //!< AISStandardClassBCSPositionReport
+	NmeaSharedRecord_ExtendedClassBCSPositionReport, //!< AISExtendedClassBCSPositionReport
+	NmeaSharedRecord_StaticDataReport, //!< AISStaticDataReport
+	NmeaSharedRecord_AidToNavigationReport, //!< AISAidToNavigationReport
+	NmeaSharedRecord_User = 0x10000 //!< First type free for application records
+};
+
+/**
+ * @brief Record type of a struct, specialized for the library structs.
+ *
+ * Applications publishing their own trivially copyable structs specialize
+ * it with types from NmeaSharedRecord_User.
+ */
+template<typename T>
+struct NmeaSharedRecordTraits;
+
+/**
+ * @brief NmeaOwnShipSnapshot record type
+ */
+template<>
+struct NmeaSharedRecordTraits<NmeaOwnShipSnapshot>
+{
+	static const uint32_t type = NmeaSharedRecord_OwnShipSnapshot; //!< Record type
+};
+
+/**
+ * @brief NmeaTrackData record type
+ */
+template<>
+struct NmeaSharedRecordTraits<NmeaTrackData>
+{
+	static const uint32_t type = NmeaSharedRecord_TrackData; //!< Record type
+};
+
+/**
+ * @brief AISPositionReportClassA record type
+ */
+template<>
+struct NmeaSharedRecordTraits<AISPositionReportClassA>
+{
+	static const uint32_t type = NmeaSharedRecord_PositionReportClassA; //!< Record type
+};
+
+/**
+ * @brief AISBaseStationReport record type
+ */
+template<>
+struct NmeaSharedRecordTraits<AISBaseStationReport>
+{
+	static const uint32_t type = NmeaSharedRecord_BaseStationReport; //!< Record type
+};
+
+/**
+ * @brief AISStaticAndVoyageRelatedData record type
+ */
+template<>
+struct NmeaSharedRecordTraits<AISStaticAndVoyageRelatedData>
+{
+	static const uint32_t type = NmeaSharedRecord_StaticAndVoyageRelatedData; //!< Record type
+};
+
+/**
+ * @brief AISStandardClassBCSPositionReport record type
+ */
+template<>
+struct NmeaSharedRecordTraits<AISStandardClassBCSPositionReport>
+{
+	static const uint32_t type = NmeaSharedRecord_StandardClassBCSPositionReport; //!< Record type
+};
+
+/**
+ * @brief AISExtendedClassBCSPositionReport record type
+ */
+template<>
+struct NmeaSharedRecordTraits<AISExtendedClassBCSPositionReport>
+{
+	static const uint32_t type = NmeaSharedRecord_ExtendedClassBCSPositionReport; //!< Record type
+};
+
+/**
+ * @brief AISStaticDataReport record type
+ */
+template<>
+struct NmeaSharedRecordTraits<AISStaticDataReport>
+{
+	static const uint32_t type = NmeaSharedRecord_StaticDataReport; //!< Record type
+};
+
+/**
+ * @brief AISAidToNavigationReport record type
+ */
+template<>
+struct NmeaSharedRecordTraits<AISAidToNavigationReport>
+{
+	static const uint32_t type = NmeaSharedRecord_AidToNavigationReport; //!< Record type
+};
+
+/**
+ * @brief Record read from a ring.
+ */
+struct NmeaSharedRecord
+{
+	uint64_t sequence; //!< Position of the record in the ring, gaps are overruns
+	uint32_t type; //!< NmeaSharedRecordType or application type
+	uint32_t size; //!< Bytes of the record
+	int64_t timestamp; //!< Time given by the writer
+	std::vector<uint64_t> data; //!< Record bytes, 8 byte aligned
+
+	/**
+	 * @brief Copies the record into a struct of its type
+	 *
+	 * @param [out] record Struct
+	 *
+	 * @return False if the record is of another type or size.
+	 */
+	template<typename T>
+	bool get(T& record) const
+	{
+		static_assert(std::is_trivially_copyable<T>::value,
+				"Shared ring records must be trivially copyable");
+		if (type != NmeaSharedRecordTraits<T>::type || size != sizeof(T))
+		{
+			return false;
+		}
+		std::memcpy(&record, data.data(), sizeof(T));
+		return true;
+	}
+};
+
+/**
+ * @brief Shared memory header, at offset 0.
+ */
+struct NmeaSharedRingHeader
+{
+	char magic[8]; //!< "NMEASHR1", written last by the writer
+	uint32_t recordWords; //!< Largest record in 64 bit words
+	uint32_t slotWords; //!< Slot stride in 64 bit words
+	uint64_t slotCount; //!< Number of slots
+	uint64_t reserved[5]; //!< Zero
+	std::atomic<uint64_t> head; //!< Number of records published, on its own cache line
+	uint64_t padding[7]; //!< Zero
+};
+
+/**
+ * @brief Words of a slot before the record
+ */
+const uint32_t NMEA_SHARED_RING_SLOT_HEADER = 3;
+
+#endif /* NMEASHAREDRING_H_ */
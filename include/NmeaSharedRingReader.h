@@ -0,0 +1,93 @@
+/**
+ *	@file NmeaSharedRingReader.h
+ *	@brief Header for NmeaSharedRingReader class
+ *
+ *   Reads decoded records published by another process through shared memory.
+ */
+
+#ifndef NMEASHAREDRINGREADER_H_
+#define NMEASHAREDRINGREADER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <boost/noncopyable.hpp>
+#include "NmeaSharedRing.h"
+
+/**
+ * @brief Reader of a shared memory ring, layout in NmeaSharedRing.h.
+ *
+ * Every reader has its own cursor and maps the ring read only, so readers
+ * do not slow down the writer or each other. A reader that falls more than
+ * the ring size behind skips to the oldest record still there; the records
+ * skipped are counted by overruns() and show as a gap in
+ * NmeaSharedRecord::sequence.
+ */
+class NmeaSharedRingReader: private boost::noncopyable
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	NmeaSharedRingReader();
+
+	/**
+	 * @brief Destructor, unmaps the ring
+	 */
+	~NmeaSharedRingReader();
+
+	/**
+	 * @brief Maps a ring, the cursor starts after the last record published
+	 *
+	 * @param [in] name Shared memory object name given to NmeaSharedRingWriter::create()
+	 *
+	 * @return False if there is no such ring or it is not initialized yet.
+	 */
+	bool open(const std::string& name);
+
+	/**
+	 * @brief Unmaps the ring
+	 */
+	void close();
+
+	/**
+	 * @brief Reads the record at the cursor and moves past it
+	 *
+	 * @param [out] record Record, its data buffer is reused between calls
+	 *
+	 * @return False if no new record was published.
+	 */
+	bool next(NmeaSharedRecord& record);
+
+	/**
+	 * @brief Moves the cursor to the oldest record still in the ring
+	 */
+	void rewind();
+
+	/**
+	 * @brief Records published and not read yet, overruns included
+	 *
+	 * @return Records behind the writer.
+	 */
+	uint64_t pending() const;
+
+	/**
+	 * @brief Records lost because the writer overwrote them before they were read
+	 *
+	 * @return Overrun records since open().
+	 */
+	uint64_t overruns() const;
+
+private:
+	/**
+	 * @brief Private Implementation
+	 */
+	class impl;
+
+	const NmeaSharedRingHeader* header; //!< Mapping, nullptr if closed
+	std::size_t mappedBytes; //!< Mapping length
+	uint64_t cursor; //!< Sequence of the next record to read
+	uint64_t lost; //!< Overrun records
+};
+
+#endif /* NMEASHAREDRINGREADER_H_ */
@@ -0,0 +1,115 @@
+/**
+ *	@file NmeaSharedRingWriter.h
+ *	@brief Header for NmeaSharedRingWriter class
+ *
+ *   Publishes decoded records to other processes through shared memory.
+ */
+
+#ifndef NMEASHAREDRINGWRITER_H_
+#define NMEASHAREDRINGWRITER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <boost/noncopyable.hpp>
+#include "NmeaSharedRing.h"
+
+/**
+ * @brief Single writer of a shared memory ring, layout in NmeaSharedRing.h.
+ *
+ * The ingest process parses once and publishes every decoded struct;
+ * readers in other processes get them without parsing. Publishing copies
+ * the record into the next slot and never blocks: readers too slow to keep
+ * up lose the oldest records and see it in their overrun counter.
+ */
+class NmeaSharedRingWriter: private boost::noncopyable
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	NmeaSharedRingWriter();
+
+	/**
+	 * @brief Destructor, unmaps the ring and leaves it to the readers
+	 */
+	~NmeaSharedRingWriter();
+
+	/**
+	 * @brief Creates a ring, replacing one of the same name
+	 *
+	 * Readers of a replaced ring keep the old one and see no new record.
+	 *
+	 * @param [in] name Shared memory object name, "/name"
+	 * @param [in] slotCount Number of records kept
+	 * @param [in] recordBytes Largest record published
+	 *
+	 * @return False if the shared memory object cannot be created.
+	 */
+	bool create(const std::string& name, uint64_t slotCount = 65536,
+			std::size_t recordBytes = 256);
+
+	/**
+	 * @brief Unmaps the ring, readers can still read it
+	 */
+	void close();
+
+	/**
+	 * @brief Removes a ring name, the memory is freed once every process unmapped it
+	 *
+	 * @param [in] name Shared memory object name
+	 *
+	 * @return False if there is no such ring.
+	 */
+	static bool remove(const std::string& name);
+
+	/**
+	 * @brief Publishes a record
+	 *
+	 * @param [in] type NmeaSharedRecordType or application type
+	 * @param [in] data Record bytes
+	 * @param [in] size Bytes, at most the record size given to create()
+	 * @param [in] timestamp Time passed to the readers
+	 *
+	 * @return False if the ring is not open or the record too large.
+	 */
+	bool publish(uint32_t type, const void* data, std::size_t size,
+			int64_t timestamp = 0);
+
+	/**
+	 * @brief Publishes a struct with a NmeaSharedRecordTraits specialization
+	 *
+	 * @param [in] record Struct
+	 * @param [in] timestamp Time passed to the readers
+	 *
+	 * @return False if the ring is not open or the record too large.
+	 */
+	template<typename T>
+	bool publish(const T& record, int64_t timestamp = 0)
+	{
+		static_assert(std::is_trivially_copyable<T>::value,
+				"Shared ring records must be trivially copyable");
+		return publish(NmeaSharedRecordTraits<T>::type, &record, sizeof(T),
+				timestamp);
+	}
+
+	/**
+	 * @brief Records published
+	 *
+	 * @return Sequence of the next record.
+	 */
+	uint64_t published() const;
+
+private:
+	/**
+	 * @brief Private Implementation
+	 */
+	class impl;
+
+	NmeaSharedRingHeader* header; //!< Mapping, nullptr if closed
+	std::size_t mappedBytes; //!< Mapping length
+	uint64_t head; //!< Next sequence, only this writer changes it
+};
+
+#endif /* NMEASHAREDRINGWRITER_H_ */
@@ -0,0 +1,99 @@
+/**
+ *	@file NmeaTimeExtractor.h
+ *	@brief Header for NmeaTimeExtractor class
+ *
+ *   Extracts the UTC time of NMEA log lines.
+ */
+
+#ifndef NMEATIMEEXTRACTOR_H_
+#define NMEATIMEEXTRACTOR_H_
+
+#include <cstdint>
+#include <boost/utility/string_ref.hpp>
+
+/**
+ * @brief UTC time of NMEA log lines, in milliseconds since the UNIX epoch.
+ *
+ * Sources, first match wins:
+ *
+ * - TAG block @c c: field, UNIX time in seconds, or milliseconds when it
+ *   has more than 11 digits.
+ * - Receive time written by the logger before the sentence, UNIX time in
+ *   seconds with optional decimals, or milliseconds when it has more than
+ *   11 digits, followed by a space, tab, comma or semicolon.
+ * - ZDA and RMC time and date fields, the same ones read by
+ *   NmeaParser::parseZDA() and NmeaParser::parseRMC().
+ * - GGA time field, with the date carried from the last time seen. A
+ *   time of day more than 12 hours before the previous one is taken as
+ *   the next day.
+ *
+ * Fields are read in place, without copying the line or going through the
+ * regular expressions of NmeaParser, so the extractor can run over every
+ * line of a large log. Lines with a checksum that does not match are
+ * ignored. The extractor is stateful because of the carried date: use one
+ * per stream.
+ */
+class NmeaTimeExtractor
+{
+public:
+	/**
+	 * @brief Constructor, no date known
+	 */
+	NmeaTimeExtractor();
+
+	/**
+	 * @brief Extracts the time of a line
+	 *
+	 * @param [in] line Line without terminator, with or without TAG block or receive time
+	 * @param [out] timestamp Milliseconds since the UNIX epoch
+	 *
+	 * @return False if the line carries no time, or only a time of day and no date is known yet.
+	 */
+	bool extract(boost::string_ref line, int64_t& timestamp);
+
+	/**
+	 * @brief Sentence part of a log line, what NmeaParser reads
+	 *
+	 * @param [in] line Line without terminator
+	 *
+	 * @return The line from its TAG block or sentence on, without the receive time written by a logger.
+	 */
+	static boost::string_ref sentence(boost::string_ref line);
+
+	/**
+	 * @brief Sets the date and time carried to following time of day only sentences
+	 *
+	 * @param [in] timestamp Milliseconds since the UNIX epoch
+	 */
+	void setReference(int64_t timestamp);
+
+	/**
+	 * @brief Last time extracted or set
+	 *
+	 * @return Milliseconds since the UNIX epoch.
+	 */
+	int64_t reference() const;
+
+	/**
+	 * @brief Whether a date is known
+	 *
+	 * @return True once a dated time was extracted or set.
+	 */
+	bool hasDate() const;
+
+	/**
+	 * @brief Forgets the carried date
+	 */
+	void reset();
+
+private:
+	/**
+	 * @brief Private Implementation
+	 */
+	class impl;
+
+	int64_t last; //!< Last time, milliseconds since the UNIX epoch
+	bool dated; //!< True if last holds a date
+};
+
+#endif /* NMEATIMEEXTRACTOR_H_ */
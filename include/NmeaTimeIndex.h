@@ -0,0 +1,125 @@
+/**
+ *	@file NmeaTimeIndex.h
+ *	@brief Header for NmeaTimeIndex class
+ *
+ *   Sparse time index for seeking into large NMEA log files.
+ */
+
+#ifndef NMEATIMEINDEX_H_
+#define NMEATIMEINDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "NmeaMappedFile.h"
+#include "NmeaTimeExtractor.h"
+
+/**
+ * @brief Time index point, the offset of a line and its UTC time.
+ */
+struct NmeaTimeIndexEntry
+{
+	uint64_t offset; //!< Log offset of the line
+	int64_t timestamp; //!< Milliseconds since the UNIX epoch
+};
+
+/**
+ * @brief Sparse time index of an NMEA log file.
+ *
+ * Line times come from NmeaTimeExtractor: TAG block timestamps, ZDA, RMC
+ * and GGA. A point is recorded every @c interval milliseconds of log time,
+ * so the index stays small: one minute points over a month of logging is
+ * 43200 points, 691 KB. Points only move forward in time; lines going back
+ * in time, after a clock correction, are seeked through but not indexed.
+ *
+ * seek() binary searches the points and scans forward from the last point
+ * before the requested time, about @c interval worth of log.
+ *
+ * update() only reads lines it has not indexed yet and stops before a last
+ * line without terminator, so it can be called again after
+ * NmeaMappedFile::refresh() while a logger keeps appending. save() and
+ * load() keep the index in a sidecar file between runs.
+ */
+class NmeaTimeIndex
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param [in] interval Log time between index points in milliseconds
+	 */
+	explicit NmeaTimeIndex(int64_t interval = 60000);
+
+	/**
+	 * @brief Indexes the lines added to a log since the last update
+	 *
+	 * A log smaller than what was indexed has been truncated or rotated
+	 * and is indexed again from the start.
+	 *
+	 * @param [in] log Mapped log file
+	 *
+	 * @return Number of points added.
+	 */
+	std::size_t update(const NmeaMappedFile& log);
+
+	/**
+	 * @brief Finds the first line at or after a time
+	 *
+	 * @param [in] log Mapped log file the index was built from
+	 * @param [in] timestamp Milliseconds since the UNIX epoch
+	 *
+	 * @return Offset of the line, log size if no line is that late.
+	 */
+	uint64_t seek(const NmeaMappedFile& log, int64_t timestamp) const;
+
+	/**
+	 * @brief Index points
+	 *
+	 * @return Points in increasing offset and time.
+	 */
+	const std::vector<NmeaTimeIndexEntry>& entries() const;
+
+	/**
+	 * @brief Log bytes indexed
+	 *
+	 * @return Offset where the next update() starts.
+	 */
+	uint64_t indexedSize() const;
+
+	/**
+	 * @brief Forgets every point
+	 */
+	void clear();
+
+	/**
+	 * @brief Writes the index to a file
+	 *
+	 * @param [in] path Index file path, overwritten
+	 *
+	 * @return False on write error.
+	 */
+	bool save(const std::string& path) const;
+
+	/**
+	 * @brief Reads an index written by save()
+	 *
+	 * @param [in] path Index file path
+	 *
+	 * @return False if the file cannot be read or is not a time index.
+	 */
+	bool load(const std::string& path);
+
+private:
+	/**
+	 * @brief Private Implementation
+	 */
+	class impl;
+
+	int64_t interval; //!< Log time between points
+	uint64_t indexed; //!< Log bytes indexed
+	NmeaTimeExtractor extractor; //!< Date carried across updates
+	std::vector<NmeaTimeIndexEntry> points; //!< Index points
+};
+
+#endif /* NMEATIMEINDEX_H_ */
@@ -0,0 +1,795 @@
+/**
+ *	@file NmeaWriter.h
+ *	@brief Header for NmeaWriter class
+ *
+ *   NmeaWriter class with all serialization methods.
+ */
+
+#ifndef NMEAWRITER_H_
+#define NMEAWRITER_H_
+
+#include "NmeaParser.h"
+
+/**
+ * @brief State-less class for static methods used for writing NMEA.
+ *
+ * Every writer mirrors the NmeaParser method of the same sentence: it takes
+ * the same values, in the same order, and produces a sentence that the parser
+ * reads back. Sentences are written into a caller provided buffer including
+ * checksum, CR LF and a terminating null character. Numbers are formatted
+ * with a fixed number of decimals without locale or iostream involvement.
+ *
+ * A writer fails, returning 0 with an empty buffer, when the Talker Id is
+ * not two upper case letters or digits, a number does not fit its field,
+ * or a text holds a character reserved by NMEA 0183 (CR, LF, $ * , ! \ ^ ~
+ * or DEL), just as the parser flags such fields instead of reading them.
+ *
+ * Writers that accept @p emptyFields leave a field empty when its bit is set.
+ * Bit indexes are the same ones reported by the matching NmeaParser method,
+ * so a parse result can be passed through unchanged when relaying sentences.
+ */
+class NmeaWriter
+{
+public:
+	/**
+	 * @brief Buffer size that fits any standard sentence
+	 *
+	 * 82 characters including CR LF, plus the terminating null character.
+	 */
+	static const std::size_t maxSentenceSize = 83;
+
+	/**
+	 * @brief ZDA NMEA Message writer
+	 *
+	 * <i>Time & Date - UTC, day, month, year and local time zone</i>
+	 *
+	 * Field layout as read by NmeaParser::parseZDA().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] mtime UTC time
+	 * @param [in] day UTC Day
+	 * @param [in] month UTC Month
+	 * @param [in] year UTC Year
+	 * @param [in] localZoneHours Local time zone Hours
+	 * @param [in] localZoneMinutes Local time zone Minutes
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeZDA(char* buffer, std::size_t size,
+			const std::string& talkerId,
+			const boost::posix_time::time_duration& mtime, int day, int month,
+			int year, int localZoneHours, int localZoneMinutes,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief GLL NMEA Message writer
+	 *
+	 * <i>Geographic Position - Latitude/Longitude</i>
+	 *
+	 * Field layout as read by NmeaParser::parseGLL().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] latitude Latitude
+	 * @param [in] longitude Longitude
+	 * @param [in] mtime UTC time
+	 * @param [in] status Status
+	 * @param [in] modeIndicator Mode Indicator
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeGLL(char* buffer, std::size_t size,
+			const std::string& talkerId, double latitude, double longitude,
+			const boost::posix_time::time_duration& mtime, char status,
+			char modeIndicator,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief GGA NMEA Message writer
+	 *
+	 * <i>Global Positioning System Fix Data</i>
+	 *
+	 * Field layout as read by NmeaParser::parseGGA().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] mtime UTC time
+	 * @param [in] latitude Latitude
+	 * @param [in] longitude Longitude
+	 * @param [in] quality Quality Indicator
+	 * @param [in] numSV SVs in use
+	 * @param [in] hdop HDOP
+	 * @param [in] orthometricheight Orthometric height (MSL reference)
+	 * @param [in] geoidseparation geoid separation measured in meters
+	 * @param [in] agediffgps Age of differential GPS data record
+	 * @param [in] refid Reference station ID
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeGGA(char* buffer, std::size_t size,
+			const std::string& talkerId,
+			const boost::posix_time::time_duration& mtime, double latitude,
+			double longitude, Nmea_GPSQualityIndicator quality, int numSV,
+			double hdop, double orthometricheight, double geoidseparation,
+			double agediffgps, const std::string& refid,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief VTG NMEA Message writer
+	 *
+	 * <i>Track made good and Ground speed</i>
+	 *
+	 * Field layout as read by NmeaParser::parseVTG().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] coursetrue Course Over Ground
+	 * @param [in] coursemagnetic Course Over Ground (relative magnetic north)
+	 * @param [in] speedknots Speed in knots
+	 * @param [in] speedkph Speed in Kph
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeVTG(char* buffer, std::size_t size,
+			const std::string& talkerId, double coursetrue,
+			double coursemagnetic, double speedknots, double speedkph,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief RMC NMEA Message writer
+	 *
+	 * <i>Recommended Minimum Navigation Information</i>
+	 *
+	 * Field layout as read by NmeaParser::parseRMC().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] mtime UTC time
+	 * @param [in] latitude Latitude
+	 * @param [in] longitude Longitude
+	 * @param [in] speedknots Speed in Knots
+	 * @param [in] coursetrue Course relative to true north
+	 * @param [in] mdate UTC date
+	 * @param [in] magneticvar Magnetic variation
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeRMC(char* buffer, std::size_t size,
+			const std::string& talkerId,
+			const boost::posix_time::time_duration& mtime, double latitude,
+			double longitude, double speedknots, double coursetrue,
+			const boost::gregorian::date& mdate, double magneticvar,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief WPL NMEA Message writer
+	 *
+	 * <i>Waypoint Location</i>
+	 *
+	 * Field layout as read by NmeaParser::parseWPL().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] latitude Latitude
+	 * @param [in] longitude Longitude
+	 * @param [in] waypointName Waypoint Name
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeWPL(char* buffer, std::size_t size,
+			const std::string& talkerId, double latitude, double longitude,
+			const std::string& waypointName,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief RTE NMEA Message writer
+	 *
+	 * <i>RoutesSFI - Scanning Frequency Information</i>
+	 *
+	 * Field layout as read by NmeaParser::parseRTE().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] totalLines Total Lines
+	 * @param [in] lineCount Current Line
+	 * @param [in] messageMode Message mode
+	 * @param [in] routeIdentifier Route Identifier
+	 * @param [in] waypointNames Waypoint Names
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeRTE(char* buffer, std::size_t size,
+			const std::string& talkerId, int totalLines, int lineCount,
+			char messageMode, const std::string& routeIdentifier,
+			const std::vector<std::string>& waypointNames,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief VHW NMEA Message writer
+	 *
+	 * <i>Water speed and heading</i>
+	 *
+	 * Field layout as read by NmeaParser::parseVHW().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] headingTrue Heading degrees true
+	 * @param [in] headingMagnetic Heading magnetic true
+	 * @param [in] speedInKnots Speed in Knots
+	 * @param [in] speedInKmH Speed in Km/h
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeVHW(char* buffer, std::size_t size,
+			const std::string& talkerId, double headingTrue,
+			double headingMagnetic, double speedInKnots, double speedInKmH,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief MTW NMEA Message writer
+	 *
+	 * <i>Mean Temperature of Water</i>
+	 *
+	 * Field layout as read by NmeaParser::parseMTW().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] degrees Temperature degrees
+	 * @param [in] units Temperature Units
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeMTW(char* buffer, std::size_t size,
+			const std::string& talkerId, double degrees, char units,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief VBW NMEA Message writer
+	 *
+	 * <i>Dual Ground/Water Speed</i>
+	 *
+	 * Field layout as read by NmeaParser::parseVBW().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] longitudinalWaterSpeed Longitudinal water speed, negative means astern
+	 * @param [in] transverseWaterSpeed Transverse water speed, negative means port
+	 * @param [in] waterDataStatus Water Data Status
+	 * @param [in] longitudinalGroundSpeed Longitudinal ground speed, negative means astern
+	 * @param [in] transverseGroundSpeed Transverse ground speed, negative means port
+	 * @param [in] groundDataStatus Ground Data Status
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeVBW(char* buffer, std::size_t size,
+			const std::string& talkerId, double longitudinalWaterSpeed,
+			double transverseWaterSpeed, char waterDataStatus,
+			double longitudinalGroundSpeed, double transverseGroundSpeed,
+			char groundDataStatus,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief VLW NMEA Message writer
+	 *
+	 * <i>Distance Traveled through Water</i>
+	 *
+	 * Field layout as read by NmeaParser::parseVLW().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] totalCumulativeDistance Total cumulative distance in Nautical Miles
+	 * @param [in] distanceSinceReset Distance since reset in Nautical Miles
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeVLW(char* buffer, std::size_t size,
+			const std::string& talkerId, double totalCumulativeDistance,
+			double distanceSinceReset,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief DPT NMEA Message writer
+	 *
+	 * <i>Depth of Water</i>
+	 *
+	 * Field layout as read by NmeaParser::parseDPT().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] waterDepthRelativeToTheTransducer Water Depth Relative to transducer in meters
+	 * @param [in] offsetFromTransducer Offset from transducer
+	 * @param [in] maximumRangeScaleInUse Maximum range scale in use
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeDPT(char* buffer, std::size_t size,
+			const std::string& talkerId,
+			double waterDepthRelativeToTheTransducer,
+			double offsetFromTransducer, double maximumRangeScaleInUse,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief DBT NMEA Message writer
+	 *
+	 * <i>Depth below transducer</i>
+	 *
+	 * Field layout as read by NmeaParser::parseDBT().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] waterDepthInFeet Water Depth in Feet
+	 * @param [in] waterDepthInMeters Water Depth in Meters
+	 * @param [in] waterDepthInFathoms Water Depth in Fathoms
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeDBT(char* buffer, std::size_t size,
+			const std::string& talkerId, double waterDepthInFeet,
+			double waterDepthInMeters, double waterDepthInFathoms,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief DBK NMEA Message writer
+	 *
+	 * <i>Depth Below Keel</i>
+	 *
+	 * Field layout as read by NmeaParser::parseDBK().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] depthBelowKeelFeet Depth below Keel in Feet
+	 * @param [in] depthBelowKeelMeters Depth below Keel in Meter
+	 * @param [in] depthBelowKeelFathoms Depth below Keel in Fathoms
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeDBK(char* buffer, std::size_t size,
+			const std::string& talkerId, double depthBelowKeelFeet,
+			double depthBelowKeelMeters, double depthBelowKeelFathoms,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief PSKPDPT NMEA Message writer
+	 *
+	 * <i>SKIPPER proprietary sentence for multiple transducers installation</i>
+	 *
+	 * Field layout as read by NmeaParser::parsePSKPDPT().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] waterDepthRelativeToTheTransducer Water Depth Relative to the Transducer
+	 * @param [in] offsetFromTransducer Offset from Transducer
+	 * @param [in] maximumRangeScaleInUse Maximum Range Scale in Use
+	 * @param [in] bottomEchoStrength Bottom Echo Strength
+	 * @param [in] echoSounderChannelNumber Echo Sounder Channel Number
+	 * @param [in] transducerLocation Transducer Location
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writePSKPDPT(char* buffer, std::size_t size,
+			double waterDepthRelativeToTheTransducer,
+			double offsetFromTransducer, double maximumRangeScaleInUse,
+			int bottomEchoStrength, int echoSounderChannelNumber,
+			const std::string& transducerLocation,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief HDT NMEA Message writer
+	 *
+	 * <i>Heading - 1</i>
+	 *
+	 * Field layout as read by NmeaParser::parseHDT().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] headingDegreesTrue Heading degrees relative to true north
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeHDT(char* buffer, std::size_t size,
+			const std::string& talkerId, double headingDegreesTrue,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief HDG NMEA Message writer
+	 *
+	 * <i>Heading - Deviation & Variation</i>
+	 *
+	 * Field layout as read by NmeaParser::parseHDG().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] magneticSensorHeadingInDegrees Magnetic Sensor Heading in Degrees
+	 * @param [in] magneticDeviationDegrees Magnetic Deviation Degrees
+	 * @param [in] magneticDeviationDirection Magnetic Deviation Direction
+	 * @param [in] magneticVariationDegrees Magnetic Variation Degrees
+	 * @param [in] magneticVariationDirection Magnetic Variation Direction
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeHDG(char* buffer, std::size_t size,
+			const std::string& talkerId, double magneticSensorHeadingInDegrees,
+			double magneticDeviationDegrees, char magneticDeviationDirection,
+			double magneticVariationDegrees, char magneticVariationDirection,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief HDM NMEA Message writer
+	 *
+	 * <i>Heading - Magnetic</i>
+	 *
+	 * Field layout as read by NmeaParser::parseHDM().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] headingDegreesMagnetic Heading Degrees relative to magnetic North
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeHDM(char* buffer, std::size_t size,
+			const std::string& talkerId, double headingDegreesMagnetic,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief ROT NMEA Message writer
+	 *
+	 * <i>Rate Of Turn</i>
+	 *
+	 * Field layout as read by NmeaParser::parseROT().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] rateOfTurn Rate of Turn, Degrees per minute. Negative means to port.
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeROT(char* buffer, std::size_t size,
+			const std::string& talkerId, double rateOfTurn,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief MWV NMEA Message writer
+	 *
+	 * <i>Wind Speed and Angle</i>
+	 *
+	 * Field layout as read by NmeaParser::parseMWV().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] windAngle Wind Angle in degrees
+	 * @param [in] reference Reference True or Relative
+	 * @param [in] windSpeed Wind Speed
+	 * @param [in] windSpeedUnits Wind Speed Units
+	 * @param [in] sensorStatus Sensor Status
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeMWV(char* buffer, std::size_t size,
+			const std::string& talkerId, double windAngle,
+			Nmea_AngleReference reference, double windSpeed,
+			char windSpeedUnits, char sensorStatus,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief MWD NMEA Message writer
+	 *
+	 * <i>Wind Direction & Speed</i>
+	 *
+	 * Field layout as read by NmeaParser::parseMWD().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] trueWindDirection Wind Direction in Degrees relative to True North.
+	 * @param [in] magneticWindDirection Wind Direction in Degrees relative to Magnetic North.
+	 * @param [in] windSpeedKnots Wind Speed in Knots.
+	 * @param [in] windSpeedMeters Wind Speed in Meters per second.
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeMWD(char* buffer, std::size_t size,
+			const std::string& talkerId, double trueWindDirection,
+			double magneticWindDirection, double windSpeedKnots,
+			double windSpeedMeters,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief XDR NMEA Message writer
+	 *
+	 * <i>Transducer Measurement</i>
+	 *
+	 * Field layout as read by NmeaParser::parseXDR().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] measurements Vector of measurements. Each item have Transducer Type, Measurement Data, Units and Name of Transducer.
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeXDR(char* buffer, std::size_t size,
+			const std::string& talkerId,
+			const std::vector<TransducerMeasurement>& measurements);
+
+	/**
+	 * @brief TTM NMEA Message writer
+	 *
+	 * <i>Tracked Target Message</i>
+	 *
+	 * Field layout as read by NmeaParser::parseTTM().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] targetNumber Target Number
+	 * @param [in] targetDistance Distance to Target
+	 * @param [in] targetBearing Bearing to Target
+	 * @param [in] targetBearingReference Relative or True North Reference
+	 * @param [in] targetSpeed Target Speed
+	 * @param [in] targetCourse Target Course
+	 * @param [in] targetCourseReference Relative or True North Reference
+	 * @param [in] speedDistanceUnits Speed and Distance Units
+	 * @param [in] targetName Target Name
+	 * @param [in] targetStatus Target Status
+	 * @param [in] timeOfData Time of acquisition
+	 * @param [in] typeOfAcquisition Type of acquisition
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeTTM(char* buffer, std::size_t size,
+			const std::string& talkerId, int targetNumber,
+			double targetDistance, double targetBearing,
+			Nmea_AngleReference targetBearingReference, double targetSpeed,
+			double targetCourse, Nmea_AngleReference targetCourseReference,
+			Nmea_SpeedDistanceUnits speedDistanceUnits,
+			const std::string& targetName, Nmea_TargetStatus targetStatus,
+			const boost::posix_time::time_duration& timeOfData,
+			Nmea_TypeOfAcquisition typeOfAcquisition,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief TTD NMEA Message writer
+	 *
+	 * <i>Tracked Target Data</i>
+	 *
+	 * Field layout as read by NmeaParser::parseTTD().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] totalLines Total lines needed to transfer the binary message
+	 * @param [in] lineCount Current line sentence number
+	 * @param [in] sequenceIdentifier Sequence identifier
+	 * @param [in] trackData Encapsulated tracked target data
+	 * @param [in] fillBits Number of fill-bits, 0 to 5
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeTTD(char* buffer, std::size_t size,
+			const std::string& talkerId, int totalLines, int lineCount,
+			int sequenceIdentifier, const std::string& trackData, int fillBits,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief TLB NMEA Message writer
+	 *
+	 * <i>Target Label</i>
+	 *
+	 * Field layout as read by NmeaParser::parseTLB().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] trackNumbernLabel Vector of Pairs with Target Number and Target Label
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeTLB(char* buffer, std::size_t size,
+			const std::string& talkerId,
+			const std::vector<std::pair<int, std::string>>& trackNumbernLabel);
+
+	/**
+	 * @brief OSD NMEA Message writer
+	 *
+	 * <i>Own ship data</i>
+	 *
+	 * Field layout as read by NmeaParser::parseOSD().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] heading Degrees from True North
+	 * @param [in] status Data Validity
+	 * @param [in] vesselCourse Ship Course
+	 * @param [in] referenceCourse Course Relative or True North Reference
+	 * @param [in] vesselSpeed Ship Speed
+	 * @param [in] referenceSpeed Reference Speed
+	 * @param [in] vesselSet Vessel Set
+	 * @param [in] vesselDrift Vessel Drift (Speed)
+	 * @param [in] speedUnits Speed Units
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeOSD(char* buffer, std::size_t size,
+			const std::string& talkerId, double heading, char status,
+			double vesselCourse, char referenceCourse, double vesselSpeed,
+			char referenceSpeed, double vesselSet, double vesselDrift,
+			char speedUnits,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief RSD NMEA Message writer
+	 *
+	 * <i>RADAR System Data</i>
+	 *
+	 * Field layout as read by NmeaParser::parseRSD().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] origin1Range Original range from own ship
+	 * @param [in] origin1BearingDegrees Original bearing degrees from 0
+	 * @param [in] variableRangeMarker1 Variable range marker 1 range
+	 * @param [in] bearingLine1 Bearing Line 1(EBL1) degrees from 0
+	 * @param [in] origin2Range Origin2 range
+	 * @param [in] origin2Bearing Origin2 bearing
+	 * @param [in] vrm2 VRM2, range
+	 * @param [in] ebl2 EBL2 degrees
+	 * @param [in] cursorRange Cursor range, from own ship
+	 * @param [in] cursorBearing Cursor bearing, degrees CW from 0
+	 * @param [in] rangeScale range scale (maximum)
+	 * @param [in] rangeUnits range units, K/N/S
+	 * @param [in] displayRotation display rotation
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeRSD(char* buffer, std::size_t size,
+			const std::string& talkerId, double origin1Range,
+			double origin1BearingDegrees, double variableRangeMarker1,
+			double bearingLine1, double origin2Range, double origin2Bearing,
+			double vrm2, double ebl2, double cursorRange, double cursorBearing,
+			double rangeScale, char rangeUnits, char displayRotation,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief VDM NMEA Message writer
+	 *
+	 * <i>AIS VHF data-link message</i>
+	 *
+	 * Field layout as read by NmeaParser::parseVDM().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] totalLines Total lines needed to transfer the binary message
+	 * @param [in] lineCount Current line sentence number
+	 * @param [in] sequenceIdentifier Sequence identifier
+	 * @param [in] aisChannel AIS Channel
+	 * @param [in] encodedData Encapsulated tracked target data
+	 * @param [in] fillBits Number of fill-bits, 0 to 5
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeVDM(char* buffer, std::size_t size,
+			const std::string& talkerId, int totalLines, int lineCount,
+			int sequenceIdentifier, char aisChannel,
+			const std::string& encodedData, int fillBits,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief VDO NMEA Message writer
+	 *
+	 * <i>AIS VHF data-link own-vessel report</i>
+	 *
+	 * Field layout as read by NmeaParser::parseVDO().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] talkerId Talker Id, two upper case letters or digits
+	 * @param [in] totalLines Total lines needed to transfer the binary message
+	 * @param [in] lineCount Current line sentence number
+	 * @param [in] sequenceIdentifier Sequence identifier
+	 * @param [in] aisChannel AIS Channel
+	 * @param [in] encodedData Encapsulated tracked target data
+	 * @param [in] fillBits Number of fill-bits, 0 to 5
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writeVDO(char* buffer, std::size_t size,
+			const std::string& talkerId, int totalLines, int lineCount,
+			int sequenceIdentifier, char aisChannel,
+			const std::string& encodedData, int fillBits,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief PRDID NMEA Message writer
+	 *
+	 * <i>Proprietary Heading, Pitch, Roll</i>
+	 *
+	 * Field layout as read by NmeaParser::parsePRDID().
+	 *
+	 * @param [out] buffer Buffer receiving the sentence
+	 * @param [in] size Size of the buffer
+	 * @param [in] pitch Is the up/down rotation of a vessel about its lateral/Y (side-to-side or port-starboard) axis.
+	 * @param [in] roll Is the tilting rotation of a vessel about its longitudinal/X (front-back or bow-stern) axis.
+	 * @param [in] heading Is the north direction of a vessel.
+	 * @param [in] emptyFields Fields written empty, same bit indexes as the parser result
+	 *
+	 * @return Length of the sentence, 0 if the buffer is too small or a value cannot be written.
+	 */
+	static std::size_t writePRDID(char* buffer, std::size_t size, double pitch,
+			double roll, double heading,
+			const NmeaParserResult& emptyFields = NmeaParserResult());
+
+	/**
+	 * @brief Replaces the Talker Id of a sentence and updates its checksum
+	 *
+	 * The checksum is patched with the difference between both Talker Ids,
+	 * so the rest of the sentence is not read again. Proprietary sentences
+	 * have no Talker Id and are left unchanged.
+	 *
+	 * @param [in,out] nmea String with NMEA Sentence
+	 * @param [in] talkerId New Talker Id, two upper case letters or digits
+	 *
+	 * @return True on success.
+	 */
+	static bool rewriteTalkerId(std::string& nmea, const std::string& talkerId);
+
+private:
+	class impl;
+
+	/**
+	 * @brief Private constructor. Prevents creating of class instance.
+	 */
+	NmeaWriter();
+
+};
+
+#endif /* NMEAWRITER_H_ */
@@ -0,0 +1,583 @@
+/**
+ *	@file AISArchiveReader.cpp
+ *	@brief AISArchiveReader Implementation
+ */
+
+#include "AISArchiveReader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define AIS_ARCHIVE_AVX2
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Private Implementation
+ */
+class AISArchiveReader::impl
+{
+public:
+	/**
+	 * @brief Decoded columns of a block
+	 */
+	struct Columns
+	{
+		std::vector<uint> mmsi; //!< MMSI
+		std::vector<int64_t> timestamp; //!< Time
+		std::vector<int32_t> longitude; //!< Longitude in 1/600000 degree
+		std::vector<int32_t> latitude; //!< Latitude in 1/600000 degree
+		std::vector<uint16_t> speedOverGround; //!< Speed in 0.1 knot
+		std::vector<uint16_t> courseOverGround; //!< Course in 0.1 degree
+		std::vector<uint16_t> trueHeading; //!< Heading
+	};
+
+	/**
+	 * @brief Converts a query border to 1/600000 degree
+	 *
+	 * @param [in] value Degrees, clamped to [-200, 200]
+	 *
+	 * @return Wire units.
+	 */
+	static int32_t toWire(float value);
+
+	/**
+	 * @brief Reads the header of a block
+	 *
+	 * @param [in] reader Reader holding the mapped file
+	 * @param [in] block Block index
+	 * @param [out] header Block header
+	 */
+	static void header(const AISArchiveReader& reader, std::size_t block,
+			AISArchiveBlockHeader& header);
+
+	/**
+	 * @brief Start of a column
+	 *
+	 * @param [in] reader Reader holding the mapped file
+	 * @param [in] block Block index
+	 * @param [in] header Block header
+	 * @param [in] column Column
+	 *
+	 * @return First byte of the column.
+	 */
+	static const uint8_t* column(const AISArchiveReader& reader,
+			std::size_t block, const AISArchiveBlockHeader& header,
+			AISArchiveColumn column);
+
+	/**
+	 * @brief Decodes a varint column of deltas
+	 *
+	 * @param [in] begin First byte
+	 * @param [in] end One past the last byte
+	 * @param [in] count Number of values
+	 * @param [in] zigzag True for signed deltas
+	 * @param [in] start Value the first delta applies to
+	 * @param [out] values Decoded values
+	 *
+	 * @return False if the column is corrupt.
+	 */
+	template<typename T>
+	static bool decodeDeltas(const uint8_t* begin, const uint8_t* end,
+			std::size_t count, bool zigzag, int64_t start,
+			std::vector<T>& values);
+
+	/**
+	 * @brief Decodes a bit-packed column
+	 *
+	 * @param [in] begin First byte
+	 * @param [in] count Number of values
+	 * @param [in] bits Bits per value
+	 * @param [in] base Value added to every offset
+	 * @param [out] values Decoded values
+	 */
+	static void decodePacked(const uint8_t* begin, std::size_t count,
+			uint8_t bits, uint16_t base, std::vector<uint16_t>& values);
+
+	/**
+	 * @brief Decodes the columns of a block
+	 *
+	 * @param [in] reader Reader holding the mapped file
+	 * @param [in] block Block index
+	 * @param [in] positions Decode longitude and latitude
+	 * @param [in] others Decode every other column
+	 * @param [out] columns Decoded columns
+	 *
+	 * @return False if the block is corrupt.
+	 */
+	static bool decode(const AISArchiveReader& reader, std::size_t block,
+			bool positions, bool others, Columns& columns);
+
+	/**
+	 * @brief Appends a decoded row
+	 *
+	 * @param [in] columns Decoded columns
+	 * @param [in] row Row index
+	 * @param [out] records Output
+	 */
+	static void emit(const Columns& columns, std::size_t row,
+			std::vector<AISArchiveRecord>& records);
+
+	/**
+	 * @brief Finds the rows inside a box
+	 *
+	 * @param [in] longitude Longitudes
+	 * @param [in] latitude Latitudes
+	 * @param [in] begin First row
+	 * @param [in] end One past the last row
+	 * @param [in] bounds West, South, East and North borders in 1/600000 degree
+	 * @param [out] rows Matching row indexes, appended
+	 */
+	static void filterScalar(const int32_t* longitude, const int32_t* latitude,
+			std::size_t begin, std::size_t end, const int32_t* bounds,
+			std::vector<uint>& rows);
+
+#ifdef AIS_ARCHIVE_AVX2
+	/**
+	 * @brief Finds the rows inside a box, eight at a time
+	 *
+	 * @param [in] longitude Longitudes
+	 * @param [in] latitude Latitudes
+	 * @param [in] count Number of rows
+	 * @param [in] bounds West, South, East and North borders in 1/600000 degree
+	 * @param [out] rows Matching row indexes, appended
+	 *
+	 * @return Number of rows checked, a multiple of eight.
+	 */
+	static std::size_t filterAVX2(const int32_t* longitude,
+			const int32_t* latitude, std::size_t count, const int32_t* bounds,
+			std::vector<uint>& rows);
+#endif
+
+	/**
+	 * @brief Whether the CPU supports AVX2
+	 *
+	 * @return True if supported.
+	 */
+	static bool avx2Supported();
+};
+
+int32_t AISArchiveReader::impl::toWire(float value)
+{
+	const double degrees = std::min(std::max(static_cast<double>(value), -200.0),
+			200.0);
+	return static_cast<int32_t>(std::lround(degrees * 600000.0));
+}
+
+void AISArchiveReader::impl::header(const AISArchiveReader& reader,
+		std::size_t block, AISArchiveBlockHeader& header)
+{
+	std::memcpy(&header, reader.data + reader.offsets[block], sizeof(header));
+}
+
+const uint8_t* AISArchiveReader::impl::column(const AISArchiveReader& reader,
+		std::size_t block, const AISArchiveBlockHeader& header,
+		AISArchiveColumn column)
+{
+	const uint8_t* p = reader.data + reader.offsets[block]
+			+ sizeof(AISArchiveBlockHeader);
+	for (int i = 0; i < column; ++i)
+	{
+		p += header.columnBytes[i];
+	}
+	return p;
+}
+
+template<typename T>
+bool AISArchiveReader::impl::decodeDeltas(const uint8_t* begin,
+		const uint8_t* end, std::size_t count, bool zigzag, int64_t start,
+		std::vector<T>& values)
+{
+	values.resize(count);
+	const uint8_t* p = begin;
+	int64_t value = start;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		uint64_t raw = 0;
+		uint shift = 0;
+		for (;;)
+		{
+			if (p == end || shift > 63)
+			{
+				return false;
+			}
+			const uint8_t byte = *p++;
+			raw |= static_cast<uint64_t>(byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0)
+			{
+				break;
+			}
+			shift += 7;
+		}
+		value += zigzag ?
+				static_cast<int64_t>((raw >> 1) ^ (0 - (raw & 1))) :
+				static_cast<int64_t>(raw);
+		values[i] = static_cast<T>(value);
+	}
+	return p == end;
+}
+
+void AISArchiveReader::impl::decodePacked(const uint8_t* begin,
+		std::size_t count, uint8_t bits, uint16_t base,
+		std::vector<uint16_t>& values)
+{
+	values.resize(count);
+	const uint64_t mask = (1ULL << bits) - 1;
+	const uint8_t* p = begin;
+	uint64_t accumulator = 0;
+	uint available = 0;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		while (available < bits)
+		{
+			accumulator |= static_cast<uint64_t>(*p++) << available;
+			available += 8;
+		}
+		values[i] = static_cast<uint16_t>(base + (accumulator & mask));
+		accumulator >>= bits;
+		available -= bits;
+	}
+}
+
+bool AISArchiveReader::impl::decode(const AISArchiveReader& reader,
+		std::size_t block, bool positions, bool others, Columns& columns)
+{
+	AISArchiveBlockHeader h;
+	header(reader, block, h);
+	const std::size_t count = h.records;
+
+	if (positions)
+	{
+		const uint8_t* lon = column(reader, block, h, AISArchiveColumn_Longitude);
+		const uint8_t* lat = lon + h.columnBytes[AISArchiveColumn_Longitude];
+		if (!decodeDeltas(lon, lat, count, true, 0, columns.longitude)
+				|| !decodeDeltas(lat,
+						lat + h.columnBytes[AISArchiveColumn_Latitude], count,
+						true, 0, columns.latitude))
+		{
+			return false;
+		}
+	}
+
+	if (others)
+	{
+		const uint8_t* mmsi = column(reader, block, h, AISArchiveColumn_Mmsi);
+		const uint8_t* timestamp = mmsi + h.columnBytes[AISArchiveColumn_Mmsi];
+		if (!decodeDeltas(mmsi, timestamp, count, false, 0, columns.mmsi)
+				|| !decodeDeltas(timestamp,
+						timestamp + h.columnBytes[AISArchiveColumn_Timestamp],
+						count, true, h.minTimestamp, columns.timestamp))
+		{
+			return false;
+		}
+
+		const uint8_t* speed = column(reader, block, h,
+				AISArchiveColumn_SpeedOverGround);
+		const uint8_t* course = speed
+				+ h.columnBytes[AISArchiveColumn_SpeedOverGround];
+		const uint8_t* heading = course
+				+ h.columnBytes[AISArchiveColumn_CourseOverGround];
+		decodePacked(speed, count, h.speedBits, h.minSpeed,
+				columns.speedOverGround);
+		decodePacked(course, count, h.courseBits, h.minCourse,
+				columns.courseOverGround);
+		decodePacked(heading, count, h.headingBits, h.minHeading,
+				columns.trueHeading);
+	}
+
+	return true;
+}
+
+void AISArchiveReader::impl::emit(const Columns& columns, std::size_t row,
+		std::vector<AISArchiveRecord>& records)
+{
+	AISArchiveRecord record;
+	record.mmsi = columns.mmsi[row];
+	record.timestamp = columns.timestamp[row];
+	record.longitude = static_cast<float>(columns.longitude[row] / 600000.0);
+	record.latitude = static_cast<float>(columns.latitude[row] / 600000.0);
+	record.speedOverGround = columns.speedOverGround[row] / 10.0f;
+	record.courseOverGround = columns.courseOverGround[row] / 10.0f;
+	record.trueHeading = columns.trueHeading[row];
+	records.push_back(record);
+}
+
+void AISArchiveReader::impl::filterScalar(const int32_t* longitude,
+		const int32_t* latitude, std::size_t begin, std::size_t end,
+		const int32_t* bounds, std::vector<uint>& rows)
+{
+	for (std::size_t i = begin; i < end; ++i)
+	{
+		if (longitude[i] >= bounds[0] && latitude[i] >= bounds[1]
+				&& longitude[i] <= bounds[2] && latitude[i] <= bounds[3])
+		{
+			rows.push_back(static_cast<uint>(i));
+		}
+	}
+}
+
+#ifdef AIS_ARCHIVE_AVX2
+__attribute__((target("avx2")))
+std::size_t AISArchiveReader::impl::filterAVX2(const int32_t* longitude,
+		const int32_t* latitude, std::size_t count, const int32_t* bounds,
+		std::vector<uint>& rows)
+{
+	// Inclusive borders as strict comparisons, bounds are far from the int32 limits
+	const __m256i west = _mm256_set1_epi32(bounds[0] - 1);
+	const __m256i south = _mm256_set1_epi32(bounds[1] - 1);
+	const __m256i east = _mm256_set1_epi32(bounds[2] + 1);
+	const __m256i north = _mm256_set1_epi32(bounds[3] + 1);
+
+	const std::size_t blocks = count / 8 * 8;
+	for (std::size_t i = 0; i < blocks; i += 8)
+	{
+		const __m256i lon = _mm256_loadu_si256(
+				reinterpret_cast<const __m256i*>(longitude + i));
+		const __m256i lat = _mm256_loadu_si256(
+				reinterpret_cast<const __m256i*>(latitude + i));
+		const __m256i inside = _mm256_and_si256(
+				_mm256_and_si256(_mm256_cmpgt_epi32(lon, west),
+						_mm256_cmpgt_epi32(east, lon)),
+				_mm256_and_si256(_mm256_cmpgt_epi32(lat, south),
+						_mm256_cmpgt_epi32(north, lat)));
+		uint mask = static_cast<uint>(_mm256_movemask_ps(
+				_mm256_castsi256_ps(inside)));
+		while (mask != 0)
+		{
+			rows.push_back(static_cast<uint>(i + __builtin_ctz(mask)));
+			mask &= mask - 1;
+		}
+	}
+	return blocks;
+}
+#endif
+
+bool AISArchiveReader::impl::avx2Supported()
+{
+#ifdef AIS_ARCHIVE_AVX2
+	static const bool supported = __builtin_cpu_supports("avx2");
+	return supported;
+#else
+	return false;
+#endif
+}
+
+AISArchiveReader::AISArchiveReader() :
+		data(nullptr), length(0), recordCount(0)
+{
+
+}
+
+AISArchiveReader::~AISArchiveReader()
+{
+	close();
+}
+
+bool AISArchiveReader::open(const std::string& path)
+{
+	close();
+
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+	struct stat st;
+	if (::fstat(fd, &st) != 0
+			|| st.st_size < static_cast<off_t>(sizeof(AISArchiveFileHeader)))
+	{
+		::close(fd);
+		return false;
+	}
+	void* mapped = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (mapped == MAP_FAILED)
+	{
+		return false;
+	}
+	data = static_cast<const uint8_t*>(mapped);
+	length = st.st_size;
+
+	AISArchiveFileHeader fileHeader;
+	std::memcpy(&fileHeader, data, sizeof(fileHeader));
+	if (std::memcmp(fileHeader.magic, "AISARCHV", sizeof(fileHeader.magic)) != 0
+			|| fileHeader.version != AIS_ARCHIVE_VERSION)
+	{
+		close();
+		return false;
+	}
+
+	// Index the blocks, the first incomplete or corrupt one ends the archive
+	std::size_t offset = sizeof(AISArchiveFileHeader);
+	while (length - offset >= sizeof(AISArchiveBlockHeader))
+	{
+		AISArchiveBlockHeader h;
+		std::memcpy(&h, data + offset, sizeof(h));
+		if (!isValidAISArchiveBlock(h, length - offset - sizeof(h)))
+		{
+			break;
+		}
+
+		AISArchiveBlockInfo info;
+		info.records = h.records;
+		info.minTimestamp = h.minTimestamp;
+		info.maxTimestamp = h.maxTimestamp;
+		info.minMmsi = h.minMmsi;
+		info.maxMmsi = h.maxMmsi;
+		info.minLongitude = static_cast<float>(h.minLongitude / 600000.0);
+		info.maxLongitude = static_cast<float>(h.maxLongitude / 600000.0);
+		info.minLatitude = static_cast<float>(h.minLatitude / 600000.0);
+		info.maxLatitude = static_cast<float>(h.maxLatitude / 600000.0);
+		info.maxSpeedOverGround = h.maxSpeed / 10.0f;
+
+		offsets.push_back(offset);
+		infos.push_back(info);
+		recordCount += h.records;
+		offset += sizeof(h) + h.payloadBytes;
+	}
+
+	return true;
+}
+
+void AISArchiveReader::close()
+{
+	if (data != nullptr)
+	{
+		::munmap(const_cast<uint8_t*>(data), length);
+	}
+	data = nullptr;
+	length = 0;
+	offsets.clear();
+	infos.clear();
+	recordCount = 0;
+}
+
+std::size_t AISArchiveReader::blockCount() const
+{
+	return infos.size();
+}
+
+const AISArchiveBlockInfo& AISArchiveReader::blockInfo(std::size_t block) const
+{
+	return infos[block];
+}
+
+uint64_t AISArchiveReader::records() const
+{
+	return recordCount;
+}
+
+bool AISArchiveReader::readBlock(std::size_t block,
+		std::vector<AISArchiveRecord>& records) const
+{
+	impl::Columns columns;
+	if (!impl::decode(*this, block, true, true, columns))
+	{
+		return false;
+	}
+	for (std::size_t i = 0; i < infos[block].records; ++i)
+	{
+		impl::emit(columns, i, records);
+	}
+	return true;
+}
+
+std::size_t AISArchiveReader::scan(int64_t begin, int64_t end,
+		float minLongitude, float minLatitude, float maxLongitude,
+		float maxLatitude, std::vector<AISArchiveRecord>& records,
+		bool vectorized) const
+{
+	const int32_t bounds[4] =
+	{ impl::toWire(minLongitude), impl::toWire(minLatitude), impl::toWire(
+			maxLongitude), impl::toWire(maxLatitude) };
+
+	const std::size_t before = records.size();
+	impl::Columns columns;
+	std::vector<uint> rows;
+	for (std::size_t block = 0; block < infos.size(); ++block)
+	{
+		AISArchiveBlockHeader h;
+		impl::header(*this, block, h);
+		if (h.maxTimestamp < begin || h.minTimestamp >= end
+				|| h.maxLongitude < bounds[0] || h.maxLatitude < bounds[1]
+				|| h.minLongitude > bounds[2] || h.minLatitude > bounds[3])
+		{
+			continue;
+		}
+
+		if (!impl::decode(*this, block, true, false, columns))
+		{
+			continue;
+		}
+
+		rows.clear();
+		std::size_t done = 0;
+#ifdef AIS_ARCHIVE_AVX2
+		if (vectorized && impl::avx2Supported())
+		{
+			done = impl::filterAVX2(columns.longitude.data(),
+					columns.latitude.data(), h.records, bounds, rows);
+		}
+#else
+		(void) vectorized;
+#endif
+		impl::filterScalar(columns.longitude.data(), columns.latitude.data(),
+				done, h.records, bounds, rows);
+		if (rows.empty() || !impl::decode(*this, block, false, true, columns))
+		{
+			continue;
+		}
+
+		for (std::vector<uint>::const_iterator it = rows.begin();
+				it != rows.end(); ++it)
+		{
+			if (columns.timestamp[*it] >= begin && columns.timestamp[*it] < end)
+			{
+				impl::emit(columns, *it, records);
+			}
+		}
+	}
+
+	return records.size() - before;
+}
+
+std::size_t AISArchiveReader::scan(uint mmsi, int64_t begin, int64_t end,
+		std::vector<AISArchiveRecord>& records) const
+{
+	const std::size_t before = records.size();
+	impl::Columns columns;
+	for (std::size_t block = 0; block < infos.size(); ++block)
+	{
+		const AISArchiveBlockInfo& info = infos[block];
+		if (mmsi < info.minMmsi || mmsi > info.maxMmsi
+				|| info.maxTimestamp < begin || info.minTimestamp >= end)
+		{
+			continue;
+		}
+
+		if (!impl::decode(*this, block, true, true, columns))
+		{
+			continue;
+		}
+
+		// Rows are sorted by MMSI
+		std::vector<uint>::const_iterator first = std::lower_bound(
+				columns.mmsi.begin(), columns.mmsi.end(), mmsi);
+		for (std::size_t i = first - columns.mmsi.begin();
+				i < info.records && columns.mmsi[i] == mmsi; ++i)
+		{
+			if (columns.timestamp[i] >= begin && columns.timestamp[i] < end)
+			{
+				impl::emit(columns, i, records);
+			}
+		}
+	}
+
+	return records.size() - before;
+}
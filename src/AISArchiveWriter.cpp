@@ -0,0 +1,440 @@
+/**
+ *	@file AISArchiveWriter.cpp
+ *	@brief AISArchiveWriter Implementation
+ */
+
+#include "AISArchiveWriter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unistd.h>
+
+/**
+ * @brief Private Implementation
+ */
+class AISArchiveWriter::impl
+{
+public:
+	/**
+	 * @brief Converts degrees to 1/600000 degree
+	 *
+	 * @param [in] value Degrees
+	 *
+	 * @return Wire units.
+	 */
+	static int32_t toWire(float value);
+
+	/**
+	 * @brief Converts a value to tenths, saturated to the uint16_t range
+	 *
+	 * @param [in] value Value
+	 *
+	 * @return Tenths.
+	 */
+	static uint16_t toTenths(float value);
+
+	/**
+	 * @brief Orders rows by MMSI then time
+	 *
+	 * @param [in] a First row
+	 * @param [in] b Second row
+	 *
+	 * @return True if @p a goes first.
+	 */
+	static bool lessRow(const Row& a, const Row& b);
+
+	/**
+	 * @brief Appends an unsigned varint, 7 bits per byte, low bits first
+	 *
+	 * @param [in,out] buffer Output
+	 * @param [in] value Value
+	 */
+	static void putVarint(std::vector<uint8_t>& buffer, uint64_t value);
+
+	/**
+	 * @brief Appends a signed value as a zigzag varint
+	 *
+	 * @param [in,out] buffer Output
+	 * @param [in] value Value
+	 */
+	static void putZigzag(std::vector<uint8_t>& buffer, int64_t value);
+
+	/**
+	 * @brief Bits needed to store a value
+	 *
+	 * @param [in] value Value
+	 *
+	 * @return Bit width, 0 for 0.
+	 */
+	static uint8_t bitWidth(uint value);
+
+	/**
+	 * @brief Appends a bit-packed column of uint16_t row members
+	 *
+	 * @param [in,out] buffer Output
+	 * @param [in] rows Rows
+	 * @param [in] member Column
+	 * @param [in] base Value subtracted before packing
+	 * @param [in] bits Bits per value
+	 */
+	static void putPacked(std::vector<uint8_t>& buffer,
+			const std::vector<Row>& rows, uint16_t Row::*member, uint16_t base,
+			uint8_t bits);
+};
+
+int32_t AISArchiveWriter::impl::toWire(float value)
+{
+	return static_cast<int32_t>(std::lround(static_cast<double>(value) * 600000.0));
+}
+
+uint16_t AISArchiveWriter::impl::toTenths(float value)
+{
+	const float tenths = std::floor(value * 10.0f + 0.5f);
+	if (!(tenths > 0.0f))
+	{
+		return 0;
+	}
+	return tenths >= 65535.0f ? 65535 : static_cast<uint16_t>(tenths);
+}
+
+bool AISArchiveWriter::impl::lessRow(const Row& a, const Row& b)
+{
+	return a.mmsi < b.mmsi || (a.mmsi == b.mmsi && a.timestamp < b.timestamp);
+}
+
+void AISArchiveWriter::impl::putVarint(std::vector<uint8_t>& buffer,
+		uint64_t value)
+{
+	while (value >= 0x80)
+	{
+		buffer.push_back(static_cast<uint8_t>(value | 0x80));
+		value >>= 7;
+	}
+	buffer.push_back(static_cast<uint8_t>(value));
+}
+
+void AISArchiveWriter::impl::putZigzag(std::vector<uint8_t>& buffer,
+		int64_t value)
+{
+	putVarint(buffer,
+			(static_cast<uint64_t>(value) << 1)
+					^ static_cast<uint64_t>(value >> 63));
+}
+
+uint8_t AISArchiveWriter::impl::bitWidth(uint value)
+{
+	uint8_t bits = 0;
+	while (value != 0)
+	{
+		++bits;
+		value >>= 1;
+	}
+	return bits;
+}
+
+void AISArchiveWriter::impl::putPacked(std::vector<uint8_t>& buffer,
+		const std::vector<Row>& rows, uint16_t Row::*member, uint16_t base,
+		uint8_t bits)
+{
+	uint64_t accumulator = 0;
+	uint used = 0;
+	for (std::vector<Row>::const_iterator it = rows.begin(); it != rows.end();
+			++it)
+	{
+		accumulator |= static_cast<uint64_t>((*it).*member - base) << used;
+		used += bits;
+		while (used >= 8)
+		{
+			buffer.push_back(static_cast<uint8_t>(accumulator));
+			accumulator >>= 8;
+			used -= 8;
+		}
+	}
+	if (used > 0)
+	{
+		buffer.push_back(static_cast<uint8_t>(accumulator));
+	}
+}
+
+AISArchiveWriter::AISArchiveWriter(uint blockRecords, int64_t partition) :
+		file(nullptr), blockRecords(std::max(blockRecords, 1u)), partition(
+				partition), currentPartition(0), recordCount(0), blockCount(0)
+{
+	rows.reserve(this->blockRecords);
+}
+
+AISArchiveWriter::~AISArchiveWriter()
+{
+	close();
+}
+
+bool AISArchiveWriter::open(const std::string& path)
+{
+	close();
+
+	std::FILE* f = std::fopen(path.c_str(), "ab+");
+	if (f == nullptr)
+	{
+		return false;
+	}
+
+	AISArchiveFileHeader header;
+	std::fseek(f, 0, SEEK_END);
+	if (std::ftell(f) == 0)
+	{
+		std::memset(&header, 0, sizeof(header));
+		std::memcpy(header.magic, "AISARCHV", sizeof(header.magic));
+		header.version = AIS_ARCHIVE_VERSION;
+		if (std::fwrite(&header, sizeof(header), 1, f) != 1)
+		{
+			std::fclose(f);
+			return false;
+		}
+	}
+	else
+	{
+		std::rewind(f);
+		if (std::fread(&header, sizeof(header), 1, f) != 1
+				|| std::memcmp(header.magic, "AISARCHV", sizeof(header.magic))
+						!= 0 || header.version != AIS_ARCHIVE_VERSION)
+		{
+			std::fclose(f);
+			return false;
+		}
+
+		// Drop the tail of an interrupted writer, readers stop before it
+		// and would not see the blocks appended after it
+		std::fseek(f, 0, SEEK_END);
+		const long size = std::ftell(f);
+		long end = sizeof(header);
+		AISArchiveBlockHeader block;
+		while (size - end >= static_cast<long>(sizeof(block))
+				&& std::fseek(f, end, SEEK_SET) == 0
+				&& std::fread(&block, sizeof(block), 1, f) == 1
+				&& isValidAISArchiveBlock(block, size - end - sizeof(block)))
+		{
+			end += sizeof(block) + block.payloadBytes;
+		}
+		if (end < size && ::ftruncate(::fileno(f), end) != 0)
+		{
+			std::fclose(f);
+			return false;
+		}
+		std::fseek(f, 0, SEEK_END);
+	}
+
+	file = f;
+	recordCount = 0;
+	blockCount = 0;
+	return true;
+}
+
+bool AISArchiveWriter::append(uint mmsi, float longitude, float latitude,
+		float speedOverGround, float courseOverGround, uint trueHeading,
+		int64_t timestamp)
+{
+	if (file == nullptr)
+	{
+		return false;
+	}
+
+	const int64_t rowPartition =
+			partition > 0 ?
+					(timestamp >= 0 ?
+							timestamp / partition :
+							(timestamp + 1) / partition - 1) :
+					0;
+	if (!rows.empty() && rowPartition > currentPartition && !writeBlock())
+	{
+		return false;
+	}
+	if (rows.empty())
+	{
+		currentPartition = rowPartition;
+	}
+
+	Row row;
+	row.timestamp = timestamp;
+	row.mmsi = mmsi;
+	row.longitude = impl::toWire(longitude);
+	row.latitude = impl::toWire(latitude);
+	row.speedOverGround = impl::toTenths(speedOverGround);
+	row.courseOverGround = impl::toTenths(courseOverGround);
+	row.trueHeading = static_cast<uint16_t>(std::min(trueHeading, 65535u));
+	rows.push_back(row);
+
+	return rows.size() < blockRecords || writeBlock();
+}
+
+bool AISArchiveWriter::append(const AISPositionReportClassA& data,
+		int64_t timestamp)
+{
+	return append(data.mmsi, data.longitude, data.latitude,
+			data.speedOverGround, data.courseOverGround, data.trueHeading,
+			timestamp);
+}
+
+bool AISArchiveWriter::append(const AISStandardClassBCSPositionReport& data,
+		int64_t timestamp)
+{
+	return append(data.mmsi, data.longitude, data.latitude,
+			data.speedOverGround, data.courseOverGround, data.trueHeading,
+			timestamp);
+}
+
+bool AISArchiveWriter::append(const AISExtendedClassBCSPositionReport& data,
+		int64_t timestamp)
+{
+	return append(data.mmsi, data.longitude, data.latitude,
+			data.speedOverGround, data.courseOverGround, data.trueHeading,
+			timestamp);
+}
+
+bool AISArchiveWriter::writeBlock()
+{
+	if (rows.empty())
+	{
+		return true;
+	}
+
+	std::sort(rows.begin(), rows.end(), impl::lessRow);
+
+	AISArchiveBlockHeader header;
+	std::memset(&header, 0, sizeof(header));
+	header.magic = AIS_ARCHIVE_BLOCK_MAGIC;
+	header.records = static_cast<uint32_t>(rows.size());
+	header.minTimestamp = header.maxTimestamp = rows[0].timestamp;
+	header.minMmsi = rows[0].mmsi;
+	header.maxMmsi = rows.back().mmsi;
+	header.minLongitude = header.maxLongitude = rows[0].longitude;
+	header.minLatitude = header.maxLatitude = rows[0].latitude;
+	header.minSpeed = header.maxSpeed = rows[0].speedOverGround;
+	header.minCourse = header.maxCourse = rows[0].courseOverGround;
+	header.minHeading = header.maxHeading = rows[0].trueHeading;
+	for (std::vector<Row>::const_iterator it = rows.begin(); it != rows.end();
+			++it)
+	{
+		header.minTimestamp = std::min(header.minTimestamp, it->timestamp);
+		header.maxTimestamp = std::max(header.maxTimestamp, it->timestamp);
+		header.minLongitude = std::min(header.minLongitude, it->longitude);
+		header.maxLongitude = std::max(header.maxLongitude, it->longitude);
+		header.minLatitude = std::min(header.minLatitude, it->latitude);
+		header.maxLatitude = std::max(header.maxLatitude, it->latitude);
+		header.minSpeed = std::min(header.minSpeed, it->speedOverGround);
+		header.maxSpeed = std::max(header.maxSpeed, it->speedOverGround);
+		header.minCourse = std::min(header.minCourse, it->courseOverGround);
+		header.maxCourse = std::max(header.maxCourse, it->courseOverGround);
+		header.minHeading = std::min(header.minHeading, it->trueHeading);
+		header.maxHeading = std::max(header.maxHeading, it->trueHeading);
+	}
+	header.speedBits = impl::bitWidth(header.maxSpeed - header.minSpeed);
+	header.courseBits = impl::bitWidth(header.maxCourse - header.minCourse);
+	header.headingBits = impl::bitWidth(header.maxHeading - header.minHeading);
+
+	buffer.clear();
+	std::size_t start = 0;
+
+	// Varint columns, deltas from the previous row
+	uint previousMmsi = 0;
+	for (std::vector<Row>::const_iterator it = rows.begin(); it != rows.end();
+			++it)
+	{
+		impl::putVarint(buffer, it->mmsi - previousMmsi);
+		previousMmsi = it->mmsi;
+	}
+	header.columnBytes[AISArchiveColumn_Mmsi] = buffer.size() - start;
+	start = buffer.size();
+
+	int64_t previousTimestamp = header.minTimestamp;
+	for (std::vector<Row>::const_iterator it = rows.begin(); it != rows.end();
+			++it)
+	{
+		impl::putZigzag(buffer, it->timestamp - previousTimestamp);
+		previousTimestamp = it->timestamp;
+	}
+	header.columnBytes[AISArchiveColumn_Timestamp] = buffer.size() - start;
+	start = buffer.size();
+
+	int32_t previous = 0;
+	for (std::vector<Row>::const_iterator it = rows.begin(); it != rows.end();
+			++it)
+	{
+		impl::putZigzag(buffer, static_cast<int64_t>(it->longitude) - previous);
+		previous = it->longitude;
+	}
+	header.columnBytes[AISArchiveColumn_Longitude] = buffer.size() - start;
+	start = buffer.size();
+
+	previous = 0;
+	for (std::vector<Row>::const_iterator it = rows.begin(); it != rows.end();
+			++it)
+	{
+		impl::putZigzag(buffer, static_cast<int64_t>(it->latitude) - previous);
+		previous = it->latitude;
+	}
+	header.columnBytes[AISArchiveColumn_Latitude] = buffer.size() - start;
+	start = buffer.size();
+
+	// Bit-packed columns, offsets from the block minimum
+	impl::putPacked(buffer, rows, &Row::speedOverGround, header.minSpeed,
+			header.speedBits);
+	header.columnBytes[AISArchiveColumn_SpeedOverGround] = buffer.size() - start;
+	start = buffer.size();
+
+	impl::putPacked(buffer, rows, &Row::courseOverGround, header.minCourse,
+			header.courseBits);
+	header.columnBytes[AISArchiveColumn_CourseOverGround] = buffer.size()
+			- start;
+	start = buffer.size();
+
+	impl::putPacked(buffer, rows, &Row::trueHeading, header.minHeading,
+			header.headingBits);
+	header.columnBytes[AISArchiveColumn_TrueHeading] = buffer.size() - start;
+
+	header.payloadBytes = static_cast<uint32_t>(buffer.size());
+
+	if (std::fwrite(&header, sizeof(header), 1, file) != 1
+			|| (!buffer.empty()
+					&& std::fwrite(buffer.data(), buffer.size(), 1, file) != 1))
+	{
+		return false;
+	}
+
+	recordCount += rows.size();
+	++blockCount;
+	rows.clear();
+	return true;
+}
+
+bool AISArchiveWriter::flush()
+{
+	if (file == nullptr)
+	{
+		return false;
+	}
+	return writeBlock() && std::fflush(file) == 0;
+}
+
+bool AISArchiveWriter::close()
+{
+	if (file == nullptr)
+	{
+		return true;
+	}
+	const bool written = writeBlock();
+	const bool closed = std::fclose(file) == 0;
+	file = nullptr;
+	rows.clear();
+	return written && closed;
+}
+
+uint64_t AISArchiveWriter::records() const
+{
+	return recordCount;
+}
+
+uint64_t AISArchiveWriter::blocks() const
+{
+	return blockCount;
+}
@@ -0,0 +1,204 @@
+/**
+ *	@file AISBatchDecoder.cpp
+ *	@brief AISBatchDecoder Implementation
+ */
+
+#include "AISBatchDecoder.h"
+#include "AISBitBuffer.h"
+#include "NmeaEnums.h"
+
+/**
+ * @brief Private Implementation
+ */
+class AISBatchDecoder::impl
+{
+public:
+	/**
+	 * @brief Rows per block, one validity word
+	 */
+	static const std::size_t BLOCK_ROWS = 64;
+
+	/**
+	 * @brief Characters holding every field up to True Heading
+	 */
+	static const std::size_t POSITION_CHARS = 23;
+
+	/**
+	 * @brief Decodes position reports
+	 *
+	 * @param [in] encodedData Payloads, std::string or boost::string_ref
+	 * @param [in] count Number of payloads
+	 * @param [out] columns Column buffers
+	 *
+	 * @return Number of valid rows.
+	 */
+	template<typename Payload>
+	static std::size_t decodePositionReports(const Payload* encodedData,
+			std::size_t count, const AISPositionColumns& columns);
+};
+
+AISBatchDecoder::AISBatchDecoder()
+{
+
+}
+
+template<typename Payload>
+std::size_t AISBatchDecoder::impl::decodePositionReports(
+		const Payload* encodedData, std::size_t count,
+		const AISPositionColumns& columns)
+{
+	std::size_t validRows = 0;
+	AISBitReader reader;
+
+	for (std::size_t first = 0; first < count; first += BLOCK_ROWS)
+	{
+		const std::size_t rows =
+				count - first < BLOCK_ROWS ? count - first : BLOCK_ROWS;
+
+		uint mmsi[BLOCK_ROWS];
+		uint messageType[BLOCK_ROWS];
+		int longitude[BLOCK_ROWS];
+		int latitude[BLOCK_ROWS];
+		uint speedOverGround[BLOCK_ROWS];
+		uint courseOverGround[BLOCK_ROWS];
+		uint trueHeading[BLOCK_ROWS];
+		uint64_t mask = 0;
+
+		// Pass 1: extract raw fields
+		for (std::size_t r = 0; r < rows; ++r)
+		{
+			const Payload& payload = encodedData[first + r];
+			const std::size_t length = payload.size();
+
+			uint type = Nmea_AisMessageType_NA;
+			bool valid = length > 0
+					&& reader.assign(payload.data(),
+							length < POSITION_CHARS ? length : POSITION_CHARS);
+			if (valid)
+			{
+				type = reader.getUInt(0, 6);
+			}
+
+			// Class B reports have 4 bits less before Speed Over Ground
+			int shift = 0;
+			switch (type)
+			{
+			case Nmea_AisMessageType_PositionReportClassA:
+			case Nmea_AisMessageType_PositionReportClassA_AssignedSchedule:
+			case Nmea_AisMessageType_PositionReportClassA_ResponseToInterrogation:
+				valid = length >= 28;
+				break;
+			case Nmea_AisMessageType_StandardClassBCSPositionReport:
+				valid = length >= 27;
+				shift = -4;
+				break;
+			case Nmea_AisMessageType_ExtendedClassBEquipmentPositionReport:
+				valid = length >= 52;
+				shift = -4;
+				break;
+			default:
+				valid = false;
+				break;
+			}
+
+			if (valid)
+			{
+				mask |= static_cast<uint64_t>(1) << r;
+				messageType[r] = type;
+				mmsi[r] = reader.getUInt(8, 30);
+				speedOverGround[r] = reader.getUInt(50 + shift, 10);
+				longitude[r] = reader.getInt(61 + shift, 28);
+				latitude[r] = reader.getInt(89 + shift, 27);
+				courseOverGround[r] = reader.getUInt(116 + shift, 12);
+				trueHeading[r] = reader.getUInt(128 + shift, 9);
+			}
+			else
+			{
+				messageType[r] = 0;
+				mmsi[r] = 0;
+				speedOverGround[r] = 0;
+				longitude[r] = 0;
+				latitude[r] = 0;
+				courseOverGround[r] = 0;
+				trueHeading[r] = 0;
+			}
+		}
+
+		// Pass 2: scale into the columns, same arithmetic as NmeaParser
+		if (columns.mmsi)
+		{
+			uint* out = columns.mmsi + first;
+			for (std::size_t r = 0; r < rows; ++r)
+			{
+				out[r] = mmsi[r];
+			}
+		}
+		if (columns.messageType)
+		{
+			uint8_t* out = columns.messageType + first;
+			for (std::size_t r = 0; r < rows; ++r)
+			{
+				out[r] = static_cast<uint8_t>(messageType[r]);
+			}
+		}
+		if (columns.longitude)
+		{
+			float* out = columns.longitude + first;
+			for (std::size_t r = 0; r < rows; ++r)
+			{
+				out[r] = longitude[r] / 600000.0f;
+			}
+		}
+		if (columns.latitude)
+		{
+			float* out = columns.latitude + first;
+			for (std::size_t r = 0; r < rows; ++r)
+			{
+				out[r] = latitude[r] / 600000.0f;
+			}
+		}
+		if (columns.speedOverGround)
+		{
+			float* out = columns.speedOverGround + first;
+			for (std::size_t r = 0; r < rows; ++r)
+			{
+				out[r] = speedOverGround[r] * 0.1f;
+			}
+		}
+		if (columns.courseOverGround)
+		{
+			float* out = columns.courseOverGround + first;
+			for (std::size_t r = 0; r < rows; ++r)
+			{
+				out[r] = courseOverGround[r] * 0.1f;
+			}
+		}
+		if (columns.trueHeading)
+		{
+			uint16_t* out = columns.trueHeading + first;
+			for (std::size_t r = 0; r < rows; ++r)
+			{
+				out[r] = static_cast<uint16_t>(trueHeading[r]);
+			}
+		}
+
+		columns.validMask[first / BLOCK_ROWS] = mask;
+		validRows += __builtin_popcountll(mask);
+	}
+
+	return validRows;
+}
+
+std::size_t AISBatchDecoder::decodePositionReports(
+		const std::string* encodedData, std::size_t count,
+		const AISPositionColumns& columns)
+{
+	return impl::decodePositionReports(encodedData, count, columns);
+}
+
+std::size_t AISBatchDecoder::decodePositionReports(
+		const boost::string_ref* encodedData, std::size_t count,
+		const AISPositionColumns& columns)
+{
+	return impl::decodePositionReports(encodedData, count, columns);
+}
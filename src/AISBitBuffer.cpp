@@ -0,0 +1,210 @@
+/**
+ *	@file AISBitBuffer.cpp
+ *	@brief AIS bit buffer Implementation
+ */
+
+#include "AISBitBuffer.h"
+#include "AISFixedString.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+const int AISBitWriter::MAX_BITS;
+const int AISBitWriter::WORD_BITS;
+const int AISBitReader::MAX_BITS;
+const int AISBitReader::WORD_BITS;
+
+AISBitWriter::AISBitWriter()
+{
+	clear();
+}
+
+void AISBitWriter::clear()
+{
+	current = 0;
+	wordCount = 0;
+	used = 0;
+	overflowed = false;
+}
+
+void AISBitWriter::putString(boost::string_ref value, int chars)
+{
+	const int length =
+			static_cast<int>(value.size()) < chars ?
+					static_cast<int>(value.size()) : chars;
+
+	for (int i = 0; i < length; ++i)
+	{
+		char c = value[i];
+		if (c >= 'a' && c <= 'z')
+		{
+			c -= 'a' - 'A';
+		}
+		if (c < ' ' || c > '_')
+		{
+			c = ' ';
+		}
+		// '@' to '_' map to 0 to 31, ' ' to '?' map to 32 to 63
+		putUInt(static_cast<uint>(c) & 0x3F, 6);
+	}
+
+	for (int i = length; i < chars; ++i)
+	{
+		putUInt(0, 6);
+	}
+}
+
+int AISBitWriter::armor(std::string& encodedData) const
+{
+	const int bits = size();
+	const int chars = (bits + 5) / 6;
+
+	encodedData.resize(chars);
+
+	for (int i = 0; i < chars; ++i)
+	{
+		const int position = i * 6;
+		const int index = position / WORD_BITS;
+		const int offset = position % WORD_BITS;
+
+		const uint64_t word = index < wordCount ? words[index] : current;
+		uint value;
+		if (offset <= WORD_BITS - 6)
+		{
+			value = static_cast<uint>(word >> (WORD_BITS - 6 - offset)) & 0x3F;
+		}
+		else
+		{
+			// Character spans two words
+			const int high = WORD_BITS - offset;
+			uint64_t next = 0;
+			if (index + 1 < wordCount)
+			{
+				next = words[index + 1];
+			}
+			else if (index + 1 == wordCount)
+			{
+				next = current;
+			}
+			value = static_cast<uint>(((word << (6 - high))
+					| (next >> (WORD_BITS - 6 + high))) & 0x3F);
+		}
+
+		encodedData[i] = static_cast<char>(value < 40 ? value + 48 : value + 56);
+	}
+
+	return chars * 6 - bits;
+}
+
+AISBitReader::AISBitReader() :
+		bitCount(0)
+{
+	std::fill(words, words + sizeof(words) / sizeof(words[0]), 0);
+}
+
+bool AISBitReader::assign(const char* encodedData, std::size_t length)
+{
+	static const std::size_t MAX_CHARS = MAX_BITS / 6;
+
+	if (length > MAX_CHARS)
+	{
+		length = MAX_CHARS;
+	}
+
+	// Six-bit values, one per byte
+	uint8_t values[MAX_CHARS + 16];
+	bool valid = true;
+	std::size_t i = 0;
+
+#ifdef __SSE2__
+	const __m128i offset = _mm_set1_epi8(48);
+	const __m128i gap = _mm_set1_epi8(39);
+	const __m128i gapEnd = _mm_set1_epi8(47);
+	const __m128i gapSize = _mm_set1_epi8(8);
+	const __m128i maxValue = _mm_set1_epi8(63);
+	__m128i invalid = _mm_setzero_si128();
+
+	for (; i + 16 <= length; i += 16)
+	{
+		__m128i v = _mm_loadu_si128(
+				reinterpret_cast<const __m128i*>(encodedData + i));
+		v = _mm_sub_epi8(v, offset);
+		// Characters after 'W' skip the eight codes between 'W' and '`'
+		const __m128i high = _mm_cmpgt_epi8(v, gap);
+		// 'X' to '_' themselves are not armor
+		invalid = _mm_or_si128(invalid,
+				_mm_andnot_si128(_mm_cmpgt_epi8(v, gapEnd), high));
+		v = _mm_sub_epi8(v, _mm_and_si128(high, gapSize));
+		// Anything outside 0..63, compared unsigned, is not armor
+		invalid = _mm_or_si128(invalid,
+				_mm_xor_si128(_mm_max_epu8(v, maxValue), maxValue));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), v);
+	}
+
+	const __m128i zero = _mm_setzero_si128();
+	valid = _mm_movemask_epi8(_mm_cmpeq_epi8(invalid, zero)) == 0xFFFF;
+#endif
+
+	for (; i < length; ++i)
+	{
+		int v = static_cast<unsigned char>(encodedData[i]) - 48;
+		if (v > 39)
+		{
+			if (v < 48)
+			{
+				valid = false;
+			}
+			v -= 8;
+		}
+		if (v < 0 || v > 63)
+		{
+			valid = false;
+		}
+		values[i] = static_cast<uint8_t>(v);
+	}
+
+	std::fill(words, words + sizeof(words) / sizeof(words[0]), 0);
+
+	// Pack the six-bit values MSB first
+	uint64_t current = 0;
+	int used = 0;
+	int index = 0;
+	for (i = 0; i < length; ++i)
+	{
+		const uint64_t v = values[i] & 0x3F;
+		if (used + 6 <= WORD_BITS)
+		{
+			current = (current << 6) | v;
+			used += 6;
+			if (used == WORD_BITS)
+			{
+				words[index++] = current;
+				current = 0;
+				used = 0;
+			}
+		}
+		else
+		{
+			const int rest = used + 6 - WORD_BITS;
+			words[index++] = (current << (6 - rest)) | (v >> rest);
+			current = v & ((1U << rest) - 1);
+			used = rest;
+		}
+	}
+	if (used > 0)
+	{
+		words[index] = current << (WORD_BITS - used);
+	}
+
+	bitCount = static_cast<int>(length) * 6;
+	return valid;
+}
+
+bool AISBitReader::assign(const std::string& encodedData)
+{
+	return assign(encodedData.data(), encodedData.size());
+}
@@ -0,0 +1,194 @@
+/**
+ *	@file AISDuplicateFilter.cpp
+ *	@brief AISDuplicateFilter Implementation
+ */
+
+#include "AISDuplicateFilter.h"
+#include "AISPayloadHash.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Private Implementation
+ */
+class AISDuplicateFilter::impl
+{
+public:
+	/**
+	 * @brief Maximum number of bits set per payload
+	 */
+	static const uint MAX_HASHES = 16;
+
+	/**
+	 * @brief Final mix of a hash, spreads every input bit over the output
+	 *
+	 * @param [in] value Hash
+	 *
+	 * @return Mixed hash.
+	 */
+	static uint64_t mix(uint64_t value);
+
+	/**
+	 * @brief Clears a Bloom filter
+	 *
+	 * @param [in,out] generation Filter
+	 */
+	static void clear(Generation& generation);
+};
+
+double AISDuplicateFilterStatistics::duplicateRatio() const
+{
+	return messages == 0 ?
+			0.0 : static_cast<double>(duplicates) / messages;
+}
+
+AISDuplicateFilter::AISDuplicateFilter(int64_t window, uint expectedMessages,
+		double targetFalsePositiveRate) :
+		window(window), generationStart(0), started(false), hashes(1), mask(0), current(
+				0)
+{
+	const double n = std::max(expectedMessages, 1U);
+	const double p = std::min(std::max(targetFalsePositiveRate, 1e-9), 0.5);
+	const double ln2 = std::log(2.0);
+
+	// Optimal size m = -n ln(p) / ln(2)^2, rounded up to a power of two
+	const double optimalBits = std::ceil(-n * std::log(p) / (ln2 * ln2));
+	std::size_t size = 64;
+	while (size < optimalBits)
+	{
+		size <<= 1;
+	}
+	mask = size - 1;
+
+	// Optimal hash count k = m / n ln(2)
+	const double optimalHashes = std::floor(size / n * ln2 + 0.5);
+	hashes = static_cast<uint>(
+			std::min(std::max(optimalHashes, 1.0),
+					static_cast<double>(impl::MAX_HASHES)));
+
+	for (uint i = 0; i < 2; ++i)
+	{
+		generations[i].words.assign(size / 64, 0);
+		generations[i].bitsSet = 0;
+	}
+
+	resetStatistics();
+}
+
+uint64_t AISDuplicateFilter::impl::mix(uint64_t value)
+{
+	value ^= value >> 33;
+	value *= 0xff51afd7ed558ccdULL;
+	value ^= value >> 33;
+	value *= 0xc4ceb9fe1a85ec53ULL;
+	value ^= value >> 33;
+	return value;
+}
+
+void AISDuplicateFilter::impl::clear(Generation& generation)
+{
+	std::fill(generation.words.begin(), generation.words.end(), 0);
+	generation.bitsSet = 0;
+}
+
+void AISDuplicateFilter::rotate(int64_t timestamp)
+{
+	if (!started)
+	{
+		started = true;
+		generationStart = timestamp;
+	}
+	else if (timestamp - generationStart >= 2 * window)
+	{
+		// Both generations are over
+		impl::clear(generations[0]);
+		impl::clear(generations[1]);
+		generationStart = timestamp;
+	}
+	else if (timestamp - generationStart >= window)
+	{
+		current ^= 1;
+		impl::clear(generations[current]);
+		generationStart += window;
+	}
+}
+
+bool AISDuplicateFilter::isDuplicate(boost::string_ref encodedData,
+		int64_t timestamp)
+{
+	rotate(timestamp);
+
+	// Double hashing: bit i is h1 + i * h2, h2 odd to visit distinct bits
+	const uint64_t h1 = impl::mix(aisPayloadHash(encodedData));
+	const uint64_t h2 = impl::mix(h1) | 1;
+
+	Generation& newer = generations[current];
+	const Generation& older = generations[current ^ 1];
+	bool inNewer = true;
+	bool inOlder = true;
+
+	for (uint i = 0; i < hashes; ++i)
+	{
+		const std::size_t bit = (h1 + i * h2) & mask;
+		const uint64_t word = static_cast<uint64_t>(1) << (bit % 64);
+		uint64_t& target = newer.words[bit / 64];
+
+		inOlder = inOlder && (older.words[bit / 64] & word) != 0;
+		if ((target & word) == 0)
+		{
+			// Recorded in the current generation, so it outlives the older one
+			inNewer = false;
+			target |= word;
+			++newer.bitsSet;
+		}
+	}
+
+	const bool duplicate = inNewer || inOlder;
+
+	++stats.messages;
+	if (duplicate)
+	{
+		++stats.duplicates;
+	}
+	return duplicate;
+}
+
+void AISDuplicateFilter::clear()
+{
+	impl::clear(generations[0]);
+	impl::clear(generations[1]);
+	started = false;
+}
+
+double AISDuplicateFilter::falsePositiveRate() const
+{
+	double miss = 1.0;
+	for (uint i = 0; i < 2; ++i)
+	{
+		const double fill = static_cast<double>(generations[i].bitsSet)
+				/ (mask + 1);
+		miss *= 1.0 - std::pow(fill, static_cast<double>(hashes));
+	}
+	return 1.0 - miss;
+}
+
+const AISDuplicateFilterStatistics& AISDuplicateFilter::statistics() const
+{
+	return stats;
+}
+
+void AISDuplicateFilter::resetStatistics()
+{
+	stats.messages = 0;
+	stats.duplicates = 0;
+}
+
+std::size_t AISDuplicateFilter::bits() const
+{
+	return mask + 1;
+}
+
+uint AISDuplicateFilter::hashCount() const
+{
+	return hashes;
+}
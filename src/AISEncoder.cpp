@@ -0,0 +1,456 @@
+/**
+ *	@file AISEncoder.cpp
+ *	@brief AISEncoder Implementation
+ */
+
+#include "AISEncoder.h"
+#include "AISBitBuffer.h"
+#include "NmeaWriter.h"
+
+#include <cmath>
+
+const int AISEncoder::MAX_FRAGMENT_CHARS;
+
+/**
+ * @brief Private Implementation
+ */
+class AISEncoder::impl
+{
+public:
+	/**
+	 * @brief Scales and rounds an unsigned field
+	 *
+	 * @param [in] value Value in natural units
+	 * @param [in] scale Field units per natural unit
+	 * @param [in] max Maximum value of the field
+	 * @param [in] notAvailable Value written for NaN
+	 *
+	 * @return Field value.
+	 */
+	static uint scaleUInt(double value, double scale, uint max,
+			uint notAvailable);
+
+	/**
+	 * @brief Scales and rounds a longitude or latitude field
+	 *
+	 * @param [in] value Decimal degrees
+	 * @param [in] limit 180 for longitude, 90 for latitude
+	 *
+	 * @return Field value in 1/10000 minutes.
+	 */
+	static int scaleLatLng(double value, int limit);
+
+	/**
+	 * @brief Encodes Rate of Turn as the indicator read by the decoder
+	 *
+	 * @param [in] rateOfTurn Rate of Turn in degrees per minute
+	 *
+	 * @return ROT indicator.
+	 */
+	static int encodeRateOfTurn(double rateOfTurn);
+
+	/**
+	 * @brief Writes message type, repeat indicator and MMSI
+	 *
+	 * @param [in,out] writer Bit writer
+	 * @param [in] messageType Message type
+	 * @param [in] repeatIndicator Repeat indicator
+	 * @param [in] mmsi MMSI
+	 */
+	static void putHeader(AISBitWriter& writer, Nmea_AisMessageType messageType,
+			int repeatIndicator, uint mmsi);
+
+	/**
+	 * @brief Writes ship dimension fields
+	 *
+	 * @param [in,out] writer Bit writer
+	 * @param [in] dimension Ship Dimension
+	 */
+	static void putDimension(AISBitWriter& writer,
+			const AISDimension& dimension);
+
+	/**
+	 * @brief Armors the written payload
+	 *
+	 * @param [in] writer Bit writer
+	 * @param [out] encodedData AIS Binary Encoded Data
+	 * @param [out] fillBits Number of fill bits
+	 *
+	 * @return True if the payload fitted in the writer.
+	 */
+	static bool finish(const AISBitWriter& writer, std::string& encodedData,
+			int& fillBits);
+};
+
+AISEncoder::AISEncoder()
+{
+
+}
+
+uint AISEncoder::impl::scaleUInt(double value, double scale, uint max,
+		uint notAvailable)
+{
+	if (std::isnan(value))
+	{
+		return notAvailable;
+	}
+
+	const double scaled = std::round(value * scale);
+	if (scaled <= 0)
+	{
+		return 0;
+	}
+	if (scaled >= max)
+	{
+		return max;
+	}
+	return static_cast<uint>(scaled);
+}
+
+int AISEncoder::impl::scaleLatLng(double value, int limit)
+{
+	static const double MINUTES_SCALE = 600000.0;
+
+	if (std::isnan(value) || value > limit || value < -limit)
+	{
+		// Not available: 181 degrees longitude, 91 degrees latitude
+		return static_cast<int>((limit + 1) * MINUTES_SCALE);
+	}
+	return static_cast<int>(std::lround(value * MINUTES_SCALE));
+}
+
+int AISEncoder::impl::encodeRateOfTurn(double rateOfTurn)
+{
+	static const double ROT_FACTOR = 4.733;
+
+	if (std::isnan(rateOfTurn))
+	{
+		// No turn information available
+		return -128;
+	}
+
+	// Inverse of ROT = (indicator / 4.733)^2
+	int indicator = static_cast<int>(std::lround(
+			ROT_FACTOR * std::sqrt(std::fabs(rateOfTurn))));
+	if (indicator > 127)
+	{
+		indicator = 127;
+	}
+	return rateOfTurn < 0 ? -indicator : indicator;
+}
+
+void AISEncoder::impl::putHeader(AISBitWriter& writer,
+		Nmea_AisMessageType messageType, int repeatIndicator, uint mmsi)
+{
+	writer.putUInt(messageType, 6);
+	writer.putUInt(repeatIndicator, 2);
+	writer.putUInt(mmsi, 30);
+}
+
+void AISEncoder::impl::putDimension(AISBitWriter& writer,
+		const AISDimension& dimension)
+{
+	writer.putUInt(scaleUInt(dimension.toBow, 1, 511, 0), 9);
+	writer.putUInt(scaleUInt(dimension.toStern, 1, 511, 0), 9);
+	writer.putUInt(scaleUInt(dimension.toPort, 1, 63, 0), 6);
+	writer.putUInt(scaleUInt(dimension.toStarboard, 1, 63, 0), 6);
+}
+
+bool AISEncoder::impl::finish(const AISBitWriter& writer,
+		std::string& encodedData, int& fillBits)
+{
+	fillBits = writer.armor(encodedData);
+	return !writer.overflow();
+}
+
+bool AISEncoder::encodeAISPositionReportClassA(
+		const AISPositionReportClassA& data, Nmea_AisMessageType messageType,
+		std::string& encodedData, int& fillBits)
+{
+	if (messageType != Nmea_AisMessageType_PositionReportClassA
+			&& messageType
+					!= Nmea_AisMessageType_PositionReportClassA_AssignedSchedule
+			&& messageType
+					!= Nmea_AisMessageType_PositionReportClassA_ResponseToInterrogation)
+	{
+		return false;
+	}
+
+	AISBitWriter writer;
+	impl::putHeader(writer, messageType, data.repeatIndicator, data.mmsi);
+	writer.putUInt(data.navigationStatus, 4);
+	writer.putInt(impl::encodeRateOfTurn(data.rateOfTurn), 8);
+	writer.putUInt(impl::scaleUInt(data.speedOverGround, 10, 1022, 1023), 10);
+	writer.putBool(
+			data.positionAccuracy == Nmea_PositionAccuracy_DGPSQualityFix);
+	writer.putInt(impl::scaleLatLng(data.longitude, 180), 28);
+	writer.putInt(impl::scaleLatLng(data.latitude, 90), 27);
+	writer.putUInt(impl::scaleUInt(data.courseOverGround, 10, 3599, 3600), 12);
+	writer.putUInt(data.trueHeading > 511 ? 511 : data.trueHeading, 9);
+	writer.putUInt(data.timestapUTCSecond > 63 ? 60 : data.timestapUTCSecond,
+			6);
+	writer.putUInt(data.maneuverIndicator, 2);
+	// Spare
+	writer.putSpare(3);
+	writer.putBool(data.raim == Nmea_RAIM_InUse);
+	// Radio status
+	writer.putSpare(19);
+
+	return impl::finish(writer, encodedData, fillBits);
+}
+
+bool AISEncoder::encodeAISBaseStationReport(const AISBaseStationReport& data,
+		std::string& encodedData, int& fillBits)
+{
+	AISBitWriter writer;
+	impl::putHeader(writer, Nmea_AisMessageType_BaseStationReport,
+			data.repeatIndicator, data.mmsi);
+	writer.putUInt(data.year, 14);
+	writer.putUInt(data.month, 4);
+	writer.putUInt(data.day, 5);
+	writer.putUInt(data.hour, 5);
+	writer.putUInt(data.minute, 6);
+	writer.putUInt(data.second, 6);
+	writer.putBool(
+			data.positionAccuracy == Nmea_PositionAccuracy_DGPSQualityFix);
+	writer.putInt(impl::scaleLatLng(data.longitude, 180), 28);
+	writer.putInt(impl::scaleLatLng(data.latitude, 90), 27);
+	writer.putUInt(data.epfd, 4);
+	// Spare
+	writer.putSpare(10);
+	writer.putBool(data.raim == Nmea_RAIM_InUse);
+	// Radio status
+	writer.putSpare(19);
+
+	return impl::finish(writer, encodedData, fillBits);
+}
+
+bool AISEncoder::encodeAISStaticAndVoyageRelatedData(
+		const AISStaticAndVoyageRelatedData& data, std::string& encodedData,
+		int& fillBits)
+{
+	AISBitWriter writer;
+	impl::putHeader(writer, Nmea_AisMessageType_StaticAndVoyageRelatedData,
+			data.repeatIndicator, data.mmsi);
+	writer.putUInt(data.aisVersion, 2);
+	writer.putUInt(data.imoNumber, 30);
+	writer.putString(data.callsign, 7);
+	writer.putString(data.vesselName, 20);
+	writer.putUInt(data.shipType, 8);
+	impl::putDimension(writer, data.dimension);
+	writer.putUInt(data.epfd, 4);
+	writer.putUInt(data.month, 4);
+	writer.putUInt(data.day, 5);
+	writer.putUInt(data.hour, 5);
+	writer.putUInt(data.minute, 6);
+	writer.putUInt(impl::scaleUInt(data.draught, 1, 255, 0), 8);
+	writer.putString(data.destination, 20);
+	// DTE and spare
+	writer.putSpare(2);
+
+	return impl::finish(writer, encodedData, fillBits);
+}
+
+bool AISEncoder::encodeAISStandardClassBCSPositionReport(
+		const AISStandardClassBCSPositionReport& data, std::string& encodedData,
+		int& fillBits)
+{
+	AISBitWriter writer;
+	impl::putHeader(writer, Nmea_AisMessageType_StandardClassBCSPositionReport,
+			data.repeatIndicator, data.mmsi);
+	// Reserved
+	writer.putSpare(8);
+	writer.putUInt(impl::scaleUInt(data.speedOverGround, 10, 1022, 1023), 10);
+	writer.putBool(
+			data.positionAccuracy == Nmea_PositionAccuracy_DGPSQualityFix);
+	writer.putInt(impl::scaleLatLng(data.longitude, 180), 28);
+	writer.putInt(impl::scaleLatLng(data.latitude, 90), 27);
+	writer.putUInt(impl::scaleUInt(data.courseOverGround, 10, 3599, 3600), 12);
+	writer.putUInt(data.trueHeading > 511 ? 511 : data.trueHeading, 9);
+	writer.putUInt(data.timestapUTCSecond > 63 ? 60 : data.timestapUTCSecond,
+			6);
+	// Regional reserved
+	writer.putSpare(2);
+	// CS Unit: Class B "CS" unit
+	writer.putBool(true);
+	// Display, DSC, Band, Message 22, Assigned and RAIM flags
+	writer.putSpare(6);
+	// Radio status
+	writer.putSpare(20);
+
+	return impl::finish(writer, encodedData, fillBits);
+}
+
+bool AISEncoder::encodeAISExtendedClassBEquipmentPositionReport(
+		const AISExtendedClassBCSPositionReport& data, std::string& encodedData,
+		int& fillBits)
+{
+	AISBitWriter writer;
+	impl::putHeader(writer,
+			Nmea_AisMessageType_ExtendedClassBEquipmentPositionReport,
+			data.repeatIndicator, data.mmsi);
+	// Reserved
+	writer.putSpare(8);
+	writer.putUInt(impl::scaleUInt(data.speedOverGround, 10, 1022, 1023), 10);
+	writer.putBool(
+			data.positionAccuracy == Nmea_PositionAccuracy_DGPSQualityFix);
+	writer.putInt(impl::scaleLatLng(data.longitude, 180), 28);
+	writer.putInt(impl::scaleLatLng(data.latitude, 90), 27);
+	writer.putUInt(impl::scaleUInt(data.courseOverGround, 10, 3599, 3600), 12);
+	writer.putUInt(data.trueHeading > 511 ? 511 : data.trueHeading, 9);
+	writer.putUInt(data.timestapUTCSecond > 63 ? 60 : data.timestapUTCSecond,
+			6);
+	// Regional reserved
+	writer.putSpare(4);
+	writer.putString(data.vesselName, 20);
+	writer.putUInt(data.shipType, 8);
+	impl::putDimension(writer, data.dimension);
+	writer.putUInt(data.epfd, 4);
+	writer.putBool(data.raim == Nmea_RAIM_InUse);
+	// DTE
+	writer.putSpare(1);
+	writer.putBool(data.assigned);
+	// Spare
+	writer.putSpare(4);
+
+	return impl::finish(writer, encodedData, fillBits);
+}
+
+bool AISEncoder::encodeAISAidToNavigationReport(
+		const AISAidToNavigationReport& data, std::string& encodedData,
+		int& fillBits)
+{
+	static const int NAME_CHARS = 20;
+	static const int NAME_EXTENSION_CHARS = 14;
+
+	AISBitWriter writer;
+	impl::putHeader(writer, Nmea_AisMessageType_AidToNavigationReport,
+			data.repeatIndicator, data.mmsi);
+	writer.putUInt(data.navigationAidType, 5);
+	writer.putString(data.name, NAME_CHARS);
+	writer.putBool(
+			data.positionAccuracy == Nmea_PositionAccuracy_DGPSQualityFix);
+	writer.putInt(impl::scaleLatLng(data.longitude, 180), 28);
+	writer.putInt(impl::scaleLatLng(data.latitude, 90), 27);
+	impl::putDimension(writer, data.dimension);
+	writer.putUInt(data.epfd, 4);
+	writer.putUInt(data.timestapUTCSecond > 63 ? 60 : data.timestapUTCSecond,
+			6);
+	writer.putBool(data.offPosition);
+	// Reserved
+	writer.putSpare(8);
+	writer.putBool(data.raim == Nmea_RAIM_InUse);
+	writer.putBool(data.virtualAid);
+	writer.putBool(data.assigned);
+	// Spare
+	writer.putSpare(1);
+
+	if (data.name.size() > static_cast<std::size_t>(NAME_CHARS))
+	{
+		const boost::string_ref extension = boost::string_ref(data.name).substr(
+				NAME_CHARS, NAME_EXTENSION_CHARS);
+		writer.putString(extension, extension.size());
+	}
+
+	return impl::finish(writer, encodedData, fillBits);
+}
+
+bool AISEncoder::encodeAISStaticDataReport(const AISStaticDataReport& data,
+		std::string& encodedData, int& fillBits)
+{
+	AISBitWriter writer;
+	impl::putHeader(writer, Nmea_AisMessageType_StaticDataReport,
+			data.repeatIndicator, data.mmsi);
+	writer.putUInt(data.partNumber, 2);
+
+	if (data.partNumber == 0)
+	{
+		writer.putString(data.partA.vesselName, 20);
+	}
+	else if (data.partNumber == 1)
+	{
+		writer.putUInt(data.partB.shipType, 8);
+		writer.putString(data.partB.vendorId, 3);
+		writer.putUInt(data.partB.unitModelCode, 4);
+		writer.putUInt(data.partB.serialNumber, 20);
+		writer.putString(data.partB.callsign, 7);
+		impl::putDimension(writer, data.partB.dimension);
+		// Spare
+		writer.putSpare(6);
+	}
+	else
+	{
+		return false;
+	}
+
+	return impl::finish(writer, encodedData, fillBits);
+}
+
+int AISEncoder::fragmentCount(const std::string& encodedData)
+{
+	const int chars = static_cast<int>(encodedData.size());
+	return chars == 0 ? 1 : (chars + MAX_FRAGMENT_CHARS - 1) / MAX_FRAGMENT_CHARS;
+}
+
+std::size_t AISEncoder::writeVDM(char* buffer, std::size_t size,
+		const std::string& talkerId, int sequenceIdentifier, char aisChannel,
+		const std::string& encodedData, int fillBits)
+{
+	const int totalLines = fragmentCount(encodedData);
+
+	if (totalLines == 1)
+	{
+		return NmeaWriter::writeVDM(buffer, size, talkerId, 1, 1,
+				sequenceIdentifier, aisChannel, encodedData, fillBits);
+	}
+
+	std::size_t total = 0;
+	for (int line = 0; line < totalLines; ++line)
+	{
+		const bool last = (line == totalLines - 1);
+		const std::size_t length = NmeaWriter::writeVDM(buffer + total,
+				size - total, talkerId, totalLines, line + 1,
+				sequenceIdentifier, aisChannel,
+				encodedData.substr(line * MAX_FRAGMENT_CHARS,
+						MAX_FRAGMENT_CHARS), last ? fillBits : 0);
+		if (length == 0)
+		{
+			if (size > 0)
+			{
+				buffer[0] = '\0';
+			}
+			return 0;
+		}
+		total += length;
+	}
+
+	return total;
+}
+
+int AISEncoder::writeVDM(std::vector<std::string>& sentences,
+		const std::string& talkerId, int sequenceIdentifier, char aisChannel,
+		const std::string& encodedData, int fillBits)
+{
+	const int totalLines = fragmentCount(encodedData);
+
+	char buffer[NmeaWriter::maxSentenceSize];
+	for (int line = 0; line < totalLines; ++line)
+	{
+		const bool last = (line == totalLines - 1);
+		const std::size_t length = NmeaWriter::writeVDM(buffer,
+				sizeof(buffer), talkerId, totalLines, line + 1,
+				sequenceIdentifier, aisChannel,
+				totalLines == 1 ?
+						encodedData :
+						encodedData.substr(line * MAX_FRAGMENT_CHARS,
+								MAX_FRAGMENT_CHARS), last ? fillBits : 0);
+		if (length < 2)
+		{
+			return line;
+		}
+		// Without CR LF
+		sentences.push_back(std::string(buffer, length - 2));
+	}
+
+	return totalLines;
+}
@@ -0,0 +1,203 @@
+/**
+ *	@file AISGeofence.cpp
+ *	@brief AISGeofence Implementation
+ */
+
+#include "AISGeofence.h"
+
+#include <algorithm>
+
+namespace
+{
+
+/**
+ * @brief Membership returned for unknown vessels
+ */
+const std::vector<uint> noZones;
+
+}
+
+const std::size_t AISGeofence::MAX_OVERLAP;
+
+AISGeofence::AISGeofence(uint capacity, float cellSize) :
+		index(capacity), membership(capacity), grid(cellSize)
+{
+
+}
+
+uint AISGeofence::addZone(const std::vector<AISGeofenceVertex>& polygon)
+{
+	if (polygon.size() < 3)
+	{
+		return AISMmsiMap::NPOS;
+	}
+
+	Zone zone;
+	zone.polygon = polygon;
+	zone.minLongitude = zone.maxLongitude = polygon[0].longitude;
+	zone.minLatitude = zone.maxLatitude = polygon[0].latitude;
+	for (std::size_t i = 1; i < polygon.size(); ++i)
+	{
+		zone.minLongitude = std::min(zone.minLongitude, polygon[i].longitude);
+		zone.maxLongitude = std::max(zone.maxLongitude, polygon[i].longitude);
+		zone.minLatitude = std::min(zone.minLatitude, polygon[i].latitude);
+		zone.maxLatitude = std::max(zone.maxLatitude, polygon[i].latitude);
+	}
+
+	const uint id = static_cast<uint>(zones.size());
+	zones.push_back(zone);
+
+	const uint first = grid.cellOf(zone.minLongitude, zone.minLatitude);
+	const uint last = grid.cellOf(zone.maxLongitude, zone.maxLatitude);
+	for (uint row = first / grid.columns; row <= last / grid.columns; ++row)
+	{
+		for (uint column = first % grid.columns; column <= last % grid.columns; ++column)
+		{
+			cells[row * grid.columns + column].push_back(id);
+		}
+	}
+
+	return id;
+}
+
+bool AISGeofence::contains(uint zone, float longitude, float latitude) const
+{
+	const Zone& z = zones[zone];
+	if (longitude < z.minLongitude || longitude > z.maxLongitude
+			|| latitude < z.minLatitude || latitude > z.maxLatitude)
+	{
+		return false;
+	}
+
+	// Even-odd rule: count edges crossed by a ray going east
+	bool inside = false;
+	const std::vector<AISGeofenceVertex>& p = z.polygon;
+	for (std::size_t i = 0, j = p.size() - 1; i < p.size(); j = i++)
+	{
+		if ((p[i].latitude > latitude) != (p[j].latitude > latitude)
+				&& longitude
+						< (p[j].longitude - p[i].longitude)
+								* (latitude - p[i].latitude)
+								/ (p[j].latitude - p[i].latitude)
+								+ p[i].longitude)
+		{
+			inside = !inside;
+		}
+	}
+	return inside;
+}
+
+std::size_t AISGeofence::update(uint mmsi, float longitude, float latitude,
+		int64_t timestamp, std::vector<AISGeofenceEvent>& events)
+{
+	if (!aisValidPosition(longitude, latitude))
+	{
+		return 0;
+	}
+
+	bool inserted;
+	const uint slot = index.insert(mmsi, inserted);
+	if (slot == AISMmsiMap::NPOS)
+	{
+		return 0;
+	}
+
+	std::vector<uint>& previous = membership[slot];
+	if (inserted)
+	{
+		previous.clear();
+	}
+
+	// Zones containing the position, sorted like the previous membership
+	uint current[MAX_OVERLAP];
+	std::size_t currentCount = 0;
+	std::unordered_map<uint, std::vector<uint> >::const_iterator cell =
+			cells.find(grid.cellOf(longitude, latitude));
+	if (cell != cells.end())
+	{
+		for (std::vector<uint>::const_iterator it = cell->second.begin();
+				it != cell->second.end() && currentCount < MAX_OVERLAP; ++it)
+		{
+			if (contains(*it, longitude, latitude))
+			{
+				current[currentCount++] = *it;
+			}
+		}
+	}
+
+	// Both lists are sorted: zone ids are added to cells in increasing order
+	const std::size_t before = events.size();
+	std::size_t i = 0;
+	std::size_t j = 0;
+	while (i < previous.size() || j < currentCount)
+	{
+		AISGeofenceEvent event;
+		event.mmsi = mmsi;
+		event.timestamp = timestamp;
+		if (j == currentCount
+				|| (i < previous.size() && previous[i] < current[j]))
+		{
+			event.zone = previous[i++];
+			event.entered = false;
+			events.push_back(event);
+		}
+		else if (i == previous.size() || current[j] < previous[i])
+		{
+			event.zone = current[j++];
+			event.entered = true;
+			events.push_back(event);
+		}
+		else
+		{
+			++i;
+			++j;
+		}
+	}
+
+	if (events.size() != before)
+	{
+		previous.assign(current, current + currentCount);
+	}
+
+	return events.size() - before;
+}
+
+std::size_t AISGeofence::update(const AISPositionReportClassA& data,
+		int64_t timestamp, std::vector<AISGeofenceEvent>& events)
+{
+	return update(data.mmsi, data.longitude, data.latitude, timestamp, events);
+}
+
+std::size_t AISGeofence::update(const AISStandardClassBCSPositionReport& data,
+		int64_t timestamp, std::vector<AISGeofenceEvent>& events)
+{
+	return update(data.mmsi, data.longitude, data.latitude, timestamp, events);
+}
+
+std::size_t AISGeofence::update(const AISExtendedClassBCSPositionReport& data,
+		int64_t timestamp, std::vector<AISGeofenceEvent>& events)
+{
+	return update(data.mmsi, data.longitude, data.latitude, timestamp, events);
+}
+
+const std::vector<uint>& AISGeofence::zonesOf(uint mmsi) const
+{
+	const uint slot = index.find(mmsi);
+	return slot == AISMmsiMap::NPOS ? noZones : membership[slot];
+}
+
+bool AISGeofence::erase(uint mmsi)
+{
+	const uint slot = index.find(mmsi);
+	if (slot == AISMmsiMap::NPOS)
+	{
+		return false;
+	}
+	membership[slot].clear();
+	return index.erase(mmsi);
+}
+
+uint AISGeofence::zoneCount() const
+{
+	return static_cast<uint>(zones.size());
+}
@@ -0,0 +1,499 @@
+/**
+ *	@file AISLogIndex.cpp
+ *	@brief AISLogIndex Implementation
+ */
+
+#include "AISLogIndex.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include "AISMessageView.h"
+
+/**
+ * @brief Private Implementation
+ */
+class AISLogIndex::impl
+{
+public:
+	/**
+	 * @brief Index file header, at offset 0
+	 *
+	 * Followed by the blocks (offset, length), the Bloom filters, the MMSI
+	 * table (mmsi, count, first entry) and the entries.
+	 */
+	struct Header
+	{
+		char magic[8]; //!< "AISLIDX1"
+		uint32_t version; //!< Format version, 1
+		uint32_t hashes; //!< Bloom filter hash count
+		uint64_t logSize; //!< Log size when indexed
+		uint64_t blockBytes; //!< Target block size
+		uint64_t blocks; //!< Number of blocks
+		uint64_t bloomWords; //!< Bloom filter words per block
+		uint64_t mmsis; //!< Number of MMSI
+		uint64_t entries; //!< Number of entries
+	};
+
+	/**
+	 * @brief Posting of the build
+	 */
+	struct Posting
+	{
+		uint mmsi; //!< MMSI
+		AISLogIndexEntry entry; //!< Message
+	};
+
+	/**
+	 * @brief Bloom filter bits per distinct MMSI
+	 */
+	static const uint BITS_PER_MMSI = 10;
+
+	/**
+	 * @brief Bloom filter hash count, optimal for 10 bits per MMSI
+	 */
+	static const uint HASHES = 7;
+
+	/**
+	 * @brief Splits the VDM or VDO sentence of a line
+	 *
+	 * @param [in] line Line, with or without TAG block
+	 * @param [out] totalLines Total lines of the message
+	 * @param [out] lineNumber Number of this line
+	 * @param [out] key Sequence identifier and channel of multi-line messages
+	 * @param [out] encodedData Payload
+	 *
+	 * @return False if the line is not a VDM or VDO sentence.
+	 */
+	static bool splitVDM(boost::string_ref line, int& totalLines,
+			int& lineNumber, uint& key, boost::string_ref& encodedData);
+
+	/**
+	 * @brief Scrambles an MMSI for the Bloom filters
+	 *
+	 * @param [in] mmsi MMSI
+	 *
+	 * @return Hash.
+	 */
+	static uint64_t hash(uint mmsi);
+
+	/**
+	 * @brief Orders postings by MMSI
+	 *
+	 * @param [in] a First posting
+	 * @param [in] b Second posting
+	 *
+	 * @return True if @p a goes first.
+	 */
+	static bool lessPosting(const Posting& a, const Posting& b);
+};
+
+const uint AISLogIndex::impl::BITS_PER_MMSI;
+const uint AISLogIndex::impl::HASHES;
+
+bool AISLogIndex::impl::splitVDM(boost::string_ref line, int& totalLines,
+		int& lineNumber, uint& key, boost::string_ref& encodedData)
+{
+	// Skip the TAG block
+	if (!line.empty() && line[0] == '\\')
+	{
+		const std::size_t end = line.substr(1).find('\\');
+		if (end == boost::string_ref::npos)
+		{
+			return false;
+		}
+		line.remove_prefix(end + 2);
+	}
+
+	if (line.size() < 7 || line[0] != '!' || line[3] != 'V' || line[4] != 'D'
+			|| (line[5] != 'M' && line[5] != 'O') || line[6] != ',')
+	{
+		return false;
+	}
+
+	// !--VDM,totalLines,lineNumber,sequenceIdentifier,channel,payload,fill*cs
+	boost::string_ref fields[5];
+	std::size_t start = 7;
+	for (int i = 0; i < 5; ++i)
+	{
+		const std::size_t comma = line.substr(start).find(',');
+		if (comma == boost::string_ref::npos)
+		{
+			return false;
+		}
+		fields[i] = line.substr(start, comma);
+		start += comma + 1;
+	}
+
+	if (fields[0].size() != 1 || fields[1].size() != 1)
+	{
+		return false;
+	}
+	totalLines = fields[0][0] - '0';
+	lineNumber = fields[1][0] - '0';
+	key = (fields[2].empty() ? 0u : static_cast<unsigned char>(fields[2][0]))
+			| (fields[3].empty() ? 0u : static_cast<unsigned char>(fields[3][0]))
+					<< 8;
+	encodedData = fields[4];
+	return totalLines >= 1 && totalLines <= 9 && lineNumber >= 1
+			&& lineNumber <= totalLines;
+}
+
+uint64_t AISLogIndex::impl::hash(uint mmsi)
+{
+	uint64_t value = mmsi;
+	value ^= value >> 33;
+	value *= 0xff51afd7ed558ccdULL;
+	value ^= value >> 33;
+	value *= 0xc4ceb9fe1a85ec53ULL;
+	value ^= value >> 33;
+	return value;
+}
+
+bool AISLogIndex::impl::lessPosting(const Posting& a, const Posting& b)
+{
+	return a.mmsi < b.mmsi;
+}
+
+bool AISLogIndex::build(const std::string& logPath,
+		const std::string& indexPath, uint64_t blockBytes)
+{
+	NmeaMappedFile log;
+	if (!log.open(logPath))
+	{
+		return false;
+	}
+
+	std::vector<impl::Posting> postings;
+	std::vector<uint64_t> blockRanges;
+	std::vector<std::vector<uint> > blockMmsis(1);
+	std::unordered_map<uint, std::size_t> pending;
+	uint64_t blockStart = 0;
+
+	uint64_t offset = 0;
+	while (offset < log.size())
+	{
+		if (offset - blockStart >= blockBytes)
+		{
+			blockRanges.push_back(blockStart);
+			blockRanges.push_back(offset - blockStart);
+			blockMmsis.push_back(std::vector<uint>());
+			blockStart = offset;
+		}
+
+		boost::string_ref line;
+		const uint64_t next = log.line(offset, line);
+
+		int totalLines;
+		int lineNumber;
+		uint key;
+		boost::string_ref encodedData;
+		if (impl::splitVDM(line, totalLines, lineNumber, key, encodedData))
+		{
+			if (lineNumber == 1)
+			{
+				// Type and MMSI are in the first 38 bits, 7 armor characters
+				if (encodedData.size() >= 7)
+				{
+					const AISMessageView view(encodedData);
+					impl::Posting posting;
+					posting.mmsi = view.mmsi();
+					std::memset(&posting.entry, 0, sizeof(posting.entry));
+					posting.entry.offset = offset;
+					posting.entry.length = static_cast<uint32_t>(next - offset);
+					posting.entry.messageType =
+							static_cast<uint8_t>(view.messageType());
+					postings.push_back(posting);
+					blockMmsis.back().push_back(posting.mmsi);
+					if (totalLines > 1)
+					{
+						pending[key] = postings.size() - 1;
+					}
+				}
+			}
+			else
+			{
+				std::unordered_map<uint, std::size_t>::iterator it =
+						pending.find(key);
+				if (it != pending.end())
+				{
+					AISLogIndexEntry& entry = postings[it->second].entry;
+					entry.length = static_cast<uint32_t>(std::min<uint64_t>(
+							next - entry.offset, 0xFFFFFFFF));
+					if (lineNumber == totalLines)
+					{
+						pending.erase(it);
+					}
+				}
+			}
+		}
+
+		offset = next;
+	}
+	if (offset > blockStart)
+	{
+		blockRanges.push_back(blockStart);
+		blockRanges.push_back(offset - blockStart);
+	}
+	else
+	{
+		blockMmsis.pop_back();
+	}
+
+	// Bloom filters sized for the block with most distinct MMSI
+	std::size_t maxDistinct = 1;
+	for (std::vector<std::vector<uint> >::iterator it = blockMmsis.begin();
+			it != blockMmsis.end(); ++it)
+	{
+		std::sort(it->begin(), it->end());
+		it->erase(std::unique(it->begin(), it->end()), it->end());
+		maxDistinct = std::max(maxDistinct, it->size());
+	}
+	uint64_t bloomBits = 512;
+	while (bloomBits < maxDistinct * impl::BITS_PER_MMSI)
+	{
+		bloomBits <<= 1;
+	}
+
+	impl::Header header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, "AISLIDX1", sizeof(header.magic));
+	header.version = 1;
+	header.hashes = impl::HASHES;
+	header.logSize = log.size();
+	header.blockBytes = blockBytes;
+	header.blocks = blockMmsis.size();
+	header.bloomWords = bloomBits / 64;
+
+	std::vector<uint64_t> bloomData(header.blocks * header.bloomWords, 0);
+	for (std::size_t block = 0; block < blockMmsis.size(); ++block)
+	{
+		uint64_t* words = &bloomData[block * header.bloomWords];
+		for (std::vector<uint>::const_iterator it = blockMmsis[block].begin();
+				it != blockMmsis[block].end(); ++it)
+		{
+			const uint64_t h = impl::hash(*it);
+			const uint64_t step = (h >> 32) | 1;
+			for (uint i = 0; i < impl::HASHES; ++i)
+			{
+				const uint64_t bit = (h + i * step) & (bloomBits - 1);
+				words[bit / 64] |= 1ULL << (bit % 64);
+			}
+		}
+	}
+
+	std::stable_sort(postings.begin(), postings.end(), impl::lessPosting);
+	std::vector<uint32_t> table;
+	std::vector<AISLogIndexEntry> entries;
+	entries.reserve(postings.size());
+	for (std::size_t i = 0; i < postings.size(); ++i)
+	{
+		if (i == 0 || postings[i].mmsi != postings[i - 1].mmsi)
+		{
+			const uint64_t first = i;
+			table.push_back(postings[i].mmsi);
+			table.push_back(0);
+			table.push_back(static_cast<uint32_t>(first));
+			table.push_back(static_cast<uint32_t>(first >> 32));
+		}
+		++table[table.size() - 3];
+		entries.push_back(postings[i].entry);
+	}
+	header.mmsis = table.size() / 4;
+	header.entries = entries.size();
+
+	std::FILE* f = std::fopen(indexPath.c_str(), "wb");
+	if (f == nullptr)
+	{
+		return false;
+	}
+	bool written = std::fwrite(&header, sizeof(header), 1, f) == 1;
+	written = written
+			&& std::fwrite(blockRanges.data(), sizeof(uint64_t),
+					blockRanges.size(), f) == blockRanges.size();
+	written = written
+			&& std::fwrite(bloomData.data(), sizeof(uint64_t),
+					bloomData.size(), f) == bloomData.size();
+	written = written
+			&& std::fwrite(table.data(), sizeof(uint32_t), table.size(), f)
+					== table.size();
+	written = written
+			&& std::fwrite(entries.data(), sizeof(AISLogIndexEntry),
+					entries.size(), f) == entries.size();
+	return std::fclose(f) == 0 && written;
+}
+
+AISLogIndex::AISLogIndex() :
+		blocks(nullptr), blooms(nullptr), mmsis(nullptr), entries(nullptr), indexedSize(
+				0), blockTotal(0), bloomWords(0), mmsiTotal(0), hashes(0)
+{
+
+}
+
+bool AISLogIndex::open(const std::string& indexPath)
+{
+	close();
+	// Queries binary search the sidecar, read ahead would be wasted
+	if (!file.open(indexPath, false) || file.size() < sizeof(impl::Header))
+	{
+		close();
+		return false;
+	}
+
+	impl::Header header;
+	std::memcpy(&header, file.data(), sizeof(header));
+	const uint64_t expected = sizeof(header)
+			+ header.blocks * 2 * sizeof(uint64_t)
+			+ header.blocks * header.bloomWords * sizeof(uint64_t)
+			+ header.mmsis * 4 * sizeof(uint32_t)
+			+ header.entries * sizeof(AISLogIndexEntry);
+	if (std::memcmp(header.magic, "AISLIDX1", sizeof(header.magic)) != 0
+			|| header.version != 1 || header.bloomWords == 0
+			|| (header.bloomWords & (header.bloomWords - 1)) != 0
+			|| expected != file.size())
+	{
+		close();
+		return false;
+	}
+
+	// Every section is a multiple of 8 bytes from a page aligned mapping
+	const char* p = file.data() + sizeof(header);
+	blocks = reinterpret_cast<const uint64_t*>(p);
+	p += header.blocks * 2 * sizeof(uint64_t);
+	blooms = reinterpret_cast<const uint64_t*>(p);
+	p += header.blocks * header.bloomWords * sizeof(uint64_t);
+	mmsis = reinterpret_cast<const uint32_t*>(p);
+	p += header.mmsis * 4 * sizeof(uint32_t);
+	entries = reinterpret_cast<const AISLogIndexEntry*>(p);
+
+	indexedSize = header.logSize;
+	blockTotal = header.blocks;
+	bloomWords = header.bloomWords;
+	mmsiTotal = header.mmsis;
+	hashes = header.hashes;
+	return true;
+}
+
+void AISLogIndex::close()
+{
+	file.close();
+	blocks = nullptr;
+	blooms = nullptr;
+	mmsis = nullptr;
+	entries = nullptr;
+	indexedSize = 0;
+	blockTotal = 0;
+	bloomWords = 0;
+	mmsiTotal = 0;
+	hashes = 0;
+}
+
+uint64_t AISLogIndex::logSize() const
+{
+	return indexedSize;
+}
+
+std::size_t AISLogIndex::mmsiCount() const
+{
+	return mmsiTotal;
+}
+
+std::size_t AISLogIndex::find(uint mmsi,
+		std::vector<AISLogIndexEntry>& result) const
+{
+	// Binary search the MMSI table, 4 words per row
+	std::size_t low = 0;
+	std::size_t high = mmsiTotal;
+	while (low < high)
+	{
+		const std::size_t middle = (low + high) / 2;
+		if (mmsis[middle * 4] < mmsi)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+	if (low == mmsiTotal || mmsis[low * 4] != mmsi)
+	{
+		return 0;
+	}
+
+	const uint32_t* row = mmsis + low * 4;
+	const uint64_t first = row[2] | static_cast<uint64_t>(row[3]) << 32;
+	result.insert(result.end(), entries + first, entries + first + row[1]);
+	return row[1];
+}
+
+std::size_t AISLogIndex::messages(uint mmsi, const NmeaMappedFile& log,
+		std::vector<boost::string_ref>& messages) const
+{
+	std::vector<AISLogIndexEntry> found;
+	find(mmsi, found);
+
+	const std::size_t before = messages.size();
+	for (std::vector<AISLogIndexEntry>::const_iterator it = found.begin();
+			it != found.end(); ++it)
+	{
+		if (it->offset + it->length <= log.size())
+		{
+			messages.push_back(
+					boost::string_ref(log.data() + it->offset, it->length));
+		}
+	}
+	return messages.size() - before;
+}
+
+std::size_t AISLogIndex::blockCount() const
+{
+	return blockTotal;
+}
+
+uint64_t AISLogIndex::blockOffset(std::size_t block) const
+{
+	return blocks[block * 2];
+}
+
+uint64_t AISLogIndex::blockLength(std::size_t block) const
+{
+	return blocks[block * 2 + 1];
+}
+
+bool AISLogIndex::mayContain(std::size_t block, uint mmsi) const
+{
+	const uint64_t* words = blooms + block * bloomWords;
+	const uint64_t mask = bloomWords * 64 - 1;
+	const uint64_t h = impl::hash(mmsi);
+	const uint64_t step = (h >> 32) | 1;
+	for (uint i = 0; i < hashes; ++i)
+	{
+		const uint64_t bit = (h + i * step) & mask;
+		if ((words[bit / 64] & (1ULL << (bit % 64))) == 0)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+std::size_t AISLogIndex::candidateBlocks(const std::vector<uint>& mmsiSet,
+		std::vector<std::size_t>& result) const
+{
+	const std::size_t before = result.size();
+	for (std::size_t block = 0; block < blockTotal; ++block)
+	{
+		for (std::vector<uint>::const_iterator it = mmsiSet.begin();
+				it != mmsiSet.end(); ++it)
+		{
+			if (mayContain(block, *it))
+			{
+				result.push_back(block);
+				break;
+			}
+		}
+	}
+	return result.size() - before;
+}
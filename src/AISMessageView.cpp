@@ -0,0 +1,204 @@
+/**
+ *	@file AISMessageView.cpp
+ *	@brief AISMessageView Implementation
+ */
+
+#include "AISMessageView.h"
+#include "AISFixedString.h"
+
+AISMessageView::AISMessageView()
+{
+
+}
+
+AISMessageView::AISMessageView(boost::string_ref encodedData) :
+		data(encodedData)
+{
+
+}
+
+void AISMessageView::assign(boost::string_ref encodedData)
+{
+	data = encodedData;
+}
+
+int AISMessageView::size() const
+{
+	return static_cast<int>(data.size()) * 6;
+}
+
+int AISMessageView::repeatIndicator() const
+{
+	return getUInt(6, 2);
+}
+
+int AISMessageView::longitudeOffset() const
+{
+	switch (messageType())
+	{
+	case Nmea_AisMessageType_PositionReportClassA:
+	case Nmea_AisMessageType_PositionReportClassA_AssignedSchedule:
+	case Nmea_AisMessageType_PositionReportClassA_ResponseToInterrogation:
+		return 61;
+	case Nmea_AisMessageType_BaseStationReport:
+		return 79;
+	case Nmea_AisMessageType_StandardClassBCSPositionReport:
+	case Nmea_AisMessageType_ExtendedClassBEquipmentPositionReport:
+		return 57;
+	case Nmea_AisMessageType_AidToNavigationReport:
+		return 164;
+	default:
+		return -1;
+	}
+}
+
+int AISMessageView::speedOffset() const
+{
+	switch (messageType())
+	{
+	case Nmea_AisMessageType_PositionReportClassA:
+	case Nmea_AisMessageType_PositionReportClassA_AssignedSchedule:
+	case Nmea_AisMessageType_PositionReportClassA_ResponseToInterrogation:
+		return 50;
+	case Nmea_AisMessageType_StandardClassBCSPositionReport:
+	case Nmea_AisMessageType_ExtendedClassBEquipmentPositionReport:
+		return 46;
+	default:
+		return -1;
+	}
+}
+
+bool AISMessageView::hasPosition() const
+{
+	const int offset = longitudeOffset();
+	// Longitude (28 bits) is followed by Latitude (27 bits)
+	return offset >= 0 && size() >= offset + 55;
+}
+
+float AISMessageView::longitude() const
+{
+	const int offset = longitudeOffset();
+	return offset < 0 ? 181.0f : getInt(offset, 28) / 600000.0f;
+}
+
+float AISMessageView::latitude() const
+{
+	const int offset = longitudeOffset();
+	return offset < 0 ? 91.0f : getInt(offset + 28, 27) / 600000.0f;
+}
+
+float AISMessageView::speedOverGround() const
+{
+	const int offset = speedOffset();
+	return offset < 0 ? 102.3f : getUInt(offset, 10) * 0.1f;
+}
+
+float AISMessageView::courseOverGround() const
+{
+	const int offset = speedOffset();
+	return offset < 0 ? 360.0f : getUInt(offset + 66, 12) * 0.1f;
+}
+
+uint AISMessageView::trueHeading() const
+{
+	const int offset = speedOffset();
+	return offset < 0 ? 511 : getUInt(offset + 78, 9);
+}
+
+Nmea_NavigationStatus AISMessageView::navigationStatus() const
+{
+	switch (messageType())
+	{
+	case Nmea_AisMessageType_PositionReportClassA:
+	case Nmea_AisMessageType_PositionReportClassA_AssignedSchedule:
+	case Nmea_AisMessageType_PositionReportClassA_ResponseToInterrogation:
+		return static_cast<Nmea_NavigationStatus>(getUInt(38, 4));
+	default:
+		return Nmea_NavigationStatus_NotDefined;
+	}
+}
+
+AISFixedString<34> AISMessageView::vesselName() const
+{
+	AISFixedString<34> name;
+	switch (messageType())
+	{
+	case Nmea_AisMessageType_StaticAndVoyageRelatedData:
+		getString(112, 20, name);
+		break;
+	case Nmea_AisMessageType_ExtendedClassBEquipmentPositionReport:
+		getString(143, 20, name);
+		break;
+	case Nmea_AisMessageType_StaticDataReport:
+		if (getUInt(38, 2) == 0)
+		{
+			getString(40, 20, name);
+		}
+		break;
+	case Nmea_AisMessageType_AidToNavigationReport:
+	{
+		// Name extension follows the 272 bits of the fixed part
+		getString(43, 20, name);
+		const int extensionChars = (size() - 272) / 6;
+		if (extensionChars > 0)
+		{
+			AISFixedString<14> extension;
+			getString(272, extensionChars, extension);
+			name.append(extension.data(), extension.size());
+		}
+		break;
+	}
+	default:
+		break;
+	}
+	return name;
+}
+
+AISFixedString<7> AISMessageView::callsign() const
+{
+	AISFixedString<7> callsign;
+	switch (messageType())
+	{
+	case Nmea_AisMessageType_StaticAndVoyageRelatedData:
+		getString(70, 7, callsign);
+		break;
+	case Nmea_AisMessageType_StaticDataReport:
+		if (getUInt(38, 2) == 1)
+		{
+			getString(90, 7, callsign);
+		}
+		break;
+	default:
+		break;
+	}
+	return callsign;
+}
+
+AISFixedString<20> AISMessageView::destination() const
+{
+	AISFixedString<20> destination;
+	if (messageType() == Nmea_AisMessageType_StaticAndVoyageRelatedData)
+	{
+		getString(302, 20, destination);
+	}
+	return destination;
+}
+
+Nmea_ShipType AISMessageView::shipType() const
+{
+	switch (messageType())
+	{
+	case Nmea_AisMessageType_StaticAndVoyageRelatedData:
+		return static_cast<Nmea_ShipType>(getUInt(232, 8));
+	case Nmea_AisMessageType_ExtendedClassBEquipmentPositionReport:
+		return static_cast<Nmea_ShipType>(getUInt(263, 8));
+	case Nmea_AisMessageType_StaticDataReport:
+		if (getUInt(38, 2) == 1)
+		{
+			return static_cast<Nmea_ShipType>(getUInt(40, 8));
+		}
+		return Nmea_ShipType_NotAvailable;
+	default:
+		return Nmea_ShipType_NotAvailable;
+	}
+}
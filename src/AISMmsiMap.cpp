@@ -0,0 +1,161 @@
+/**
+ *	@file AISMmsiMap.cpp
+ *	@brief AISMmsiMap Implementation
+ */
+
+#include "AISMmsiMap.h"
+
+const uint AISMmsiMap::NPOS;
+
+AISMmsiMap::AISMmsiMap(uint capacity) :
+		slotMmsi(capacity, NPOS), mask(0), shift(31), count(0)
+{
+	// At least twice the capacity, rounded up to a power of two
+	uint bucketCount = 2;
+	while (bucketCount < 2 * static_cast<unsigned long long>(capacity))
+	{
+		bucketCount <<= 1;
+		--shift;
+	}
+	mask = bucketCount - 1;
+
+	Bucket empty = { NPOS, NPOS };
+	buckets.assign(bucketCount, empty);
+
+	freeSlots.reserve(capacity);
+	clear();
+}
+
+inline uint AISMmsiMap::home(uint mmsi) const
+{
+	// Fibonacci hashing: consecutive MMSI spread over the table
+	return (mmsi * 2654435769U) >> shift;
+}
+
+uint AISMmsiMap::find(uint mmsi) const
+{
+	uint i = home(mmsi);
+	while (buckets[i].mmsi != NPOS)
+	{
+		if (buckets[i].mmsi == mmsi)
+		{
+			return buckets[i].slot;
+		}
+		i = (i + 1) & mask;
+	}
+	return NPOS;
+}
+
+uint AISMmsiMap::insert(uint mmsi, bool& inserted)
+{
+	inserted = false;
+
+	if (mmsi == NPOS)
+	{
+		return NPOS;
+	}
+
+	uint i = home(mmsi);
+	while (buckets[i].mmsi != NPOS)
+	{
+		if (buckets[i].mmsi == mmsi)
+		{
+			return buckets[i].slot;
+		}
+		i = (i + 1) & mask;
+	}
+
+	if (freeSlots.empty())
+	{
+		return NPOS;
+	}
+
+	const uint slot = freeSlots.back();
+	freeSlots.pop_back();
+
+	buckets[i].mmsi = mmsi;
+	buckets[i].slot = slot;
+	slotMmsi[slot] = mmsi;
+	++count;
+	inserted = true;
+
+	return slot;
+}
+
+bool AISMmsiMap::erase(uint mmsi)
+{
+	if (mmsi == NPOS)
+	{
+		return false;
+	}
+
+	uint i = home(mmsi);
+	while (buckets[i].mmsi != mmsi)
+	{
+		if (buckets[i].mmsi == NPOS)
+		{
+			return false;
+		}
+		i = (i + 1) & mask;
+	}
+
+	const uint slot = buckets[i].slot;
+	slotMmsi[slot] = NPOS;
+	freeSlots.push_back(slot);
+	--count;
+
+	// Backward shift: move back entries whose probe sequence crosses the hole
+	uint hole = i;
+	uint j = (i + 1) & mask;
+	while (buckets[j].mmsi != NPOS)
+	{
+		const uint h = home(buckets[j].mmsi);
+		// Entry at j may fill the hole if its home is not in (hole, j]
+		if (((j - h) & mask) >= ((j - hole) & mask))
+		{
+			buckets[hole] = buckets[j];
+			hole = j;
+		}
+		j = (j + 1) & mask;
+	}
+	buckets[hole].mmsi = NPOS;
+	buckets[hole].slot = NPOS;
+
+	return true;
+}
+
+void AISMmsiMap::clear()
+{
+	for (std::vector<Bucket>::iterator it = buckets.begin();
+			it != buckets.end(); ++it)
+	{
+		it->mmsi = NPOS;
+		it->slot = NPOS;
+	}
+
+	slotMmsi.assign(slotMmsi.size(), NPOS);
+
+	// Lowest slots are handed out first
+	freeSlots.clear();
+	for (uint slot = slotMmsi.size(); slot > 0; --slot)
+	{
+		freeSlots.push_back(slot - 1);
+	}
+
+	count = 0;
+}
+
+uint AISMmsiMap::mmsiAt(uint slot) const
+{
+	return slot < slotMmsi.size() ? slotMmsi[slot] : NPOS;
+}
+
+uint AISMmsiMap::size() const
+{
+	return count;
+}
+
+uint AISMmsiMap::capacity() const
+{
+	return slotMmsi.size();
+}
@@ -0,0 +1,302 @@
+/**
+ *	@file AISSpatialIndex.cpp
+ *	@brief AISSpatialIndex Implementation
+ */
+
+#include "AISSpatialIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Private Implementation
+ */
+class AISSpatialIndex::impl
+{
+public:
+	/**
+	 * @brief Mean Earth radius in nautical miles
+	 */
+	static const double EARTH_RADIUS;
+
+	/**
+	 * @brief Degrees to radians
+	 */
+	static const double DEG_TO_RAD;
+
+	/**
+	 * @brief Great circle distance, haversine formula
+	 *
+	 * @param [in] lon1 First longitude
+	 * @param [in] lat1 First latitude
+	 * @param [in] lon2 Second longitude
+	 * @param [in] lat2 Second latitude
+	 *
+	 * @return Distance in nautical miles.
+	 */
+	static double distance(double lon1, double lat1, double lon2, double lat2);
+
+	/**
+	 * @brief Accepts vessels inside a bounding box
+	 */
+	struct InBox
+	{
+		float minLongitude; //!< West border
+		float minLatitude; //!< South border
+		float maxLongitude; //!< East border
+		float maxLatitude; //!< North border
+
+		/**
+		 * @brief Test
+		 *
+		 * @param [in] node Vessel entry
+		 *
+		 * @return True if inside.
+		 */
+		bool operator()(const Node& node) const
+		{
+			const bool longitude =
+					minLongitude <= maxLongitude ?
+							node.longitude >= minLongitude
+									&& node.longitude <= maxLongitude :
+							node.longitude >= minLongitude
+									|| node.longitude <= maxLongitude;
+			return longitude && node.latitude >= minLatitude
+					&& node.latitude <= maxLatitude;
+		}
+	};
+
+	/**
+	 * @brief Accepts vessels within a distance
+	 */
+	struct InRadius
+	{
+		double longitude; //!< Center longitude
+		double latitude; //!< Center latitude
+		double radius; //!< Distance in nautical miles
+
+		/**
+		 * @brief Test
+		 *
+		 * @param [in] node Vessel entry
+		 *
+		 * @return True if within the distance.
+		 */
+		bool operator()(const Node& node) const
+		{
+			return distance(longitude, latitude, node.longitude, node.latitude)
+					<= radius;
+		}
+	};
+};
+
+const double AISSpatialIndex::impl::EARTH_RADIUS = 3440.065;
+const double AISSpatialIndex::impl::DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+
+AISSpatialIndex::AISSpatialIndex(uint capacity, float cellSize) :
+		index(capacity), nodes(capacity), grid(cellSize)
+{
+	cells.assign(static_cast<std::size_t>(grid.columns) * grid.rows,
+			AISMmsiMap::NPOS);
+}
+
+double AISSpatialIndex::impl::distance(double lon1, double lat1, double lon2,
+		double lat2)
+{
+	const double sinLat = std::sin((lat2 - lat1) * DEG_TO_RAD / 2);
+	const double sinLon = std::sin((lon2 - lon1) * DEG_TO_RAD / 2);
+	const double a = sinLat * sinLat
+			+ std::cos(lat1 * DEG_TO_RAD) * std::cos(lat2 * DEG_TO_RAD)
+					* sinLon * sinLon;
+	return 2 * EARTH_RADIUS * std::asin(std::min(1.0, std::sqrt(a)));
+}
+
+void AISSpatialIndex::unlink(uint slot)
+{
+	Node& node = nodes[slot];
+	if (node.prev != AISMmsiMap::NPOS)
+	{
+		nodes[node.prev].next = node.next;
+	}
+	else
+	{
+		cells[node.cell] = node.next;
+	}
+	if (node.next != AISMmsiMap::NPOS)
+	{
+		nodes[node.next].prev = node.prev;
+	}
+}
+
+void AISSpatialIndex::link(uint slot, uint cell)
+{
+	Node& node = nodes[slot];
+	node.cell = cell;
+	node.prev = AISMmsiMap::NPOS;
+	node.next = cells[cell];
+	if (node.next != AISMmsiMap::NPOS)
+	{
+		nodes[node.next].prev = slot;
+	}
+	cells[cell] = slot;
+}
+
+bool AISSpatialIndex::update(uint mmsi, float longitude, float latitude)
+{
+	if (!aisValidPosition(longitude, latitude))
+	{
+		erase(mmsi);
+		return true;
+	}
+
+	bool inserted;
+	const uint slot = index.insert(mmsi, inserted);
+	if (slot == AISMmsiMap::NPOS)
+	{
+		return false;
+	}
+
+	const uint cell = grid.cellOf(longitude, latitude);
+	if (inserted)
+	{
+		link(slot, cell);
+	}
+	else if (nodes[slot].cell != cell)
+	{
+		unlink(slot);
+		link(slot, cell);
+	}
+
+	nodes[slot].longitude = longitude;
+	nodes[slot].latitude = latitude;
+	return true;
+}
+
+bool AISSpatialIndex::erase(uint mmsi)
+{
+	const uint slot = index.find(mmsi);
+	if (slot == AISMmsiMap::NPOS)
+	{
+		return false;
+	}
+	unlink(slot);
+	return index.erase(mmsi);
+}
+
+void AISSpatialIndex::clear()
+{
+	index.clear();
+	std::fill(cells.begin(), cells.end(), AISMmsiMap::NPOS);
+}
+
+bool AISSpatialIndex::find(uint mmsi, float& longitude, float& latitude) const
+{
+	const uint slot = index.find(mmsi);
+	if (slot == AISMmsiMap::NPOS)
+	{
+		return false;
+	}
+	longitude = nodes[slot].longitude;
+	latitude = nodes[slot].latitude;
+	return true;
+}
+
+template<typename Accept>
+void AISSpatialIndex::scan(int minColumn, int maxColumn, int minRow,
+		int maxRow, const Accept& accept, std::vector<uint>& mmsi) const
+{
+	if (maxColumn - minColumn + 1 >= grid.columns)
+	{
+		minColumn = 0;
+		maxColumn = grid.columns - 1;
+	}
+	minRow = std::max(minRow, 0);
+	maxRow = std::min(maxRow, grid.rows - 1);
+
+	for (int row = minRow; row <= maxRow; ++row)
+	{
+		for (int c = minColumn; c <= maxColumn; ++c)
+		{
+			const int column = ((c % grid.columns) + grid.columns) % grid.columns;
+			uint slot = cells[row * grid.columns + column];
+			while (slot != AISMmsiMap::NPOS)
+			{
+				const Node& node = nodes[slot];
+				if (accept(node))
+				{
+					mmsi.push_back(index.mmsiAt(slot));
+				}
+				slot = node.next;
+			}
+		}
+	}
+}
+
+std::size_t AISSpatialIndex::queryBox(float minLongitude, float minLatitude,
+		float maxLongitude, float maxLatitude, std::vector<uint>& mmsi) const
+{
+	mmsi.clear();
+
+	const uint minCell = grid.cellOf(minLongitude, minLatitude);
+	const uint maxCell = grid.cellOf(maxLongitude, maxLatitude);
+	const int minColumn = minCell % grid.columns;
+	int maxColumn = maxCell % grid.columns;
+	if (minLongitude > maxLongitude)
+	{
+		// Crosses the antimeridian, columns wrap around
+		maxColumn += grid.columns;
+	}
+
+	const impl::InBox accept = { minLongitude, minLatitude, maxLongitude,
+			maxLatitude };
+	scan(minColumn, maxColumn, minCell / grid.columns, maxCell / grid.columns, accept,
+			mmsi);
+
+	return mmsi.size();
+}
+
+std::size_t AISSpatialIndex::queryRadius(float longitude, float latitude,
+		float radius, std::vector<uint>& mmsi) const
+{
+	mmsi.clear();
+
+	// One nautical mile is one minute of latitude
+	const double latitudeSpan = radius / 60.0;
+	const double south = latitude - latitudeSpan;
+	const double north = latitude + latitudeSpan;
+
+	int minColumn = 0;
+	int maxColumn = grid.columns - 1;
+	if (south > -90.0 && north < 90.0)
+	{
+		// Widest longitude span is at the border closest to a pole
+		const double widest = std::max(std::fabs(south), std::fabs(north));
+		const double longitudeSpan = latitudeSpan
+				/ std::cos(widest * impl::DEG_TO_RAD);
+		if (longitudeSpan < 180.0)
+		{
+			minColumn = static_cast<int>(std::floor(
+					(longitude - longitudeSpan + 180.0) / grid.cellSize));
+			maxColumn = static_cast<int>(std::floor(
+					(longitude + longitudeSpan + 180.0) / grid.cellSize));
+		}
+	}
+
+	const int minRow = static_cast<int>(std::floor((south + 90.0) / grid.cellSize));
+	const int maxRow = static_cast<int>(std::floor((north + 90.0) / grid.cellSize));
+
+	const impl::InRadius accept = { longitude, latitude, radius };
+	scan(minColumn, maxColumn, minRow, maxRow, accept, mmsi);
+
+	return mmsi.size();
+}
+
+uint AISSpatialIndex::size() const
+{
+	return index.size();
+}
+
+uint AISSpatialIndex::capacity() const
+{
+	return index.capacity();
+}
@@ -0,0 +1,218 @@
+/**
+ *	@file AISStaticDataCache.cpp
+ *	@brief AISStaticDataCache Implementation
+ */
+
+#include "AISStaticDataCache.h"
+#include "AISMessageView.h"
+#include "AISPayloadHash.h"
+#include "NmeaParser.h"
+
+#include <algorithm>
+
+/**
+ * @brief Private Implementation
+ */
+class AISStaticDataCache::impl
+{
+public:
+	/**
+	 * @brief Returns the cached record or decodes the payload into the table
+	 *
+	 * @param [in,out] table Records of the message kind
+	 * @param [in,out] stats Counters
+	 * @param [in] encodedData AIS Binary Encoded Data
+	 * @param [in] parse NmeaParser method decoding the message kind
+	 *
+	 * @return Decoded record, nullptr if the message is not valid.
+	 */
+	template<typename Record>
+	static const Record* lookup(Table<Record>& table,
+			AISStaticDataCacheStatistics& stats, const std::string& encodedData,
+			bool (*parse)(const std::string&, Record&));
+
+	/**
+	 * @brief Finds the slot of a MMSI, evicting another MMSI if full
+	 *
+	 * @param [in,out] table Records of the message kind
+	 * @param [in,out] stats Counters
+	 * @param [in] mmsi MMSI
+	 *
+	 * @return Slot index.
+	 */
+	template<typename Record>
+	static uint acquire(Table<Record>& table,
+			AISStaticDataCacheStatistics& stats, uint mmsi);
+
+	/**
+	 * @brief Drops every record of a table
+	 *
+	 * @param [in,out] table Records of the message kind
+	 */
+	template<typename Record>
+	static void clear(Table<Record>& table);
+};
+
+double AISStaticDataCacheStatistics::hitRate() const
+{
+	const uint64_t lookups = hits + misses;
+	return lookups == 0 ? 0.0 : static_cast<double>(hits) / lookups;
+}
+
+template<typename Record>
+AISStaticDataCache::Table<Record>::Table(uint capacity) :
+		index(capacity), hash(capacity), record(capacity), referenced(
+				capacity), hand(0)
+{
+
+}
+
+AISStaticDataCache::AISStaticDataCache(uint capacity) :
+		voyage(std::max(capacity, 1u)), partA(std::max(capacity, 1u)), partB(
+				std::max(capacity, 1u))
+{
+	resetStatistics();
+}
+
+template<typename Record>
+uint AISStaticDataCache::impl::acquire(Table<Record>& table,
+		AISStaticDataCacheStatistics& stats, uint mmsi)
+{
+	bool inserted;
+	uint slot = table.index.insert(mmsi, inserted);
+	if (slot != AISMmsiMap::NPOS)
+	{
+		return slot;
+	}
+
+	// Full: sweep until a slot not used since the last pass is found
+	const uint capacity = table.index.capacity();
+	while (table.referenced[table.hand])
+	{
+		table.referenced[table.hand] = false;
+		table.hand = (table.hand + 1) % capacity;
+	}
+
+	table.index.erase(table.index.mmsiAt(table.hand));
+	table.hand = (table.hand + 1) % capacity;
+	++stats.evictions;
+
+	return table.index.insert(mmsi, inserted);
+}
+
+template<typename Record>
+const Record* AISStaticDataCache::impl::lookup(Table<Record>& table,
+		AISStaticDataCacheStatistics& stats, const std::string& encodedData,
+		bool (*parse)(const std::string&, Record&))
+{
+	const uint mmsi = AISMessageView(encodedData).mmsi();
+	const uint64_t hash = aisPayloadHash(encodedData);
+
+	uint slot = table.index.find(mmsi);
+	if (slot != AISMmsiMap::NPOS && table.hash[slot] == hash)
+	{
+		++stats.hits;
+		table.referenced[slot] = true;
+		return &table.record[slot];
+	}
+
+	++stats.misses;
+
+	Record data;
+	if (!parse(encodedData, data))
+	{
+		return nullptr;
+	}
+
+	if (slot == AISMmsiMap::NPOS)
+	{
+		slot = acquire(table, stats, mmsi);
+	}
+
+	table.hash[slot] = hash;
+	table.record[slot] = data;
+	table.referenced[slot] = true;
+	return &table.record[slot];
+}
+
+template<typename Record>
+void AISStaticDataCache::impl::clear(Table<Record>& table)
+{
+	table.index.clear();
+	table.referenced.assign(table.referenced.size(), false);
+	table.hand = 0;
+}
+
+const AISStaticAndVoyageRelatedData* AISStaticDataCache::parseAISStaticAndVoyageRelatedData(
+		const std::string& encodedData)
+{
+	return impl::lookup(voyage, stats, encodedData,
+			&NmeaParser::parseAISStaticAndVoyageRelatedData);
+}
+
+bool AISStaticDataCache::parseAISStaticAndVoyageRelatedData(
+		const std::string& encodedData, AISStaticAndVoyageRelatedData& data)
+{
+	const AISStaticAndVoyageRelatedData* cached =
+			parseAISStaticAndVoyageRelatedData(encodedData);
+	if (cached == nullptr)
+	{
+		return false;
+	}
+	data = *cached;
+	return true;
+}
+
+const AISStaticDataReport* AISStaticDataCache::parseAISStaticDataReport(
+		const std::string& encodedData)
+{
+	// Part A and part B carry different fields, each has its own record
+	if (AISMessageView(encodedData).getUInt(38, 2) == 0)
+	{
+		return impl::lookup(partA, stats, encodedData,
+				&NmeaParser::parseAISStaticDataReport);
+	}
+	return impl::lookup(partB, stats, encodedData,
+			&NmeaParser::parseAISStaticDataReport);
+}
+
+bool AISStaticDataCache::parseAISStaticDataReport(
+		const std::string& encodedData, AISStaticDataReport& data)
+{
+	const AISStaticDataReport* cached = parseAISStaticDataReport(encodedData);
+	if (cached == nullptr)
+	{
+		return false;
+	}
+	data = *cached;
+	return true;
+}
+
+void AISStaticDataCache::clear()
+{
+	impl::clear(voyage);
+	impl::clear(partA);
+	impl::clear(partB);
+}
+
+uint AISStaticDataCache::size() const
+{
+	return voyage.index.size() + partA.index.size() + partB.index.size();
+}
+
+uint AISStaticDataCache::capacity() const
+{
+	return voyage.index.capacity();
+}
+
+const AISStaticDataCacheStatistics& AISStaticDataCache::statistics() const
+{
+	return stats;
+}
+
+void AISStaticDataCache::resetStatistics()
+{
+	stats.hits = 0;
+	stats.misses = 0;
+	stats.evictions = 0;
+}
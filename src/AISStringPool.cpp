@@ -0,0 +1,103 @@
+/**
+ *	@file AISStringPool.cpp
+ *	@brief AISStringPool Implementation
+ */
+
+#include "AISStringPool.h"
+#include "AISPayloadHash.h"
+
+#include <cstring>
+
+const uint AISStringPool::NPOS;
+
+AISStringPool::AISStringPool(uint maxStrings, std::size_t maxBytes) :
+		text(maxBytes), entries(maxStrings + 1), count(1), used(0), mask(0)
+{
+	// Buckets are kept at most half full
+	uint bucketCount = 2;
+	while (bucketCount < 2 * (maxStrings + 1))
+	{
+		bucketCount <<= 1;
+	}
+	buckets.assign(bucketCount, 0);
+	mask = bucketCount - 1;
+
+	entries[0].offset = 0;
+	entries[0].length = 0;
+	buckets[probe(boost::string_ref())] = 1;
+}
+
+uint AISStringPool::probe(boost::string_ref value) const
+{
+	uint bucket = static_cast<uint>(aisPayloadHash(value)) & mask;
+	while (buckets[bucket] != 0)
+	{
+		const Entry& entry = entries[buckets[bucket] - 1];
+		if (entry.length == value.size()
+				&& std::memcmp(text.data() + entry.offset, value.data(),
+						entry.length) == 0)
+		{
+			break;
+		}
+		bucket = (bucket + 1) & mask;
+	}
+	return bucket;
+}
+
+uint AISStringPool::find(boost::string_ref value) const
+{
+	const uint slot = buckets[probe(value)];
+	return slot == 0 ? NPOS : slot - 1;
+}
+
+uint AISStringPool::intern(boost::string_ref value)
+{
+	const uint bucket = probe(value);
+	if (buckets[bucket] != 0)
+	{
+		return buckets[bucket] - 1;
+	}
+
+	const uint handle = count.load(std::memory_order_relaxed);
+	if (handle >= entries.size() || value.size() > text.size() - used)
+	{
+		return NPOS;
+	}
+
+	std::memcpy(text.data() + used, value.data(), value.size());
+	entries[handle].offset = static_cast<uint32_t>(used);
+	entries[handle].length = static_cast<uint32_t>(value.size());
+	used += value.size();
+	buckets[bucket] = handle + 1;
+
+	// Text and entry are visible to readers that see the new count
+	count.store(handle + 1, std::memory_order_release);
+
+	return handle;
+}
+
+boost::string_ref AISStringPool::get(uint handle) const
+{
+	if (handle >= count.load(std::memory_order_acquire))
+	{
+		return boost::string_ref();
+	}
+	const Entry& entry = entries[handle];
+	return boost::string_ref(text.data() + entry.offset, entry.length);
+}
+
+uint AISStringPool::size() const
+{
+	return count.load(std::memory_order_acquire);
+}
+
+std::size_t AISStringPool::textBytes() const
+{
+	return used;
+}
+
+std::size_t AISStringPool::memoryUsage() const
+{
+	return text.capacity() + entries.capacity() * sizeof(Entry)
+			+ buckets.capacity() * sizeof(uint);
+}
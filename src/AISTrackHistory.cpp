@@ -0,0 +1,202 @@
+/**
+ *	@file AISTrackHistory.cpp
+ *	@brief AISTrackHistory Implementation
+ */
+
+#include "AISTrackHistory.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+
+/**
+ * @brief Wire units per degree of longitude or latitude
+ */
+const float POSITION_SCALE = 600000.0f;
+
+/**
+ * @brief Largest time delta a point can hold
+ */
+const int64_t MAX_DELTA = std::numeric_limits<uint32_t>::max();
+
+/**
+ * @brief Converts a value to tenths, saturated to the uint16_t range
+ *
+ * @param [in] value Value
+ *
+ * @return Tenths.
+ */
+uint16_t toTenths(float value)
+{
+	const float tenths = std::floor(value * 10.0f + 0.5f);
+	if (!(tenths > 0.0f))
+	{
+		return 0;
+	}
+	return tenths >= 65535.0f ? 65535 : static_cast<uint16_t>(tenths);
+}
+
+}
+
+AISTrackHistory::AISTrackHistory(uint capacity, uint pointsPerTrack) :
+		index(capacity), ring(std::min(std::max(pointsPerTrack, 1u), 65535u)), tracks(
+				capacity), points(static_cast<std::size_t>(capacity) * ring)
+{
+
+}
+
+void AISTrackHistory::rebase(uint slot, int64_t timestamp)
+{
+	Track& t = tracks[slot];
+	AISTrackPoint* p = &points[static_cast<std::size_t>(slot) * ring];
+
+	while (t.count > 0 && timestamp - (t.baseTime + p[t.first].timeDelta) > MAX_DELTA)
+	{
+		t.first = static_cast<uint16_t>((t.first + 1) % ring);
+		--t.count;
+	}
+
+	if (t.count == 0)
+	{
+		t.baseTime = timestamp;
+		return;
+	}
+
+	const uint32_t shift = p[t.first].timeDelta;
+	for (uint i = 0; i < t.count; ++i)
+	{
+		p[(t.first + i) % ring].timeDelta -= shift;
+	}
+	t.baseTime += shift;
+}
+
+bool AISTrackHistory::append(uint mmsi, float longitude, float latitude,
+		float speedOverGround, float courseOverGround, int64_t timestamp)
+{
+	if (!aisValidPosition(longitude, latitude))
+	{
+		return false;
+	}
+
+	bool inserted;
+	const uint slot = index.insert(mmsi, inserted);
+	if (slot == AISMmsiMap::NPOS)
+	{
+		return false;
+	}
+
+	Track& t = tracks[slot];
+	if (inserted)
+	{
+		t.baseTime = timestamp;
+		t.first = 0;
+		t.count = 0;
+	}
+	else if (timestamp - t.baseTime > MAX_DELTA)
+	{
+		rebase(slot, timestamp);
+	}
+
+	uint position = t.first + t.count;
+	if (t.count == ring)
+	{
+		// Full, overwrite the oldest point
+		position = t.first;
+		t.first = static_cast<uint16_t>((t.first + 1) % ring);
+	}
+	else
+	{
+		++t.count;
+	}
+
+	AISTrackPoint& p = points[static_cast<std::size_t>(slot) * ring
+			+ position % ring];
+	p.longitude = static_cast<int32_t>(std::lround(longitude * POSITION_SCALE));
+	p.latitude = static_cast<int32_t>(std::lround(latitude * POSITION_SCALE));
+	p.timeDelta = static_cast<uint32_t>(std::max<int64_t>(0,
+			timestamp - t.baseTime));
+	p.speedOverGround = toTenths(speedOverGround);
+	p.courseOverGround = toTenths(courseOverGround);
+	return true;
+}
+
+bool AISTrackHistory::append(const AISPositionReportClassA& data,
+		int64_t timestamp)
+{
+	return append(data.mmsi, data.longitude, data.latitude,
+			data.speedOverGround, data.courseOverGround, timestamp);
+}
+
+bool AISTrackHistory::append(const AISStandardClassBCSPositionReport& data,
+		int64_t timestamp)
+{
+	return append(data.mmsi, data.longitude, data.latitude,
+			data.speedOverGround, data.courseOverGround, timestamp);
+}
+
+bool AISTrackHistory::append(const AISExtendedClassBCSPositionReport& data,
+		int64_t timestamp)
+{
+	return append(data.mmsi, data.longitude, data.latitude,
+			data.speedOverGround, data.courseOverGround, timestamp);
+}
+
+std::size_t AISTrackHistory::trackSize(uint mmsi) const
+{
+	const uint slot = index.find(mmsi);
+	return slot == AISMmsiMap::NPOS ? 0 : tracks[slot].count;
+}
+
+std::size_t AISTrackHistory::track(uint mmsi,
+		std::vector<AISTrackPosition>& track) const
+{
+	track.clear();
+	const uint slot = index.find(mmsi);
+	if (slot == AISMmsiMap::NPOS)
+	{
+		return 0;
+	}
+
+	const Track& t = tracks[slot];
+	const AISTrackPoint* p = &points[static_cast<std::size_t>(slot) * ring];
+	track.resize(t.count);
+	for (uint i = 0; i < t.count; ++i)
+	{
+		const AISTrackPoint& point = p[(t.first + i) % ring];
+		AISTrackPosition& position = track[i];
+		position.longitude = point.longitude / POSITION_SCALE;
+		position.latitude = point.latitude / POSITION_SCALE;
+		position.speedOverGround = point.speedOverGround / 10.0f;
+		position.courseOverGround = point.courseOverGround / 10.0f;
+		position.timestamp = t.baseTime + point.timeDelta;
+	}
+	return track.size();
+}
+
+bool AISTrackHistory::erase(uint mmsi)
+{
+	return index.erase(mmsi);
+}
+
+uint AISTrackHistory::size() const
+{
+	return index.size();
+}
+
+uint AISTrackHistory::capacity() const
+{
+	return index.capacity();
+}
+
+uint AISTrackHistory::pointsPerTrack() const
+{
+	return ring;
+}
+
+std::size_t AISTrackHistory::memoryUsage() const
+{
+	return tracks.size() * sizeof(Track) + points.size() * sizeof(AISTrackPoint);
+}
@@ -0,0 +1,154 @@
+/**
+ *	@file AISTrajectoryCompressor.cpp
+ *	@brief AISTrajectoryCompressor Implementation
+ */
+
+#include "AISTrajectoryCompressor.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+/**
+ * @brief Degrees to radians
+ */
+const float DEG_TO_RAD = 3.14159265358979323846f / 180.0f;
+
+/**
+ * @brief Milliseconds per hour, knots to nautical miles per millisecond
+ */
+const float MS_PER_HOUR = 3600000.0f;
+
+}
+
+double AISTrajectoryCompressorStatistics::compressionRatio() const
+{
+	return kept == 0 ? 1.0 : static_cast<double>(points) / kept;
+}
+
+AISTrajectoryCompressor::AISTrajectoryCompressor(uint capacity,
+		float tolerance, int64_t maxInterval) :
+		index(capacity), anchors(capacity), tolerance(tolerance), maxInterval(
+				maxInterval)
+{
+	resetStatistics();
+}
+
+void AISTrajectoryCompressor::keep(Anchor& anchor, float longitude,
+		float latitude, float speedOverGround, float courseOverGround,
+		int64_t timestamp)
+{
+	anchor.timestamp = timestamp;
+	anchor.longitude = longitude;
+	anchor.latitude = latitude;
+	if (aisValidMotion(speedOverGround, courseOverGround))
+	{
+		const float speed = speedOverGround / MS_PER_HOUR;
+		anchor.velocityEast = speed * std::sin(courseOverGround * DEG_TO_RAD);
+		anchor.velocityNorth = speed * std::cos(courseOverGround * DEG_TO_RAD);
+	}
+	else
+	{
+		anchor.velocityEast = 0.0f;
+		anchor.velocityNorth = 0.0f;
+	}
+}
+
+bool AISTrajectoryCompressor::update(uint mmsi, float longitude,
+		float latitude, float speedOverGround, float courseOverGround,
+		int64_t timestamp)
+{
+	if (!aisValidPosition(longitude, latitude))
+	{
+		return false;
+	}
+
+	++stats.points;
+
+	bool inserted;
+	const uint slot = index.insert(mmsi, inserted);
+	if (slot == AISMmsiMap::NPOS)
+	{
+		++stats.kept;
+		return true;
+	}
+
+	Anchor& anchor = anchors[slot];
+	const int64_t elapsed = timestamp - anchor.timestamp;
+	if (!inserted && (maxInterval == 0 || elapsed < maxInterval))
+	{
+		// Error of the dead reckoning prediction, local flat Earth
+		const float dt = static_cast<float>(std::max<int64_t>(elapsed, 0));
+		float deltaLongitude = longitude - anchor.longitude;
+		if (deltaLongitude > 180.0f)
+		{
+			deltaLongitude -= 360.0f;
+		}
+		else if (deltaLongitude < -180.0f)
+		{
+			deltaLongitude += 360.0f;
+		}
+		const float meanLatitude = (latitude + anchor.latitude) * 0.5f;
+		const float errorEast = deltaLongitude * 60.0f
+				* std::cos(meanLatitude * DEG_TO_RAD) - anchor.velocityEast * dt;
+		const float errorNorth = (latitude - anchor.latitude) * 60.0f
+				- anchor.velocityNorth * dt;
+		const float error = std::sqrt(
+				errorEast * errorEast + errorNorth * errorNorth);
+		if (error <= tolerance)
+		{
+			stats.maxError = std::max(stats.maxError, error);
+			return false;
+		}
+	}
+
+	keep(anchor, longitude, latitude, speedOverGround, courseOverGround,
+			timestamp);
+	++stats.kept;
+	return true;
+}
+
+bool AISTrajectoryCompressor::update(const AISPositionReportClassA& data,
+		int64_t timestamp)
+{
+	return update(data.mmsi, data.longitude, data.latitude,
+			data.speedOverGround, data.courseOverGround, timestamp);
+}
+
+bool AISTrajectoryCompressor::update(
+		const AISStandardClassBCSPositionReport& data, int64_t timestamp)
+{
+	return update(data.mmsi, data.longitude, data.latitude,
+			data.speedOverGround, data.courseOverGround, timestamp);
+}
+
+bool AISTrajectoryCompressor::update(
+		const AISExtendedClassBCSPositionReport& data, int64_t timestamp)
+{
+	return update(data.mmsi, data.longitude, data.latitude,
+			data.speedOverGround, data.courseOverGround, timestamp);
+}
+
+bool AISTrajectoryCompressor::erase(uint mmsi)
+{
+	return index.erase(mmsi);
+}
+
+uint AISTrajectoryCompressor::size() const
+{
+	return index.size();
+}
+
+const AISTrajectoryCompressorStatistics& AISTrajectoryCompressor::statistics() const
+{
+	return stats;
+}
+
+void AISTrajectoryCompressor::resetStatistics()
+{
+	stats.points = 0;
+	stats.kept = 0;
+	stats.maxError = 0.0f;
+}
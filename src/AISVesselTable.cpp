@@ -0,0 +1,404 @@
+/**
+ *	@file AISVesselTable.cpp
+ *	@brief AISVesselTable Implementation
+ */
+
+#include "AISVesselTable.h"
+#include "NmeaParser.h"
+
+AISVesselTable::AISVesselTable(uint capacity, AISStringPool* pool) :
+		index(capacity), pool(pool), hot(capacity), cold(
+				pool ? 0 : capacity), coldHandles(pool ? capacity : 0)
+{
+	for (uint slot = 0; slot < capacity; ++slot)
+	{
+		reset(slot, AISMmsiMap::NPOS);
+	}
+}
+
+void AISVesselTable::reset(uint slot, uint mmsi)
+{
+	AISVesselPosition& position = hot[slot];
+	position.mmsi = mmsi;
+	position.longitude = 181.0f;
+	position.latitude = 91.0f;
+	position.speedOverGround = 102.3f;
+	position.courseOverGround = 360.0f;
+	position.rateOfTurn = 0.0f;
+	position.trueHeading = 511;
+	position.navigationStatus = Nmea_NavigationStatus_NotDefined;
+	position.messageType = Nmea_AisMessageType_NA;
+	position.valid = false;
+	position.timestamp = 0;
+
+	if (pool)
+	{
+		coldHandles[slot] = AISVesselStaticHandles();
+	}
+	else
+	{
+		cold[slot] = AISVesselStatic();
+	}
+	AISVesselStaticBase& vessel = staticRecord(slot);
+	vessel.mmsi = mmsi;
+	vessel.valid = false;
+	vessel.shipType = Nmea_ShipType_NotAvailable;
+	vessel.epfd = Nmea_EPFDFix_Undefined;
+}
+
+AISVesselStaticBase& AISVesselTable::staticRecord(uint slot)
+{
+	if (pool)
+	{
+		return coldHandles[slot];
+	}
+	return cold[slot];
+}
+
+const AISVesselStaticBase& AISVesselTable::staticRecord(uint slot) const
+{
+	if (pool)
+	{
+		return coldHandles[slot];
+	}
+	return cold[slot];
+}
+
+uint AISVesselTable::intern(boost::string_ref text, bool& interned)
+{
+	const uint handle = pool->intern(text);
+	if (handle == AISStringPool::NPOS)
+	{
+		interned = false;
+	}
+	return handle;
+}
+
+uint AISVesselTable::acquire(uint mmsi)
+{
+	bool inserted;
+	const uint slot = index.insert(mmsi, inserted);
+	if (inserted)
+	{
+		reset(slot, mmsi);
+	}
+	return slot;
+}
+
+bool AISVesselTable::update(const AISPositionReportClassA& data,
+		Nmea_AisMessageType messageType, int64_t timestamp)
+{
+	const uint slot = acquire(data.mmsi);
+	if (slot == AISMmsiMap::NPOS)
+	{
+		return false;
+	}
+
+	AISVesselPosition& position = hot[slot];
+	position.longitude = data.longitude;
+	position.latitude = data.latitude;
+	position.speedOverGround = data.speedOverGround;
+	position.courseOverGround = data.courseOverGround;
+	position.rateOfTurn = data.rateOfTurn;
+	position.trueHeading = data.trueHeading;
+	position.navigationStatus = data.navigationStatus;
+	position.messageType = messageType;
+	position.valid = true;
+	position.timestamp = timestamp;
+
+	return true;
+}
+
+bool AISVesselTable::update(const AISStandardClassBCSPositionReport& data,
+		int64_t timestamp)
+{
+	const uint slot = acquire(data.mmsi);
+	if (slot == AISMmsiMap::NPOS)
+	{
+		return false;
+	}
+
+	AISVesselPosition& position = hot[slot];
+	position.longitude = data.longitude;
+	position.latitude = data.latitude;
+	position.speedOverGround = data.speedOverGround;
+	position.courseOverGround = data.courseOverGround;
+	position.trueHeading = data.trueHeading;
+	// Class B does not send them, a Class A value would be stale
+	position.rateOfTurn = 0.0f;
+	position.navigationStatus = Nmea_NavigationStatus_NotDefined;
+	position.messageType = Nmea_AisMessageType_StandardClassBCSPositionReport;
+	position.valid = true;
+	position.timestamp = timestamp;
+
+	return true;
+}
+
+bool AISVesselTable::update(const AISExtendedClassBCSPositionReport& data,
+		int64_t timestamp)
+{
+	const uint slot = acquire(data.mmsi);
+	if (slot == AISMmsiMap::NPOS)
+	{
+		return false;
+	}
+
+	AISVesselPosition& position = hot[slot];
+	position.longitude = data.longitude;
+	position.latitude = data.latitude;
+	position.speedOverGround = data.speedOverGround;
+	position.courseOverGround = data.courseOverGround;
+	position.trueHeading = data.trueHeading;
+	// Class B does not send them, a Class A value would be stale
+	position.rateOfTurn = 0.0f;
+	position.navigationStatus = Nmea_NavigationStatus_NotDefined;
+	position.messageType =
+			Nmea_AisMessageType_ExtendedClassBEquipmentPositionReport;
+	position.valid = true;
+	position.timestamp = timestamp;
+
+	bool interned = true;
+	if (pool)
+	{
+		coldHandles[slot].vesselName = intern(data.vesselName, interned);
+	}
+	else
+	{
+		cold[slot].vesselName = data.vesselName;
+	}
+
+	AISVesselStaticBase& vessel = staticRecord(slot);
+	vessel.shipType = data.shipType;
+	vessel.dimension = data.dimension;
+	vessel.epfd = data.epfd;
+	vessel.valid = true;
+	vessel.timestamp = timestamp;
+
+	return interned;
+}
+
+bool AISVesselTable::update(const AISStaticAndVoyageRelatedData& data,
+		int64_t timestamp)
+{
+	const uint slot = acquire(data.mmsi);
+	if (slot == AISMmsiMap::NPOS)
+	{
+		return false;
+	}
+
+	bool interned = true;
+	if (pool)
+	{
+		AISVesselStaticHandles& text = coldHandles[slot];
+		text.callsign = intern(data.callsign, interned);
+		text.vesselName = intern(data.vesselName, interned);
+		text.destination = intern(data.destination, interned);
+	}
+	else
+	{
+		AISVesselStatic& text = cold[slot];
+		text.callsign = data.callsign;
+		text.vesselName = data.vesselName;
+		text.destination = data.destination;
+	}
+
+	AISVesselStaticBase& vessel = staticRecord(slot);
+	vessel.imoNumber = data.imoNumber;
+	vessel.shipType = data.shipType;
+	vessel.dimension = data.dimension;
+	vessel.epfd = data.epfd;
+	vessel.draught = data.draught;
+	vessel.etaMonth = data.month;
+	vessel.etaDay = data.day;
+	vessel.etaHour = data.hour;
+	vessel.etaMinute = data.minute;
+	vessel.valid = true;
+	vessel.timestamp = timestamp;
+
+	return interned;
+}
+
+bool AISVesselTable::update(const AISStaticDataReport& data,
+		int64_t timestamp)
+{
+	if (data.partNumber != 0 && data.partNumber != 1)
+	{
+		return false;
+	}
+
+	const uint slot = acquire(data.mmsi);
+	if (slot == AISMmsiMap::NPOS)
+	{
+		return false;
+	}
+
+	bool interned = true;
+	AISVesselStaticBase& vessel = staticRecord(slot);
+	if (data.partNumber == 0)
+	{
+		if (pool)
+		{
+			coldHandles[slot].vesselName = intern(data.partA.vesselName,
+					interned);
+		}
+		else
+		{
+			cold[slot].vesselName = data.partA.vesselName;
+		}
+	}
+	else
+	{
+		if (pool)
+		{
+			AISVesselStaticHandles& text = coldHandles[slot];
+			text.vendorId = intern(data.partB.vendorId, interned);
+			text.callsign = intern(data.partB.callsign, interned);
+		}
+		else
+		{
+			AISVesselStatic& text = cold[slot];
+			text.vendorId = data.partB.vendorId;
+			text.callsign = data.partB.callsign;
+		}
+		vessel.shipType = data.partB.shipType;
+		vessel.dimension = data.partB.dimension;
+	}
+	vessel.valid = true;
+	vessel.timestamp = timestamp;
+
+	return interned;
+}
+
+bool AISVesselTable::update(const std::string& encodedData, int64_t timestamp)
+{
+	Nmea_AisMessageType messageType;
+	if (!NmeaParser::parseAISMessageType(encodedData, messageType))
+	{
+		return false;
+	}
+
+	switch (messageType)
+	{
+	case Nmea_AisMessageType_PositionReportClassA:
+	case Nmea_AisMessageType_PositionReportClassA_AssignedSchedule:
+	case Nmea_AisMessageType_PositionReportClassA_ResponseToInterrogation:
+	{
+		AISPositionReportClassA data;
+		return NmeaParser::parseAISPositionReportClassA(encodedData, data)
+				&& update(data, messageType, timestamp);
+	}
+	case Nmea_AisMessageType_StaticAndVoyageRelatedData:
+	{
+		AISStaticAndVoyageRelatedData data;
+		return NmeaParser::parseAISStaticAndVoyageRelatedData(encodedData, data)
+				&& update(data, timestamp);
+	}
+	case Nmea_AisMessageType_StandardClassBCSPositionReport:
+	{
+		AISStandardClassBCSPositionReport data;
+		return NmeaParser::parseAISStandardClassBCSPositionReport(encodedData,
+				data) && update(data, timestamp);
+	}
+	case Nmea_AisMessageType_ExtendedClassBEquipmentPositionReport:
+	{
+		AISExtendedClassBCSPositionReport data;
+		return NmeaParser::parseAISExtendedClassBEquipmentPositionReport(
+				encodedData, data) && update(data, timestamp);
+	}
+	case Nmea_AisMessageType_StaticDataReport:
+	{
+		AISStaticDataReport data;
+		return NmeaParser::parseAISStaticDataReport(encodedData, data)
+				&& update(data, timestamp);
+	}
+	default:
+		return false;
+	}
+}
+
+const AISVesselPosition* AISVesselTable::findPosition(uint mmsi) const
+{
+	const uint slot = index.find(mmsi);
+	if (slot == AISMmsiMap::NPOS || !hot[slot].valid)
+	{
+		return nullptr;
+	}
+	return &hot[slot];
+}
+
+const AISVesselStatic* AISVesselTable::findStatic(uint mmsi) const
+{
+	const uint slot = index.find(mmsi);
+	if (pool || slot == AISMmsiMap::NPOS || !cold[slot].valid)
+	{
+		return nullptr;
+	}
+	return &cold[slot];
+}
+
+const AISVesselStaticHandles* AISVesselTable::findStaticHandles(
+		uint mmsi) const
+{
+	const uint slot = index.find(mmsi);
+	if (!pool || slot == AISMmsiMap::NPOS || !coldHandles[slot].valid)
+	{
+		return nullptr;
+	}
+	return &coldHandles[slot];
+}
+
+bool AISVesselTable::erase(uint mmsi)
+{
+	const uint slot = index.find(mmsi);
+	if (slot == AISMmsiMap::NPOS)
+	{
+		return false;
+	}
+	index.erase(mmsi);
+	reset(slot, AISMmsiMap::NPOS);
+	return true;
+}
+
+uint AISVesselTable::expire(int64_t timestamp)
+{
+	uint removed = 0;
+	for (uint slot = 0; slot < hot.size(); ++slot)
+	{
+		const uint mmsi = hot[slot].mmsi;
+		if (mmsi != AISMmsiMap::NPOS
+				&& (!hot[slot].valid || hot[slot].timestamp < timestamp)
+				&& (!staticRecord(slot).valid
+						|| staticRecord(slot).timestamp < timestamp))
+		{
+			index.erase(mmsi);
+			reset(slot, AISMmsiMap::NPOS);
+			++removed;
+		}
+	}
+	return removed;
+}
+
+uint AISVesselTable::size() const
+{
+	return index.size();
+}
+
+uint AISVesselTable::capacity() const
+{
+	return index.capacity();
+}
+
+const AISVesselPosition* AISVesselTable::positions() const
+{
+	return hot.data();
+}
+
+const AISVesselStatic* AISVesselTable::statics() const
+{
+	return pool ? nullptr : cold.data();
+}
+
+const AISVesselStaticHandles* AISVesselTable::staticHandles() const
+{
+	return pool ? coldHandles.data() : nullptr;
+}
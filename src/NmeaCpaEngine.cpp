@@ -0,0 +1,365 @@
+/**
+ *	@file NmeaCpaEngine.cpp
+ *	@brief NmeaCpaEngine Implementation
+ */
+
+#include "NmeaCpaEngine.h"
+
+#include <cmath>
+#include <limits>
+#include "AISGeometry.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define NMEA_CPA_AVX2
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Private Implementation
+ */
+class NmeaCpaEngine::impl
+{
+public:
+	/**
+	 * @brief Degrees to radians
+	 */
+	static const float DEG_TO_RAD;
+
+	/**
+	 * @brief Squared relative speed below which a target has no relative motion
+	 */
+	static const float MIN_SPEED2;
+
+	/**
+	 * @brief Computes CPA and TCPA of a range of targets
+	 *
+	 * @param [in,out] engine Engine holding the targets
+	 * @param [in] begin First target
+	 * @param [in] end One past the last target
+	 */
+	static void computeScalar(NmeaCpaEngine& engine, std::size_t begin,
+			std::size_t end);
+
+#ifdef NMEA_CPA_AVX2
+	/**
+	 * @brief Computes CPA and TCPA eight targets at a time
+	 *
+	 * @param [in,out] engine Engine holding the targets
+	 *
+	 * @return Number of targets computed, a multiple of eight.
+	 */
+	static std::size_t computeAVX2(NmeaCpaEngine& engine);
+#endif
+
+	/**
+	 * @brief Converts a distance to nautical miles
+	 *
+	 * @param [in] value Distance
+	 * @param [in] units Units
+	 *
+	 * @return Nautical miles.
+	 */
+	static double toNauticalMiles(double value, Nmea_SpeedDistanceUnits units);
+
+	/**
+	 * @brief Converts a speed to knots
+	 *
+	 * @param [in] value Speed
+	 * @param [in] units Units
+	 *
+	 * @return Knots.
+	 */
+	static double toKnots(double value, Nmea_SpeedDistanceUnits units);
+};
+
+const std::size_t NmeaCpaEngine::NPOS;
+const float NmeaCpaEngine::impl::DEG_TO_RAD = 3.14159265358979323846f / 180.0f;
+const float NmeaCpaEngine::impl::MIN_SPEED2 = 1e-6f;
+
+NmeaCpaEngine::NmeaCpaEngine() :
+		ownLongitude(0), ownLatitude(0), ownHeading(0), ownVelocityEast(0), ownVelocityNorth(
+				0), count(0)
+{
+
+}
+
+void NmeaCpaEngine::setOwnShip(float longitude, float latitude,
+		float speedOverGround, float courseOverGround, float heading)
+{
+	ownLongitude = longitude;
+	ownLatitude = latitude;
+	ownHeading = heading;
+	ownVelocityEast = speedOverGround
+			* std::sin(courseOverGround * impl::DEG_TO_RAD);
+	ownVelocityNorth = speedOverGround
+			* std::cos(courseOverGround * impl::DEG_TO_RAD);
+}
+
+void NmeaCpaEngine::clear()
+{
+	count = 0;
+	unknownMotion.clear();
+}
+
+std::size_t NmeaCpaEngine::push(float e, float n, float ve, float vn)
+{
+	if (count == east.size())
+	{
+		east.push_back(e);
+		north.push_back(n);
+		velocityEast.push_back(ve);
+		velocityNorth.push_back(vn);
+		cpaValues.push_back(0);
+		tcpaValues.push_back(0);
+	}
+	else
+	{
+		east[count] = e;
+		north[count] = n;
+		velocityEast[count] = ve;
+		velocityNorth[count] = vn;
+	}
+	return count++;
+}
+
+std::size_t NmeaCpaEngine::addTarget(float longitude, float latitude,
+		float speedOverGround, float courseOverGround)
+{
+	if (!aisValidPosition(longitude, latitude))
+	{
+		return NPOS;
+	}
+
+	float velocityE = 0.0f;
+	float velocityN = 0.0f;
+	if (aisValidMotion(speedOverGround, courseOverGround))
+	{
+		velocityE = speedOverGround
+				* std::sin(courseOverGround * impl::DEG_TO_RAD);
+		velocityN = speedOverGround
+				* std::cos(courseOverGround * impl::DEG_TO_RAD);
+	}
+	else
+	{
+		unknownMotion.push_back(count);
+	}
+
+	float deltaLongitude = longitude - ownLongitude;
+	if (deltaLongitude > 180.0f)
+	{
+		deltaLongitude -= 360.0f;
+	}
+	else if (deltaLongitude < -180.0f)
+	{
+		deltaLongitude += 360.0f;
+	}
+
+	// Local flat Earth, one nautical mile per minute of latitude
+	const float meanLatitude = (latitude + ownLatitude) * 0.5f;
+	return push(
+			deltaLongitude * 60.0f * std::cos(meanLatitude * impl::DEG_TO_RAD),
+			(latitude - ownLatitude) * 60.0f, velocityE, velocityN);
+}
+
+std::size_t NmeaCpaEngine::addTarget(const AISPositionReportClassA& data)
+{
+	return addTarget(data.longitude, data.latitude, data.speedOverGround,
+			data.courseOverGround);
+}
+
+std::size_t NmeaCpaEngine::addTarget(
+		const AISStandardClassBCSPositionReport& data)
+{
+	return addTarget(data.longitude, data.latitude, data.speedOverGround,
+			data.courseOverGround);
+}
+
+std::size_t NmeaCpaEngine::addTarget(
+		const AISExtendedClassBCSPositionReport& data)
+{
+	return addTarget(data.longitude, data.latitude, data.speedOverGround,
+			data.courseOverGround);
+}
+
+std::size_t NmeaCpaEngine::addTarget(const NmeaTrackData& track)
+{
+	return addTarget(track.distance, track.trueBearing,
+			Nmea_AngleReference_True, track.speed, track.course,
+			track.speedMode == Nmea_SpeedMode_Relative ?
+					Nmea_AngleReference_Relative : Nmea_AngleReference_True,
+			Nmea_SpeedDistanceUnits_Knots_NauticalMiles);
+}
+
+double NmeaCpaEngine::impl::toNauticalMiles(double value,
+		Nmea_SpeedDistanceUnits units)
+{
+	switch (units)
+	{
+	case Nmea_SpeedDistanceUnits_Kph_Kilometers:
+		return value / 1.852;
+	case Nmea_SpeedDistanceUnits_Mps_Meters:
+		return value / 1852.0;
+	default:
+		return value;
+	}
+}
+
+double NmeaCpaEngine::impl::toKnots(double value,
+		Nmea_SpeedDistanceUnits units)
+{
+	switch (units)
+	{
+	case Nmea_SpeedDistanceUnits_Kph_Kilometers:
+		return value / 1.852;
+	case Nmea_SpeedDistanceUnits_Mps_Meters:
+		return value * 3600.0 / 1852.0;
+	default:
+		return value;
+	}
+}
+
+std::size_t NmeaCpaEngine::addTarget(double targetDistance,
+		double targetBearing, Nmea_AngleReference targetBearingReference,
+		double targetSpeed, double targetCourse,
+		Nmea_AngleReference targetCourseReference,
+		Nmea_SpeedDistanceUnits speedDistanceUnits)
+{
+	const double distance = impl::toNauticalMiles(targetDistance,
+			speedDistanceUnits);
+	const double speed = impl::toKnots(targetSpeed, speedDistanceUnits);
+
+	double bearing = targetBearing;
+	if (targetBearingReference == Nmea_AngleReference_Relative)
+	{
+		bearing += ownHeading;
+	}
+
+	float velocityE = static_cast<float>(speed
+			* std::sin(targetCourse * impl::DEG_TO_RAD));
+	float velocityN = static_cast<float>(speed
+			* std::cos(targetCourse * impl::DEG_TO_RAD));
+	if (targetCourseReference == Nmea_AngleReference_Relative)
+	{
+		// Relative motion, add own ship motion to get true motion
+		velocityE += ownVelocityEast;
+		velocityN += ownVelocityNorth;
+	}
+
+	return push(static_cast<float>(distance * std::sin(bearing * impl::DEG_TO_RAD)),
+			static_cast<float>(distance * std::cos(bearing * impl::DEG_TO_RAD)),
+			velocityE, velocityN);
+}
+
+void NmeaCpaEngine::impl::computeScalar(NmeaCpaEngine& engine,
+		std::size_t begin, std::size_t end)
+{
+	const float* e = engine.east.data();
+	const float* n = engine.north.data();
+	const float* ve = engine.velocityEast.data();
+	const float* vn = engine.velocityNorth.data();
+	float* cpa = engine.cpaValues.data();
+	float* tcpa = engine.tcpaValues.data();
+
+	for (std::size_t i = begin; i < end; ++i)
+	{
+		const float relativeE = ve[i] - engine.ownVelocityEast;
+		const float relativeN = vn[i] - engine.ownVelocityNorth;
+		const float speed2 = relativeE * relativeE + relativeN * relativeN;
+		const float dot = e[i] * relativeE + n[i] * relativeN;
+		const float t = speed2 > MIN_SPEED2 ? -dot / speed2 : 0.0f;
+		const float closestE = e[i] + relativeE * t;
+		const float closestN = n[i] + relativeN * t;
+		cpa[i] = std::sqrt(closestE * closestE + closestN * closestN);
+		tcpa[i] = t * 60.0f;
+	}
+}
+
+#ifdef NMEA_CPA_AVX2
+__attribute__((target("avx2")))
+std::size_t NmeaCpaEngine::impl::computeAVX2(NmeaCpaEngine& engine)
+{
+	const float* e = engine.east.data();
+	const float* n = engine.north.data();
+	const float* ve = engine.velocityEast.data();
+	const float* vn = engine.velocityNorth.data();
+	float* cpa = engine.cpaValues.data();
+	float* tcpa = engine.tcpaValues.data();
+
+	const __m256 ownE = _mm256_set1_ps(engine.ownVelocityEast);
+	const __m256 ownN = _mm256_set1_ps(engine.ownVelocityNorth);
+	const __m256 minSpeed2 = _mm256_set1_ps(MIN_SPEED2);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 minutes = _mm256_set1_ps(60.0f);
+
+	const std::size_t blocks = engine.count / 8 * 8;
+	for (std::size_t i = 0; i < blocks; i += 8)
+	{
+		const __m256 pe = _mm256_loadu_ps(e + i);
+		const __m256 pn = _mm256_loadu_ps(n + i);
+		const __m256 relativeE = _mm256_sub_ps(_mm256_loadu_ps(ve + i), ownE);
+		const __m256 relativeN = _mm256_sub_ps(_mm256_loadu_ps(vn + i), ownN);
+		const __m256 speed2 = _mm256_add_ps(_mm256_mul_ps(relativeE, relativeE),
+				_mm256_mul_ps(relativeN, relativeN));
+		const __m256 dot = _mm256_add_ps(_mm256_mul_ps(pe, relativeE),
+				_mm256_mul_ps(pn, relativeN));
+		const __m256 moving = _mm256_cmp_ps(speed2, minSpeed2, _CMP_GT_OQ);
+		const __m256 t = _mm256_and_ps(moving,
+				_mm256_div_ps(_mm256_sub_ps(zero, dot), speed2));
+		const __m256 closestE = _mm256_add_ps(pe, _mm256_mul_ps(relativeE, t));
+		const __m256 closestN = _mm256_add_ps(pn, _mm256_mul_ps(relativeN, t));
+		_mm256_storeu_ps(cpa + i,
+				_mm256_sqrt_ps(
+						_mm256_add_ps(_mm256_mul_ps(closestE, closestE),
+								_mm256_mul_ps(closestN, closestN))));
+		_mm256_storeu_ps(tcpa + i, _mm256_mul_ps(t, minutes));
+	}
+
+	return blocks;
+}
+#endif
+
+void NmeaCpaEngine::compute(bool vectorized)
+{
+	std::size_t done = 0;
+#ifdef NMEA_CPA_AVX2
+	if (vectorized && avx2Supported())
+	{
+		done = impl::computeAVX2(*this);
+	}
+#else
+	(void) vectorized;
+#endif
+	impl::computeScalar(*this, done, count);
+
+	const float unknown = std::numeric_limits<float>::quiet_NaN();
+	for (std::size_t i = 0; i < unknownMotion.size(); ++i)
+	{
+		cpaValues[unknownMotion[i]] = unknown;
+		tcpaValues[unknownMotion[i]] = unknown;
+	}
+}
+
+std::size_t NmeaCpaEngine::size() const
+{
+	return count;
+}
+
+const float* NmeaCpaEngine::cpa() const
+{
+	return cpaValues.data();
+}
+
+const float* NmeaCpaEngine::tcpa() const
+{
+	return tcpaValues.data();
+}
+
+bool NmeaCpaEngine::avx2Supported()
+{
+#ifdef NMEA_CPA_AVX2
+	static const bool supported = __builtin_cpu_supports("avx2");
+	return supported;
+#else
+	return false;
+#endif
+}
@@ -0,0 +1,189 @@
+/**
+ *	@file NmeaDispatcher.cpp
+ *	@brief NmeaDispatcherBase Implementation
+ */
+
+#include "NmeaDispatcher.h"
+
+/**
+ * @brief Private Implementation
+ */
+class NmeaDispatcherBase::impl
+{
+public:
+	/**
+	 * @brief Packs a 3 letter sentence id into an integer
+	 *
+	 * @param [in] a First letter
+	 * @param [in] b Second letter
+	 * @param [in] c Third letter
+	 *
+	 * @return Id usable as case label.
+	 */
+	static constexpr uint code(char a, char b, char c)
+	{
+		return static_cast<uint>(static_cast<unsigned char>(a)) << 16
+				| static_cast<uint>(static_cast<unsigned char>(b)) << 8
+				| static_cast<unsigned char>(c);
+	}
+};
+
+NmeaDispatcherBase::NmeaDispatcherBase() :
+		lines(0), parsedLines(0), own(false)
+{
+
+}
+
+uint64_t NmeaDispatcherBase::sentences() const
+{
+	return lines;
+}
+
+uint64_t NmeaDispatcherBase::parsed() const
+{
+	return parsedLines;
+}
+
+bool NmeaDispatcherBase::ownVessel() const
+{
+	return own;
+}
+
+void NmeaDispatcherBase::reset()
+{
+	pending.clear();
+}
+
+NmeaDispatcherBase::Sentence NmeaDispatcherBase::identify(
+		const std::string& nmea, std::size_t& start)
+{
+	start = 0;
+	if (!nmea.empty() && nmea[0] == '\\')
+	{
+		const std::size_t end = nmea.find('\\', 1);
+		if (end == std::string::npos)
+		{
+			return Sentence_Other;
+		}
+		start = end + 1;
+	}
+
+	// $ or !, 2 letter talker id, sentence id
+	if (nmea.size() < start + 6
+			|| (nmea[start] != '$' && nmea[start] != '!')
+			|| nmea[start + 1] == 'P')
+	{
+		return Sentence_Other;
+	}
+
+	switch (impl::code(nmea[start + 3], nmea[start + 4], nmea[start + 5]))
+	{
+	case impl::code('Z', 'D', 'A'):
+		return Sentence_ZDA;
+	case impl::code('G', 'L', 'L'):
+		return Sentence_GLL;
+	case impl::code('G', 'G', 'A'):
+		return Sentence_GGA;
+	case impl::code('V', 'T', 'G'):
+		return Sentence_VTG;
+	case impl::code('R', 'M', 'C'):
+		return Sentence_RMC;
+	case impl::code('H', 'D', 'T'):
+		return Sentence_HDT;
+	case impl::code('H', 'D', 'G'):
+		return Sentence_HDG;
+	case impl::code('R', 'O', 'T'):
+		return Sentence_ROT;
+	case impl::code('M', 'W', 'V'):
+		return Sentence_MWV;
+	case impl::code('D', 'P', 'T'):
+		return Sentence_DPT;
+	case impl::code('V', 'H', 'W'):
+		return Sentence_VHW;
+	case impl::code('T', 'T', 'M'):
+		return Sentence_TTM;
+	case impl::code('T', 'T', 'D'):
+		return Sentence_TTD;
+	case impl::code('V', 'D', 'M'):
+		return Sentence_VDM;
+	case impl::code('V', 'D', 'O'):
+		return Sentence_VDO;
+	default:
+		return Sentence_Other;
+	}
+}
+
+const std::string& NmeaDispatcherBase::body(const std::string& nmea,
+		std::size_t start, std::string& buffer)
+{
+	if (start == 0)
+	{
+		return nmea;
+	}
+	buffer.assign(nmea, start, std::string::npos);
+	return buffer;
+}
+
+bool NmeaDispatcherBase::assemble(const std::string& sentence, bool own,
+		std::string& encodedData)
+{
+	int totalLines;
+	int lineCount;
+	int sequenceIdentifier;
+	char aisChannel;
+	int fillBits;
+	const NmeaParserResult result =
+			own ? NmeaParser::parseVDO(sentence, totalLines, lineCount,
+							sequenceIdentifier, aisChannel, encodedData,
+							fillBits) :
+					NmeaParser::parseVDM(sentence, totalLines, lineCount,
+							sequenceIdentifier, aisChannel, encodedData,
+							fillBits);
+	if (result[0] || result[1] || result[4] || lineCount < 1
+			|| lineCount > totalLines)
+	{
+		return false;
+	}
+
+	if (totalLines == 1)
+	{
+		this->own = own;
+		return true;
+	}
+
+	// Fragments of one message share sequence id and channel
+	const uint key = (result[2] ? 0xFFu : static_cast<uint>(sequenceIdentifier))
+			| static_cast<uint>(static_cast<unsigned char>(aisChannel)) << 8
+			| (own ? 1u << 16 : 0u);
+	if (lineCount == 1)
+	{
+		Fragments& fragments = pending[key];
+		fragments.totalLines = totalLines;
+		fragments.nextLine = 2;
+		fragments.encodedData.swap(encodedData);
+		return false;
+	}
+
+	std::map<uint, Fragments>::iterator it = pending.find(key);
+	if (it == pending.end())
+	{
+		return false;
+	}
+	if (it->second.totalLines != totalLines
+			|| it->second.nextLine != lineCount)
+	{
+		// A fragment was lost
+		pending.erase(it);
+		return false;
+	}
+	it->second.encodedData += encodedData;
+	if (lineCount < totalLines)
+	{
+		++it->second.nextLine;
+		return false;
+	}
+	encodedData.swap(it->second.encodedData);
+	pending.erase(it);
+	this->own = own;
+	return true;
+}
@@ -0,0 +1,481 @@
+/**
+ *	@file NmeaGzipReader.cpp
+ *	@brief NmeaGzipReader Implementation
+ */
+
+#include "NmeaGzipReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <zlib.h>
+
+/**
+ * @brief Private Implementation
+ */
+class NmeaGzipReader::impl
+{
+public:
+	/**
+	 * @brief Largest uncompressed size of a BGZF block
+	 */
+	static const std::size_t BGZF_BLOCK = 65536;
+
+	/**
+	 * @brief Lists the blocks of a BGZF file
+	 *
+	 * @param [in] data File
+	 * @param [in] size File size
+	 * @param [out] blocks Block offsets, then the file size
+	 *
+	 * @return False if the file is not BGZF from start to end.
+	 */
+	static bool listBlocks(const unsigned char* data, uint64_t size,
+			std::vector<uint64_t>& blocks);
+
+	/**
+	 * @brief Waits for the ring slot of a chunk to be free
+	 *
+	 * @param [in] self Reader
+	 * @param [in] sequence Chunk
+	 *
+	 * @return Slot, nullptr if the reader is closing.
+	 */
+	static Chunk* acquire(NmeaGzipReader& self, uint64_t sequence);
+
+	/**
+	 * @brief Hands an inflated chunk to the reader
+	 *
+	 * @param [in] self Reader
+	 * @param [in] chunk Slot
+	 * @param [in] valid False if the data was corrupt
+	 */
+	static void publish(NmeaGzipReader& self, Chunk& chunk, bool valid);
+
+	/**
+	 * @brief Releases the current chunk and waits for the next one
+	 *
+	 * @param [in] self Reader
+	 *
+	 * @return False at the end of the file or on error.
+	 */
+	static bool fetch(NmeaGzipReader& self);
+
+	/**
+	 * @brief Inflates a gzip stream, or copies a plain file, in order
+	 *
+	 * @param [in] self Reader
+	 */
+	static void inflateStream(NmeaGzipReader* self);
+
+	/**
+	 * @brief Inflates runs of BGZF blocks until none is left
+	 *
+	 * @param [in] self Reader
+	 */
+	static void inflateBlocks(NmeaGzipReader* self);
+};
+
+const std::size_t NmeaGzipReader::impl::BGZF_BLOCK;
+
+bool NmeaGzipReader::impl::listBlocks(const unsigned char* data, uint64_t size,
+		std::vector<uint64_t>& blocks)
+{
+	blocks.clear();
+	uint64_t offset = 0;
+	while (offset < size)
+	{
+		// Fixed header, FEXTRA, then a BC subfield holding the block size - 1
+		const unsigned char* h = data + offset;
+		if (size - offset < 28 || h[0] != 0x1f || h[1] != 0x8b || h[2] != 8
+				|| (h[3] & 4) == 0)
+		{
+			return false;
+		}
+		const std::size_t extra = h[10] | h[11] << 8;
+		std::size_t blockSize = 0;
+		for (std::size_t i = 12; i + 4 <= 12 + extra && offset + i + 4 <= size;)
+		{
+			const std::size_t length = h[i + 2] | h[i + 3] << 8;
+			if (h[i] == 'B' && h[i + 1] == 'C' && length == 2
+					&& offset + i + 6 <= size)
+			{
+				blockSize = (h[i + 4] | h[i + 5] << 8) + 1;
+				break;
+			}
+			i += 4 + length;
+		}
+		if (blockSize < 12 + extra + 8 || blockSize > size - offset)
+		{
+			return false;
+		}
+		blocks.push_back(offset);
+		offset += blockSize;
+	}
+	blocks.push_back(size);
+	return blocks.size() > 1;
+}
+
+NmeaGzipReader::Chunk* NmeaGzipReader::impl::acquire(NmeaGzipReader& self,
+		uint64_t sequence)
+{
+	std::unique_lock<std::mutex> lock(self.mutex);
+	self.consumed.wait(lock, [&self, sequence]()
+	{
+		return self.stopping || sequence < self.reading + self.ring.size();
+	});
+	if (self.stopping)
+	{
+		return nullptr;
+	}
+	Chunk& chunk = self.ring[sequence % self.ring.size()];
+	chunk.sequence = sequence;
+	return &chunk;
+}
+
+void NmeaGzipReader::impl::publish(NmeaGzipReader& self, Chunk& chunk,
+		bool valid)
+{
+	{
+		std::lock_guard<std::mutex> lock(self.mutex);
+		chunk.ready = true;
+		if (!valid)
+		{
+			self.corrupt = true;
+			self.end = std::min(self.end, chunk.sequence);
+		}
+	}
+	self.inflated.notify_all();
+}
+
+bool NmeaGzipReader::impl::fetch(NmeaGzipReader& self)
+{
+	std::unique_lock<std::mutex> lock(self.mutex);
+	if (self.current != nullptr)
+	{
+		self.ring[self.reading % self.ring.size()].ready = false;
+		++self.reading;
+		self.current = nullptr;
+		self.consumed.notify_all();
+	}
+
+	Chunk& chunk = self.ring[self.reading % self.ring.size()];
+	self.inflated.wait(lock, [&self, &chunk]()
+	{
+		return self.reading >= self.end
+				|| (chunk.ready && chunk.sequence == self.reading);
+	});
+	if (self.reading >= self.end)
+	{
+		return false;
+	}
+	self.current = &chunk;
+	self.position = 0;
+	return true;
+}
+
+void NmeaGzipReader::impl::inflateStream(NmeaGzipReader* self)
+{
+	const unsigned char* input =
+			reinterpret_cast<const unsigned char*>(self->file.data());
+	uint64_t remaining = self->file.size();
+	const bool gzip = remaining >= 2 && input[0] == 0x1f && input[1] == 0x8b;
+
+	z_stream stream = z_stream();
+	// Gzip header expected, members follow each other
+	if (gzip && inflateInit2(&stream, 15 + 16) != Z_OK)
+	{
+		Chunk* chunk = acquire(*self, 0);
+		if (chunk != nullptr)
+		{
+			publish(*self, *chunk, false);
+		}
+		return;
+	}
+
+	bool finished = false;
+	bool valid = true;
+	uint64_t sequence = 0;
+	while (!finished && valid)
+	{
+		Chunk* chunk = acquire(*self, sequence);
+		if (chunk == nullptr)
+		{
+			break;
+		}
+		chunk->data.resize(self->chunkBytes);
+
+		if (!gzip)
+		{
+			const std::size_t length = std::min<uint64_t>(remaining,
+					self->chunkBytes);
+			std::memcpy(chunk->data.data(), input, length);
+			chunk->data.resize(length);
+			input += length;
+			remaining -= length;
+			finished = remaining == 0;
+		}
+		else
+		{
+			stream.next_out = reinterpret_cast<Bytef*>(chunk->data.data());
+			stream.avail_out = chunk->data.size();
+			while (stream.avail_out > 0)
+			{
+				if (stream.avail_in == 0)
+				{
+					const uInt length = std::min<uint64_t>(remaining, 1 << 30);
+					stream.next_in = const_cast<Bytef*>(input);
+					stream.avail_in = length;
+					input += length;
+					remaining -= length;
+				}
+				const int result = inflate(&stream, Z_NO_FLUSH);
+				if (result == Z_STREAM_END)
+				{
+					// Another member, unless only padding is left
+					if ((stream.avail_in == 0 && remaining == 0)
+							|| (stream.avail_in > 0 && stream.next_in[0] != 0x1f))
+					{
+						finished = true;
+						break;
+					}
+					inflateReset(&stream);
+				}
+				else if (result != Z_OK)
+				{
+					// Corrupt, or truncated when input ran out mid member
+					valid = false;
+					break;
+				}
+			}
+			chunk->data.resize(chunk->data.size() - stream.avail_out);
+		}
+
+		publish(*self, *chunk, valid);
+		++sequence;
+	}
+	if (gzip)
+	{
+		inflateEnd(&stream);
+	}
+
+	std::lock_guard<std::mutex> lock(self->mutex);
+	self->end = std::min(self->end, sequence);
+	self->inflated.notify_all();
+}
+
+void NmeaGzipReader::impl::inflateBlocks(NmeaGzipReader* self)
+{
+	const unsigned char* input =
+			reinterpret_cast<const unsigned char*>(self->file.data());
+	const std::size_t blockCount = self->blocks.size() - 1;
+	const std::size_t perChunk = std::max<std::size_t>(1,
+			self->chunkBytes / BGZF_BLOCK);
+
+	z_stream stream = z_stream();
+	if (inflateInit2(&stream, -15) != Z_OK)
+	{
+		return;
+	}
+
+	for (;;)
+	{
+		uint64_t sequence;
+		{
+			std::lock_guard<std::mutex> lock(self->mutex);
+			sequence = self->nextJob++;
+		}
+		const std::size_t first = sequence * perChunk;
+		if (first >= blockCount)
+		{
+			break;
+		}
+		Chunk* chunk = acquire(*self, sequence);
+		if (chunk == nullptr)
+		{
+			break;
+		}
+
+		const std::size_t last = std::min(first + perChunk, blockCount);
+		chunk->data.resize((last - first) * BGZF_BLOCK);
+		std::size_t length = 0;
+		bool valid = true;
+		for (std::size_t b = first; b < last && valid; ++b)
+		{
+			// Raw deflate between the header and the CRC32, ISIZE trailer
+			const unsigned char* block = input + self->blocks[b];
+			const std::size_t blockSize = self->blocks[b + 1] - self->blocks[b];
+			const std::size_t header = 12 + (block[10] | block[11] << 8);
+			const unsigned char* trailer = block + blockSize - 8;
+			const uLong crc = trailer[0] | trailer[1] << 8 | trailer[2] << 16
+					| static_cast<uLong>(trailer[3]) << 24;
+			const std::size_t size = trailer[4] | trailer[5] << 8
+					| trailer[6] << 16 | static_cast<std::size_t>(trailer[7]) << 24;
+
+			inflateReset(&stream);
+			stream.next_in = const_cast<Bytef*>(block + header);
+			stream.avail_in = blockSize - header - 8;
+			stream.next_out = reinterpret_cast<Bytef*>(chunk->data.data()
+					+ length);
+			stream.avail_out = BGZF_BLOCK;
+			valid = size <= BGZF_BLOCK
+					&& inflate(&stream, Z_FINISH) == Z_STREAM_END
+					&& stream.total_out == size
+					&& crc32(crc32(0L, Z_NULL, 0),
+							reinterpret_cast<const Bytef*>(chunk->data.data()
+									+ length), size) == crc;
+			length += size;
+		}
+		chunk->data.resize(valid ? length : 0);
+		publish(*self, *chunk, valid);
+	}
+	inflateEnd(&stream);
+}
+
+NmeaGzipReader::NmeaGzipReader(unsigned threads, std::size_t chunkBytes) :
+		threads(
+				threads > 0 ?
+						threads :
+						std::max(1U, std::thread::hardware_concurrency())), chunkBytes(
+				std::max<std::size_t>(chunkBytes, 1)), nextJob(0), reading(0), end(
+				0), stopping(false), corrupt(false), current(nullptr), position(
+				0), carried(false)
+{
+
+}
+
+NmeaGzipReader::~NmeaGzipReader()
+{
+	close();
+}
+
+bool NmeaGzipReader::open(const std::string& path)
+{
+	close();
+	if (!file.open(path))
+	{
+		return false;
+	}
+
+	nextJob = 0;
+	reading = 0;
+	stopping = false;
+	corrupt = false;
+	current = nullptr;
+	position = 0;
+	carry.clear();
+	carried = false;
+
+	if (impl::listBlocks(
+			reinterpret_cast<const unsigned char*>(file.data()), file.size(),
+			blocks))
+	{
+		const std::size_t perChunk = std::max<std::size_t>(1,
+				chunkBytes / impl::BGZF_BLOCK);
+		end = (blocks.size() - 1 + perChunk - 1) / perChunk;
+		ring.resize(4 * threads);
+		for (unsigned i = 0; i < threads; ++i)
+		{
+			workers.push_back(std::thread(impl::inflateBlocks, this));
+		}
+	}
+	else
+	{
+		blocks.clear();
+		end = std::numeric_limits<uint64_t>::max();
+		ring.resize(4);
+		workers.push_back(std::thread(impl::inflateStream, this));
+	}
+	return true;
+}
+
+void NmeaGzipReader::close()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	consumed.notify_all();
+	for (std::size_t i = 0; i < workers.size(); ++i)
+	{
+		workers[i].join();
+	}
+	workers.clear();
+	ring.clear();
+	blocks.clear();
+	current = nullptr;
+	carry.clear();
+	carried = false;
+	file.close();
+}
+
+bool NmeaGzipReader::next(boost::string_ref& line)
+{
+	if (carried)
+	{
+		carry.clear();
+		carried = false;
+	}
+
+	for (;;)
+	{
+		if (current != nullptr)
+		{
+			const char* data = current->data.data();
+			const std::size_t size = current->data.size();
+			const char* newline = position < size ?
+					static_cast<const char*>(std::memchr(data + position, '\n',
+							size - position)) :
+					nullptr;
+			if (newline != nullptr)
+			{
+				const std::size_t length = newline - data - position;
+				if (carry.empty())
+				{
+					line = boost::string_ref(data + position, length);
+				}
+				else
+				{
+					carry.append(data + position, length);
+					line = carry;
+					carried = true;
+				}
+				position += length + 1;
+				if (!line.empty() && line.back() == '\r')
+				{
+					line.remove_suffix(1);
+				}
+				return true;
+			}
+			carry.append(data + position, size - position);
+			position = size;
+		}
+
+		if (workers.empty() || !impl::fetch(*this))
+		{
+			// Last line without terminator
+			if (carry.empty())
+			{
+				return false;
+			}
+			line = carry;
+			carried = true;
+			if (line.back() == '\r')
+			{
+				line.remove_suffix(1);
+			}
+			return true;
+		}
+	}
+}
+
+bool NmeaGzipReader::blocked() const
+{
+	return !blocks.empty();
+}
+
+bool NmeaGzipReader::failed() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return corrupt;
+}
@@ -0,0 +1,172 @@
+/**
+ *	@file NmeaLogMerger.cpp
+ *	@brief NmeaLogMerger Implementation
+ */
+
+#include "NmeaLogMerger.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * @brief Private Implementation
+ */
+class NmeaLogMerger::impl
+{
+public:
+	/**
+	 * @brief Heap order, the earliest line on top
+	 *
+	 * @param [in] a Line
+	 * @param [in] b Line
+	 *
+	 * @return True if @p a comes after @p b.
+	 */
+	static bool later(const NmeaMergedLine& a, const NmeaMergedLine& b);
+
+	/**
+	 * @brief Reads the next non empty line of a source
+	 *
+	 * @param [in] self Merger
+	 * @param [in] source Source index
+	 * @param [out] line Line and its time
+	 *
+	 * @return False at the end of the source.
+	 */
+	static bool read(NmeaLogMerger& self, std::size_t source,
+			NmeaMergedLine& line);
+};
+
+bool NmeaLogMerger::impl::later(const NmeaMergedLine& a,
+		const NmeaMergedLine& b)
+{
+	return a.timestamp > b.timestamp
+			|| (a.timestamp == b.timestamp && a.source > b.source);
+}
+
+bool NmeaLogMerger::impl::read(NmeaLogMerger& self, std::size_t source,
+		NmeaMergedLine& line)
+{
+	const NmeaMappedFile& file = self.files[source];
+	Cursor& cursor = self.cursors[source];
+
+	do
+	{
+		if (cursor.offset >= file.size())
+		{
+			return false;
+		}
+		line.offset = cursor.offset;
+		cursor.offset = file.line(cursor.offset, line.line);
+	} while (line.line.empty());
+
+	line.sentence = NmeaTimeExtractor::sentence(line.line);
+	int64_t timestamp;
+	line.timed = cursor.extractor.extract(line.line, timestamp);
+	if (line.timed)
+	{
+		cursor.timestamp = timestamp;
+	}
+	line.timestamp = cursor.timestamp;
+	line.source = source;
+
+	// Chunk done, read the one after next ahead and drop what was read
+	const uint64_t chunk = cursor.offset / self.chunkBytes;
+	if (chunk != cursor.chunk)
+	{
+		file.release(cursor.chunk * self.chunkBytes,
+				(chunk - cursor.chunk) * self.chunkBytes);
+		file.prefetch((chunk + 1) * self.chunkBytes, self.chunkBytes);
+		cursor.chunk = chunk;
+	}
+	return true;
+}
+
+NmeaLogMerger::NmeaLogMerger(uint64_t chunkBytes) :
+		chunkBytes(std::max<uint64_t>(chunkBytes, 1)), started(false)
+{
+
+}
+
+bool NmeaLogMerger::add(const std::string& path)
+{
+	if (started)
+	{
+		return false;
+	}
+
+	files.emplace_back();
+	NmeaMappedFile& file = files.back();
+	if (!file.open(path))
+	{
+		files.pop_back();
+		return false;
+	}
+	file.prefetch(0, 2 * chunkBytes);
+
+	// Lines before the first time take that time, a source without time comes first
+	Cursor cursor;
+	cursor.offset = 0;
+	cursor.chunk = 0;
+	cursor.timestamp = std::numeric_limits<int64_t>::min();
+	NmeaTimeExtractor lookahead;
+	uint64_t offset = 0;
+	while (offset < file.size())
+	{
+		boost::string_ref line;
+		offset = file.line(offset, line);
+		int64_t timestamp;
+		if (lookahead.extract(line, timestamp))
+		{
+			cursor.timestamp = timestamp;
+			break;
+		}
+	}
+	if (offset > 2 * chunkBytes)
+	{
+		file.release(2 * chunkBytes, offset - 2 * chunkBytes);
+	}
+	cursors.push_back(cursor);
+
+	NmeaMergedLine line;
+	if (impl::read(*this, files.size() - 1, line))
+	{
+		heap.push_back(line);
+		std::push_heap(heap.begin(), heap.end(), impl::later);
+	}
+	return true;
+}
+
+bool NmeaLogMerger::next(NmeaMergedLine& line)
+{
+	started = true;
+	if (heap.empty())
+	{
+		return false;
+	}
+
+	std::pop_heap(heap.begin(), heap.end(), impl::later);
+	line = heap.back();
+	if (impl::read(*this, line.source, heap.back()))
+	{
+		std::push_heap(heap.begin(), heap.end(), impl::later);
+	}
+	else
+	{
+		heap.pop_back();
+	}
+	return true;
+}
+
+std::size_t NmeaLogMerger::sourceCount() const
+{
+	return files.size();
+}
+
+void NmeaLogMerger::close()
+{
+	heap.clear();
+	cursors.clear();
+	files.clear();
+	started = false;
+}
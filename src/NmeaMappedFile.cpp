@@ -0,0 +1,151 @@
+/**
+ *	@file NmeaMappedFile.cpp
+ *	@brief NmeaMappedFile Implementation
+ */
+
+#include "NmeaMappedFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+NmeaMappedFile::NmeaMappedFile() :
+		mapped(nullptr), length(0), sequential(true), opened(false)
+{
+
+}
+
+NmeaMappedFile::~NmeaMappedFile()
+{
+	close();
+}
+
+bool NmeaMappedFile::open(const std::string& path, bool sequential)
+{
+	close();
+
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	struct stat st;
+	if (::fstat(fd, &st) != 0)
+	{
+		::close(fd);
+		return false;
+	}
+
+	if (st.st_size > 0)
+	{
+		void* p = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		if (p == MAP_FAILED)
+		{
+			::close(fd);
+			return false;
+		}
+		::madvise(p, st.st_size, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+		mapped = static_cast<const char*>(p);
+		length = st.st_size;
+	}
+	::close(fd);
+
+	filePath = path;
+	this->sequential = sequential;
+	opened = true;
+	return true;
+}
+
+void NmeaMappedFile::close()
+{
+	if (mapped != nullptr)
+	{
+		::munmap(const_cast<char*>(mapped), length);
+	}
+	mapped = nullptr;
+	length = 0;
+	opened = false;
+}
+
+bool NmeaMappedFile::refresh()
+{
+	if (!opened)
+	{
+		return false;
+	}
+
+	struct stat st;
+	if (::stat(filePath.c_str(), &st) == 0
+			&& static_cast<uint64_t>(st.st_size) == length)
+	{
+		return true;
+	}
+
+	const std::string path = filePath;
+	return open(path, sequential);
+}
+
+bool NmeaMappedFile::isOpen() const
+{
+	return opened;
+}
+
+const char* NmeaMappedFile::data() const
+{
+	return mapped;
+}
+
+uint64_t NmeaMappedFile::size() const
+{
+	return length;
+}
+
+uint64_t NmeaMappedFile::line(uint64_t offset, boost::string_ref& line) const
+{
+	if (offset >= length)
+	{
+		line.clear();
+		return length;
+	}
+
+	const char* begin = mapped + offset;
+	const char* newline = static_cast<const char*>(std::memchr(begin, '\n',
+			length - offset));
+	const char* end = newline != nullptr ? newline : mapped + length;
+	const uint64_t next = newline != nullptr ? end - mapped + 1 : length;
+	if (end > begin && end[-1] == '\r')
+	{
+		--end;
+	}
+	line = boost::string_ref(begin, end - begin);
+	return next;
+}
+
+void NmeaMappedFile::prefetch(uint64_t offset, uint64_t length) const
+{
+	advise(offset, length, MADV_WILLNEED);
+}
+
+void NmeaMappedFile::release(uint64_t offset, uint64_t length) const
+{
+	advise(offset, length, MADV_DONTNEED);
+}
+
+void NmeaMappedFile::advise(uint64_t offset, uint64_t bytes, int advice) const
+{
+	if (offset >= length)
+	{
+		return;
+	}
+	bytes = std::min(bytes, length - offset);
+
+	// madvise() wants page aligned addresses
+	static const uint64_t page = ::sysconf(_SC_PAGESIZE);
+	const uint64_t begin = offset / page * page;
+	::madvise(const_cast<char*>(mapped) + begin, offset + bytes - begin,
+			advice);
+}
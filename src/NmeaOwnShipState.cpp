@@ -0,0 +1,289 @@
+/**
+ *	@file NmeaOwnShipState.cpp
+ *	@brief NmeaOwnShipState Implementation
+ */
+
+#include "NmeaOwnShipState.h"
+
+#include <cstring>
+
+const int NmeaOwnShipState::WORD_COUNT;
+
+namespace
+{
+
+/**
+ * @brief Bit pattern of a double
+ *
+ * @param [in] value Value
+ *
+ * @return Bits.
+ */
+inline uint64_t toWord(double value)
+{
+	uint64_t word;
+	std::memcpy(&word, &value, sizeof(word));
+	return word;
+}
+
+/**
+ * @brief Double from its bit pattern
+ *
+ * @param [in] word Bits
+ *
+ * @return Value.
+ */
+inline double fromWord(uint64_t word)
+{
+	double value;
+	std::memcpy(&value, &word, sizeof(value));
+	return value;
+}
+
+}
+
+NmeaOwnShipState::NmeaOwnShipState() :
+		sequence(0)
+{
+	for (int i = 0; i < Nmea_OwnShipField_Count; ++i)
+	{
+		pending.value[i] = 0.0;
+		pending.timestamp[i] = 0;
+	}
+	pending.validMask = 0;
+	pending.version = 0;
+
+	for (int i = 0; i < WORD_COUNT; ++i)
+	{
+		words[i].store(0, std::memory_order_relaxed);
+	}
+}
+
+void NmeaOwnShipState::set(Nmea_OwnShipField field, double value, bool valid,
+		int64_t timestamp)
+{
+	if (valid)
+	{
+		pending.value[field] = value;
+		pending.timestamp[field] = timestamp;
+		pending.validMask |= static_cast<uint64_t>(1) << field;
+	}
+	else
+	{
+		pending.validMask &= ~(static_cast<uint64_t>(1) << field);
+	}
+}
+
+void NmeaOwnShipState::publish()
+{
+	const uint32_t current = sequence.load(std::memory_order_relaxed);
+
+	// Odd sequence: readers discard what they copy from now on
+	sequence.store(current + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	for (int i = 0; i < Nmea_OwnShipField_Count; ++i)
+	{
+		words[2 * i].store(toWord(pending.value[i]),
+				std::memory_order_relaxed);
+		words[2 * i + 1].store(static_cast<uint64_t>(pending.timestamp[i]),
+				std::memory_order_relaxed);
+	}
+	words[WORD_COUNT - 1].store(pending.validMask, std::memory_order_relaxed);
+
+	sequence.store(current + 2, std::memory_order_release);
+}
+
+bool NmeaOwnShipState::read(NmeaOwnShipSnapshot& snapshot,
+		uint32_t& version) const
+{
+	version = sequence.load(std::memory_order_acquire);
+	if (version & 1)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < Nmea_OwnShipField_Count; ++i)
+	{
+		snapshot.value[i] = fromWord(
+				words[2 * i].load(std::memory_order_relaxed));
+		snapshot.timestamp[i] = static_cast<int64_t>(words[2 * i + 1].load(
+				std::memory_order_relaxed));
+	}
+	snapshot.validMask = words[WORD_COUNT - 1].load(std::memory_order_relaxed);
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (sequence.load(std::memory_order_relaxed) != version)
+	{
+		return false;
+	}
+
+	snapshot.version = version / 2;
+	return true;
+}
+
+void NmeaOwnShipState::snapshot(NmeaOwnShipSnapshot& snapshot) const
+{
+	uint32_t version;
+	while (!read(snapshot, version))
+	{
+		// Publication in progress, retry
+	}
+}
+
+bool NmeaOwnShipState::trySnapshot(NmeaOwnShipSnapshot& snapshot) const
+{
+	uint32_t version;
+	return read(snapshot, version);
+}
+
+uint32_t NmeaOwnShipState::version() const
+{
+	return sequence.load(std::memory_order_acquire) / 2;
+}
+
+bool NmeaOwnShipState::ingest(const std::string& nmea, int64_t timestamp)
+{
+	if (nmea.size() < 6)
+	{
+		return false;
+	}
+
+	const std::string sentenceId = nmea.substr(3, 3);
+	NmeaParserResult result;
+
+	if (sentenceId == "GGA")
+	{
+		boost::posix_time::time_duration mtime;
+		double latitude;
+		double longitude;
+		Nmea_GPSQualityIndicator quality;
+		int numSV;
+		double hdop;
+		double orthometricheight;
+		double geoidseparation;
+		double agediffgps;
+		std::string refid;
+
+		result = NmeaParser::parseGGA(nmea, mtime, latitude, longitude,
+				quality, numSV, hdop, orthometricheight, geoidseparation,
+				agediffgps, refid);
+		if (result.all())
+		{
+			return false;
+		}
+
+		const bool fix = !result[3]
+				&& quality != Nmea_GPSQualityIndicator_FixNotValid;
+		set(Nmea_OwnShipField_UtcTime, mtime.total_milliseconds() / 1000.0,
+				!result[0], timestamp);
+		set(Nmea_OwnShipField_Latitude, latitude, fix && !result[1],
+				timestamp);
+		set(Nmea_OwnShipField_Longitude, longitude, fix && !result[2],
+				timestamp);
+		set(Nmea_OwnShipField_FixQuality, quality, !result[3], timestamp);
+		set(Nmea_OwnShipField_SatelliteCount, numSV, !result[4], timestamp);
+		set(Nmea_OwnShipField_Hdop, hdop, !result[5], timestamp);
+		set(Nmea_OwnShipField_Altitude, orthometricheight, fix && !result[6],
+				timestamp);
+	}
+	else if (sentenceId == "RMC")
+	{
+		boost::posix_time::time_duration mtime;
+		double latitude;
+		double longitude;
+		double speedknots;
+		double coursetrue;
+		boost::gregorian::date mdate;
+		double magneticvar;
+
+		result = NmeaParser::parseRMC(nmea, mtime, latitude, longitude,
+				speedknots, coursetrue, mdate, magneticvar);
+		if (result.all())
+		{
+			return false;
+		}
+
+		set(Nmea_OwnShipField_UtcTime, mtime.total_milliseconds() / 1000.0,
+				!result[0], timestamp);
+		set(Nmea_OwnShipField_Latitude, latitude, !result[1], timestamp);
+		set(Nmea_OwnShipField_Longitude, longitude, !result[2], timestamp);
+		set(Nmea_OwnShipField_SpeedOverGround, speedknots, !result[3],
+				timestamp);
+		set(Nmea_OwnShipField_CourseOverGround, coursetrue, !result[4],
+				timestamp);
+	}
+	else if (sentenceId == "VTG")
+	{
+		double coursetrue;
+		double coursemagnetic;
+		double speedknots;
+		double speedkph;
+
+		result = NmeaParser::parseVTG(nmea, coursetrue, coursemagnetic,
+				speedknots, speedkph);
+		if (result.all())
+		{
+			return false;
+		}
+
+		set(Nmea_OwnShipField_CourseOverGround, coursetrue, !result[0],
+				timestamp);
+		set(Nmea_OwnShipField_SpeedOverGround, speedknots, !result[2],
+				timestamp);
+	}
+	else if (sentenceId == "HDT")
+	{
+		double headingDegreesTrue;
+
+		result = NmeaParser::parseHDT(nmea, headingDegreesTrue);
+		if (result.all())
+		{
+			return false;
+		}
+
+		set(Nmea_OwnShipField_Heading, headingDegreesTrue, !result[0],
+				timestamp);
+	}
+	else if (sentenceId == "ROT")
+	{
+		double rateOfTurn;
+
+		result = NmeaParser::parseROT(nmea, rateOfTurn);
+		if (result.all())
+		{
+			return false;
+		}
+
+		set(Nmea_OwnShipField_RateOfTurn, rateOfTurn, !result[0], timestamp);
+	}
+	else if (sentenceId == "VHW")
+	{
+		double headingTrue;
+		double headingMagnetic;
+		double speedInKnots;
+		double speedInKmH;
+
+		result = NmeaParser::parseVHW(nmea, headingTrue, headingMagnetic,
+				speedInKnots, speedInKmH);
+		if (result.all())
+		{
+			return false;
+		}
+
+		// An empty heading in VHW does not invalidate the HDT heading
+		if (!result[0])
+		{
+			set(Nmea_OwnShipField_Heading, headingTrue, true, timestamp);
+		}
+		set(Nmea_OwnShipField_SpeedThroughWater, speedInKnots, !result[2],
+				timestamp);
+	}
+	else
+	{
+		return false;
+	}
+
+	publish();
+	return true;
+}
@@ -173,11 +173,11 @@ public:
 	 * @param [in] data Full decoded bitset
 	 * @param [in] pointer Pointer indicating where to read
 	 * @param [in] size Number of bits to consider
-	 *
-	 * @return Decoded String.
+	 * @param [out] value Decoded String, truncated to its capacity
 	 */
-	static std::string decodeBitString(const boost::dynamic_bitset<>& data,
-			int pointer, int size);
+	template<std::size_t N>
+	static void decodeBitString(const boost::dynamic_bitset<>& data,
+			int pointer, int size, AISFixedString<N>& value);
 };
 
 NmeaParser::NmeaParser()
@@ -220,7 +220,7 @@ bool NmeaParser::impl::decodeTime(std::vector<std::string>::iterator &i,
 						boost::lexical_cast<int>(
 								boost::lexical_cast<double>(m[4].str())
 										* 1000) :
-						0.0));
+						0));
 		out = boost::posix_time::time_duration(hr + min + sec + ms);
 	}
 	else
@@ -392,34 +392,20 @@ inline int NmeaParser::impl::decodeBitInt(const boost::dynamic_bitset<>& data,
 	return (val ^ m) - m;
 }
 
-std::string NmeaParser::impl::decodeBitString(
-		const boost::dynamic_bitset<>& data, int pointer, int size)
+template<std::size_t N>
+void NmeaParser::impl::decodeBitString(const boost::dynamic_bitset<>& data,
+		int pointer, int size, AISFixedString<N>& value)
 {
-	int len = size / 6;
-	std::string strVariable(len, '\0');
-
-	SixBit bitChar;
+	const int len = size / 6;
 
+	value.clear();
 	for (int i = 0; i < len; ++i)
 	{
-		for (int j = 0; j < 6; ++j)
-		{
-			bitChar[5 - j] = data[pointer + i * 6 + j];
-		}
-		if (bitChar.to_ulong() < 32)
-		{
-			strVariable[i] = '@' + bitChar.to_ulong();
-		}
-		else
-		{
-			strVariable[i] = ' ' + (bitChar.to_ulong() - 32);
-		}
+		value.push_back(
+				aisSixBitToAscii(decodeBitUInt(data, pointer + i * 6, 6)));
 	}
 
-	boost::trim(strVariable);
-	boost::trim_right_if(strVariable, boost::is_any_of("@"));
-
-	return strVariable;
+	value.trimSixBit();
 }
 
 // Parseo de tramas NMEA
@@ -2211,18 +2197,21 @@ NmeaParserResult NmeaParser::parseMWV(const std::string& nmea,
 			char aux;
 			if (!impl::decodeDefault<char>(itNmea, aux, defChar))
 			{
-				if (aux == 'T')
-				{
-					reference = Nmea_AngleReference_True;
-					ret.set(idxVar);
-				}
-				else if (aux == 'R')
-				{
-					reference = Nmea_AngleReference_Relative;
-					ret.set(idxVar);
-				}
+				ret.set(idxVar);
 				++itNmea;
 			}
+			else if (aux == 'T')
+			{
+				reference = Nmea_AngleReference_True;
+			}
+			else if (aux == 'R')
+			{
+				reference = Nmea_AngleReference_Relative;
+			}
+			else
+			{
+				ret.set(idxVar);
+			}
 			++idxVar;
 			LOG_MESSAGE(debug) << "reference = " << reference;
 
@@ -3764,6 +3753,9 @@ bool NmeaParser::parseAISPositionReportClassA(const std::string& encodedData,
 			LOG_MESSAGE(debug) << "ManeuverIndicator = "
 					<< data.maneuverIndicator;
 
+			// Spare
+			cursor += 3;
+
 			if (binaryData[cursor++] == false)
 			{
 				data.raim = Nmea_RAIM_NotInUse;
@@ -3953,11 +3945,13 @@ bool NmeaParser::parseAISStaticAndVoyageRelatedData(
 			cursor += 30;
 			LOG_MESSAGE(debug) << "ImoNumber = " << data.imoNumber;
 
-			data.callsign = impl::decodeBitString(binaryData, cursor, 42);
+			impl::decodeBitString(binaryData, cursor, 42,
+					data.callsign);
 			cursor += 42;
 			LOG_MESSAGE(debug) << "CallSign = '" << data.callsign << "'";
 
-			data.vesselName = impl::decodeBitString(binaryData, cursor, 120);
+			impl::decodeBitString(binaryData, cursor, 120,
+					data.vesselName);
 			cursor += 120;
 			LOG_MESSAGE(debug) << "VesselName = '" << data.vesselName << "'";
 
@@ -4009,7 +4003,8 @@ bool NmeaParser::parseAISStaticAndVoyageRelatedData(
 			cursor += 8;
 			LOG_MESSAGE(debug) << "Draught = " << data.draught * 0.1f;
 
-			data.destination = impl::decodeBitString(binaryData, cursor, 120);
+			impl::decodeBitString(binaryData, cursor, 120,
+					data.destination);
 			//cursor += 120;
 			LOG_MESSAGE(debug) << "Destination = " << data.destination;
 		}
@@ -4117,6 +4112,153 @@ bool NmeaParser::parseAISStandardClassBCSPositionReport(
 	return ret;
 }
 
+bool NmeaParser::parseAISExtendedClassBEquipmentPositionReport(
+		const std::string& encodedData, AISExtendedClassBCSPositionReport& data)
+{
+	bool ret = false;
+
+	LOG_MESSAGE(trace)
+			<< "NmeaParser::parseAISExtendedClassBEquipmentPositionReport";
+	LOG_MESSAGE(debug) << "encodedData = " << encodedData;
+
+	const int TYPE19_TOTALBITS = 312;
+	const int TYPE19_TOTALCHARS = 52;
+
+	if (encodedData.length() >= TYPE19_TOTALCHARS)
+	{
+
+		boost::dynamic_bitset<> binaryData(TYPE19_TOTALBITS);
+
+		// Decodifica cadena a array de bits
+		for (int i = 0; i < TYPE19_TOTALCHARS; ++i)
+		{
+			SixBit bitsetDecode = impl::decodeSixBit(encodedData.at(i));
+			LOG_MESSAGE(debug) << "Char: " << encodedData.at(i) << " Bits: "
+					<< bitsetDecode;
+
+			// Concatenate all six-bit quantities found in the payload, MSB first
+			impl::concatSixBitMSBFirst(i * 6, binaryData, bitsetDecode);
+		}
+		LOG_MESSAGE(debug) << "parseAISExtendedClassBEquipmentPositionReport : "
+				<< binaryData;
+
+		int cursor = 0;
+
+		Nmea_AisMessageType messageType =
+				static_cast<Nmea_AisMessageType>(impl::decodeBitUInt(binaryData,
+						cursor, 6));
+		cursor += 6;
+		LOG_MESSAGE(debug) << "MessageType = " << messageType;
+
+		if (messageType
+				== Nmea_AisMessageType_ExtendedClassBEquipmentPositionReport)
+		{
+			ret = true;
+
+			data.repeatIndicator = impl::decodeBitUInt(binaryData, cursor, 2);
+			cursor += 2;
+			LOG_MESSAGE(debug) << "RepeatIndicator = " << data.repeatIndicator;
+
+			data.mmsi = impl::decodeBitUInt(binaryData, cursor, 30);
+			cursor += 30;
+			LOG_MESSAGE(debug) << "MMSI = " << data.mmsi;
+
+			// Reserved
+			cursor += 8;
+
+			data.speedOverGround = impl::decodeBitUInt(binaryData, cursor, 10)
+					* 0.1f;
+			cursor += 10;
+			LOG_MESSAGE(debug) << "SpeedOverGround = " << data.speedOverGround;
+
+			if (binaryData[cursor++] == false)
+			{
+				data.positionAccuracy =
+						Nmea_PositionAccuracy_UnaugmentedGNSSFix;
+			}
+			else
+			{
+				data.positionAccuracy = Nmea_PositionAccuracy_DGPSQualityFix;
+			}
+			LOG_MESSAGE(debug) << "PositionAccuracy = "
+					<< data.positionAccuracy;
+
+			data.longitude = impl::decodeBitInt(binaryData, cursor, 28)
+					/ 600000.0f;
+			cursor += 28;
+			LOG_MESSAGE(debug) << "Longitude = " << data.longitude;
+
+			data.latitude = impl::decodeBitInt(binaryData, cursor, 27)
+					/ 600000.0f;
+			cursor += 27;
+			LOG_MESSAGE(debug) << "Latitude = " << data.latitude;
+
+			data.courseOverGround = impl::decodeBitUInt(binaryData, cursor, 12)
+					* 0.1f;
+			cursor += 12;
+			LOG_MESSAGE(debug) << "CourseOverGround = "
+					<< data.courseOverGround;
+
+			data.trueHeading = impl::decodeBitUInt(binaryData, cursor, 9);
+			cursor += 9;
+			LOG_MESSAGE(debug) << "TrueHeading = " << data.trueHeading;
+
+			data.timestapUTCSecond = impl::decodeBitUInt(binaryData, cursor, 6);
+			cursor += 6;
+			LOG_MESSAGE(debug) << "TimestampUTCSecond = "
+					<< data.timestapUTCSecond;
+
+			// Regional reserved
+			cursor += 4;
+
+			impl::decodeBitString(binaryData, cursor, 120,
+					data.vesselName);
+			cursor += 120;
+			LOG_MESSAGE(debug) << "VesselName = '" << data.vesselName << "'";
+
+			data.shipType = static_cast<Nmea_ShipType>(impl::decodeBitUInt(
+					binaryData, cursor, 8));
+			cursor += 8;
+			LOG_MESSAGE(debug) << "ShipType = " << data.shipType;
+
+			data.dimension.toBow = impl::decodeBitUInt(binaryData, cursor, 9);
+			cursor += 9;
+
+			data.dimension.toStern = impl::decodeBitUInt(binaryData, cursor, 9);
+			cursor += 9;
+
+			data.dimension.toPort = impl::decodeBitUInt(binaryData, cursor, 6);
+			cursor += 6;
+
+			data.dimension.toStarboard = impl::decodeBitUInt(binaryData, cursor,
+					6);
+			cursor += 6;
+
+			data.epfd = static_cast<Nmea_EPFDFix>(impl::decodeBitUInt(
+					binaryData, cursor, 4));
+			cursor += 4;
+			LOG_MESSAGE(debug) << "EPFD = " << data.epfd;
+
+			if (binaryData[cursor++] == false)
+			{
+				data.raim = Nmea_RAIM_NotInUse;
+			}
+			else
+			{
+				data.raim = Nmea_RAIM_InUse;
+			}
+			LOG_MESSAGE(debug) << "RAIM = " << data.raim;
+
+			// DTE
+			cursor += 1;
+
+			data.assigned = binaryData[cursor++];
+			LOG_MESSAGE(debug) << "Assigned = " << data.assigned;
+		}
+	}
+	return ret;
+}
+
 bool NmeaParser::parseAISStaticDataReport(const std::string& encodedData,
 		AISStaticDataReport& data)
 {
@@ -4172,8 +4314,8 @@ bool NmeaParser::parseAISStaticDataReport(const std::string& encodedData,
 
 			if (data.partNumber == 0)
 			{
-				data.partA.vesselName = impl::decodeBitString(binaryData,
-						cursor, 120);
+				impl::decodeBitString(binaryData, cursor, 120,
+						data.partA.vesselName);
 				//cursor += 120;
 				LOG_MESSAGE(debug) << "VesselName = '" << data.partA.vesselName
 						<< "'";
@@ -4186,8 +4328,8 @@ bool NmeaParser::parseAISStaticDataReport(const std::string& encodedData,
 				cursor += 8;
 				LOG_MESSAGE(debug) << "ShipType = " << data.partB.shipType;
 
-				data.partB.vendorId = impl::decodeBitString(binaryData, cursor,
-						18);
+				impl::decodeBitString(binaryData, cursor, 18,
+						data.partB.vendorId);
 				cursor += 18;
 				LOG_MESSAGE(debug) << "VendorId = '" << data.partB.vendorId
 						<< "'";
@@ -4204,8 +4346,8 @@ bool NmeaParser::parseAISStaticDataReport(const std::string& encodedData,
 				LOG_MESSAGE(debug) << "SerialNumber = "
 						<< data.partB.serialNumber;
 
-				data.partB.callsign = impl::decodeBitString(binaryData, cursor,
-						42);
+				impl::decodeBitString(binaryData, cursor, 42,
+						data.partB.callsign);
 				cursor += 42;
 				LOG_MESSAGE(debug) << "CallSign = '" << data.partB.callsign
 						<< "'";
@@ -4291,7 +4433,8 @@ bool NmeaParser::parseAISAidToNavigationReport(const std::string& encodedData,
 			cursor += 5;
 			LOG_MESSAGE(debug) << "NavigationAidType = " << data.mmsi;
 
-			data.name = impl::decodeBitString(binaryData, cursor, 120);
+			impl::decodeBitString(binaryData, cursor, 120,
+					data.name);
 			cursor += 120;
 			LOG_MESSAGE(debug) << "Name = " << data.name;
 
@@ -4367,12 +4510,17 @@ bool NmeaParser::parseAISAidToNavigationReport(const std::string& encodedData,
 			data.assigned = binaryData[cursor++];
 			LOG_MESSAGE(debug) << "Assigned = " << data.assigned;
 
+			// Spare
+			cursor += 1;
+
 			int nameExtensionBits = bitsLength - TYPE21_TOTALBITS;
 			if (nameExtensionBits > 0)
 			{
 				nameExtensionBits = (nameExtensionBits / 6) * 6;
-				data.name += impl::decodeBitString(binaryData, cursor,
-						nameExtensionBits);
+				AISFixedString<14> nameExtension;
+				impl::decodeBitString(binaryData, cursor, nameExtensionBits,
+						nameExtension);
+				data.name.append(nameExtension.data(), nameExtension.size());
 			}
 		}
 	}
@@ -0,0 +1,515 @@
+/**
+ *	@file NmeaPcapReader.cpp
+ *	@brief NmeaPcapReader Implementation
+ */
+
+#include "NmeaPcapReader.h"
+
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @brief Private Implementation
+ */
+class NmeaPcapReader::impl
+{
+public:
+	/**
+	 * @brief pcapng block types
+	 */
+	enum BlockType
+	{
+		SectionHeader = 0x0A0D0D0A, //!< Starts a section, sets the byte order
+		InterfaceDescription = 1, //!< Declares an interface
+		EnhancedPacket = 6 //!< Packet with interface and timestamp
+	};
+
+	/**
+	 * @brief Link types
+	 */
+	enum LinkType
+	{
+		Null = 0, //!< BSD loopback, address family first
+		Ethernet = 1, //!< Ethernet II
+		Raw = 101, //!< Raw IP
+		LinuxSll = 113, //!< Linux cooked capture
+		Ipv4 = 228, //!< Raw IPv4
+		LinuxSll2 = 276 //!< Linux cooked capture v2
+	};
+
+	/**
+	 * @brief Reads a 16 bit word in file byte order
+	 *
+	 * @param [in] p Word
+	 * @param [in] swapped True if the file byte order is not the host one
+	 *
+	 * @return Value.
+	 */
+	static uint16_t read16(const char* p, bool swapped);
+
+	/**
+	 * @brief Reads a 32 bit word in file byte order
+	 *
+	 * @param [in] p Word
+	 * @param [in] swapped True if the file byte order is not the host one
+	 *
+	 * @return Value.
+	 */
+	static uint32_t read32(const char* p, bool swapped);
+
+	/**
+	 * @brief Reads a 64 bit word in file byte order
+	 *
+	 * @param [in] p Word
+	 * @param [in] swapped True if the file byte order is not the host one
+	 *
+	 * @return Value.
+	 */
+	static uint64_t read64(const char* p, bool swapped);
+
+	/**
+	 * @brief Reads a 16 bit word in network byte order
+	 *
+	 * @param [in] p Word
+	 *
+	 * @return Value.
+	 */
+	static uint16_t big16(const char* p);
+
+	/**
+	 * @brief Reads a 32 bit word in network byte order
+	 *
+	 * @param [in] p Word
+	 *
+	 * @return Value.
+	 */
+	static uint32_t big32(const char* p);
+
+	/**
+	 * @brief Converts a pcapng timestamp to microseconds
+	 *
+	 * @param [in] interface Interface of the packet
+	 * @param [in] timestamp Timestamp in interface units
+	 *
+	 * @return Microseconds since the UNIX epoch.
+	 */
+	static int64_t microseconds(const Interface& interface, uint64_t timestamp);
+
+	/**
+	 * @brief Reads the next packet record
+	 *
+	 * @param [in] self Reader
+	 * @param [out] data Captured bytes
+	 * @param [out] length Captured length
+	 * @param [out] linkType Link type of the packet
+	 *
+	 * @return False at the end of the file or at a corrupt record.
+	 */
+	static bool record(NmeaPcapReader& self, const char*& data,
+			std::size_t& length, uint16_t& linkType);
+
+	/**
+	 * @brief Walks the headers of a packet down to a NMEA UDP payload
+	 *
+	 * @param [in] self Reader, receives the addresses and the payload
+	 * @param [in] linkType Link type of the packet
+	 * @param [in] data Captured bytes
+	 * @param [in] length Captured length
+	 *
+	 * @return False if the packet holds no NMEA datagram.
+	 */
+	static bool datagram(NmeaPcapReader& self, uint16_t linkType,
+			const char* data, std::size_t length);
+};
+
+uint16_t NmeaPcapReader::impl::read16(const char* p, bool swapped)
+{
+	uint16_t value;
+	std::memcpy(&value, p, sizeof(value));
+	return swapped ? __builtin_bswap16(value) : value;
+}
+
+uint32_t NmeaPcapReader::impl::read32(const char* p, bool swapped)
+{
+	uint32_t value;
+	std::memcpy(&value, p, sizeof(value));
+	return swapped ? __builtin_bswap32(value) : value;
+}
+
+uint64_t NmeaPcapReader::impl::read64(const char* p, bool swapped)
+{
+	uint64_t value;
+	std::memcpy(&value, p, sizeof(value));
+	return swapped ? __builtin_bswap64(value) : value;
+}
+
+uint16_t NmeaPcapReader::impl::big16(const char* p)
+{
+	const unsigned char* u = reinterpret_cast<const unsigned char*>(p);
+	return u[0] << 8 | u[1];
+}
+
+uint32_t NmeaPcapReader::impl::big32(const char* p)
+{
+	return static_cast<uint32_t>(big16(p)) << 16 | big16(p + 2);
+}
+
+int64_t NmeaPcapReader::impl::microseconds(const Interface& interface,
+		uint64_t timestamp)
+{
+	int64_t value;
+	if (interface.binary)
+	{
+		// Whole seconds first, the fraction would overflow otherwise
+		const uint64_t mask = (uint64_t(1) << interface.exponent) - 1;
+		value = (timestamp >> interface.exponent) * 1000000
+				+ ((timestamp & mask) * 1000000 >> interface.exponent);
+	}
+	else
+	{
+		value = timestamp;
+		for (int e = interface.exponent; e > 6; --e)
+		{
+			value /= 10;
+		}
+		for (int e = interface.exponent; e < 6; ++e)
+		{
+			value *= 10;
+		}
+	}
+	return value + interface.offset * 1000000;
+}
+
+bool NmeaPcapReader::impl::record(NmeaPcapReader& self, const char*& data,
+		std::size_t& length, uint16_t& linkType)
+{
+	const char* base = self.file.data();
+	const uint64_t size = self.file.size();
+
+	if (!self.ng)
+	{
+		if (size - self.offset < 16)
+		{
+			return false;
+		}
+		const char* h = base + self.offset;
+		const uint32_t captured = read32(h + 8, self.swapped);
+		if (captured > size - self.offset - 16)
+		{
+			return false;
+		}
+		const uint32_t fraction = read32(h + 4, self.swapped);
+		self.datagram.timestamp = static_cast<int64_t>(read32(h,
+				self.swapped)) * 1000000
+				+ (self.nanoseconds ? fraction / 1000 : fraction);
+		if (captured < read32(h + 12, self.swapped))
+		{
+			++self.counters.truncated;
+		}
+		data = h + 16;
+		length = captured;
+		linkType = self.linkType;
+		self.offset += 16 + captured;
+		return true;
+	}
+
+	while (size - self.offset >= 12)
+	{
+		const char* b = base + self.offset;
+		// The section header sets the byte order of its own length
+		if (read32(b, false) == SectionHeader)
+		{
+			const uint32_t magic = read32(b + 8, false);
+			if (magic != 0x1A2B3C4D && magic != 0x4D3C2B1A)
+			{
+				return false;
+			}
+			self.swapped = magic != 0x1A2B3C4D;
+			self.interfaces.clear();
+		}
+		const uint32_t type = read32(b, self.swapped);
+		const uint32_t total = read32(b + 4, self.swapped);
+		if (total < 12 || total % 4 != 0 || total > size - self.offset)
+		{
+			return false;
+		}
+		self.offset += total;
+
+		if (type == InterfaceDescription && total >= 20)
+		{
+			Interface interface;
+			interface.linkType = read16(b + 8, self.swapped);
+			interface.binary = false;
+			interface.exponent = 6;
+			interface.offset = 0;
+			// Options, padded to 32 bits, up to the trailing length
+			for (uint32_t o = 16; o + 4 <= total - 4;)
+			{
+				const uint16_t code = read16(b + o, self.swapped);
+				const uint16_t optionLength = read16(b + o + 2, self.swapped);
+				if (code == 0 || o + 4 + optionLength > total - 4)
+				{
+					break;
+				}
+				if (code == 9 && optionLength == 1)
+				{
+					const unsigned char resolution = b[o + 4];
+					interface.binary = (resolution & 0x80) != 0;
+					interface.exponent = resolution & 0x7F;
+					// Finer resolutions overflow the conversion to microseconds
+					if (interface.exponent > (interface.binary ? 44 : 19))
+					{
+						return false;
+					}
+				}
+				else if (code == 14 && optionLength == 8)
+				{
+					interface.offset = static_cast<int64_t>(read64(b + o + 4,
+							self.swapped));
+				}
+				o += 4 + ((optionLength + 3) & ~3U);
+			}
+			self.interfaces.push_back(interface);
+		}
+		else if (type == EnhancedPacket && total >= 32)
+		{
+			const uint32_t id = read32(b + 8, self.swapped);
+			const uint32_t captured = read32(b + 20, self.swapped);
+			if (id >= self.interfaces.size() || captured > total - 32)
+			{
+				return false;
+			}
+			const Interface& interface = self.interfaces[id];
+			const uint64_t timestamp = static_cast<uint64_t>(read32(b + 12,
+					self.swapped)) << 32 | read32(b + 16, self.swapped);
+			self.datagram.timestamp = microseconds(interface, timestamp);
+			if (captured < read32(b + 24, self.swapped))
+			{
+				++self.counters.truncated;
+			}
+			data = b + 28;
+			length = captured;
+			linkType = interface.linkType;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool NmeaPcapReader::impl::datagram(NmeaPcapReader& self, uint16_t linkType,
+		const char* data, std::size_t length)
+{
+	std::size_t header;
+	uint16_t protocol = 0x0800;
+	switch (linkType)
+	{
+	case Ethernet:
+		if (length < 14)
+		{
+			return false;
+		}
+		header = 14;
+		protocol = big16(data + 12);
+		// 802.1Q and 802.1ad tags
+		while ((protocol == 0x8100 || protocol == 0x88A8)
+				&& length >= header + 4)
+		{
+			protocol = big16(data + header + 2);
+			header += 4;
+		}
+		break;
+	case LinuxSll:
+		if (length < 16)
+		{
+			return false;
+		}
+		header = 16;
+		protocol = big16(data + 14);
+		break;
+	case LinuxSll2:
+		if (length < 20)
+		{
+			return false;
+		}
+		header = 20;
+		protocol = big16(data);
+		break;
+	case Null:
+		// Address family in the byte order of the capturing host
+		if (length < 4 || (read32(data, false) != 2 && read32(data, true) != 2))
+		{
+			return false;
+		}
+		header = 4;
+		break;
+	case Raw:
+	case Ipv4:
+		header = 0;
+		break;
+	default:
+		return false;
+	}
+	if (protocol != 0x0800)
+	{
+		return false;
+	}
+
+	// IPv4, unfragmented UDP
+	const char* ip = data + header;
+	length -= header;
+	if (length < 20 || (ip[0] & 0xF0) != 0x40)
+	{
+		return false;
+	}
+	const std::size_t ipHeader = (ip[0] & 0x0F) * 4;
+	if (ipHeader < 20 || length < ipHeader + 8 || ip[9] != 17
+			|| (big16(ip + 6) & 0x3FFF) != 0)
+	{
+		return false;
+	}
+	// Total length below the headers would wrap the payload length around
+	const std::size_t total = big16(ip + 2);
+	if (total < ipHeader + 8)
+	{
+		return false;
+	}
+	length = std::min(length, total);
+
+	const char* udp = ip + ipHeader;
+	const uint16_t udpLength = big16(udp + 4);
+	if (udpLength < 8)
+	{
+		return false;
+	}
+	self.datagram.sourceAddress = big32(ip + 12);
+	self.datagram.destinationAddress = big32(ip + 16);
+	self.datagram.sourcePort = big16(udp);
+	self.datagram.destinationPort = big16(udp + 2);
+	if (self.port != 0 && self.datagram.destinationPort != self.port)
+	{
+		return false;
+	}
+
+	const char* payload = udp + 8;
+	std::size_t remaining = std::min<std::size_t>(udpLength - 8,
+			length - ipHeader - 8);
+	self.datagram.udpbc = remaining >= 6 && std::memcmp(payload, "UdPbC", 6) == 0;
+	if (self.datagram.udpbc)
+	{
+		payload += 6;
+		remaining -= 6;
+	}
+	// Sentences or TAG blocks only, other 61162-450 headers carry binary data
+	if (remaining == 0
+			|| (payload[0] != '$' && payload[0] != '!' && payload[0] != '\\'))
+	{
+		return false;
+	}
+	self.payload = payload;
+	self.remaining = remaining;
+	return true;
+}
+
+NmeaPcapReader::NmeaPcapReader() :
+		ng(false), swapped(false), nanoseconds(false), linkType(0), offset(0), port(
+				0), datagram(), payload(nullptr), remaining(0), counters()
+{
+
+}
+
+bool NmeaPcapReader::open(const std::string& path)
+{
+	close();
+	if (!file.open(path) || file.size() < 24)
+	{
+		file.close();
+		return false;
+	}
+
+	const char* data = file.data();
+	const uint32_t magic = impl::read32(data, false);
+	if (magic == 0xA1B2C3D4 || magic == 0xA1B23C4D
+			|| magic == 0xD4C3B2A1 || magic == 0x4D3CB2A1)
+	{
+		ng = false;
+		swapped = magic == 0xD4C3B2A1 || magic == 0x4D3CB2A1;
+		nanoseconds = magic == 0xA1B23C4D || magic == 0x4D3CB2A1;
+		// Upper bits may hold FCS information
+		linkType = impl::read32(data + 20, swapped) & 0xFFFF;
+		offset = 24;
+	}
+	else if (magic == impl::SectionHeader)
+	{
+		ng = true;
+		offset = 0;
+	}
+	else
+	{
+		file.close();
+		return false;
+	}
+	return true;
+}
+
+void NmeaPcapReader::close()
+{
+	file.close();
+	interfaces.clear();
+	offset = 0;
+	payload = nullptr;
+	remaining = 0;
+	counters = NmeaPcapStatistics();
+}
+
+void NmeaPcapReader::setPort(uint16_t port)
+{
+	this->port = port;
+}
+
+bool NmeaPcapReader::next(NmeaCapturedLine& line)
+{
+	for (;;)
+	{
+		while (remaining > 0)
+		{
+			const char* newline = static_cast<const char*>(std::memchr(payload,
+					'\n', remaining));
+			const std::size_t length =
+					newline != nullptr ? newline - payload : remaining;
+			line = datagram;
+			line.line = boost::string_ref(payload, length);
+			payload += length + (newline != nullptr ? 1 : 0);
+			remaining -= length + (newline != nullptr ? 1 : 0);
+			if (!line.line.empty() && line.line.back() == '\r')
+			{
+				line.line.remove_suffix(1);
+			}
+			if (!line.line.empty())
+			{
+				return true;
+			}
+		}
+
+		const char* data;
+		std::size_t length;
+		uint16_t type;
+		if (!file.isOpen() || !impl::record(*this, data, length, type))
+		{
+			return false;
+		}
+		++counters.packets;
+		if (impl::datagram(*this, type, data, length))
+		{
+			++counters.datagrams;
+		}
+		else
+		{
+			++counters.skipped;
+		}
+	}
+}
+
+const NmeaPcapStatistics& NmeaPcapReader::statistics() const
+{
+	return counters;
+}
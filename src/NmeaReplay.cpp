@@ -0,0 +1,343 @@
+/**
+ *	@file NmeaReplay.cpp
+ *	@brief NmeaReplay Implementation
+ */
+
+#include "NmeaReplay.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fcntl.h>
+#include <limits>
+#include <termios.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+/**
+ * @brief Private Implementation
+ */
+class NmeaReplay::impl
+{
+public:
+	/**
+	 * @brief Histogram buckets, 1 us each, the last one for 10 ms and more
+	 */
+	static const std::size_t BUCKETS = 10001;
+
+	/**
+	 * @brief Reads the monotonic clock
+	 *
+	 * @return Nanoseconds.
+	 */
+	static int64_t now();
+
+	/**
+	 * @brief Waits for a deadline, sleeping then spinning
+	 *
+	 * @param [in] deadline Monotonic time in nanoseconds
+	 * @param [in] spin Time spent spinning before the deadline
+	 */
+	static void waitUntil(int64_t deadline, int64_t spin);
+
+	/**
+	 * @brief Sends a line to every sink
+	 *
+	 * @param [in] self Replay
+	 * @param [in] line Line and its time
+	 *
+	 * @return False if a sink could not take the line.
+	 */
+	static bool send(NmeaReplay& self, const NmeaMergedLine& line);
+
+	/**
+	 * @brief Writes what the pseudo terminal can take of the pending tail
+	 *
+	 * @param [in,out] self Replay
+	 *
+	 * @return True if nothing is left pending.
+	 */
+	static bool flushPty(NmeaReplay& self);
+};
+
+const std::size_t NmeaReplay::impl::BUCKETS;
+
+int64_t NmeaReplay::impl::now()
+{
+	struct timespec ts;
+	::clock_gettime(CLOCK_MONOTONIC, &ts);
+	return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+void NmeaReplay::impl::waitUntil(int64_t deadline, int64_t spin)
+{
+	const int64_t wake = deadline - spin;
+	if (wake > now())
+	{
+		struct timespec ts;
+		ts.tv_sec = wake / 1000000000;
+		ts.tv_nsec = wake % 1000000000;
+		// Absolute deadline, a signal does not shorten or lengthen the wait
+		while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr)
+				== EINTR)
+		{
+		}
+	}
+	while (now() < deadline)
+	{
+	}
+}
+
+bool NmeaReplay::impl::flushPty(NmeaReplay& self)
+{
+	if (!self.ptyPending.empty())
+	{
+		const ssize_t written = ::write(self.ptyFd, self.ptyPending.data(),
+				self.ptyPending.size());
+		if (written > 0)
+		{
+			self.ptyPending.erase(0, written);
+		}
+	}
+	return self.ptyPending.empty();
+}
+
+bool NmeaReplay::impl::send(NmeaReplay& self, const NmeaMergedLine& line)
+{
+	// Devices get NMEA, not the receive time a logger wrote before it
+	self.buffer.assign(line.sentence.data(), line.sentence.size());
+	self.buffer += "\r\n";
+
+	bool taken = true;
+	if (self.ptyFd >= 0)
+	{
+		// A stream, a line is all or nothing and a partial one is finished first
+		if (!flushPty(self))
+		{
+			taken = false;
+		}
+		else
+		{
+			const ssize_t written = ::write(self.ptyFd, self.buffer.data(),
+					self.buffer.size());
+			if (written < 0)
+			{
+				taken = false;
+			}
+			else
+			{
+				self.ptyPending.assign(self.buffer, written, std::string::npos);
+			}
+		}
+	}
+	if (self.udpFd >= 0)
+	{
+		taken &= ::send(self.udpFd, self.buffer.data(), self.buffer.size(),
+				MSG_DONTWAIT) == static_cast<ssize_t>(self.buffer.size());
+	}
+	if (self.callback)
+	{
+		self.callback(line.sentence, line.timestamp);
+	}
+	return taken;
+}
+
+NmeaReplay::NmeaReplay() :
+		ptyFd(-1), udpFd(-1), speed(1.0), spin(100000), stopping(false), histogram(
+				impl::BUCKETS)
+{
+	resetStatistics();
+}
+
+NmeaReplay::~NmeaReplay()
+{
+	close();
+}
+
+bool NmeaReplay::openPty(std::string& name)
+{
+	if (ptyFd >= 0)
+	{
+		::close(ptyFd);
+	}
+
+	ptyPending.clear();
+	ptyFd = ::posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+	if (ptyFd < 0)
+	{
+		return false;
+	}
+
+	struct termios tio;
+	if (::grantpt(ptyFd) == 0 && ::unlockpt(ptyFd) == 0
+			&& ::tcgetattr(ptyFd, &tio) == 0)
+	{
+		// Raw, lines reach the slave without CR LF translation or echo
+		::cfmakeraw(&tio);
+		const char* slave = ::ptsname(ptyFd);
+		if (::tcsetattr(ptyFd, TCSANOW, &tio) == 0 && slave != nullptr)
+		{
+			name = slave;
+			return true;
+		}
+	}
+	::close(ptyFd);
+	ptyFd = -1;
+	return false;
+}
+
+bool NmeaReplay::openUdp(const std::string& address, uint16_t port)
+{
+	if (udpFd >= 0)
+	{
+		::close(udpFd);
+		udpFd = -1;
+	}
+
+	struct sockaddr_in destination = sockaddr_in();
+	destination.sin_family = AF_INET;
+	destination.sin_port = htons(port);
+	if (::inet_pton(AF_INET, address.c_str(), &destination.sin_addr) != 1)
+	{
+		return false;
+	}
+
+	udpFd = ::socket(AF_INET, SOCK_DGRAM, 0);
+	if (udpFd < 0)
+	{
+		return false;
+	}
+	if (::connect(udpFd, reinterpret_cast<struct sockaddr*>(&destination),
+			sizeof(destination)) != 0)
+	{
+		::close(udpFd);
+		udpFd = -1;
+		return false;
+	}
+	return true;
+}
+
+void NmeaReplay::setCallback(const Callback& callback)
+{
+	this->callback = callback;
+}
+
+void NmeaReplay::close()
+{
+	if (ptyFd >= 0)
+	{
+		::close(ptyFd);
+		ptyFd = -1;
+	}
+	ptyPending.clear();
+	if (udpFd >= 0)
+	{
+		::close(udpFd);
+		udpFd = -1;
+	}
+	callback = Callback();
+}
+
+void NmeaReplay::setSpeed(double speed)
+{
+	this->speed = std::max(speed, 0.0);
+}
+
+void NmeaReplay::setSpin(int64_t nanoseconds)
+{
+	spin = std::max<int64_t>(nanoseconds, 0);
+}
+
+uint64_t NmeaReplay::replay(NmeaLogMerger& merger)
+{
+	stopping = false;
+
+	uint64_t sent = 0;
+	bool started = false;
+	int64_t origin = 0;
+	int64_t start = 0;
+	int64_t previous = 0;
+	NmeaMergedLine line;
+	while (!stopping.load(std::memory_order_relaxed) && merger.next(line))
+	{
+		// Lines before any time, and every line at full speed, are not scheduled
+		if (speed > 0.0
+				&& line.timestamp != std::numeric_limits<int64_t>::min())
+		{
+			if (!started)
+			{
+				origin = line.timestamp;
+				start = impl::now();
+				previous = start;
+				started = true;
+			}
+			// A clock stepping back in the log does not make lines earlier
+			const int64_t deadline = std::max(previous,
+					start
+							+ static_cast<int64_t>(std::llround(
+									(line.timestamp - origin) * 1e6 / speed)));
+			previous = deadline;
+			impl::waitUntil(deadline, spin);
+
+			const int64_t late = std::max<int64_t>(impl::now() - deadline, 0);
+			++histogram[std::min<int64_t>(late / 1000, impl::BUCKETS - 1)];
+			counters.maxJitter = std::max(counters.maxJitter, late);
+			++counters.scheduled;
+		}
+
+		if (!impl::send(*this, line))
+		{
+			++counters.dropped;
+		}
+		++counters.lines;
+		++sent;
+	}
+	if (ptyFd >= 0)
+	{
+		impl::flushPty(*this);
+	}
+	return sent;
+}
+
+void NmeaReplay::stop()
+{
+	stopping = true;
+}
+
+NmeaReplayStatistics NmeaReplay::statistics() const
+{
+	return counters;
+}
+
+int64_t NmeaReplay::jitterPercentile(double percentile) const
+{
+	if (counters.scheduled == 0)
+	{
+		return 0;
+	}
+
+	const uint64_t rank = std::max<uint64_t>(1,
+			static_cast<uint64_t>(std::ceil(
+					std::min(std::max(percentile, 0.0), 100.0) / 100.0
+							* counters.scheduled)));
+	uint64_t count = 0;
+	for (std::size_t i = 0; i < impl::BUCKETS - 1; ++i)
+	{
+		count += histogram[i];
+		if (count >= rank)
+		{
+			return static_cast<int64_t>(i + 1) * 1000;
+		}
+	}
+	return counters.maxJitter;
+}
+
+void NmeaReplay::resetStatistics()
+{
+	counters = NmeaReplayStatistics();
+	std::fill(histogram.begin(), histogram.end(), 0);
+}
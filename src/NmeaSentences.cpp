@@ -5,6 +5,8 @@
 
 #include "NmeaSentences.h"
 
+#include <stdexcept>
+
 const std::map<std::string, std::string> NmeaTalkerIdMap::mapTalkerId = { {
 		"AB", "Independent AIS Base Station" }, { "AD",
 		"Dependent AIS Base Station" }, { "AG", "Autopilot - General" }, { "AP",
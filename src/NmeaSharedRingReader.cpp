@@ -0,0 +1,187 @@
+/**
+ *	@file NmeaSharedRingReader.cpp
+ *	@brief NmeaSharedRingReader Implementation
+ */
+
+#include "NmeaSharedRingReader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Private Implementation
+ */
+class NmeaSharedRingReader::impl
+{
+public:
+	/**
+	 * @brief First word of a slot
+	 *
+	 * @param [in] header Mapping
+	 * @param [in] sequence Record
+	 *
+	 * @return Sequence word of the slot, followed by the rest of the slot.
+	 */
+	static const std::atomic<uint64_t>* slot(
+			const NmeaSharedRingHeader* header, uint64_t sequence);
+};
+
+const std::atomic<uint64_t>* NmeaSharedRingReader::impl::slot(
+		const NmeaSharedRingHeader* header, uint64_t sequence)
+{
+	return reinterpret_cast<const std::atomic<uint64_t>*>(header + 1)
+			+ (sequence % header->slotCount) * header->slotWords;
+}
+
+NmeaSharedRingReader::NmeaSharedRingReader() :
+		header(nullptr), mappedBytes(0), cursor(0), lost(0)
+{
+
+}
+
+NmeaSharedRingReader::~NmeaSharedRingReader()
+{
+	close();
+}
+
+bool NmeaSharedRingReader::open(const std::string& name)
+{
+	close();
+
+	const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+	if (fd < 0)
+	{
+		return false;
+	}
+	struct stat st;
+	void* p = MAP_FAILED;
+	if (::fstat(fd, &st) == 0
+			&& static_cast<std::size_t>(st.st_size)
+					>= sizeof(NmeaSharedRingHeader))
+	{
+		p = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	}
+	::close(fd);
+	if (p == MAP_FAILED)
+	{
+		return false;
+	}
+
+	header = static_cast<const NmeaSharedRingHeader*>(p);
+	mappedBytes = st.st_size;
+	// The magic is written once the rest of the header is
+	const bool ready = std::memcmp(header->magic, "NMEASHR1",
+			sizeof(header->magic)) == 0;
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (!ready || header->slotCount == 0
+			|| header->slotWords < NMEA_SHARED_RING_SLOT_HEADER + header->recordWords
+			|| mappedBytes
+					< sizeof(NmeaSharedRingHeader)
+							+ header->slotCount * header->slotWords
+									* sizeof(uint64_t))
+	{
+		close();
+		return false;
+	}
+
+	cursor = header->head.load(std::memory_order_acquire);
+	lost = 0;
+	return true;
+}
+
+void NmeaSharedRingReader::close()
+{
+	if (header != nullptr)
+	{
+		::munmap(const_cast<NmeaSharedRingHeader*>(header), mappedBytes);
+	}
+	header = nullptr;
+	mappedBytes = 0;
+	cursor = 0;
+}
+
+bool NmeaSharedRingReader::next(NmeaSharedRecord& record)
+{
+	if (header == nullptr)
+	{
+		return false;
+	}
+
+	const uint64_t head = header->head.load(std::memory_order_acquire);
+	while (cursor < head)
+	{
+		// Overrun: the records before head - slotCount are gone
+		if (head - cursor > header->slotCount)
+		{
+			lost += head - header->slotCount - cursor;
+			cursor = head - header->slotCount;
+		}
+
+		const std::atomic<uint64_t>* slot = impl::slot(header, cursor);
+		const uint64_t sequence = slot[0].load(std::memory_order_acquire);
+		if (sequence != 2 * cursor + 2)
+		{
+			// Being overwritten by a later record
+			++lost;
+			++cursor;
+			continue;
+		}
+
+		const uint64_t meta = slot[1].load(std::memory_order_relaxed);
+		const uint32_t size = static_cast<uint32_t>(meta);
+		const std::size_t words = (size + sizeof(uint64_t) - 1)
+				/ sizeof(uint64_t);
+		if (words > header->recordWords)
+		{
+			++lost;
+			++cursor;
+			continue;
+		}
+		record.data.resize(words);
+		for (std::size_t i = 0; i < words; ++i)
+		{
+			record.data[i] = slot[NMEA_SHARED_RING_SLOT_HEADER + i].load(
+					std::memory_order_relaxed);
+		}
+		record.timestamp = static_cast<int64_t>(slot[2].load(
+				std::memory_order_relaxed));
+
+		// The copy is only good if the writer did not come back meanwhile
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot[0].load(std::memory_order_relaxed) != sequence)
+		{
+			++lost;
+			++cursor;
+			continue;
+		}
+
+		record.sequence = cursor;
+		record.type = static_cast<uint32_t>(meta >> 32);
+		record.size = size;
+		++cursor;
+		return true;
+	}
+	return false;
+}
+
+void NmeaSharedRingReader::rewind()
+{
+	if (header != nullptr)
+	{
+		const uint64_t head = header->head.load(std::memory_order_acquire);
+		cursor = head > header->slotCount ? head - header->slotCount : 0;
+	}
+}
+
+uint64_t NmeaSharedRingReader::pending() const
+{
+	return header != nullptr ?
+			header->head.load(std::memory_order_acquire) - cursor : 0;
+}
+
+uint64_t NmeaSharedRingReader::overruns() const
+{
+	return lost;
+}
@@ -0,0 +1,146 @@
+/**
+ *	@file NmeaSharedRingWriter.cpp
+ *	@brief NmeaSharedRingWriter Implementation
+ */
+
+#include "NmeaSharedRingWriter.h"
+
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * @brief Private Implementation
+ */
+class NmeaSharedRingWriter::impl
+{
+public:
+	/**
+	 * @brief First word of a slot
+	 *
+	 * @param [in] header Mapping
+	 * @param [in] sequence Record
+	 *
+	 * @return Sequence word of the slot, followed by the rest of the slot.
+	 */
+	static std::atomic<uint64_t>* slot(NmeaSharedRingHeader* header,
+			uint64_t sequence);
+};
+
+std::atomic<uint64_t>* NmeaSharedRingWriter::impl::slot(
+		NmeaSharedRingHeader* header, uint64_t sequence)
+{
+	return reinterpret_cast<std::atomic<uint64_t>*>(header + 1)
+			+ (sequence % header->slotCount) * header->slotWords;
+}
+
+NmeaSharedRingWriter::NmeaSharedRingWriter() :
+		header(nullptr), mappedBytes(0), head(0)
+{
+
+}
+
+NmeaSharedRingWriter::~NmeaSharedRingWriter()
+{
+	close();
+}
+
+bool NmeaSharedRingWriter::create(const std::string& name, uint64_t slotCount,
+		std::size_t recordBytes)
+{
+	close();
+	if (slotCount == 0 || recordBytes == 0)
+	{
+		return false;
+	}
+
+	// Slots padded to whole cache lines
+	const uint32_t recordWords = (recordBytes + 7) / 8;
+	const uint32_t slotWords = (NMEA_SHARED_RING_SLOT_HEADER + recordWords + 7)
+			/ 8 * 8;
+	const std::size_t bytes = sizeof(NmeaSharedRingHeader)
+			+ slotCount * slotWords * sizeof(uint64_t);
+
+	// A new object, readers of an old one are not disturbed
+	::shm_unlink(name.c_str());
+	const int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+	if (fd < 0)
+	{
+		return false;
+	}
+	void* p = MAP_FAILED;
+	if (::ftruncate(fd, bytes) == 0)
+	{
+		p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	}
+	::close(fd);
+	if (p == MAP_FAILED)
+	{
+		::shm_unlink(name.c_str());
+		return false;
+	}
+
+	// ftruncate() zero fills: every sequence word starts at 0, no record
+	header = static_cast<NmeaSharedRingHeader*>(p);
+	mappedBytes = bytes;
+	head = 0;
+	header->recordWords = recordWords;
+	header->slotWords = slotWords;
+	header->slotCount = slotCount;
+	header->head.store(0, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	std::memcpy(header->magic, "NMEASHR1", sizeof(header->magic));
+	return true;
+}
+
+void NmeaSharedRingWriter::close()
+{
+	if (header != nullptr)
+	{
+		::munmap(header, mappedBytes);
+	}
+	header = nullptr;
+	mappedBytes = 0;
+	head = 0;
+}
+
+bool NmeaSharedRingWriter::remove(const std::string& name)
+{
+	return ::shm_unlink(name.c_str()) == 0;
+}
+
+bool NmeaSharedRingWriter::publish(uint32_t type, const void* data,
+		std::size_t size, int64_t timestamp)
+{
+	if (header == nullptr || size > header->recordWords * sizeof(uint64_t))
+	{
+		return false;
+	}
+
+	std::atomic<uint64_t>* slot = impl::slot(header, head);
+	slot[0].store(2 * head + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	slot[1].store(static_cast<uint64_t>(type) << 32 | size,
+			std::memory_order_relaxed);
+	slot[2].store(static_cast<uint64_t>(timestamp), std::memory_order_relaxed);
+	const char* bytes = static_cast<const char*>(data);
+	for (std::size_t i = 0; i < size; i += sizeof(uint64_t))
+	{
+		uint64_t word = 0;
+		std::memcpy(&word, bytes + i, std::min(size - i, sizeof(uint64_t)));
+		slot[NMEA_SHARED_RING_SLOT_HEADER + i / sizeof(uint64_t)].store(word,
+				std::memory_order_relaxed);
+	}
+
+	slot[0].store(2 * head + 2, std::memory_order_release);
+	++head;
+	header->head.store(head, std::memory_order_release);
+	return true;
+}
+
+uint64_t NmeaSharedRingWriter::published() const
+{
+	return head;
+}
@@ -0,0 +1,438 @@
+/**
+ *	@file NmeaTimeExtractor.cpp
+ *	@brief NmeaTimeExtractor Implementation
+ */
+
+#include "NmeaTimeExtractor.h"
+
+/**
+ * @brief Private Implementation
+ */
+class NmeaTimeExtractor::impl
+{
+public:
+	/**
+	 * @brief Milliseconds per day
+	 */
+	static const int64_t DAY = 86400000;
+
+	/**
+	 * @brief Checks the optional checksum of a sentence or TAG block
+	 *
+	 * @param [in] text Characters covered by the checksum, then optionally '*' and two hex digits
+	 * @param [out] body Text without checksum
+	 *
+	 * @return False if a checksum is present and does not match.
+	 */
+	static bool checksum(boost::string_ref text, boost::string_ref& body);
+
+	/**
+	 * @brief Reads a comma separated field
+	 *
+	 * @param [in] body Sentence without checksum
+	 * @param [in] index Field index, 0 is the first field after the address
+	 *
+	 * @return Field, empty if missing.
+	 */
+	static boost::string_ref field(boost::string_ref body, int index);
+
+	/**
+	 * @brief Reads an unsigned decimal number
+	 *
+	 * @param [in] text Digits
+	 * @param [out] value Number
+	 *
+	 * @return False if @p text is empty, too long or not only digits.
+	 */
+	static bool number(boost::string_ref text, int64_t& value);
+
+	/**
+	 * @brief Reads a time of day hhmmss.sss
+	 *
+	 * @param [in] text Field
+	 * @param [out] value Milliseconds since midnight
+	 *
+	 * @return False if the field is not a valid time.
+	 */
+	static bool timeOfDay(boost::string_ref text, int64_t& value);
+
+	/**
+	 * @brief Days from 1970-01-01 to a date of the proleptic Gregorian calendar
+	 *
+	 * @param [in] year Year
+	 * @param [in] month Month, 1 to 12
+	 * @param [in] day Day, 1 to 31
+	 *
+	 * @return Days.
+	 */
+	static int64_t daysFromCivil(int64_t year, int64_t month, int64_t day);
+
+	/**
+	 * @brief Reads the c: field of a TAG block
+	 *
+	 * @param [in] tag TAG block without backslashes
+	 * @param [out] value Milliseconds since the UNIX epoch
+	 *
+	 * @return False if there is no valid c: field.
+	 */
+	static bool tagTime(boost::string_ref tag, int64_t& value);
+
+	/**
+	 * @brief Reads the receive time written by a logger before the sentence
+	 *
+	 * @param [in] line Line
+	 * @param [out] value Milliseconds since the UNIX epoch
+	 * @param [out] end Offset of the separator after the receive time
+	 *
+	 * @return False if the line does not start with a receive time.
+	 */
+	static bool receiveTime(boost::string_ref line, int64_t& value,
+			std::size_t& end);
+};
+
+const int64_t NmeaTimeExtractor::impl::DAY;
+
+bool NmeaTimeExtractor::impl::checksum(boost::string_ref text,
+		boost::string_ref& body)
+{
+	const std::size_t star = text.rfind('*');
+	if (star == boost::string_ref::npos)
+	{
+		body = text;
+		return true;
+	}
+
+	body = text.substr(0, star);
+	const boost::string_ref hex = text.substr(star + 1);
+	if (hex.size() < 2)
+	{
+		return false;
+	}
+	int expected = 0;
+	for (int i = 0; i < 2; ++i)
+	{
+		const char c = hex[i];
+		expected <<= 4;
+		if (c >= '0' && c <= '9')
+		{
+			expected |= c - '0';
+		}
+		else if (c >= 'A' && c <= 'F')
+		{
+			expected |= c - 'A' + 10;
+		}
+		else if (c >= 'a' && c <= 'f')
+		{
+			expected |= c - 'a' + 10;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	// Sentences skip their leading '$' or '!', TAG blocks have none
+	std::size_t i = !body.empty() && (body[0] == '$' || body[0] == '!') ? 1 : 0;
+	int sum = 0;
+	for (; i < body.size(); ++i)
+	{
+		sum ^= static_cast<unsigned char>(body[i]);
+	}
+	return sum == expected;
+}
+
+boost::string_ref NmeaTimeExtractor::impl::field(boost::string_ref body,
+		int index)
+{
+	std::size_t comma = body.find(',');
+	for (int i = 0; i < index && comma != boost::string_ref::npos; ++i)
+	{
+		body.remove_prefix(comma + 1);
+		comma = body.find(',');
+	}
+	if (comma == boost::string_ref::npos)
+	{
+		return boost::string_ref();
+	}
+	body.remove_prefix(comma + 1);
+	return body.substr(0, body.find(','));
+}
+
+bool NmeaTimeExtractor::impl::number(boost::string_ref text, int64_t& value)
+{
+	if (text.empty() || text.size() > 15)
+	{
+		return false;
+	}
+	value = 0;
+	for (std::size_t i = 0; i < text.size(); ++i)
+	{
+		if (text[i] < '0' || text[i] > '9')
+		{
+			return false;
+		}
+		value = value * 10 + (text[i] - '0');
+	}
+	return true;
+}
+
+bool NmeaTimeExtractor::impl::timeOfDay(boost::string_ref text,
+		int64_t& value)
+{
+	int64_t hours;
+	int64_t minutes;
+	int64_t seconds;
+	if (text.size() < 6 || !number(text.substr(0, 2), hours)
+			|| !number(text.substr(2, 2), minutes)
+			|| !number(text.substr(4, 2), seconds) || hours > 23
+			|| minutes > 59 || seconds > 60)
+	{
+		return false;
+	}
+
+	int64_t milliseconds = 0;
+	if (text.size() > 6)
+	{
+		if (text[6] != '.')
+		{
+			return false;
+		}
+		// Three decimals at most are kept
+		int64_t scale = 100;
+		for (std::size_t i = 7; i < text.size(); ++i)
+		{
+			if (text[i] < '0' || text[i] > '9')
+			{
+				return false;
+			}
+			milliseconds += (text[i] - '0') * scale;
+			scale /= 10;
+		}
+	}
+
+	value = ((hours * 60 + minutes) * 60 + seconds) * 1000 + milliseconds;
+	return true;
+}
+
+int64_t NmeaTimeExtractor::impl::daysFromCivil(int64_t year, int64_t month,
+		int64_t day)
+{
+	// Years starting in March put the leap day last
+	year -= month <= 2 ? 1 : 0;
+	const int64_t era = (year >= 0 ? year : year - 399) / 400;
+	const int64_t yearOfEra = year - era * 400;
+	const int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5
+			+ day - 1;
+	const int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100
+			+ dayOfYear;
+	return era * 146097 + dayOfEra - 719468;
+}
+
+bool NmeaTimeExtractor::impl::tagTime(boost::string_ref tag, int64_t& value)
+{
+	boost::string_ref body;
+	if (!checksum(tag, body))
+	{
+		return false;
+	}
+
+	while (!body.empty())
+	{
+		const std::size_t comma = body.find(',');
+		const boost::string_ref item = body.substr(0, comma);
+		if (item.size() > 2 && item[0] == 'c' && item[1] == ':')
+		{
+			int64_t epoch;
+			if (!number(item.substr(2), epoch))
+			{
+				return false;
+			}
+			value = item.size() - 2 > 11 ? epoch : epoch * 1000;
+			return true;
+		}
+		if (comma == boost::string_ref::npos)
+		{
+			break;
+		}
+		body.remove_prefix(comma + 1);
+	}
+	return false;
+}
+
+bool NmeaTimeExtractor::impl::receiveTime(boost::string_ref line,
+		int64_t& value, std::size_t& end)
+{
+	std::size_t digits = 0;
+	while (digits < line.size() && line[digits] >= '0' && line[digits] <= '9')
+	{
+		++digits;
+	}
+	int64_t epoch;
+	if (digits < 9 || !number(line.substr(0, digits), epoch))
+	{
+		return false;
+	}
+
+	value = digits > 11 ? epoch : epoch * 1000;
+	std::size_t i = digits;
+	if (i < line.size() && line[i] == '.' && digits <= 11)
+	{
+		// Three decimals at most are kept
+		int64_t scale = 100;
+		for (++i; i < line.size() && line[i] >= '0' && line[i] <= '9'; ++i)
+		{
+			value += (line[i] - '0') * scale;
+			scale /= 10;
+		}
+	}
+	end = i;
+	return i < line.size()
+			&& (line[i] == ' ' || line[i] == '\t' || line[i] == ','
+					|| line[i] == ';');
+}
+
+NmeaTimeExtractor::NmeaTimeExtractor() :
+		last(0), dated(false)
+{
+
+}
+
+bool NmeaTimeExtractor::extract(boost::string_ref line, int64_t& timestamp)
+{
+	std::size_t end;
+	if (!line.empty() && line[0] >= '0' && line[0] <= '9'
+			&& impl::receiveTime(line, timestamp, end))
+	{
+		last = timestamp;
+		dated = true;
+		return true;
+	}
+
+	if (!line.empty() && line[0] == '\\')
+	{
+		const std::size_t end = line.substr(1).find('\\');
+		if (end == boost::string_ref::npos)
+		{
+			return false;
+		}
+		if (impl::tagTime(line.substr(1, end), timestamp))
+		{
+			last = timestamp;
+			dated = true;
+			return true;
+		}
+		line.remove_prefix(end + 2);
+	}
+
+	if (line.size() < 7 || (line[0] != '$' && line[0] != '!'))
+	{
+		return false;
+	}
+
+	const boost::string_ref id = line.substr(3, 3);
+	const bool zda = id == "ZDA";
+	const bool rmc = id == "RMC";
+	if (!zda && !rmc && id != "GGA")
+	{
+		return false;
+	}
+
+	boost::string_ref body;
+	int64_t time;
+	if (!impl::checksum(line, body) || !impl::timeOfDay(impl::field(body, 0), time))
+	{
+		return false;
+	}
+
+	int64_t year;
+	int64_t month;
+	int64_t day;
+	if (zda)
+	{
+		if (!impl::number(impl::field(body, 1), day)
+				|| !impl::number(impl::field(body, 2), month)
+				|| !impl::number(impl::field(body, 3), year))
+		{
+			return false;
+		}
+	}
+	else if (rmc)
+	{
+		const boost::string_ref date = impl::field(body, 8);
+		if (date.size() != 6 || !impl::number(date.substr(0, 2), day)
+				|| !impl::number(date.substr(2, 2), month)
+				|| !impl::number(date.substr(4, 2), year))
+		{
+			return false;
+		}
+		year += year < 80 ? 2000 : 1900;
+	}
+	else
+	{
+		// Time of day only, date carried from the reference
+		if (!dated)
+		{
+			return false;
+		}
+		const int64_t midnight = (last >= 0 ? last : last - impl::DAY + 1)
+				/ impl::DAY * impl::DAY;
+		timestamp = midnight + time;
+		if (timestamp < last - impl::DAY / 2)
+		{
+			timestamp += impl::DAY;
+		}
+		else if (timestamp > last + impl::DAY / 2)
+		{
+			timestamp -= impl::DAY;
+		}
+		last = timestamp;
+		return true;
+	}
+
+	if (month < 1 || month > 12 || day < 1 || day > 31)
+	{
+		return false;
+	}
+	timestamp = impl::daysFromCivil(year, month, day) * impl::DAY + time;
+	last = timestamp;
+	dated = true;
+	return true;
+}
+
+boost::string_ref NmeaTimeExtractor::sentence(boost::string_ref line)
+{
+	int64_t timestamp;
+	std::size_t end;
+	if (!line.empty() && line[0] >= '0' && line[0] <= '9'
+			&& impl::receiveTime(line, timestamp, end))
+	{
+		line.remove_prefix(end + 1);
+		while (!line.empty() && (line[0] == ' ' || line[0] == '\t'))
+		{
+			line.remove_prefix(1);
+		}
+	}
+	return line;
+}
+
+void NmeaTimeExtractor::setReference(int64_t timestamp)
+{
+	last = timestamp;
+	dated = true;
+}
+
+int64_t NmeaTimeExtractor::reference() const
+{
+	return last;
+}
+
+bool NmeaTimeExtractor::hasDate() const
+{
+	return dated;
+}
+
+void NmeaTimeExtractor::reset()
+{
+	last = 0;
+	dated = false;
+}
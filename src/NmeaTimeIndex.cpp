@@ -0,0 +1,199 @@
+/**
+ *	@file NmeaTimeIndex.cpp
+ *	@brief NmeaTimeIndex Implementation
+ */
+
+#include "NmeaTimeIndex.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+
+/**
+ * @brief Private Implementation
+ */
+class NmeaTimeIndex::impl
+{
+public:
+	/**
+	 * @brief Index file header, followed by the points
+	 */
+	struct Header
+	{
+		char magic[8]; //!< "NMEATIX1"
+		int64_t interval; //!< Log time between points
+		uint64_t indexed; //!< Log bytes indexed
+		int64_t reference; //!< Carried date and time
+		uint64_t dated; //!< 1 if reference holds a date
+		uint64_t count; //!< Number of points
+	};
+
+	/**
+	 * @brief Orders a time before a point
+	 *
+	 * @param [in] timestamp Time
+	 * @param [in] entry Point
+	 *
+	 * @return True if @p timestamp is before the point.
+	 */
+	static bool before(int64_t timestamp, const NmeaTimeIndexEntry& entry);
+};
+
+bool NmeaTimeIndex::impl::before(int64_t timestamp,
+		const NmeaTimeIndexEntry& entry)
+{
+	return timestamp < entry.timestamp;
+}
+
+NmeaTimeIndex::NmeaTimeIndex(int64_t interval) :
+		interval(interval), indexed(0)
+{
+
+}
+
+std::size_t NmeaTimeIndex::update(const NmeaMappedFile& log)
+{
+	if (log.size() < indexed)
+	{
+		clear();
+	}
+
+	const std::size_t before = points.size();
+	uint64_t offset = indexed;
+	while (offset < log.size())
+	{
+		boost::string_ref line;
+		const uint64_t next = log.line(offset, line);
+		if (log.data()[next - 1] != '\n')
+		{
+			// Line still being written
+			break;
+		}
+
+		int64_t timestamp;
+		if (extractor.extract(line, timestamp)
+				&& (points.empty()
+						|| timestamp >= points.back().timestamp + interval))
+		{
+			NmeaTimeIndexEntry entry;
+			entry.offset = offset;
+			entry.timestamp = timestamp;
+			points.push_back(entry);
+		}
+		offset = next;
+	}
+	indexed = offset;
+
+	return points.size() - before;
+}
+
+uint64_t NmeaTimeIndex::seek(const NmeaMappedFile& log,
+		int64_t timestamp) const
+{
+	// Last point at or before the time
+	std::vector<NmeaTimeIndexEntry>::const_iterator it = std::upper_bound(
+			points.begin(), points.end(), timestamp, impl::before);
+
+	NmeaTimeExtractor scanner;
+	uint64_t offset = 0;
+	if (it != points.begin())
+	{
+		--it;
+		offset = it->offset;
+		scanner.setReference(it->timestamp);
+	}
+
+	while (offset < log.size())
+	{
+		boost::string_ref line;
+		const uint64_t next = log.line(offset, line);
+		int64_t time;
+		if (scanner.extract(line, time) && time >= timestamp)
+		{
+			return offset;
+		}
+		offset = next;
+	}
+	return log.size();
+}
+
+const std::vector<NmeaTimeIndexEntry>& NmeaTimeIndex::entries() const
+{
+	return points;
+}
+
+uint64_t NmeaTimeIndex::indexedSize() const
+{
+	return indexed;
+}
+
+void NmeaTimeIndex::clear()
+{
+	points.clear();
+	indexed = 0;
+	extractor.reset();
+}
+
+bool NmeaTimeIndex::save(const std::string& path) const
+{
+	impl::Header header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, "NMEATIX1", sizeof(header.magic));
+	header.interval = interval;
+	header.indexed = indexed;
+	header.reference = extractor.reference();
+	header.dated = extractor.hasDate() ? 1 : 0;
+	header.count = points.size();
+
+	std::FILE* f = std::fopen(path.c_str(), "wb");
+	if (f == nullptr)
+	{
+		return false;
+	}
+	const bool written = std::fwrite(&header, sizeof(header), 1, f) == 1
+			&& std::fwrite(points.data(), sizeof(NmeaTimeIndexEntry),
+					points.size(), f) == points.size();
+	return std::fclose(f) == 0 && written;
+}
+
+bool NmeaTimeIndex::load(const std::string& path)
+{
+	std::FILE* f = std::fopen(path.c_str(), "rb");
+	if (f == nullptr)
+	{
+		return false;
+	}
+
+	impl::Header header;
+	bool read = std::fread(&header, sizeof(header), 1, f) == 1
+			&& std::memcmp(header.magic, "NMEATIX1", sizeof(header.magic)) == 0;
+	// The point count must fit in the file before anything is allocated
+	struct stat st;
+	read = read && ::fstat(::fileno(f), &st) == 0
+			&& header.count
+					<= (static_cast<uint64_t>(st.st_size) - sizeof(header))
+							/ sizeof(NmeaTimeIndexEntry);
+	std::vector<NmeaTimeIndexEntry> loaded;
+	if (read)
+	{
+		loaded.resize(header.count);
+		read = std::fread(loaded.data(), sizeof(NmeaTimeIndexEntry),
+				loaded.size(), f) == loaded.size();
+	}
+	std::fclose(f);
+	if (!read)
+	{
+		return false;
+	}
+
+	interval = header.interval;
+	indexed = header.indexed;
+	extractor.reset();
+	if (header.dated != 0)
+	{
+		extractor.setReference(header.reference);
+	}
+	points.swap(loaded);
+	return true;
+}
@@ -0,0 +1,1073 @@
+/**
+ *	@file NmeaWriter.cpp
+ *	@brief NmeaWriter Implementation
+ */
+
+#include "NmeaWriter.h"
+
+#include <cmath>
+#include <cstring>
+
+const std::size_t NmeaWriter::maxSentenceSize;
+
+/**
+ * @brief Private Implementation
+ */
+class NmeaWriter::impl
+{
+public:
+	/**
+	 * @brief Sentence being written into a caller provided buffer.
+	 *
+	 * Each field method writes the leading comma and the value. The checksum
+	 * is updated as characters are appended, so finish() only appends it.
+	 */
+	class Sentence
+	{
+	public:
+		/**
+		 * @brief Starts a sentence with address field Talker Id + Sentence Id
+		 *
+		 * @param [out] buffer Buffer receiving the sentence
+		 * @param [in] size Size of the buffer
+		 * @param [in] start Start character, '$' or '!'
+		 * @param [in] talkerId Talker Id
+		 * @param [in] sentenceId Sentence Id
+		 */
+		Sentence(char* buffer, std::size_t size, char start,
+				const std::string& talkerId, const char* sentenceId);
+
+		/**
+		 * @brief Starts a proprietary sentence
+		 *
+		 * @param [out] buffer Buffer receiving the sentence
+		 * @param [in] size Size of the buffer
+		 * @param [in] sentenceId Proprietary Sentence Id, including leading P
+		 */
+		Sentence(char* buffer, std::size_t size, const char* sentenceId);
+
+		/**
+		 * @brief Writes an empty field
+		 */
+		void field();
+
+		/**
+		 * @brief Writes a single character field
+		 *
+		 * @param [in] value Character
+		 * @param [in] empty Write the field empty
+		 */
+		void fieldChar(char value, bool empty = false);
+
+		/**
+		 * @brief Writes a decimal integer field
+		 *
+		 * @param [in] value Integer
+		 * @param [in] width Minimum number of digits, zero padded
+		 * @param [in] empty Write the field empty
+		 */
+		void fieldInt(int value, int width, bool empty = false);
+
+		/**
+		 * @brief Writes an upper case hexadecimal field
+		 *
+		 * @param [in] value Integer
+		 * @param [in] width Minimum number of digits, zero padded
+		 * @param [in] empty Write the field empty
+		 */
+		void fieldHex(uint value, int width, bool empty = false);
+
+		/**
+		 * @brief Writes a fixed point decimal field
+		 *
+		 * @param [in] value Value, NaN or infinite values are written empty,
+		 * values beyond the range of long long fail the sentence
+		 * @param [in] decimals Number of decimals
+		 * @param [in] empty Write the field empty
+		 */
+		void fieldFixed(double value, int decimals, bool empty = false);
+
+		/**
+		 * @brief Writes a text field
+		 *
+		 * @param [in] value Text, a reserved character fails the sentence
+		 * @param [in] empty Write the field empty
+		 */
+		void fieldString(const std::string& value, bool empty = false);
+
+		/**
+		 * @brief Writes a hhmmss.ss time field
+		 *
+		 * @param [in] value Time of day
+		 * @param [in] empty Write the field empty
+		 */
+		void fieldTime(const boost::posix_time::time_duration& value,
+				bool empty = false);
+
+		/**
+		 * @brief Writes a ddmmyy date field
+		 *
+		 * @param [in] value Date
+		 * @param [in] empty Write the field empty
+		 */
+		void fieldDate(const boost::gregorian::date& value, bool empty =
+				false);
+
+		/**
+		 * @brief Writes latitude or longitude as two fields, value and hemisphere
+		 *
+		 * @param [in] value Decimal degrees, negative for S or W, more than
+		 * degreeDigits digits of degrees fail the sentence
+		 * @param [in] degreeDigits 2 for latitude, 3 for longitude
+		 * @param [in] positive Hemisphere character for positive values
+		 * @param [in] negative Hemisphere character for negative values
+		 * @param [in] empty Write both fields empty
+		 */
+		void fieldLatLng(double value, int degreeDigits, char positive,
+				char negative, bool empty = false);
+
+		/**
+		 * @brief Appends checksum, CR LF and null terminator
+		 *
+		 * @return Length of the sentence, 0 if the buffer was too small or a
+		 * value was invalid.
+		 */
+		std::size_t finish();
+
+	private:
+		/**
+		 * @brief Appends a character and updates the checksum
+		 *
+		 * @param [in] c Character
+		 */
+		void put(char c);
+
+		/**
+		 * @brief Appends characters and updates the checksum
+		 *
+		 * @param [in] data Characters
+		 * @param [in] length Number of characters
+		 */
+		void put(const char* data, std::size_t length);
+
+		/**
+		 * @brief Appends an unsigned integer in base 10
+		 *
+		 * @param [in] value Integer
+		 * @param [in] width Minimum number of digits, zero padded
+		 */
+		void putUInt(unsigned long long value, int width);
+
+		char* begin; //!< Start of the buffer
+		char* pos; //!< Next character to write
+		char* end; //!< End of the buffer
+		unsigned char checksum; //!< XOR of the characters written after the start character
+		bool overflow; //!< The buffer was too small
+		bool invalid; //!< A value could not be written
+	};
+
+	/**
+	 * @brief Powers of ten used by fixed point formatting
+	 */
+	static const unsigned long long pow10[];
+
+	/**
+	 * @brief Maximum number of decimals for fixed point formatting
+	 */
+	static const int MAX_DECIMALS = 9;
+
+	/**
+	 * @brief Upper case hexadecimal digits
+	 */
+	static const char hexDigits[];
+
+	/**
+	 * @brief Parses an hexadecimal digit
+	 *
+	 * @param [in] c Character
+	 * @param [out] value Digit value
+	 *
+	 * @return True on success.
+	 */
+	static bool parseHexDigit(char c, int& value);
+
+	/**
+	 * @brief Checks a Talker Id
+	 *
+	 * @param [in] talkerId Talker Id
+	 *
+	 * @return True if two upper case letters or digits.
+	 */
+	static bool validTalkerId(const std::string& talkerId);
+
+	/**
+	 * @brief Checks that a text holds no NMEA reserved character
+	 *
+	 * @param [in] value Text
+	 *
+	 * @return False if a framing, delimiter or escape character is present.
+	 */
+	static bool validText(const std::string& value);
+};
+
+const unsigned long long NmeaWriter::impl::pow10[] = { 1ULL, 10ULL, 100ULL,
+		1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+		1000000000ULL };
+
+const char NmeaWriter::impl::hexDigits[] = "0123456789ABCDEF";
+
+NmeaWriter::NmeaWriter()
+{
+
+}
+
+NmeaWriter::impl::Sentence::Sentence(char* buffer, std::size_t size,
+		char start, const std::string& talkerId, const char* sentenceId) :
+		begin(buffer), pos(buffer), end(buffer + size), checksum(0), overflow(
+				false), invalid(!validTalkerId(talkerId))
+{
+	if (pos < end)
+	{
+		*pos++ = start;
+	}
+	else
+	{
+		overflow = true;
+	}
+	put(talkerId.data(), talkerId.size());
+	put(sentenceId, 3);
+}
+
+NmeaWriter::impl::Sentence::Sentence(char* buffer, std::size_t size,
+		const char* sentenceId) :
+		begin(buffer), pos(buffer), end(buffer + size), checksum(0), overflow(
+				false), invalid(false)
+{
+	if (pos < end)
+	{
+		*pos++ = '$';
+	}
+	else
+	{
+		overflow = true;
+	}
+	while (*sentenceId != '\0')
+	{
+		put(*sentenceId++);
+	}
+}
+
+inline void NmeaWriter::impl::Sentence::put(char c)
+{
+	if (pos < end)
+	{
+		*pos++ = c;
+		checksum ^= static_cast<unsigned char>(c);
+	}
+	else
+	{
+		overflow = true;
+	}
+}
+
+inline void NmeaWriter::impl::Sentence::put(const char* data,
+		std::size_t length)
+{
+	if (static_cast<std::size_t>(end - pos) >= length)
+	{
+		for (std::size_t i = 0; i < length; ++i)
+		{
+			pos[i] = data[i];
+			checksum ^= static_cast<unsigned char>(data[i]);
+		}
+		pos += length;
+	}
+	else
+	{
+		overflow = true;
+	}
+}
+
+inline void NmeaWriter::impl::Sentence::putUInt(unsigned long long value,
+		int width)
+{
+	char digits[24];
+	int count = 0;
+	do
+	{
+		digits[count++] = '0' + static_cast<char>(value % 10);
+		value /= 10;
+	} while (value != 0);
+
+	while (count < width && count < static_cast<int>(sizeof(digits)))
+	{
+		digits[count++] = '0';
+	}
+
+	while (count > 0)
+	{
+		put(digits[--count]);
+	}
+}
+
+void NmeaWriter::impl::Sentence::field()
+{
+	put(',');
+}
+
+void NmeaWriter::impl::Sentence::fieldChar(char value, bool empty)
+{
+	put(',');
+	if (!empty && value != '\0')
+	{
+		put(value);
+	}
+}
+
+void NmeaWriter::impl::Sentence::fieldInt(int value, int width, bool empty)
+{
+	put(',');
+	if (!empty)
+	{
+		long long v = value;
+		if (v < 0)
+		{
+			put('-');
+			v = -v;
+		}
+		putUInt(static_cast<unsigned long long>(v), width);
+	}
+}
+
+void NmeaWriter::impl::Sentence::fieldHex(uint value, int width, bool empty)
+{
+	put(',');
+	if (!empty)
+	{
+		char digits[8];
+		int count = 0;
+		do
+		{
+			digits[count++] = hexDigits[value & 0xF];
+			value >>= 4;
+		} while (value != 0);
+
+		while (count < width && count < 8)
+		{
+			digits[count++] = '0';
+		}
+
+		while (count > 0)
+		{
+			put(digits[--count]);
+		}
+	}
+}
+
+void NmeaWriter::impl::Sentence::fieldFixed(double value, int decimals,
+		bool empty)
+{
+	put(',');
+	if (!empty && std::isfinite(value))
+	{
+		if (decimals > MAX_DECIMALS)
+		{
+			decimals = MAX_DECIMALS;
+		}
+
+		// llround() is undefined past the long long range
+		const double magnitude = std::fabs(value) * pow10[decimals];
+		if (magnitude >= 9.2e18)
+		{
+			invalid = true;
+			return;
+		}
+		const unsigned long long scaled = std::llround(magnitude);
+		if (value < 0 && scaled != 0)
+		{
+			put('-');
+		}
+		putUInt(scaled / pow10[decimals], 1);
+		if (decimals > 0)
+		{
+			put('.');
+			putUInt(scaled % pow10[decimals], decimals);
+		}
+	}
+}
+
+void NmeaWriter::impl::Sentence::fieldString(const std::string& value,
+		bool empty)
+{
+	put(',');
+	if (!empty)
+	{
+		if (!validText(value))
+		{
+			invalid = true;
+			return;
+		}
+		put(value.data(), value.size());
+	}
+}
+
+void NmeaWriter::impl::Sentence::fieldTime(
+		const boost::posix_time::time_duration& value, bool empty)
+{
+	put(',');
+	if (!empty && !value.is_special() && !value.is_negative())
+	{
+		// Centiseconds since midnight
+		const long long cs = (value.total_milliseconds() / 10)
+				% (24LL * 3600 * 100);
+		putUInt(cs / 360000, 2);
+		putUInt((cs / 6000) % 60, 2);
+		putUInt((cs / 100) % 60, 2);
+		put('.');
+		putUInt(cs % 100, 2);
+	}
+}
+
+void NmeaWriter::impl::Sentence::fieldDate(const boost::gregorian::date& value,
+		bool empty)
+{
+	put(',');
+	if (!empty && !value.is_special())
+	{
+		putUInt(value.day(), 2);
+		putUInt(value.month(), 2);
+		putUInt(value.year() % 100, 2);
+	}
+}
+
+void NmeaWriter::impl::Sentence::fieldLatLng(double value, int degreeDigits,
+		char positive, char negative, bool empty)
+{
+	static const int MINUTES_DECIMALS = 5;
+
+	put(',');
+	if (!empty && std::isfinite(value))
+	{
+		const double absValue = std::fabs(value);
+		if (absValue >= pow10[degreeDigits])
+		{
+			invalid = true;
+			return;
+		}
+		unsigned long long degrees = static_cast<unsigned long long>(absValue);
+		unsigned long long minutes = std::llround(
+				(absValue - degrees) * 60.0 * pow10[MINUTES_DECIMALS]);
+		if (minutes >= 60 * pow10[MINUTES_DECIMALS])
+		{
+			minutes -= 60 * pow10[MINUTES_DECIMALS];
+			++degrees;
+		}
+		putUInt(degrees, degreeDigits);
+		putUInt(minutes / pow10[MINUTES_DECIMALS], 2);
+		put('.');
+		putUInt(minutes % pow10[MINUTES_DECIMALS], MINUTES_DECIMALS);
+		put(',');
+		put(value < 0 ? negative : positive);
+	}
+	else
+	{
+		put(',');
+	}
+}
+
+std::size_t NmeaWriter::impl::Sentence::finish()
+{
+	// '*', two checksum digits, CR, LF and the null terminator
+	if (overflow || invalid || end - pos < 6)
+	{
+		if (begin < end)
+		{
+			*begin = '\0';
+		}
+		return 0;
+	}
+
+	*pos++ = '*';
+	*pos++ = hexDigits[checksum >> 4];
+	*pos++ = hexDigits[checksum & 0xF];
+	*pos++ = '\r';
+	*pos++ = '\n';
+	*pos = '\0';
+
+	return pos - begin;
+}
+
+bool NmeaWriter::impl::parseHexDigit(char c, int& value)
+{
+	if (c >= '0' && c <= '9')
+	{
+		value = c - '0';
+	}
+	else if (c >= 'A' && c <= 'F')
+	{
+		value = c - 'A' + 10;
+	}
+	else if (c >= 'a' && c <= 'f')
+	{
+		value = c - 'a' + 10;
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+
+bool NmeaWriter::impl::validTalkerId(const std::string& talkerId)
+{
+	if (talkerId.size() != 2)
+	{
+		return false;
+	}
+	for (std::size_t i = 0; i < 2; ++i)
+	{
+		const char c = talkerId[i];
+		if (!((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool NmeaWriter::impl::validText(const std::string& value)
+{
+	for (std::string::const_iterator it = value.begin(); it != value.end();
+			++it)
+	{
+		if (*it == '\0' || std::strchr("\r\n$*,!\\^~\x7F", *it) != nullptr)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+std::size_t NmeaWriter::writeZDA(char* buffer, std::size_t size,
+		const std::string& talkerId,
+		const boost::posix_time::time_duration& mtime, int day, int month,
+		int year, int localZoneHours, int localZoneMinutes,
+		const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "ZDA");
+	s.fieldTime(mtime, emptyFields[0]);
+	s.fieldInt(day, 2, emptyFields[1]);
+	s.fieldInt(month, 2, emptyFields[2]);
+	s.fieldInt(year, 4, emptyFields[3]);
+	s.fieldInt(localZoneHours, 2, emptyFields[4]);
+	s.fieldInt(localZoneMinutes, 2, emptyFields[5]);
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeGLL(char* buffer, std::size_t size,
+		const std::string& talkerId, double latitude, double longitude,
+		const boost::posix_time::time_duration& mtime, char status,
+		char modeIndicator, const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "GLL");
+	s.fieldLatLng(latitude, 2, 'N', 'S', emptyFields[0]);
+	s.fieldLatLng(longitude, 3, 'E', 'W', emptyFields[1]);
+	s.fieldTime(mtime, emptyFields[2]);
+	s.fieldChar(status, emptyFields[3]);
+	s.fieldChar(modeIndicator, emptyFields[4]);
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeGGA(char* buffer, std::size_t size,
+		const std::string& talkerId,
+		const boost::posix_time::time_duration& mtime, double latitude,
+		double longitude, Nmea_GPSQualityIndicator quality, int numSV,
+		double hdop, double orthometricheight, double geoidseparation,
+		double agediffgps, const std::string& refid,
+		const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "GGA");
+	s.fieldTime(mtime, emptyFields[0]);
+	s.fieldLatLng(latitude, 2, 'N', 'S', emptyFields[1]);
+	s.fieldLatLng(longitude, 3, 'E', 'W', emptyFields[2]);
+	s.fieldInt(quality, 1, emptyFields[3]);
+	s.fieldInt(numSV, 2, emptyFields[4]);
+	s.fieldFixed(hdop, 1, emptyFields[5]);
+	s.fieldFixed(orthometricheight, 3, emptyFields[6]);
+	s.fieldChar('M');
+	s.fieldFixed(geoidseparation, 3, emptyFields[7]);
+	s.fieldChar('M');
+	s.fieldFixed(agediffgps, 1, emptyFields[8]);
+	s.fieldString(refid, emptyFields[9]);
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeVTG(char* buffer, std::size_t size,
+		const std::string& talkerId, double coursetrue, double coursemagnetic,
+		double speedknots, double speedkph, const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "VTG");
+	s.fieldFixed(coursetrue, 2, emptyFields[0]);
+	s.fieldChar('T');
+	s.fieldFixed(coursemagnetic, 2, emptyFields[1]);
+	s.fieldChar('M');
+	s.fieldFixed(speedknots, 2, emptyFields[2]);
+	s.fieldChar('N');
+	s.fieldFixed(speedkph, 2, emptyFields[3]);
+	s.fieldChar('K');
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeRMC(char* buffer, std::size_t size,
+		const std::string& talkerId,
+		const boost::posix_time::time_duration& mtime, double latitude,
+		double longitude, double speedknots, double coursetrue,
+		const boost::gregorian::date& mdate, double magneticvar,
+		const NmeaParserResult& emptyFields)
+{
+	const bool positionValid = !emptyFields[1] && !emptyFields[2];
+
+	impl::Sentence s(buffer, size, '$', talkerId, "RMC");
+	s.fieldTime(mtime, emptyFields[0]);
+	s.fieldChar(positionValid ? 'A' : 'V');
+	s.fieldLatLng(latitude, 2, 'N', 'S', emptyFields[1]);
+	s.fieldLatLng(longitude, 3, 'E', 'W', emptyFields[2]);
+	s.fieldFixed(speedknots, 2, emptyFields[3]);
+	s.fieldFixed(coursetrue, 2, emptyFields[4]);
+	s.fieldDate(mdate, emptyFields[5]);
+	s.fieldFixed(std::fabs(magneticvar), 1, emptyFields[6]);
+	s.fieldChar(magneticvar < 0 ? 'W' : 'E', emptyFields[6]);
+	s.fieldChar(positionValid ? 'A' : 'N');
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeWPL(char* buffer, std::size_t size,
+		const std::string& talkerId, double latitude, double longitude,
+		const std::string& waypointName, const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "WPL");
+	s.fieldLatLng(latitude, 2, 'N', 'S', emptyFields[0]);
+	s.fieldLatLng(longitude, 3, 'E', 'W', emptyFields[1]);
+	s.fieldString(waypointName, emptyFields[2]);
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeRTE(char* buffer, std::size_t size,
+		const std::string& talkerId, int totalLines, int lineCount,
+		char messageMode, const std::string& routeIdentifier,
+		const std::vector<std::string>& waypointNames,
+		const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "RTE");
+	s.fieldInt(totalLines, 1, emptyFields[0]);
+	s.fieldInt(lineCount, 1, emptyFields[1]);
+	s.fieldChar(messageMode, emptyFields[2]);
+	s.fieldString(routeIdentifier, emptyFields[3]);
+	for (std::vector<std::string>::const_iterator it = waypointNames.begin();
+			it != waypointNames.end(); ++it)
+	{
+		s.fieldString(*it);
+	}
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeVHW(char* buffer, std::size_t size,
+		const std::string& talkerId, double headingTrue,
+		double headingMagnetic, double speedInKnots, double speedInKmH,
+		const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "VHW");
+	s.fieldFixed(headingTrue, 1, emptyFields[0]);
+	s.fieldChar('T');
+	s.fieldFixed(headingMagnetic, 1, emptyFields[1]);
+	s.fieldChar('M');
+	s.fieldFixed(speedInKnots, 2, emptyFields[2]);
+	s.fieldChar('N');
+	s.fieldFixed(speedInKmH, 2, emptyFields[3]);
+	s.fieldChar('K');
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeMTW(char* buffer, std::size_t size,
+		const std::string& talkerId, double degrees, char units,
+		const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "MTW");
+	s.fieldFixed(degrees, 1, emptyFields[0]);
+	s.fieldChar(units, emptyFields[1]);
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeVBW(char* buffer, std::size_t size,
+		const std::string& talkerId, double longitudinalWaterSpeed,
+		double transverseWaterSpeed, char waterDataStatus,
+		double longitudinalGroundSpeed, double transverseGroundSpeed,
+		char groundDataStatus, const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "VBW");
+	s.fieldFixed(longitudinalWaterSpeed, 2, emptyFields[0]);
+	s.fieldFixed(transverseWaterSpeed, 2, emptyFields[1]);
+	s.fieldChar(waterDataStatus, emptyFields[2]);
+	s.fieldFixed(longitudinalGroundSpeed, 2, emptyFields[3]);
+	s.fieldFixed(transverseGroundSpeed, 2, emptyFields[4]);
+	s.fieldChar(groundDataStatus, emptyFields[5]);
+	// Stern water and ground speeds are not provided
+	s.field();
+	s.field();
+	s.field();
+	s.field();
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeVLW(char* buffer, std::size_t size,
+		const std::string& talkerId, double totalCumulativeDistance,
+		double distanceSinceReset, const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "VLW");
+	s.fieldFixed(totalCumulativeDistance, 2, emptyFields[0]);
+	s.fieldChar('N');
+	s.fieldFixed(distanceSinceReset, 2, emptyFields[1]);
+	s.fieldChar('N');
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeDPT(char* buffer, std::size_t size,
+		const std::string& talkerId, double waterDepthRelativeToTheTransducer,
+		double offsetFromTransducer, double maximumRangeScaleInUse,
+		const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "DPT");
+	s.fieldFixed(waterDepthRelativeToTheTransducer, 2, emptyFields[0]);
+	s.fieldFixed(offsetFromTransducer, 2, emptyFields[1]);
+	s.fieldFixed(maximumRangeScaleInUse, 1, emptyFields[2]);
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeDBT(char* buffer, std::size_t size,
+		const std::string& talkerId, double waterDepthInFeet,
+		double waterDepthInMeters, double waterDepthInFathoms,
+		const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "DBT");
+	s.fieldFixed(waterDepthInFeet, 2, emptyFields[0]);
+	s.fieldChar('f');
+	s.fieldFixed(waterDepthInMeters, 2, emptyFields[1]);
+	s.fieldChar('M');
+	s.fieldFixed(waterDepthInFathoms, 2, emptyFields[2]);
+	s.fieldChar('F');
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeDBK(char* buffer, std::size_t size,
+		const std::string& talkerId, double depthBelowKeelFeet,
+		double depthBelowKeelMeters, double depthBelowKeelFathoms,
+		const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "DBK");
+	s.fieldFixed(depthBelowKeelFeet, 2, emptyFields[0]);
+	s.fieldChar('f');
+	s.fieldFixed(depthBelowKeelMeters, 2, emptyFields[1]);
+	s.fieldChar('M');
+	s.fieldFixed(depthBelowKeelFathoms, 2, emptyFields[2]);
+	s.fieldChar('F');
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writePSKPDPT(char* buffer, std::size_t size,
+		double waterDepthRelativeToTheTransducer, double offsetFromTransducer,
+		double maximumRangeScaleInUse, int bottomEchoStrength,
+		int echoSounderChannelNumber, const std::string& transducerLocation,
+		const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, "PSKPDPT");
+	s.fieldFixed(waterDepthRelativeToTheTransducer, 2, emptyFields[0]);
+	s.fieldFixed(offsetFromTransducer, 2, emptyFields[1]);
+	s.fieldFixed(maximumRangeScaleInUse, 1, emptyFields[2]);
+	s.fieldInt(bottomEchoStrength, 1, emptyFields[3]);
+	s.fieldInt(echoSounderChannelNumber, 1, emptyFields[4]);
+	s.fieldString(transducerLocation, emptyFields[5]);
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeHDT(char* buffer, std::size_t size,
+		const std::string& talkerId, double headingDegreesTrue,
+		const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "HDT");
+	s.fieldFixed(headingDegreesTrue, 2, emptyFields[0]);
+	s.fieldChar('T');
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeHDG(char* buffer, std::size_t size,
+		const std::string& talkerId, double magneticSensorHeadingInDegrees,
+		double magneticDeviationDegrees, char magneticDeviationDirection,
+		double magneticVariationDegrees, char magneticVariationDirection,
+		const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "HDG");
+	s.fieldFixed(magneticSensorHeadingInDegrees, 2, emptyFields[0]);
+	s.fieldFixed(magneticDeviationDegrees, 2, emptyFields[1]);
+	s.fieldChar(magneticDeviationDirection, emptyFields[2]);
+	s.fieldFixed(magneticVariationDegrees, 2, emptyFields[3]);
+	s.fieldChar(magneticVariationDirection, emptyFields[4]);
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeHDM(char* buffer, std::size_t size,
+		const std::string& talkerId, double headingDegreesMagnetic,
+		const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "HDM");
+	s.fieldFixed(headingDegreesMagnetic, 2, emptyFields[0]);
+	s.fieldChar('M');
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeROT(char* buffer, std::size_t size,
+		const std::string& talkerId, double rateOfTurn,
+		const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "ROT");
+	s.fieldFixed(rateOfTurn, 2, emptyFields[0]);
+	s.fieldChar(emptyFields[0] ? 'V' : 'A');
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeMWV(char* buffer, std::size_t size,
+		const std::string& talkerId, double windAngle,
+		Nmea_AngleReference reference, double windSpeed, char windSpeedUnits,
+		char sensorStatus, const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "MWV");
+	s.fieldFixed(windAngle, 1, emptyFields[0]);
+	s.fieldChar(reference == Nmea_AngleReference_True ? 'T' : 'R',
+			emptyFields[1]);
+	s.fieldFixed(windSpeed, 2, emptyFields[2]);
+	s.fieldChar(windSpeedUnits, emptyFields[3]);
+	s.fieldChar(sensorStatus, emptyFields[4]);
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeMWD(char* buffer, std::size_t size,
+		const std::string& talkerId, double trueWindDirection,
+		double magneticWindDirection, double windSpeedKnots,
+		double windSpeedMeters, const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "MWD");
+	s.fieldFixed(trueWindDirection, 1, emptyFields[0]);
+	s.fieldChar('T');
+	s.fieldFixed(magneticWindDirection, 1, emptyFields[1]);
+	s.fieldChar('M');
+	s.fieldFixed(windSpeedKnots, 2, emptyFields[2]);
+	s.fieldChar('N');
+	s.fieldFixed(windSpeedMeters, 2, emptyFields[3]);
+	s.fieldChar('M');
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeXDR(char* buffer, std::size_t size,
+		const std::string& talkerId,
+		const std::vector<TransducerMeasurement>& measurements)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "XDR");
+	for (std::vector<TransducerMeasurement>::const_iterator it =
+			measurements.begin(); it != measurements.end(); ++it)
+	{
+		s.fieldChar(it->transducerType);
+		s.fieldFixed(it->measurementData, 4);
+		s.fieldChar(it->unitsOfMeasurement);
+		s.fieldString(it->nameOfTransducer);
+	}
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeTTM(char* buffer, std::size_t size,
+		const std::string& talkerId, int targetNumber, double targetDistance,
+		double targetBearing, Nmea_AngleReference targetBearingReference,
+		double targetSpeed, double targetCourse,
+		Nmea_AngleReference targetCourseReference,
+		Nmea_SpeedDistanceUnits speedDistanceUnits,
+		const std::string& targetName, Nmea_TargetStatus targetStatus,
+		const boost::posix_time::time_duration& timeOfData,
+		Nmea_TypeOfAcquisition typeOfAcquisition,
+		const NmeaParserResult& emptyFields)
+{
+	static const char speedDistanceUnitsChar[] = { 'K', 'S', 'N' };
+	static const char targetStatusChar[] = { 'L', 'Q', 'T' };
+	static const char typeOfAcquisitionChar[] = { 'A', 'M', 'R' };
+
+	impl::Sentence s(buffer, size, '$', talkerId, "TTM");
+	s.fieldInt(targetNumber, 2, emptyFields[0]);
+	s.fieldFixed(targetDistance, 2, emptyFields[1]);
+	s.fieldFixed(targetBearing, 1, emptyFields[2]);
+	s.fieldChar(targetBearingReference == Nmea_AngleReference_True ? 'T' : 'R',
+			emptyFields[3]);
+	s.fieldFixed(targetSpeed, 1, emptyFields[4]);
+	s.fieldFixed(targetCourse, 1, emptyFields[5]);
+	s.fieldChar(targetCourseReference == Nmea_AngleReference_True ? 'T' : 'R',
+			emptyFields[6]);
+	// Distance and time to CPA are not provided
+	s.field();
+	s.field();
+	s.fieldChar(speedDistanceUnitsChar[speedDistanceUnits % 3],
+			emptyFields[7]);
+	s.fieldString(targetName, emptyFields[8]);
+	s.fieldChar(targetStatusChar[targetStatus % 3], emptyFields[9]);
+	// Reference target
+	s.field();
+	s.fieldTime(timeOfData, emptyFields[10]);
+	s.fieldChar(typeOfAcquisitionChar[typeOfAcquisition % 3],
+			emptyFields[11]);
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeTTD(char* buffer, std::size_t size,
+		const std::string& talkerId, int totalLines, int lineCount,
+		int sequenceIdentifier, const std::string& trackData, int fillBits,
+		const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '!', talkerId, "TTD");
+	s.fieldHex(totalLines, 2, emptyFields[0]);
+	s.fieldHex(lineCount, 2, emptyFields[1]);
+	s.fieldInt(sequenceIdentifier, 1,
+			emptyFields[2] || sequenceIdentifier < 0);
+	s.fieldString(trackData, emptyFields[3]);
+	s.fieldInt(fillBits, 1, emptyFields[4]);
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeTLB(char* buffer, std::size_t size,
+		const std::string& talkerId,
+		const std::vector<std::pair<int, std::string>>& trackNumbernLabel)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "TLB");
+	for (std::vector<std::pair<int, std::string>>::const_iterator it =
+			trackNumbernLabel.begin(); it != trackNumbernLabel.end(); ++it)
+	{
+		s.fieldInt(it->first, 1);
+		s.fieldString(it->second);
+	}
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeOSD(char* buffer, std::size_t size,
+		const std::string& talkerId, double heading, char status,
+		double vesselCourse, char referenceCourse, double vesselSpeed,
+		char referenceSpeed, double vesselSet, double vesselDrift,
+		char speedUnits, const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "OSD");
+	s.fieldFixed(heading, 1, emptyFields[0]);
+	s.fieldChar(status, emptyFields[1]);
+	s.fieldFixed(vesselCourse, 1, emptyFields[2]);
+	s.fieldChar(referenceCourse, emptyFields[3]);
+	s.fieldFixed(vesselSpeed, 2, emptyFields[4]);
+	s.fieldChar(referenceSpeed, emptyFields[5]);
+	s.fieldFixed(vesselSet, 1, emptyFields[6]);
+	s.fieldFixed(vesselDrift, 2, emptyFields[7]);
+	s.fieldChar(speedUnits, emptyFields[8]);
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeRSD(char* buffer, std::size_t size,
+		const std::string& talkerId, double origin1Range,
+		double origin1BearingDegrees, double variableRangeMarker1,
+		double bearingLine1, double origin2Range, double origin2Bearing,
+		double vrm2, double ebl2, double cursorRange, double cursorBearing,
+		double rangeScale, char rangeUnits, char displayRotation,
+		const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '$', talkerId, "RSD");
+	s.fieldFixed(origin1Range, 2, emptyFields[0]);
+	s.fieldFixed(origin1BearingDegrees, 1, emptyFields[1]);
+	s.fieldFixed(variableRangeMarker1, 2, emptyFields[2]);
+	s.fieldFixed(bearingLine1, 1, emptyFields[3]);
+	s.fieldFixed(origin2Range, 2, emptyFields[4]);
+	s.fieldFixed(origin2Bearing, 1, emptyFields[5]);
+	s.fieldFixed(vrm2, 2, emptyFields[6]);
+	s.fieldFixed(ebl2, 1, emptyFields[7]);
+	s.fieldFixed(cursorRange, 2, emptyFields[8]);
+	s.fieldFixed(cursorBearing, 1, emptyFields[9]);
+	s.fieldFixed(rangeScale, 2, emptyFields[10]);
+	s.fieldChar(rangeUnits, emptyFields[11]);
+	s.fieldChar(displayRotation, emptyFields[12]);
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeVDM(char* buffer, std::size_t size,
+		const std::string& talkerId, int totalLines, int lineCount,
+		int sequenceIdentifier, char aisChannel, const std::string& encodedData,
+		int fillBits, const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '!', talkerId, "VDM");
+	s.fieldHex(totalLines, 1, emptyFields[0]);
+	s.fieldHex(lineCount, 1, emptyFields[1]);
+	s.fieldInt(sequenceIdentifier, 1,
+			emptyFields[2] || sequenceIdentifier < 0);
+	s.fieldChar(aisChannel, emptyFields[3]);
+	s.fieldString(encodedData, emptyFields[4]);
+	s.fieldInt(fillBits, 1, emptyFields[5]);
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writeVDO(char* buffer, std::size_t size,
+		const std::string& talkerId, int totalLines, int lineCount,
+		int sequenceIdentifier, char aisChannel, const std::string& encodedData,
+		int fillBits, const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, '!', talkerId, "VDO");
+	s.fieldHex(totalLines, 1, emptyFields[0]);
+	s.fieldHex(lineCount, 1, emptyFields[1]);
+	s.fieldInt(sequenceIdentifier, 1,
+			emptyFields[2] || sequenceIdentifier < 0);
+	s.fieldChar(aisChannel, emptyFields[3]);
+	s.fieldString(encodedData, emptyFields[4]);
+	s.fieldInt(fillBits, 1, emptyFields[5]);
+	return s.finish();
+}
+
+std::size_t NmeaWriter::writePRDID(char* buffer, std::size_t size,
+		double pitch, double roll, double heading,
+		const NmeaParserResult& emptyFields)
+{
+	impl::Sentence s(buffer, size, "PRDID");
+	s.fieldFixed(pitch, 2, emptyFields[0]);
+	s.fieldFixed(roll, 2, emptyFields[1]);
+	s.fieldFixed(heading, 2, emptyFields[2]);
+	return s.finish();
+}
+
+bool NmeaWriter::rewriteTalkerId(std::string& nmea,
+		const std::string& talkerId)
+{
+	// Proprietary sentences have no Talker Id
+	if (!impl::validTalkerId(talkerId) || nmea.size() < 6
+			|| (nmea[0] != '$' && nmea[0] != '!') || nmea[1] == 'P')
+	{
+		return false;
+	}
+
+	const std::string::size_type star = nmea.rfind('*');
+	if (star != std::string::npos)
+	{
+		int high;
+		int low;
+		if (star + 2 >= nmea.size() || !impl::parseHexDigit(nmea[star + 1], high)
+				|| !impl::parseHexDigit(nmea[star + 2], low))
+		{
+			return false;
+		}
+
+		// XOR is its own inverse: remove the old Talker Id and add the new one
+		const int checksum = ((high << 4) | low) ^ nmea[1] ^ nmea[2]
+				^ talkerId[0] ^ talkerId[1];
+		nmea[star + 1] = impl::hexDigits[(checksum >> 4) & 0xF];
+		nmea[star + 2] = impl::hexDigits[checksum & 0xF];
+	}
+
+	nmea[1] = talkerId[0];
+	nmea[2] = talkerId[1];
+
+	return true;
+}
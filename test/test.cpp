@@ -8,6 +8,49 @@
 #define BOOST_TEST_MODULE libNmeaParser test
 #include <boost/test/included/unit_test.hpp>
 #include "NmeaParser.h"
+#include "NmeaWriter.h"
+#include "AISEncoder.h"
+#include "AISVesselTable.h"
+#include "NmeaOwnShipState.h"
+#include "AISBatchDecoder.h"
+#include "AISBitBuffer.h"
+#include "AISMessageView.h"
+#include "AISStaticDataCache.h"
+#include "AISDuplicateFilter.h"
+#include "AISStringPool.h"
+#include "AISSpatialIndex.h"
+#include "NmeaCpaEngine.h"
+#include "AISGeofence.h"
+#include "AISTrackHistory.h"
+#include "AISTrajectoryCompressor.h"
+#include "AISArchiveWriter.h"
+#include "AISArchiveReader.h"
+#include "AISLogIndex.h"
+#include "NmeaTimeExtractor.h"
+#include "NmeaTimeIndex.h"
+#include "NmeaLogMerger.h"
+#include "NmeaReplay.h"
+#include "NmeaGzipReader.h"
+#include "NmeaPcapReader.h"
+#include "NmeaSharedRingWriter.h"
+#include "NmeaSharedRingReader.h"
+#include "NmeaDispatcher.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <thread>
+#include <type_traits>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <zlib.h>
 
 //int main() {
 
@@ -612,3 +655,2565 @@ BOOST_AUTO_TEST_CASE( parseAISStaticDataReport ) {
 			true);
 
 }
+
+BOOST_AUTO_TEST_CASE( enumToStringRef ) {
+
+	for (int i = Nmea_ShipType_NotAvailable;
+			i <= Nmea_ShipType_OtherType_NoAdditionalInformation; ++i)
+	{
+		Nmea_ShipType shipType = static_cast<Nmea_ShipType>(i);
+		Nmea_ShipType parsed;
+		BOOST_REQUIRE(!toStringRef(shipType).empty());
+		BOOST_REQUIRE(fromString(toStringRef(shipType), parsed));
+		BOOST_REQUIRE_EQUAL(parsed, shipType);
+	}
+
+	BOOST_REQUIRE_EQUAL(toStringRef(Nmea_EPFDFix_Galileo),
+			"Nmea_EPFDFix_Galileo");
+	BOOST_REQUIRE(toStringRef(static_cast<Nmea_ShipType>(200)).empty());
+
+	Nmea_RAIM raim;
+	BOOST_REQUIRE(!fromString("Nmea_RAIM_Unknown", raim));
+
+	std::ostringstream out;
+	out << Nmea_NavigationStatus_Moored << ","
+			<< static_cast<Nmea_NavigationStatus>(42);
+	BOOST_REQUIRE_EQUAL(out.str(), "Nmea_NavigationStatus_Moored,42");
+
+	// Names honour width and fill like any formatted output
+	std::ostringstream padded;
+	padded << std::setw(20) << std::setfill('.') << std::left
+			<< Nmea_RAIM_InUse << "|";
+	BOOST_REQUIRE_EQUAL(padded.str(), "Nmea_RAIM_InUse.....|");
+}
+
+BOOST_AUTO_TEST_CASE( writeZDA ) {
+	char buffer[NmeaWriter::maxSentenceSize];
+	boost::posix_time::time_duration mtime(16, 6, 19);
+
+	BOOST_REQUIRE_EQUAL(
+			NmeaWriter::writeZDA(buffer, sizeof(buffer), "GP", mtime, 20, 4,
+					2016, -5, 0), 39UL);
+	BOOST_REQUIRE_EQUAL(std::string(buffer),
+			"$GPZDA,160619.00,20,04,2016,-05,00*44\r\n");
+
+	NmeaParserResult emptyFields(0b0000000000111110);
+	BOOST_REQUIRE_EQUAL(
+			NmeaWriter::writeZDA(buffer, sizeof(buffer), "GP", mtime, 20, 4,
+					2016, -5, 0, emptyFields), 26UL);
+	BOOST_REQUIRE_EQUAL(std::string(buffer), "$GPZDA,160619.00,,,,,*6F\r\n");
+
+	// Buffer too small for the sentence
+	BOOST_REQUIRE_EQUAL(
+			NmeaWriter::writeZDA(buffer, 30, "GP", mtime, 20, 4, 2016, -5, 0),
+			0UL);
+	BOOST_REQUIRE_EQUAL(buffer[0], '\0');
+
+	std::string nmea = "$GPZDA,160619.00,20,04,2016,-05,00*44";
+	BOOST_REQUIRE(NmeaWriter::rewriteTalkerId(nmea, "II"));
+	BOOST_REQUIRE_EQUAL(nmea, "$IIZDA,160619.00,20,04,2016,-05,00*53");
+	BOOST_REQUIRE(!NmeaWriter::rewriteTalkerId(nmea, "III"));
+
+	// Talker Id of other than two characters, values that do not fit
+	BOOST_REQUIRE_EQUAL(
+			NmeaWriter::writeZDA(buffer, sizeof(buffer), "GPS", mtime, 20, 4,
+					2016, -5, 0), 0UL);
+	BOOST_REQUIRE_EQUAL(buffer[0], '\0');
+	BOOST_REQUIRE_EQUAL(
+			NmeaWriter::writeZDA(buffer, sizeof(buffer), "G", mtime, 20, 4,
+					2016, -5, 0), 0UL);
+	BOOST_REQUIRE_EQUAL(
+			NmeaWriter::writeZDA(buffer, sizeof(buffer), "gp", mtime, 20, 4,
+					2016, -5, 0), 0UL);
+	BOOST_REQUIRE_EQUAL(
+			NmeaWriter::writeZDA(buffer, sizeof(buffer), "G,", mtime, 20, 4,
+					2016, -5, 0), 0UL);
+	BOOST_REQUIRE(!NmeaWriter::rewriteTalkerId(nmea, "i1"));
+
+	// Proprietary sentences keep their manufacturer code
+	std::string proprietary = "$PSKPDPT,0002.5,M,,,,*21";
+	BOOST_REQUIRE(!NmeaWriter::rewriteTalkerId(proprietary, "II"));
+	BOOST_REQUIRE_EQUAL(proprietary, "$PSKPDPT,0002.5,M,,,,*21");
+
+	// Text that would break the framing or the checksum
+	const char* reserved[] = { "WP,1", "WP*1", "WP$1", "WP!1", "WP\\1",
+			"WP\r1", "WP\n1", "WP^1", "WP~1" };
+	for (std::size_t i = 0; i < sizeof(reserved) / sizeof(reserved[0]); ++i)
+	{
+		BOOST_REQUIRE_EQUAL(
+				NmeaWriter::writeWPL(buffer, sizeof(buffer), "GP", -12.0,
+						-77.0, reserved[i]), 0UL);
+		BOOST_REQUIRE_EQUAL(buffer[0], '\0');
+	}
+	BOOST_REQUIRE(
+			NmeaWriter::writeWPL(buffer, sizeof(buffer), "GP", -12.0, -77.0,
+					"CALLAO-1") > 0);
+	std::vector<std::string> waypoints = { "A", "B|C" };
+	BOOST_REQUIRE(
+			NmeaWriter::writeRTE(buffer, sizeof(buffer), "GP", 1, 1, 'c',
+					"R1", waypoints) > 0);
+	waypoints.push_back("D,E");
+	BOOST_REQUIRE_EQUAL(
+			NmeaWriter::writeRTE(buffer, sizeof(buffer), "GP", 1, 1, 'c',
+					"R1", waypoints), 0UL);
+	BOOST_REQUIRE_EQUAL(
+			NmeaWriter::writeVTG(buffer, sizeof(buffer), "GP", 1e300, 0.0,
+					1.0, 1.0), 0UL);
+	BOOST_REQUIRE_EQUAL(
+			NmeaWriter::writeGLL(buffer, sizeof(buffer), "GP", 1e20, -77.0,
+					mtime, 'A', 'A'), 0UL);
+	BOOST_REQUIRE_EQUAL(buffer[0], '\0');
+}
+
+BOOST_AUTO_TEST_CASE( writeRoundTrip ) {
+	char buffer[NmeaWriter::maxSentenceSize];
+
+	boost::posix_time::time_duration mtime;
+	double latitude;
+	double longitude;
+	Nmea_GPSQualityIndicator quality;
+	int numSV;
+	double hdop;
+	double orthometricheight;
+	double geoidseparation;
+	double agediffgps;
+	std::string refid;
+
+	BOOST_REQUIRE(
+			NmeaWriter::writeGGA(buffer, sizeof(buffer), "GP",
+					boost::posix_time::time_duration(17, 28, 14), -12.0422,
+					-77.1424, Nmea_GPSQualityIndicator_GPSFixDifferential, 9,
+					0.9, 24.9, 10.6, 0.0, "",
+					NmeaParserResult(0b0000001100000000)) > 0);
+	BOOST_REQUIRE_EQUAL(
+			NmeaParser::parseGGA(buffer, mtime, latitude, longitude, quality,
+					numSV, hdop, orthometricheight, geoidseparation, agediffgps,
+					refid), 0b0000001100000000);
+	BOOST_REQUIRE_EQUAL(mtime, boost::posix_time::time_duration(17, 28, 14));
+	BOOST_REQUIRE_CLOSE(latitude, -12.0422, 1e-6);
+	BOOST_REQUIRE_CLOSE(longitude, -77.1424, 1e-6);
+	BOOST_REQUIRE_EQUAL(quality, Nmea_GPSQualityIndicator_GPSFixDifferential);
+	BOOST_REQUIRE_EQUAL(numSV, 9);
+	BOOST_REQUIRE_CLOSE(hdop, 0.9, 1e-6);
+
+	double windAngle;
+	Nmea_AngleReference reference;
+	double windSpeed;
+	char windSpeedUnits;
+	char sensorStatus;
+
+	BOOST_REQUIRE(
+			NmeaWriter::writeMWV(buffer, sizeof(buffer), "WI", 270.5,
+					Nmea_AngleReference_Relative, 12.25, 'N', 'A') > 0);
+	BOOST_REQUIRE_EQUAL(
+			NmeaParser::parseMWV(buffer, windAngle, reference, windSpeed,
+					windSpeedUnits, sensorStatus), 0UL);
+	BOOST_REQUIRE_CLOSE(windAngle, 270.5, 1e-6);
+	BOOST_REQUIRE_EQUAL(reference, Nmea_AngleReference_Relative);
+	BOOST_REQUIRE_CLOSE(windSpeed, 12.25, 1e-6);
+
+	int totalLines;
+	int lineCount;
+	int sequenceIdentifier;
+	char aisChannel;
+	std::string encodedData;
+	int fillBits;
+
+	BOOST_REQUIRE(
+			NmeaWriter::writeVDM(buffer, sizeof(buffer), "AI", 1, 1, -1, 'B',
+					"177KQJ5000G?tO`K>RA1wUbN0TKH", 0) > 0);
+	BOOST_REQUIRE_EQUAL(std::string(buffer),
+			"!AIVDM,1,1,,B,177KQJ5000G?tO`K>RA1wUbN0TKH,0*5C\r\n");
+	BOOST_REQUIRE_EQUAL(
+			NmeaParser::parseVDM(buffer, totalLines, lineCount,
+					sequenceIdentifier, aisChannel, encodedData, fillBits),
+			0b0000000000000100);
+	BOOST_REQUIRE_EQUAL(encodedData, "177KQJ5000G?tO`K>RA1wUbN0TKH");
+}
+
+BOOST_AUTO_TEST_CASE( encodeAISPositionReportClassA ) {
+
+	std::string encodedData;
+	int fillBits;
+
+	AISPositionReportClassA data;
+	AISPositionReportClassA decoded;
+
+	BOOST_REQUIRE(
+			NmeaParser::parseAISPositionReportClassA(
+					"3;DjhdPP@3JNfEIq6uHjlUCp00w1", data));
+	BOOST_REQUIRE(
+			AISEncoder::encodeAISPositionReportClassA(data,
+					Nmea_AisMessageType_PositionReportClassA_ResponseToInterrogation,
+					encodedData, fillBits));
+	BOOST_REQUIRE_EQUAL(encodedData.size(), 28UL);
+	BOOST_REQUIRE_EQUAL(fillBits, 0);
+	// Fields ahead of the position are bit exact
+	BOOST_REQUIRE_EQUAL(encodedData.substr(0, 10), "3;DjhdPP@3");
+
+	BOOST_REQUIRE(
+			NmeaParser::parseAISPositionReportClassA(encodedData, decoded));
+	BOOST_REQUIRE_EQUAL(decoded.mmsi, data.mmsi);
+	BOOST_REQUIRE_EQUAL(decoded.navigationStatus, data.navigationStatus);
+	BOOST_REQUIRE_CLOSE(decoded.rateOfTurn, data.rateOfTurn, 1e-3);
+	BOOST_REQUIRE_CLOSE(decoded.speedOverGround, data.speedOverGround, 1e-3);
+	BOOST_REQUIRE_CLOSE(decoded.longitude, data.longitude, 1e-4);
+	BOOST_REQUIRE_CLOSE(decoded.latitude, data.latitude, 1e-4);
+	BOOST_REQUIRE_EQUAL(decoded.trueHeading, data.trueHeading);
+	BOOST_REQUIRE_EQUAL(decoded.maneuverIndicator, data.maneuverIndicator);
+	BOOST_REQUIRE_EQUAL(decoded.raim, data.raim);
+
+	// RAIM follows the 3 spare bits
+	for (int raim = 0; raim < 2; ++raim)
+	{
+		data.raim = raim != 0 ? Nmea_RAIM_InUse : Nmea_RAIM_NotInUse;
+		BOOST_REQUIRE(
+				AISEncoder::encodeAISPositionReportClassA(data,
+						Nmea_AisMessageType_PositionReportClassA, encodedData,
+						fillBits));
+		BOOST_REQUIRE(
+				NmeaParser::parseAISPositionReportClassA(encodedData, decoded));
+		BOOST_REQUIRE_EQUAL(decoded.raim, data.raim);
+	}
+
+	BOOST_REQUIRE(
+			!AISEncoder::encodeAISPositionReportClassA(data,
+					Nmea_AisMessageType_BaseStationReport, encodedData,
+					fillBits));
+}
+
+BOOST_AUTO_TEST_CASE( encodeAISStaticAndVoyageRelatedData ) {
+
+	AISStaticAndVoyageRelatedData data;
+	data.repeatIndicator = 0;
+	data.mmsi = 760000123;
+	data.aisVersion = 1;
+	data.imoNumber = 9074729;
+	data.callsign = "OA4321";
+	data.vesselName = "Marina del Callao";
+	data.shipType = Nmea_ShipType_Cargo_AllShipsOfThisType;
+	data.dimension.toBow = 120;
+	data.dimension.toStern = 30;
+	data.dimension.toPort = 12;
+	data.dimension.toStarboard = 13;
+	data.epfd = Nmea_EPFDFix_GPS;
+	data.month = 4;
+	data.day = 20;
+	data.hour = 16;
+	data.minute = 30;
+	data.draught = 95;
+	data.destination = "CALLAO";
+
+	std::string encodedData;
+	int fillBits;
+	BOOST_REQUIRE(
+			AISEncoder::encodeAISStaticAndVoyageRelatedData(data, encodedData,
+					fillBits));
+	BOOST_REQUIRE_EQUAL(encodedData.size(), 71UL);
+	BOOST_REQUIRE_EQUAL(fillBits, 2);
+
+	std::vector<std::string> sentences;
+	BOOST_REQUIRE_EQUAL(
+			AISEncoder::writeVDM(sentences, "AI", 3, 'A', encodedData,
+					fillBits), 2);
+	BOOST_REQUIRE_EQUAL(sentences.size(), 2UL);
+
+	std::string payload;
+	for (std::size_t i = 0; i < sentences.size(); ++i)
+	{
+		int totalLines;
+		int lineCount;
+		int sequenceIdentifier;
+		char aisChannel;
+		std::string fragment;
+		int fragmentFillBits;
+
+		BOOST_REQUIRE(sentences[i].size() <= 80);
+		BOOST_REQUIRE_EQUAL(
+				NmeaParser::parseVDM(sentences[i], totalLines, lineCount,
+						sequenceIdentifier, aisChannel, fragment,
+						fragmentFillBits), 0UL);
+		BOOST_REQUIRE_EQUAL(totalLines, 2);
+		BOOST_REQUIRE_EQUAL(lineCount, static_cast<int>(i) + 1);
+		BOOST_REQUIRE_EQUAL(sequenceIdentifier, 3);
+		BOOST_REQUIRE_EQUAL(fragmentFillBits, i == 0 ? 0 : 2);
+		payload += fragment;
+	}
+	BOOST_REQUIRE_EQUAL(payload, encodedData);
+
+	char buffer[2 * NmeaWriter::maxSentenceSize];
+	BOOST_REQUIRE_EQUAL(
+			AISEncoder::writeVDM(buffer, sizeof(buffer), "AI", 3, 'A',
+					encodedData, fillBits),
+			sentences[0].size() + sentences[1].size() + 4);
+	BOOST_REQUIRE_EQUAL(std::string(buffer),
+			sentences[0] + "\r\n" + sentences[1] + "\r\n");
+	BOOST_REQUIRE_EQUAL(
+			AISEncoder::writeVDM(buffer, 100, "AI", 3, 'A', encodedData,
+					fillBits), 0UL);
+
+	AISStaticAndVoyageRelatedData decoded;
+	BOOST_REQUIRE(
+			NmeaParser::parseAISStaticAndVoyageRelatedData(payload, decoded));
+	BOOST_REQUIRE_EQUAL(decoded.mmsi, data.mmsi);
+	BOOST_REQUIRE_EQUAL(decoded.imoNumber, data.imoNumber);
+	BOOST_REQUIRE_EQUAL(decoded.callsign, "OA4321");
+	BOOST_REQUIRE_EQUAL(decoded.vesselName, "MARINA DEL CALLAO");
+	BOOST_REQUIRE_EQUAL(decoded.shipType, data.shipType);
+	BOOST_REQUIRE_EQUAL(decoded.dimension.toStarboard, 13);
+	BOOST_REQUIRE_EQUAL(decoded.minute, 30);
+	BOOST_REQUIRE_EQUAL(decoded.draught, 95);
+	BOOST_REQUIRE_EQUAL(decoded.destination, "CALLAO");
+}
+
+BOOST_AUTO_TEST_CASE( encodeAISRoundTrip ) {
+
+	std::string encodedData;
+	int fillBits;
+
+	AISBaseStationReport baseStation;
+	AISBaseStationReport decodedBaseStation;
+	BOOST_REQUIRE(
+			NmeaParser::parseAISBaseStationReport(
+					"400TcdiuiT7VDR>3nIfr6>i00000", baseStation));
+	BOOST_REQUIRE(
+			AISEncoder::encodeAISBaseStationReport(baseStation, encodedData,
+					fillBits));
+	// Fields ahead of the position are bit exact
+	BOOST_REQUIRE_EQUAL(encodedData.substr(0, 13), "400TcdiuiT7VD");
+	BOOST_REQUIRE(
+			NmeaParser::parseAISBaseStationReport(encodedData,
+					decodedBaseStation));
+	BOOST_REQUIRE_EQUAL(decodedBaseStation.year, baseStation.year);
+	BOOST_REQUIRE_EQUAL(decodedBaseStation.second, baseStation.second);
+
+	AISStandardClassBCSPositionReport classB;
+	AISStandardClassBCSPositionReport decodedClassB;
+	BOOST_REQUIRE(
+			NmeaParser::parseAISStandardClassBCSPositionReport(
+					"B;Djf2h01fWd0qNAh;M0cwb7kP06", classB));
+	BOOST_REQUIRE(
+			AISEncoder::encodeAISStandardClassBCSPositionReport(classB,
+					encodedData, fillBits));
+	BOOST_REQUIRE(
+			NmeaParser::parseAISStandardClassBCSPositionReport(encodedData,
+					decodedClassB));
+	BOOST_REQUIRE_EQUAL(decodedClassB.mmsi, classB.mmsi);
+	BOOST_REQUIRE_CLOSE(decodedClassB.courseOverGround,
+			classB.courseOverGround, 1e-3);
+
+	AISStaticDataReport staticData;
+	AISStaticDataReport decodedStaticData;
+	BOOST_REQUIRE(
+			NmeaParser::parseAISStaticDataReport("H6K8C4Q<Dq<QF0l59F0pvs>2220",
+					staticData));
+	BOOST_REQUIRE(
+			AISEncoder::encodeAISStaticDataReport(staticData, encodedData,
+					fillBits));
+	BOOST_REQUIRE(
+			NmeaParser::parseAISStaticDataReport(encodedData,
+					decodedStaticData));
+	BOOST_REQUIRE_EQUAL(decodedStaticData.partNumber, 0);
+	BOOST_REQUIRE_EQUAL(decodedStaticData.partA.vesselName,
+			staticData.partA.vesselName);
+
+	staticData.partNumber = 1;
+	staticData.partB.shipType = Nmea_ShipType_PleasureCraft;
+	staticData.partB.vendorId = "SRT";
+	staticData.partB.unitModelCode = 2;
+	staticData.partB.serialNumber = 123456;
+	staticData.partB.callsign = "OA2345";
+	staticData.partB.dimension.toBow = 8;
+	staticData.partB.dimension.toStern = 4;
+	staticData.partB.dimension.toPort = 2;
+	staticData.partB.dimension.toStarboard = 2;
+	BOOST_REQUIRE(
+			AISEncoder::encodeAISStaticDataReport(staticData, encodedData,
+					fillBits));
+	BOOST_REQUIRE_EQUAL(encodedData.size(), 28UL);
+	BOOST_REQUIRE(
+			NmeaParser::parseAISStaticDataReport(encodedData,
+					decodedStaticData));
+	BOOST_REQUIRE_EQUAL(decodedStaticData.partNumber, 1);
+	BOOST_REQUIRE_EQUAL(decodedStaticData.partB.vendorId, "SRT");
+	BOOST_REQUIRE_EQUAL(decodedStaticData.partB.serialNumber, 123456);
+	BOOST_REQUIRE_EQUAL(decodedStaticData.partB.callsign, "OA2345");
+
+	AISAidToNavigationReport aid;
+	aid.repeatIndicator = 0;
+	aid.mmsi = 992761001;
+	aid.navigationAidType = Nmea_NavigationAidType_LightWithoutSectors;
+	aid.name = "ISLA SAN LORENZO LIGHTHOUSE";
+	aid.positionAccuracy = Nmea_PositionAccuracy_DGPSQualityFix;
+	aid.longitude = -77.25f;
+	aid.latitude = -12.075f;
+	aid.dimension.toBow = 0;
+	aid.dimension.toStern = 0;
+	aid.dimension.toPort = 0;
+	aid.dimension.toStarboard = 0;
+	aid.epfd = Nmea_EPFDFix_Surveyed;
+	aid.timestapUTCSecond = 60;
+	aid.offPosition = false;
+	aid.raim = Nmea_RAIM_NotInUse;
+	aid.virtualAid = true;
+	aid.assigned = false;
+
+	AISAidToNavigationReport decodedAid;
+	BOOST_REQUIRE(
+			AISEncoder::encodeAISAidToNavigationReport(aid, encodedData,
+					fillBits));
+	BOOST_REQUIRE(
+			NmeaParser::parseAISAidToNavigationReport(encodedData, decodedAid));
+	BOOST_REQUIRE_EQUAL(decodedAid.name, aid.name);
+	BOOST_REQUIRE_EQUAL(decodedAid.navigationAidType, aid.navigationAidType);
+	BOOST_REQUIRE_CLOSE(decodedAid.longitude, aid.longitude, 1e-4);
+	BOOST_REQUIRE_EQUAL(decodedAid.virtualAid, true);
+}
+
+BOOST_AUTO_TEST_CASE( mmsiMap ) {
+
+	const uint capacity = 1000;
+	AISMmsiMap map(capacity);
+	bool inserted;
+
+	for (uint i = 0; i < capacity; ++i)
+	{
+		BOOST_REQUIRE_EQUAL(map.insert(200000000 + i * 7, inserted), i);
+		BOOST_REQUIRE(inserted);
+	}
+	BOOST_REQUIRE_EQUAL(map.insert(999999999, inserted), AISMmsiMap::NPOS);
+	BOOST_REQUIRE_EQUAL(map.insert(200000007, inserted), 1U);
+	BOOST_REQUIRE(!inserted);
+
+	// Erasing shifts back colliding entries, the rest must stay reachable
+	for (uint i = 0; i < capacity; i += 2)
+	{
+		BOOST_REQUIRE(map.erase(200000000 + i * 7));
+	}
+	BOOST_REQUIRE(!map.erase(200000000));
+	BOOST_REQUIRE_EQUAL(map.size(), capacity / 2);
+	for (uint i = 0; i < capacity; ++i)
+	{
+		BOOST_REQUIRE_EQUAL(map.find(200000000 + i * 7),
+				i % 2 ? i : AISMmsiMap::NPOS);
+	}
+
+	// Released slots are reused
+	const uint slot = map.insert(999999999, inserted);
+	BOOST_REQUIRE(inserted);
+	BOOST_REQUIRE(slot < capacity && slot % 2 == 0);
+	BOOST_REQUIRE_EQUAL(map.mmsiAt(slot), 999999999U);
+}
+
+BOOST_AUTO_TEST_CASE( vesselTable ) {
+
+	AISVesselTable table(16);
+	std::string encodedData;
+	int fillBits;
+
+	AISPositionReportClassA position;
+	BOOST_REQUIRE(
+			NmeaParser::parseAISPositionReportClassA(
+					"3;DjhdPP@3JNfEIq6uHjlUCp00w1", position));
+	BOOST_REQUIRE(table.update("3;DjhdPP@3JNfEIq6uHjlUCp00w1", 1000));
+	BOOST_REQUIRE(table.findStatic(position.mmsi) == nullptr);
+
+	const AISVesselPosition* hot = table.findPosition(position.mmsi);
+	BOOST_REQUIRE(hot != nullptr);
+	BOOST_REQUIRE_EQUAL(hot->latitude, position.latitude);
+	BOOST_REQUIRE_EQUAL(hot->messageType,
+			Nmea_AisMessageType_PositionReportClassA_ResponseToInterrogation);
+	BOOST_REQUIRE_EQUAL(hot->timestamp, 1000);
+
+	AISStaticDataReport partA;
+	partA.repeatIndicator = 0;
+	partA.mmsi = position.mmsi;
+	partA.partNumber = 0;
+	partA.partA.vesselName = "A VERY LONG VESSEL NAME";
+	BOOST_REQUIRE(
+			AISEncoder::encodeAISStaticDataReport(partA, encodedData,
+					fillBits));
+	BOOST_REQUIRE(table.update(encodedData, 2000));
+
+	const AISVesselStatic* cold = table.findStatic(position.mmsi);
+	BOOST_REQUIRE(cold != nullptr);
+	BOOST_REQUIRE_EQUAL(cold->vesselName, "A VERY LONG VESSEL N");
+	BOOST_REQUIRE_EQUAL(table.size(), 1U);
+
+	AISExtendedClassBCSPositionReport extended;
+	extended.repeatIndicator = 0;
+	extended.mmsi = 338123456;
+	extended.speedOverGround = 5.5f;
+	extended.positionAccuracy = Nmea_PositionAccuracy_UnaugmentedGNSSFix;
+	extended.longitude = -77.5f;
+	extended.latitude = -12.25f;
+	extended.courseOverGround = 90.0f;
+	extended.trueHeading = 91;
+	extended.timestapUTCSecond = 10;
+	extended.vesselName = "SEA BREEZE";
+	extended.shipType = Nmea_ShipType_Sailing;
+	extended.dimension.toBow = 10;
+	extended.dimension.toStern = 2;
+	extended.dimension.toPort = 2;
+	extended.dimension.toStarboard = 2;
+	extended.epfd = Nmea_EPFDFix_GPS;
+	extended.raim = Nmea_RAIM_NotInUse;
+	extended.assigned = false;
+	BOOST_REQUIRE(
+			AISEncoder::encodeAISExtendedClassBEquipmentPositionReport(extended,
+					encodedData, fillBits));
+	BOOST_REQUIRE_EQUAL(encodedData.size(), 52UL);
+	BOOST_REQUIRE(table.update(encodedData, 3000));
+
+	hot = table.findPosition(338123456);
+	cold = table.findStatic(338123456);
+	BOOST_REQUIRE(hot != nullptr && cold != nullptr);
+	BOOST_REQUIRE_CLOSE(hot->speedOverGround, 5.5f, 1e-3);
+	BOOST_REQUIRE_EQUAL(hot->trueHeading, 91);
+	BOOST_REQUIRE_EQUAL(cold->vesselName, "SEA BREEZE");
+	BOOST_REQUIRE_EQUAL(cold->shipType, Nmea_ShipType_Sailing);
+
+	// Base station reports are not merged
+	BOOST_REQUIRE(!table.update("400TcdiuiT7VDR>3nIfr6>i00000", 3000));
+
+	BOOST_REQUIRE_EQUAL(table.expire(2500), 1U);
+	BOOST_REQUIRE(table.findPosition(position.mmsi) == nullptr);
+	BOOST_REQUIRE_EQUAL(table.size(), 1U);
+	BOOST_REQUIRE(table.erase(338123456));
+	BOOST_REQUIRE_EQUAL(table.size(), 0U);
+
+	// Zero is a time like any other
+	position.navigationStatus = Nmea_NavigationStatus_Moored;
+	position.rateOfTurn = 5.0f;
+	BOOST_REQUIRE(
+			table.update(position, Nmea_AisMessageType_PositionReportClassA,
+					0));
+	hot = table.findPosition(position.mmsi);
+	BOOST_REQUIRE(hot != nullptr);
+	BOOST_REQUIRE_EQUAL(hot->timestamp, 0);
+	BOOST_REQUIRE_EQUAL(hot->navigationStatus, Nmea_NavigationStatus_Moored);
+
+	// Class B after Class A drops the Class A only fields
+	AISStandardClassBCSPositionReport classB;
+	classB.repeatIndicator = 0;
+	classB.mmsi = position.mmsi;
+	classB.speedOverGround = 1.0f;
+	classB.positionAccuracy = Nmea_PositionAccuracy_UnaugmentedGNSSFix;
+	classB.longitude = -77.5f;
+	classB.latitude = -12.25f;
+	classB.courseOverGround = 45.0f;
+	classB.trueHeading = 45;
+	classB.timestapUTCSecond = 10;
+	BOOST_REQUIRE(table.update(classB, -100));
+	BOOST_REQUIRE_EQUAL(hot->navigationStatus,
+			Nmea_NavigationStatus_NotDefined);
+	BOOST_REQUIRE_EQUAL(hot->rateOfTurn, 0.0f);
+	BOOST_REQUIRE_EQUAL(hot->timestamp, -100);
+	BOOST_REQUIRE_EQUAL(table.expire(-100), 0U);
+	BOOST_REQUIRE_EQUAL(table.expire(-99), 1U);
+}
+
+BOOST_AUTO_TEST_CASE( ownShipState ) {
+
+	NmeaOwnShipState state;
+	NmeaOwnShipSnapshot snapshot;
+
+	state.snapshot(snapshot);
+	BOOST_REQUIRE_EQUAL(snapshot.version, 0U);
+	BOOST_REQUIRE(!snapshot.isValid(Nmea_OwnShipField_Heading));
+	BOOST_REQUIRE_EQUAL(snapshot.age(Nmea_OwnShipField_Heading, 100), -1);
+
+	BOOST_REQUIRE(state.ingest("$HEHDT,274.07,T*03", 1000));
+	BOOST_REQUIRE(state.ingest("$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K*19",
+			1100));
+	BOOST_REQUIRE(!state.ingest("$GPZDA,160619.00,20,04,2016,8,3*6C", 1200));
+	BOOST_REQUIRE(state.ingest("$HEHDT,,T*03", 1500));
+
+	state.snapshot(snapshot);
+	BOOST_REQUIRE_EQUAL(snapshot.version, 3U);
+	BOOST_REQUIRE_EQUAL(state.version(), 3U);
+	BOOST_REQUIRE(snapshot.isValid(Nmea_OwnShipField_SpeedOverGround));
+	BOOST_REQUIRE_CLOSE(snapshot.value[Nmea_OwnShipField_SpeedOverGround],
+			5.5, 1e-6);
+	// Empty heading keeps the last valid value, flagged invalid and aging
+	BOOST_REQUIRE(!snapshot.isValid(Nmea_OwnShipField_Heading));
+	BOOST_REQUIRE_CLOSE(snapshot.value[Nmea_OwnShipField_Heading], 274.07,
+			1e-6);
+	BOOST_REQUIRE_EQUAL(snapshot.age(Nmea_OwnShipField_Heading, 2000), 1000);
+}
+
+BOOST_AUTO_TEST_CASE( ownShipStateConcurrentReaders ) {
+
+	const int updates = 5000;
+	NmeaOwnShipState state;
+	std::atomic<bool> done(false);
+	std::atomic<int> inconsistent(0);
+
+	// Latitude and altitude of every GGA are derived from the same counter
+	std::vector<std::thread> readers;
+	for (int r = 0; r < 2; ++r)
+	{
+		readers.push_back(std::thread([&]()
+		{
+			NmeaOwnShipSnapshot snapshot;
+			while (!done.load())
+			{
+				state.snapshot(snapshot);
+				if (std::fabs(snapshot.value[Nmea_OwnShipField_Latitude] * 100.0
+						- snapshot.value[Nmea_OwnShipField_Altitude]) > 1e-3)
+				{
+					++inconsistent;
+				}
+			}
+		}));
+	}
+
+	char buffer[NmeaWriter::maxSentenceSize];
+	for (int i = 1; i <= updates; ++i)
+	{
+		NmeaWriter::writeGGA(buffer, sizeof(buffer), "GP",
+				boost::posix_time::time_duration(12, 0, 0), i / 100.0, -77.0,
+				Nmea_GPSQualityIndicator_GPSFix, 8, 1.0, i, 0.0, 0.0, "",
+				NmeaParserResult(0b0000001100000000));
+		BOOST_REQUIRE(state.ingest(buffer, i));
+	}
+	done = true;
+
+	for (std::size_t r = 0; r < readers.size(); ++r)
+	{
+		readers[r].join();
+	}
+
+	BOOST_REQUIRE_EQUAL(inconsistent.load(), 0);
+
+	NmeaOwnShipSnapshot snapshot;
+	state.snapshot(snapshot);
+	BOOST_REQUIRE_EQUAL(snapshot.version, static_cast<uint32_t>(updates));
+	BOOST_REQUIRE_EQUAL(snapshot.timestamp[Nmea_OwnShipField_Latitude],
+			updates);
+}
+
+BOOST_AUTO_TEST_CASE( batchDecodePositionReports ) {
+
+	const std::size_t count = 70;
+	std::vector<std::string> payloads(count);
+	int fillBits;
+
+	AISPositionReportClassA classA;
+	BOOST_REQUIRE(
+			NmeaParser::parseAISPositionReportClassA(
+					"3;DjhdPP@3JNfEIq6uHjlUCp00w1", classA));
+	AISStandardClassBCSPositionReport classB;
+	BOOST_REQUIRE(
+			NmeaParser::parseAISStandardClassBCSPositionReport(
+					"B;Djf2h01fWd0qNAh;M0cwb7kP06", classB));
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		classA.mmsi = 200000000 + i;
+		classA.longitude = -77.0f + i * 0.01f;
+		classA.speedOverGround = i * 0.1f;
+		classB.mmsi = 300000000 + i;
+		classB.latitude = -12.0f - i * 0.01f;
+		classB.courseOverGround = i;
+		switch (i % 5)
+		{
+		case 0:
+			AISEncoder::encodeAISPositionReportClassA(classA,
+					Nmea_AisMessageType_PositionReportClassA, payloads[i],
+					fillBits);
+			break;
+		case 1:
+			AISEncoder::encodeAISStandardClassBCSPositionReport(classB,
+					payloads[i], fillBits);
+			break;
+		case 2:
+			payloads[i] =
+					"58wt8Ui`g??r21`7S=:22058<v05Htp000000015>8OA;0skeQ8823mDm3kP00000000000";
+			break;
+		case 3:
+			payloads[i] = "3;Djhd P@3JNfEIq6uHjlUCp00w1";
+			break;
+		default:
+			AISEncoder::encodeAISPositionReportClassA(classA,
+					Nmea_AisMessageType_PositionReportClassA_AssignedSchedule,
+					payloads[i], fillBits);
+			payloads[i].resize(20);
+			break;
+		}
+	}
+
+	std::vector<uint> mmsi(count);
+	std::vector<uint8_t> messageType(count);
+	std::vector<float> longitude(count);
+	std::vector<float> latitude(count);
+	std::vector<float> speedOverGround(count);
+	std::vector<float> courseOverGround(count);
+	std::vector<uint64_t> validMask((count + 63) / 64);
+
+	AISPositionColumns columns;
+	columns.mmsi = mmsi.data();
+	columns.messageType = messageType.data();
+	columns.longitude = longitude.data();
+	columns.latitude = latitude.data();
+	columns.speedOverGround = speedOverGround.data();
+	columns.courseOverGround = courseOverGround.data();
+	columns.trueHeading = nullptr;
+	columns.validMask = validMask.data();
+
+	BOOST_REQUIRE_EQUAL(
+			AISBatchDecoder::decodePositionReports(payloads.data(), count,
+					columns), 28UL);
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const bool valid = (validMask[i / 64] >> (i % 64)) & 1;
+		BOOST_REQUIRE_EQUAL(valid, i % 5 < 2);
+		if (i % 5 == 0)
+		{
+			BOOST_REQUIRE(
+					NmeaParser::parseAISPositionReportClassA(payloads[i],
+							classA));
+			BOOST_REQUIRE_EQUAL(mmsi[i], classA.mmsi);
+			BOOST_REQUIRE_EQUAL(messageType[i],
+					Nmea_AisMessageType_PositionReportClassA);
+			BOOST_REQUIRE_EQUAL(longitude[i], classA.longitude);
+			BOOST_REQUIRE_EQUAL(latitude[i], classA.latitude);
+			BOOST_REQUIRE_EQUAL(speedOverGround[i], classA.speedOverGround);
+			BOOST_REQUIRE_EQUAL(courseOverGround[i], classA.courseOverGround);
+		}
+		else if (i % 5 == 1)
+		{
+			BOOST_REQUIRE(
+					NmeaParser::parseAISStandardClassBCSPositionReport(
+							payloads[i], classB));
+			BOOST_REQUIRE_EQUAL(mmsi[i], classB.mmsi);
+			BOOST_REQUIRE_EQUAL(longitude[i], classB.longitude);
+			BOOST_REQUIRE_EQUAL(latitude[i], classB.latitude);
+			BOOST_REQUIRE_EQUAL(speedOverGround[i], classB.speedOverGround);
+			BOOST_REQUIRE_EQUAL(courseOverGround[i], classB.courseOverGround);
+		}
+		else
+		{
+			BOOST_REQUIRE_EQUAL(mmsi[i], 0U);
+		}
+	}
+
+	// Same rows through string references
+	std::vector<boost::string_ref> refs(payloads.begin(), payloads.end());
+	BOOST_REQUIRE_EQUAL(
+			AISBatchDecoder::decodePositionReports(refs.data(), count,
+					columns), 28UL);
+}
+
+BOOST_AUTO_TEST_CASE( bitReaderArmor ) {
+	AISBitReader reader;
+	const std::string armor = "0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVW`abcdefghijklmnopqrstuvw";
+	BOOST_REQUIRE(reader.assign(armor));
+	for (int i = 0; i < 64; ++i)
+	{
+		BOOST_REQUIRE_EQUAL(reader.getUInt(i * 6, 6), uint(i));
+	}
+
+	// 'X' to '_' fall in the gap, in the vectorized part and in the tail
+	for (char c = 'X'; c <= '_'; ++c)
+	{
+		std::string payload(20, '0');
+		payload[3] = c;
+		BOOST_REQUIRE(!reader.assign(payload));
+		payload[3] = '0';
+		payload[18] = c;
+		BOOST_REQUIRE(!reader.assign(payload));
+		BOOST_REQUIRE(!reader.assign(std::string(1, c)));
+	}
+	BOOST_REQUIRE(!reader.assign("13u?etPv2;0n:dDPwUM1U1Cb069{"));
+	BOOST_REQUIRE(reader.assign("13u?etPv2;0n:dDPwUM1U1Cb069D"));
+
+	// Text fields read as AISMessageView reads them
+	const std::string voyage =
+			"58wt8Ui`g??r21`7S=:22058<v05Htp000000015>8OA;0skeQ8823mDm3kP00000000000";
+	BOOST_REQUIRE(reader.assign(voyage));
+	AISFixedString<20> name;
+	reader.getString(112, 20, name);
+	BOOST_REQUIRE(!name.empty());
+	BOOST_REQUIRE_EQUAL(name, AISMessageView(voyage).vesselName());
+}
+
+BOOST_AUTO_TEST_CASE( messageView ) {
+
+	const std::string classA = "3;DjhdPP@3JNfEIq6uHjlUCp00w1";
+	AISPositionReportClassA position;
+	BOOST_REQUIRE(NmeaParser::parseAISPositionReportClassA(classA, position));
+
+	AISMessageView view(classA);
+	BOOST_REQUIRE_EQUAL(view.messageType(),
+			Nmea_AisMessageType_PositionReportClassA_ResponseToInterrogation);
+	BOOST_REQUIRE_EQUAL(view.repeatIndicator(), position.repeatIndicator);
+	BOOST_REQUIRE_EQUAL(view.mmsi(), position.mmsi);
+	BOOST_REQUIRE(view.hasPosition());
+	BOOST_REQUIRE_EQUAL(view.navigationStatus(), position.navigationStatus);
+	BOOST_REQUIRE_EQUAL(view.longitude(), position.longitude);
+	BOOST_REQUIRE_EQUAL(view.latitude(), position.latitude);
+	BOOST_REQUIRE_EQUAL(view.speedOverGround(), position.speedOverGround);
+	BOOST_REQUIRE_EQUAL(view.courseOverGround(), position.courseOverGround);
+	BOOST_REQUIRE_EQUAL(view.trueHeading(), position.trueHeading);
+	BOOST_REQUIRE(view.vesselName().empty());
+
+	const std::string classB = "B;Djf2h01fWd0qNAh;M0cwb7kP06";
+	AISStandardClassBCSPositionReport positionB;
+	BOOST_REQUIRE(
+			NmeaParser::parseAISStandardClassBCSPositionReport(classB,
+					positionB));
+	view.assign(classB);
+	BOOST_REQUIRE_EQUAL(view.mmsi(), positionB.mmsi);
+	BOOST_REQUIRE_EQUAL(view.longitude(), positionB.longitude);
+	BOOST_REQUIRE_EQUAL(view.latitude(), positionB.latitude);
+	BOOST_REQUIRE_EQUAL(view.speedOverGround(), positionB.speedOverGround);
+	BOOST_REQUIRE_EQUAL(view.courseOverGround(), positionB.courseOverGround);
+	BOOST_REQUIRE_EQUAL(view.trueHeading(), positionB.trueHeading);
+
+	const std::string voyage =
+			"58wt8Ui`g??r21`7S=:22058<v05Htp000000015>8OA;0skeQ8823mDm3kP00000000000";
+	AISStaticAndVoyageRelatedData data;
+	BOOST_REQUIRE(NmeaParser::parseAISStaticAndVoyageRelatedData(voyage, data));
+	view.assign(voyage);
+	BOOST_REQUIRE_EQUAL(view.mmsi(), data.mmsi);
+	BOOST_REQUIRE(!view.hasPosition());
+	BOOST_REQUIRE_EQUAL(view.vesselName(), data.vesselName);
+	BOOST_REQUIRE_EQUAL(view.callsign(), data.callsign);
+	BOOST_REQUIRE_EQUAL(view.destination(), data.destination);
+	BOOST_REQUIRE_EQUAL(view.shipType(), data.shipType);
+	BOOST_REQUIRE_EQUAL(view.longitude(), 181.0f);
+
+	const std::string staticData = "H6K8C4Q<Dq<QF0l59F0pvs>2220";
+	AISStaticDataReport report;
+	BOOST_REQUIRE(NmeaParser::parseAISStaticDataReport(staticData, report));
+	view.assign(staticData);
+	BOOST_REQUIRE_EQUAL(view.mmsi(), report.mmsi);
+	if (report.partNumber == 0)
+	{
+		BOOST_REQUIRE_EQUAL(view.vesselName(), report.partA.vesselName);
+	}
+	else
+	{
+		BOOST_REQUIRE_EQUAL(view.callsign(), report.partB.callsign);
+		BOOST_REQUIRE_EQUAL(view.shipType(), report.partB.shipType);
+	}
+
+	view.assign(boost::string_ref());
+	BOOST_REQUIRE_EQUAL(view.messageType(), Nmea_AisMessageType_NA);
+	BOOST_REQUIRE(!view.hasPosition());
+}
+
+BOOST_AUTO_TEST_CASE( staticDataCache ) {
+
+	const std::string payload =
+			"58wt8Ui`g??r21`7S=:22058<v05Htp000000015>8OA;0skeQ8823mDm3kP00000000000";
+	AISStaticAndVoyageRelatedData expected;
+	BOOST_REQUIRE(NmeaParser::parseAISStaticAndVoyageRelatedData(payload, expected));
+
+	AISStaticDataCache cache(2);
+	AISStaticAndVoyageRelatedData data;
+	BOOST_REQUIRE(cache.parseAISStaticAndVoyageRelatedData(payload, data));
+	BOOST_REQUIRE_EQUAL(data.mmsi, expected.mmsi);
+	BOOST_REQUIRE_EQUAL(data.vesselName, expected.vesselName);
+	BOOST_REQUIRE_EQUAL(data.destination, expected.destination);
+
+	const AISStaticAndVoyageRelatedData* cached =
+			cache.parseAISStaticAndVoyageRelatedData(payload);
+	BOOST_REQUIRE(cached != nullptr);
+	BOOST_REQUIRE_EQUAL(cached->callsign, expected.callsign);
+	BOOST_REQUIRE_EQUAL(cache.statistics().hits, 1U);
+	BOOST_REQUIRE_EQUAL(cache.statistics().misses, 1U);
+	BOOST_REQUIRE_CLOSE(cache.statistics().hitRate(), 0.5, 0.001);
+
+	// Changed payload for the same vessel is decoded again
+	AISStaticAndVoyageRelatedData changed = expected;
+	changed.destination = "CALLAO";
+	std::string changedPayload;
+	int fillBits;
+	BOOST_REQUIRE(
+			AISEncoder::encodeAISStaticAndVoyageRelatedData(changed,
+					changedPayload, fillBits));
+	cached = cache.parseAISStaticAndVoyageRelatedData(changedPayload);
+	BOOST_REQUIRE(cached != nullptr);
+	BOOST_REQUIRE_EQUAL(cached->destination, "CALLAO");
+	BOOST_REQUIRE_EQUAL(cache.statistics().misses, 2U);
+	BOOST_REQUIRE_EQUAL(cache.size(), 1U);
+
+	// Third vessel in a cache of two evicts one
+	for (uint mmsi = 1; mmsi <= 2; ++mmsi)
+	{
+		changed.mmsi = 200000000 + mmsi;
+		BOOST_REQUIRE(
+				AISEncoder::encodeAISStaticAndVoyageRelatedData(changed,
+						changedPayload, fillBits));
+		BOOST_REQUIRE(cache.parseAISStaticAndVoyageRelatedData(changedPayload));
+	}
+	BOOST_REQUIRE_EQUAL(cache.size(), 2U);
+	BOOST_REQUIRE_EQUAL(cache.statistics().evictions, 1U);
+
+	BOOST_REQUIRE(cache.parseAISStaticAndVoyageRelatedData("5") == nullptr);
+
+	const std::string report = "H6K8C4Q<Dq<QF0l59F0pvs>2220";
+	AISStaticDataReport reportData;
+	BOOST_REQUIRE(cache.parseAISStaticDataReport(report, reportData));
+	BOOST_REQUIRE(cache.parseAISStaticDataReport(report, reportData));
+	BOOST_REQUIRE_EQUAL(cache.statistics().hits, 2U);
+	BOOST_REQUIRE_EQUAL(cache.size(), 3U);
+
+	cache.clear();
+	BOOST_REQUIRE_EQUAL(cache.size(), 0U);
+
+	// A cache of no vessels still keeps one
+	AISStaticDataCache single(0);
+	BOOST_REQUIRE_EQUAL(single.capacity(), 1U);
+	BOOST_REQUIRE(single.parseAISStaticAndVoyageRelatedData(payload));
+	BOOST_REQUIRE(single.parseAISStaticAndVoyageRelatedData(changedPayload));
+	BOOST_REQUIRE_EQUAL(single.size(), 1U);
+	BOOST_REQUIRE_EQUAL(single.statistics().evictions, 1U);
+}
+
+BOOST_AUTO_TEST_CASE( duplicateFilter ) {
+
+	AISDuplicateFilter filter(1000, 10000, 0.001);
+	BOOST_REQUIRE(filter.bits() >= 143776U);
+	BOOST_REQUIRE(filter.hashCount() >= 1U);
+
+	const std::string payload = "3;DjhdPP@3JNfEIq6uHjlUCp00w1";
+	BOOST_REQUIRE(!filter.isDuplicate(payload, 0));
+	BOOST_REQUIRE(filter.isDuplicate(payload, 100));
+	BOOST_REQUIRE(!filter.isDuplicate("B;Djf2h01fWd0qNAh;M0cwb7kP06", 200));
+
+	// Remembered through the next generation, forgotten after two windows
+	BOOST_REQUIRE(filter.isDuplicate(payload, 1500));
+	BOOST_REQUIRE(!filter.isDuplicate(payload, 4000));
+
+	// Distinct payloads within the expected count stay near the target rate
+	AISPositionReportClassA data;
+	BOOST_REQUIRE(NmeaParser::parseAISPositionReportClassA(payload, data));
+	std::string encoded;
+	int fillBits;
+	uint falsePositives = 0;
+	filter.clear();
+	filter.resetStatistics();
+	for (uint i = 0; i < 10000; ++i)
+	{
+		data.mmsi = 200000000 + i;
+		AISEncoder::encodeAISPositionReportClassA(data,
+				Nmea_AisMessageType_PositionReportClassA, encoded, fillBits);
+		if (filter.isDuplicate(encoded, 5000))
+		{
+			++falsePositives;
+		}
+		BOOST_REQUIRE(filter.isDuplicate(encoded, 5001));
+	}
+	BOOST_REQUIRE(falsePositives < 50);
+	BOOST_REQUIRE(filter.falsePositiveRate() < 0.005);
+	BOOST_REQUIRE_EQUAL(filter.statistics().messages, 20000U);
+	BOOST_REQUIRE_CLOSE(filter.statistics().duplicateRatio(),
+			(10000.0 + falsePositives) / 20000.0, 0.001);
+}
+
+BOOST_AUTO_TEST_CASE( fixedString ) {
+
+	BOOST_REQUIRE(std::is_trivially_copyable<AISStaticAndVoyageRelatedData>::value);
+	BOOST_REQUIRE(std::is_trivially_copyable<AISStaticDataReport>::value);
+	BOOST_REQUIRE(std::is_trivially_copyable<AISAidToNavigationReport>::value);
+
+	AISFixedString<7> callsign("OA12345678");
+	BOOST_REQUIRE_EQUAL(callsign.size(), 7U);
+	BOOST_REQUIRE_EQUAL(callsign, "OA12345");
+	BOOST_REQUIRE_EQUAL(std::strlen(callsign.c_str()), 7U);
+
+	AISFixedString<20> name("  SEA BREEZE @@@@");
+	name.trimSixBit();
+	BOOST_REQUIRE_EQUAL(name, "SEA BREEZE ");
+	name.append("XYZXYZXYZXYZ", 12);
+	BOOST_REQUIRE_EQUAL(name.size(), 20U);
+	BOOST_REQUIRE(name != std::string("SEA BREEZE"));
+
+	AISFixedString<20> padding("@@@@");
+	padding.trimSixBit();
+	BOOST_REQUIRE(padding.empty());
+
+	// Formatted like the std::string fields it replaced
+	std::ostringstream out;
+	out << '[' << std::setw(6) << std::left << AISFixedString<7>("AB") << ']'
+			<< 7;
+	BOOST_REQUIRE_EQUAL(out.str(), "[AB    ]7");
+
+	BOOST_REQUIRE_EQUAL(aisSixBitToAscii(0), '@');
+	BOOST_REQUIRE_EQUAL(aisSixBitToAscii(1), 'A');
+	BOOST_REQUIRE_EQUAL(aisSixBitToAscii(32), ' ');
+	BOOST_REQUIRE_EQUAL(aisSixBitToAscii(63), '?');
+}
+
+BOOST_AUTO_TEST_CASE( stringPool ) {
+
+	AISStringPool pool(1000, 16384);
+	BOOST_REQUIRE_EQUAL(pool.size(), 1U);
+	BOOST_REQUIRE_EQUAL(pool.intern(""), 0U);
+
+	AISStaticAndVoyageRelatedData data;
+	BOOST_REQUIRE(
+			NmeaParser::parseAISStaticAndVoyageRelatedData(
+					"58wt8Ui`g??r21`7S=:22058<v05Htp000000015>8OA;0skeQ8823mDm3kP00000000000",
+					data));
+
+	const uint destination = pool.intern(data.destination);
+	BOOST_REQUIRE(destination != AISStringPool::NPOS);
+	BOOST_REQUIRE(pool.get(destination) == boost::string_ref(data.destination));
+	BOOST_REQUIRE_EQUAL(pool.intern(std::string(data.destination.c_str())),
+			destination);
+	BOOST_REQUIRE_EQUAL(pool.find("ROTTERDAM"), AISStringPool::NPOS);
+
+	// A reader resolves handles while the writer keeps interning
+	const char* const ports[] = { "ROTTERDAM", "SINGAPORE", "CALLAO",
+			"SHANGHAI", "HAMBURG" };
+	std::atomic<bool> done(false);
+	std::atomic<uint> mismatches(0);
+	std::thread reader([&]()
+	{
+		while (!done.load())
+		{
+			const uint size = pool.size();
+			for (uint h = 0; h < size; ++h)
+			{
+				if (pool.get(h).size() > 20)
+				{
+					++mismatches;
+				}
+			}
+		}
+	});
+
+	for (uint vessel = 0; vessel < 10000; ++vessel)
+	{
+		const uint handle = pool.intern(ports[vessel % 5]);
+		BOOST_REQUIRE(handle != AISStringPool::NPOS);
+		BOOST_REQUIRE_EQUAL(pool.get(handle), ports[vessel % 5]);
+	}
+	done = true;
+	reader.join();
+
+	BOOST_REQUIRE_EQUAL(mismatches.load(), 0U);
+	BOOST_REQUIRE_EQUAL(pool.size(), 7U);
+	BOOST_REQUIRE_EQUAL(pool.textBytes(),
+			data.destination.size() + 9 + 9 + 6 + 8 + 7);
+
+	// Full pool
+	AISStringPool small(1, 4);
+	BOOST_REQUIRE_EQUAL(small.intern("ABCDE"), AISStringPool::NPOS);
+	BOOST_REQUIRE_EQUAL(small.intern("ABCD"), 1U);
+	BOOST_REQUIRE_EQUAL(small.intern("ABC"), AISStringPool::NPOS);
+	BOOST_REQUIRE(small.get(2).empty());
+
+	// Vessel table keeping text as handles, shared between vessels
+	BOOST_REQUIRE_LT(sizeof(AISVesselStaticHandles), sizeof(AISVesselStatic));
+	AISStringPool names(100, 1024);
+	AISVesselTable table(16, &names);
+	BOOST_REQUIRE(table.statics() == nullptr);
+	BOOST_REQUIRE(table.staticHandles() != nullptr);
+	BOOST_REQUIRE(table.update(data, 1000));
+	data.mmsi += 1;
+	data.vesselName = "OTHER SHIP";
+	BOOST_REQUIRE(table.update(data, 2000));
+	BOOST_REQUIRE(table.findStatic(data.mmsi) == nullptr);
+
+	const AISVesselStaticHandles* first = table.findStaticHandles(
+			data.mmsi - 1);
+	const AISVesselStaticHandles* second = table.findStaticHandles(
+			data.mmsi);
+	BOOST_REQUIRE(first != nullptr && second != nullptr);
+	BOOST_REQUIRE_EQUAL(first->destination, second->destination);
+	BOOST_REQUIRE(
+			names.get(second->destination)
+					== boost::string_ref(data.destination));
+	BOOST_REQUIRE_EQUAL(names.get(second->vesselName), "OTHER SHIP");
+	BOOST_REQUIRE(first->vesselName != second->vesselName);
+	BOOST_REQUIRE_EQUAL(second->imoNumber, data.imoNumber);
+
+	AISStaticDataReport partB;
+	partB.mmsi = data.mmsi;
+	partB.partNumber = 1;
+	partB.partB.shipType = Nmea_ShipType_Sailing;
+	partB.partB.vendorId = "ABC";
+	partB.partB.callsign = "OA1234";
+	partB.partB.dimension = AISDimension();
+	BOOST_REQUIRE(table.update(partB, 3000));
+	BOOST_REQUIRE_EQUAL(names.get(second->vendorId), "ABC");
+	BOOST_REQUIRE_EQUAL(names.get(second->callsign), "OA1234");
+	BOOST_REQUIRE_EQUAL(second->shipType, Nmea_ShipType_Sailing);
+
+	// Full pool, other fields are still merged
+	AISVesselTable crowded(16, &small);
+	BOOST_REQUIRE(!crowded.update(partB, 4000));
+	second = crowded.findStaticHandles(partB.mmsi);
+	BOOST_REQUIRE(second != nullptr);
+	BOOST_REQUIRE_EQUAL(second->callsign, AISStringPool::NPOS);
+	BOOST_REQUIRE_EQUAL(second->shipType, Nmea_ShipType_Sailing);
+
+	BOOST_REQUIRE_EQUAL(table.expire(1500), 1U);
+	BOOST_REQUIRE(table.findStaticHandles(data.mmsi - 1) == nullptr);
+	BOOST_REQUIRE_EQUAL(table.size(), 1U);
+}
+
+BOOST_AUTO_TEST_CASE( spatialIndex ) {
+
+	const uint count = 5000;
+	AISSpatialIndex index(count, 1.0f);
+	std::vector<float> longitude(count);
+	std::vector<float> latitude(count);
+
+	uint seed = 12345;
+	for (uint i = 0; i < count; ++i)
+	{
+		seed = seed * 1103515245 + 12345;
+		longitude[i] = (seed >> 8) % 36000 / 100.0f - 180.0f;
+		seed = seed * 1103515245 + 12345;
+		latitude[i] = (seed >> 8) % 17000 / 100.0f - 85.0f;
+		BOOST_REQUIRE(index.update(200000000 + i, longitude[i], latitude[i]));
+	}
+	BOOST_REQUIRE_EQUAL(index.size(), count);
+
+	// Moving half the vessels keeps the index consistent
+	for (uint i = 0; i < count; i += 2)
+	{
+		longitude[i] = -longitude[i] * 0.5f;
+		BOOST_REQUIRE(index.update(200000000 + i, longitude[i], latitude[i]));
+	}
+	BOOST_REQUIRE(index.update(200000001, 181.0f, 91.0f));
+	BOOST_REQUIRE_EQUAL(index.size(), count - 1);
+
+	std::vector<uint> found;
+	const float boxes[][4] = { { -10.0f, 20.0f, 30.5f, 45.0f }, { 170.0f,
+			-20.0f, -170.0f, 20.0f }, { -180.0f, -90.0f, 180.0f, 90.0f } };
+	for (std::size_t b = 0; b < 3; ++b)
+	{
+		const float* box = boxes[b];
+		std::size_t expected = 0;
+		for (uint i = 0; i < count; ++i)
+		{
+			const bool inLongitude =
+					box[0] <= box[2] ?
+							longitude[i] >= box[0] && longitude[i] <= box[2] :
+							longitude[i] >= box[0] || longitude[i] <= box[2];
+			if (i != 1 && inLongitude && latitude[i] >= box[1]
+					&& latitude[i] <= box[3])
+			{
+				++expected;
+			}
+		}
+		BOOST_REQUIRE_EQUAL(
+				index.queryBox(box[0], box[1], box[2], box[3], found),
+				expected);
+	}
+
+	// Radius around Callao, against a brute force great circle check
+	float lon;
+	float lat;
+	BOOST_REQUIRE(index.find(200000002, lon, lat));
+	BOOST_REQUIRE_EQUAL(lon, longitude[2]);
+	const float radii[] = { 60.0f, 600.0f, 3000.0f };
+	for (std::size_t r = 0; r < 3; ++r)
+	{
+		std::size_t expected = 0;
+		for (uint i = 0; i < count; ++i)
+		{
+			const double rad = 3.14159265358979323846 / 180.0;
+			const double a = std::pow(std::sin((latitude[i] + 12.05) * rad / 2), 2)
+					+ std::cos(-12.05 * rad) * std::cos(latitude[i] * rad)
+							* std::pow(std::sin((longitude[i] + 77.15) * rad / 2), 2);
+			if (i != 1 && 2 * 3440.065 * std::asin(std::sqrt(a)) <= radii[r])
+			{
+				++expected;
+			}
+		}
+		BOOST_REQUIRE_EQUAL(index.queryRadius(-77.15f, -12.05f, radii[r], found),
+				expected);
+	}
+
+	BOOST_REQUIRE(index.erase(200000000));
+	BOOST_REQUIRE(!index.erase(200000000));
+	index.clear();
+	BOOST_REQUIRE_EQUAL(index.queryBox(-180.0f, -90.0f, 180.0f, 90.0f, found),
+			0U);
+}
+
+BOOST_AUTO_TEST_CASE( cpaEngine ) {
+
+	NmeaCpaEngine engine;
+	engine.setOwnShip(-77.0f, -12.0f, 10.0f, 0.0f, 0.0f);
+
+	// Head on, 6 NM ahead, closing at 20 knots
+	AISPositionReportClassA ahead;
+	ahead.longitude = -77.0f;
+	ahead.latitude = -11.9f;
+	ahead.speedOverGround = 10.0f;
+	ahead.courseOverGround = 180.0f;
+	BOOST_REQUIRE_EQUAL(engine.addTarget(ahead), 0U);
+
+	// TTM target abeam to starboard, 2 NM, same true motion as own ship
+	BOOST_REQUIRE_EQUAL(
+			engine.addTarget(2.0, 90.0, Nmea_AngleReference_Relative, 10.0,
+					0.0, Nmea_AngleReference_True,
+					Nmea_SpeedDistanceUnits_Knots_NauticalMiles), 1U);
+
+	// TTD target 5 NM east moving west relative to own ship at 10 knots
+	NmeaTrackData track;
+	track.distance = 5.0f;
+	track.trueBearing = 90.0f;
+	track.speed = 10.0f;
+	track.course = 270.0f;
+	track.speedMode = Nmea_SpeedMode_Relative;
+	BOOST_REQUIRE_EQUAL(engine.addTarget(track), 2U);
+
+	engine.compute();
+	BOOST_REQUIRE_EQUAL(engine.size(), 3U);
+	BOOST_REQUIRE_SMALL(engine.cpa()[0], 0.01f);
+	BOOST_REQUIRE_CLOSE(engine.tcpa()[0], 18.0f, 0.1f);
+	BOOST_REQUIRE_CLOSE(engine.cpa()[1], 2.0f, 0.01f);
+	BOOST_REQUIRE_EQUAL(engine.tcpa()[1], 0.0f);
+	BOOST_REQUIRE_SMALL(engine.cpa()[2], 0.01f);
+	BOOST_REQUIRE_CLOSE(engine.tcpa()[2], 30.0f, 0.1f);
+
+	// No position is not a target, no speed or course is unknown motion
+	AISStandardClassBCSPositionReport lost;
+	lost.longitude = 181.0f;
+	lost.latitude = 91.0f;
+	lost.speedOverGround = 5.0f;
+	lost.courseOverGround = 90.0f;
+	BOOST_REQUIRE_EQUAL(engine.addTarget(lost), NmeaCpaEngine::NPOS);
+	AISExtendedClassBCSPositionReport extended;
+	extended.longitude = 181.0f;
+	extended.latitude = 91.0f;
+	extended.speedOverGround = 5.0f;
+	extended.courseOverGround = 90.0f;
+	BOOST_REQUIRE_EQUAL(engine.addTarget(extended), NmeaCpaEngine::NPOS);
+	ahead.speedOverGround = 102.3f;
+	BOOST_REQUIRE_EQUAL(engine.addTarget(ahead), 3U);
+	ahead.speedOverGround = 10.0f;
+	ahead.courseOverGround = 360.0f;
+	BOOST_REQUIRE_EQUAL(engine.addTarget(ahead), 4U);
+	engine.compute();
+	BOOST_REQUIRE_EQUAL(engine.size(), 5U);
+	BOOST_REQUIRE_SMALL(engine.cpa()[0], 0.01f);
+	BOOST_REQUIRE(std::isnan(engine.cpa()[3]) && std::isnan(engine.tcpa()[3]));
+	BOOST_REQUIRE(std::isnan(engine.cpa()[4]) && std::isnan(engine.tcpa()[4]));
+
+	// Vectorized and scalar paths agree over many targets
+	engine.clear();
+	uint seed = 42;
+	for (uint i = 0; i < 1003; ++i)
+	{
+		seed = seed * 1103515245 + 12345;
+		const float dLon = ((seed >> 8) % 2000) / 10000.0f - 0.1f;
+		seed = seed * 1103515245 + 12345;
+		const float dLat = ((seed >> 8) % 2000) / 10000.0f - 0.1f;
+		engine.addTarget(-77.0f + dLon, -12.0f + dLat, (i % 25) * 1.0f,
+				(i * 37) % 360);
+	}
+	engine.compute(false);
+	const std::vector<float> cpa(engine.cpa(), engine.cpa() + engine.size());
+	const std::vector<float> tcpa(engine.tcpa(), engine.tcpa() + engine.size());
+	engine.compute(true);
+	for (std::size_t i = 0; i < engine.size(); ++i)
+	{
+		BOOST_REQUIRE_CLOSE(engine.cpa()[i], cpa[i], 0.001f);
+		BOOST_REQUIRE_CLOSE(engine.tcpa()[i], tcpa[i], 0.001f);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( geofence ) {
+
+	AISGeofence geofence(100);
+
+	// Callao anchorage, a concave L shape, and an exclusion box inside it
+	std::vector<AISGeofenceVertex> anchorage = { { -77.30f, -12.10f }, {
+			-77.10f, -12.10f }, { -77.10f, -12.00f }, { -77.20f, -12.00f }, {
+			-77.20f, -11.90f }, { -77.30f, -11.90f } };
+	std::vector<AISGeofenceVertex> exclusion = { { -77.28f, -12.08f }, {
+			-77.25f, -12.08f }, { -77.25f, -12.05f }, { -77.28f, -12.05f } };
+	BOOST_REQUIRE_EQUAL(geofence.addZone(anchorage), 0U);
+	BOOST_REQUIRE_EQUAL(geofence.addZone(exclusion), 1U);
+	BOOST_REQUIRE_EQUAL(geofence.addZone(std::vector<AISGeofenceVertex>(2)),
+			AISMmsiMap::NPOS);
+	BOOST_REQUIRE_EQUAL(geofence.zoneCount(), 2U);
+
+	BOOST_REQUIRE(geofence.contains(0, -77.25f, -11.95f));
+	BOOST_REQUIRE(!geofence.contains(0, -77.15f, -11.95f));
+
+	std::vector<AISGeofenceEvent> events;
+	AISPositionReportClassA data;
+	data.mmsi = 760000001;
+	data.longitude = -77.40f;
+	data.latitude = -12.06f;
+	BOOST_REQUIRE_EQUAL(geofence.update(data, 1000, events), 0U);
+
+	// Into the anchorage and the exclusion box at once
+	data.longitude = -77.26f;
+	BOOST_REQUIRE_EQUAL(geofence.update(data, 2000, events), 2U);
+	BOOST_REQUIRE_EQUAL(events[0].zone, 0U);
+	BOOST_REQUIRE(events[0].entered);
+	BOOST_REQUIRE_EQUAL(events[1].zone, 1U);
+	BOOST_REQUIRE_EQUAL(events[1].mmsi, 760000001U);
+	BOOST_REQUIRE_EQUAL(events[1].timestamp, 2000);
+	BOOST_REQUIRE_EQUAL(geofence.zonesOf(760000001).size(), 2U);
+
+	// Still inside, no events
+	data.longitude = -77.27f;
+	BOOST_REQUIRE_EQUAL(geofence.update(data, 3000, events), 0U);
+
+	// Out of the exclusion box only
+	data.longitude = -77.15f;
+	BOOST_REQUIRE_EQUAL(geofence.update(data, 4000, events), 1U);
+	BOOST_REQUIRE_EQUAL(events[2].zone, 1U);
+	BOOST_REQUIRE(!events[2].entered);
+
+	// Into the notch of the L: out of the anchorage
+	data.latitude = -11.95f;
+	BOOST_REQUIRE_EQUAL(geofence.update(data, 5000, events), 1U);
+	BOOST_REQUIRE_EQUAL(events[3].zone, 0U);
+	BOOST_REQUIRE(!events[3].entered);
+	BOOST_REQUIRE(geofence.zonesOf(760000001).empty());
+
+	// Not available position is ignored
+	data.longitude = 181.0f;
+	data.latitude = 91.0f;
+	BOOST_REQUIRE_EQUAL(geofence.update(data, 6000, events), 0U);
+
+	// Extended Class B report into the anchorage
+	AISExtendedClassBCSPositionReport extended;
+	extended.mmsi = 760000002;
+	extended.longitude = -77.15f;
+	extended.latitude = -12.05f;
+	BOOST_REQUIRE_EQUAL(geofence.update(extended, 7000, events), 1U);
+	BOOST_REQUIRE_EQUAL(events[4].mmsi, 760000002U);
+	BOOST_REQUIRE_EQUAL(events[4].zone, 0U);
+	BOOST_REQUIRE(events[4].entered);
+
+	BOOST_REQUIRE(geofence.erase(760000001));
+	BOOST_REQUIRE(!geofence.erase(760000001));
+}
+
+BOOST_AUTO_TEST_CASE( trackHistory ) {
+	AISTrackHistory history(10, 4);
+	BOOST_REQUIRE_EQUAL(sizeof(AISTrackPoint), 16U);
+	BOOST_REQUIRE_EQUAL(history.memoryUsage(), 10U * (4U * 16U + 16U));
+
+	AISPositionReportClassA data;
+	data.mmsi = 760000001;
+	data.latitude = -12.05f;
+	data.speedOverGround = 12.3f;
+	data.courseOverGround = 245.6f;
+	for (int i = 0; i < 6; ++i)
+	{
+		data.longitude = -77.20f + i * 0.01f;
+		BOOST_REQUIRE(history.append(data, 1000 + i * 10000));
+	}
+
+	// Ring of 4: the two oldest points are overwritten
+	std::vector<AISTrackPosition> track;
+	BOOST_REQUIRE_EQUAL(history.track(760000001, track), 4U);
+	BOOST_REQUIRE_EQUAL(track[0].timestamp, 21000);
+	BOOST_REQUIRE_EQUAL(track[3].timestamp, 51000);
+	BOOST_REQUIRE_CLOSE(track[0].longitude, -77.18f, 1e-4);
+	BOOST_REQUIRE_CLOSE(track[3].longitude, -77.15f, 1e-4);
+	BOOST_REQUIRE_CLOSE(track[3].latitude, -12.05f, 1e-4);
+	BOOST_REQUIRE_CLOSE(track[3].speedOverGround, 12.3f, 1e-4);
+	BOOST_REQUIRE_CLOSE(track[3].courseOverGround, 245.6f, 1e-4);
+
+	// Not available position is ignored
+	AISStandardClassBCSPositionReport classB;
+	classB.mmsi = 760000002;
+	classB.longitude = 181.0f;
+	classB.latitude = 91.0f;
+	classB.speedOverGround = 0;
+	classB.courseOverGround = 0;
+	BOOST_REQUIRE(!history.append(classB, 0));
+	BOOST_REQUIRE_EQUAL(history.trackSize(760000002), 0U);
+
+	// Points too old for a 32 bit delta from the new one are dropped
+	classB.longitude = -77.10f;
+	classB.latitude = -12.00f;
+	BOOST_REQUIRE(history.append(classB, 1000));
+	BOOST_REQUIRE(history.append(classB, 2000));
+	BOOST_REQUIRE(history.append(classB, 4294968500LL));
+	BOOST_REQUIRE_EQUAL(history.track(760000002, track), 2U);
+	BOOST_REQUIRE_EQUAL(track[0].timestamp, 2000);
+	BOOST_REQUIRE_EQUAL(track[1].timestamp, 4294968500LL);
+	BOOST_REQUIRE(history.append(classB, 4296000000LL));
+	BOOST_REQUIRE_EQUAL(history.track(760000002, track), 2U);
+	BOOST_REQUIRE_EQUAL(track[0].timestamp, 4294968500LL);
+	BOOST_REQUIRE_EQUAL(track[1].timestamp, 4296000000LL);
+
+	BOOST_REQUIRE_EQUAL(history.size(), 2U);
+	BOOST_REQUIRE(history.erase(760000001));
+	BOOST_REQUIRE_EQUAL(history.trackSize(760000001), 0U);
+	BOOST_REQUIRE_EQUAL(history.size(), 1U);
+}
+
+BOOST_AUTO_TEST_CASE( trajectoryCompressor ) {
+	AISTrajectoryCompressor compressor(10, 0.01f, 600000);
+
+	// Steady 10 knots north, one report every 10 s
+	AISPositionReportClassA data;
+	data.mmsi = 760000001;
+	data.longitude = -77.20f;
+	data.latitude = -12.10f;
+	data.speedOverGround = 10.0f;
+	data.courseOverGround = 0.0f;
+	const float step = 10.0f / 360.0f / 60.0f;
+	BOOST_REQUIRE(compressor.update(data, 0));
+	for (int i = 1; i <= 30; ++i)
+	{
+		data.latitude = -12.10f + i * step;
+		BOOST_REQUIRE(!compressor.update(data, i * 10000));
+	}
+	BOOST_REQUIRE_EQUAL(compressor.statistics().kept, 1U);
+	BOOST_REQUIRE_LT(compressor.statistics().maxError, 0.01f);
+
+	// Turn to the east: the first report off the predicted track is kept
+	data.courseOverGround = 90.0f;
+	const float east = step / std::cos(data.latitude * 3.14159265f / 180.0f);
+	data.longitude += east;
+	BOOST_REQUIRE(compressor.update(data, 310000));
+	data.longitude += east;
+	BOOST_REQUIRE(!compressor.update(data, 320000));
+	BOOST_REQUIRE_EQUAL(compressor.statistics().kept, 2U);
+
+	// Keep one position every 10 minutes even without deviation
+	data.longitude += east * 60.0f;
+	BOOST_REQUIRE(compressor.update(data, 310000 + 600000));
+
+	// Not available position is ignored, not available speed predicts stopped
+	AISStandardClassBCSPositionReport classB;
+	classB.mmsi = 760000002;
+	classB.longitude = 181.0f;
+	classB.latitude = 91.0f;
+	classB.speedOverGround = 102.3f;
+	classB.courseOverGround = 360.0f;
+	BOOST_REQUIRE(!compressor.update(classB, 0));
+	classB.longitude = -77.10f;
+	classB.latitude = -12.00f;
+	BOOST_REQUIRE(compressor.update(classB, 0));
+	BOOST_REQUIRE(!compressor.update(classB, 60000));
+	classB.latitude += 0.001f;
+	BOOST_REQUIRE(compressor.update(classB, 70000));
+
+	BOOST_REQUIRE_EQUAL(compressor.size(), 2U);
+	BOOST_REQUIRE_EQUAL(compressor.statistics().points, 37U);
+	BOOST_REQUIRE_CLOSE(compressor.statistics().compressionRatio(), 37.0 / 5.0,
+			1e-6);
+	BOOST_REQUIRE(compressor.erase(760000002));
+	BOOST_REQUIRE(compressor.update(classB, 80000));
+
+	// Extended Class B reports go through the same prediction
+	AISExtendedClassBCSPositionReport extended;
+	extended.mmsi = 760000003;
+	extended.longitude = -77.30f;
+	extended.latitude = -12.20f;
+	extended.speedOverGround = 0.0f;
+	extended.courseOverGround = 0.0f;
+	BOOST_REQUIRE(compressor.update(extended, 0));
+	BOOST_REQUIRE(!compressor.update(extended, 10000));
+	BOOST_REQUIRE_EQUAL(compressor.size(), 3U);
+}
+
+BOOST_AUTO_TEST_CASE( archive ) {
+	const std::string path = "test.libNmeaParser.archive";
+	std::remove(path.c_str());
+
+	// Blocks of 4 reports, 1 hour partitions
+	AISArchiveWriter writer(4, 3600000);
+	BOOST_REQUIRE(writer.open(path));
+
+	AISPositionReportClassA data;
+	data.speedOverGround = 12.3f;
+	data.courseOverGround = 245.6f;
+	data.trueHeading = 511;
+	for (int i = 0; i < 3; ++i)
+	{
+		data.mmsi = 760000003 - i;
+		data.longitude = -77.20f + i * 0.01f;
+		data.latitude = -12.05f;
+		BOOST_REQUIRE(writer.append(data, 1000 + i));
+	}
+
+	// A report of the next hour closes the first block
+	AISStandardClassBCSPositionReport classB;
+	classB.mmsi = 760000010;
+	classB.longitude = 4.0f;
+	classB.latitude = 52.0f;
+	classB.speedOverGround = 0.0f;
+	classB.courseOverGround = 360.0f;
+	classB.trueHeading = 90;
+	for (int i = 0; i < 5; ++i)
+	{
+		BOOST_REQUIRE(writer.append(classB, 3600000 + i * 10000));
+		classB.latitude += 0.001f;
+	}
+	BOOST_REQUIRE_EQUAL(writer.blocks(), 2U);
+	BOOST_REQUIRE(writer.close());
+	BOOST_REQUIRE_EQUAL(writer.records(), 8U);
+
+	// Reopening appends
+	BOOST_REQUIRE(writer.open(path));
+	classB.mmsi = 760000011;
+	BOOST_REQUIRE(writer.append(classB, 7200000));
+	BOOST_REQUIRE(writer.close());
+
+	// A torn block at the end is ignored
+	std::FILE* f = std::fopen(path.c_str(), "ab");
+	BOOST_REQUIRE(f != nullptr);
+	const char torn[20] = "ABLK";
+	std::fwrite(torn, sizeof(torn), 1, f);
+	std::fclose(f);
+
+	AISArchiveReader reader;
+	BOOST_REQUIRE(reader.open(path));
+	BOOST_REQUIRE_EQUAL(reader.blockCount(), 4U);
+	BOOST_REQUIRE_EQUAL(reader.records(), 9U);
+	BOOST_REQUIRE_EQUAL(reader.blockInfo(0).records, 3U);
+	BOOST_REQUIRE_EQUAL(reader.blockInfo(0).minTimestamp, 1000);
+	BOOST_REQUIRE_EQUAL(reader.blockInfo(0).maxTimestamp, 1002);
+	BOOST_REQUIRE_EQUAL(reader.blockInfo(0).minMmsi, 760000001U);
+	BOOST_REQUIRE_CLOSE(reader.blockInfo(0).maxSpeedOverGround, 12.3f, 1e-4);
+
+	// Rows of a block are sorted by MMSI
+	std::vector<AISArchiveRecord> records;
+	BOOST_REQUIRE(reader.readBlock(0, records));
+	BOOST_REQUIRE_EQUAL(records.size(), 3U);
+	BOOST_REQUIRE_EQUAL(records[0].mmsi, 760000001U);
+	BOOST_REQUIRE_EQUAL(records[0].timestamp, 1002);
+	BOOST_REQUIRE_CLOSE(records[0].longitude, -77.18f, 1e-4);
+	BOOST_REQUIRE_CLOSE(records[0].latitude, -12.05f, 1e-4);
+	BOOST_REQUIRE_CLOSE(records[0].speedOverGround, 12.3f, 1e-4);
+	BOOST_REQUIRE_CLOSE(records[0].courseOverGround, 245.6f, 1e-4);
+	BOOST_REQUIRE_EQUAL(records[0].trueHeading, 511U);
+
+	// Area and time range, vectorized or not
+	for (int vectorized = 0; vectorized < 2; ++vectorized)
+	{
+		records.clear();
+		BOOST_REQUIRE_EQUAL(
+				reader.scan(3600000, 3620001, 3.9f, 51.9f, 4.1f, 52.1f, records,
+						vectorized != 0), 3U);
+		BOOST_REQUIRE_EQUAL(records[0].mmsi, 760000010U);
+		BOOST_REQUIRE_EQUAL(records[2].timestamp, 3620000);
+		BOOST_REQUIRE_EQUAL(records[2].trueHeading, 90U);
+		BOOST_REQUIRE_EQUAL(records[2].courseOverGround, 360.0f);
+	}
+	records.clear();
+	BOOST_REQUIRE_EQUAL(
+			reader.scan(0, 10000000, -77.195f, -13.0f, -77.0f, -12.0f, records),
+			2U);
+
+	// One vessel across blocks
+	records.clear();
+	BOOST_REQUIRE_EQUAL(reader.scan(760000010, 0, 10000000, records), 5U);
+	BOOST_REQUIRE_EQUAL(records[4].timestamp, 3640000);
+	records.clear();
+	BOOST_REQUIRE_EQUAL(reader.scan(760000011, 0, 10000000, records), 1U);
+	BOOST_REQUIRE_CLOSE(records[0].latitude, 52.005f, 1e-4);
+	reader.close();
+
+	// Reopening cuts the torn block, the blocks appended after it are read
+	BOOST_REQUIRE(writer.open(path));
+	classB.mmsi = 760000012;
+	BOOST_REQUIRE(writer.append(classB, 10800000));
+	BOOST_REQUIRE(writer.close());
+	BOOST_REQUIRE(reader.open(path));
+	BOOST_REQUIRE_EQUAL(reader.blockCount(), 5U);
+	BOOST_REQUIRE_EQUAL(reader.records(), 10U);
+	records.clear();
+	BOOST_REQUIRE_EQUAL(reader.scan(760000012, 0, 20000000, records), 1U);
+	BOOST_REQUIRE_EQUAL(records[0].timestamp, 10800000);
+
+	reader.close();
+	std::remove(path.c_str());
+	BOOST_REQUIRE(!reader.open(path));
+}
+
+BOOST_AUTO_TEST_CASE( logIndex ) {
+	const std::string logPath = "test.libNmeaParser.log";
+	const std::string indexPath = "test.libNmeaParser.log.idx";
+
+	AISPositionReportClassA data = AISPositionReportClassA();
+	data.speedOverGround = 10.0f;
+	data.longitude = -77.2f;
+	data.latitude = -12.05f;
+	data.trueHeading = 511;
+
+	std::string log = "$GPZDA,160012.71,11,03,2004,-1,00*7D\r\n";
+	for (int i = 0; i < 6; ++i)
+	{
+		data.mmsi = 760000001 + i % 2;
+		std::string encodedData;
+		int fillBits;
+		BOOST_REQUIRE(
+				AISEncoder::encodeAISPositionReportClassA(data,
+						Nmea_AisMessageType_PositionReportClassA, encodedData,
+						fillBits));
+		char buffer[128];
+		const std::size_t length = AISEncoder::writeVDM(buffer,
+				sizeof(buffer), "AI", 0, 'A', encodedData, fillBits);
+		if (i == 2)
+		{
+			log += "\\s:rcv1,c:1700000000*5D\\";
+		}
+		log.append(buffer, length);
+	}
+
+	// Type 5 of the first vessel, two fragments
+	const std::string voyage =
+			"!AIVDM,2,1,3,A,58wt8Ui`g??r21`7S=:22058<v05Htp000000015>8OA;0skeQ8823mDm3kP,0*1A\r\n"
+			"!AIVDM,2,2,3,A,00000000000,2*23\r\n";
+	log += voyage;
+	std::FILE* f = std::fopen(logPath.c_str(), "wb");
+	BOOST_REQUIRE(f != nullptr);
+	std::fwrite(log.data(), log.size(), 1, f);
+	std::fclose(f);
+
+	const uint voyageMmsi = AISMessageView("58wt8Ui`g??r").mmsi();
+	BOOST_REQUIRE(AISLogIndex::build(logPath, indexPath, 100));
+
+	AISLogIndex index;
+	BOOST_REQUIRE(index.open(indexPath));
+	BOOST_REQUIRE_EQUAL(index.logSize(), log.size());
+	BOOST_REQUIRE_EQUAL(index.mmsiCount(), 3U);
+
+	std::vector<AISLogIndexEntry> entries;
+	BOOST_REQUIRE_EQUAL(index.find(760000001, entries), 3U);
+	BOOST_REQUIRE_EQUAL(entries[0].messageType,
+			Nmea_AisMessageType_PositionReportClassA);
+	BOOST_REQUIRE_LT(entries[0].offset, entries[1].offset);
+	BOOST_REQUIRE_EQUAL(index.find(123456789, entries), 0U);
+
+	// Only the matching sentences are read, TAG blocks and fragments included
+	NmeaMappedFile mapped;
+	BOOST_REQUIRE(mapped.open(logPath));
+	std::vector<boost::string_ref> messages;
+	BOOST_REQUIRE_EQUAL(index.messages(760000001, mapped, messages), 3U);
+	BOOST_REQUIRE(messages[1].starts_with("\\s:rcv1"));
+	BOOST_REQUIRE_EQUAL(index.messages(voyageMmsi, mapped, messages), 1U);
+	BOOST_REQUIRE(messages[3] == voyage);
+
+	int totalLines;
+	int lineCount;
+	int sequenceIdentifier;
+	char aisChannel;
+	std::string encodedData;
+	int fillBits;
+	boost::string_ref line;
+	mapped.line(entries[2].offset, line);
+	BOOST_REQUIRE_EQUAL(
+			NmeaParser::parseVDM(line.to_string(), totalLines, lineCount,
+					sequenceIdentifier, aisChannel, encodedData, fillBits), 0UL);
+	BOOST_REQUIRE_EQUAL(AISMessageView(encodedData).mmsi(), 760000001U);
+
+	// Blocks of about 100 bytes, each with its own Bloom filter
+	BOOST_REQUIRE_GT(index.blockCount(), 3U);
+	BOOST_REQUIRE_EQUAL(index.blockOffset(0), 0U);
+	BOOST_REQUIRE_EQUAL(
+			index.blockOffset(index.blockCount() - 1)
+					+ index.blockLength(index.blockCount() - 1), log.size());
+	std::vector<std::size_t> blocks;
+	std::vector<uint> fleet(1, voyageMmsi);
+	BOOST_REQUIRE_GE(index.candidateBlocks(fleet, blocks), 1U);
+	BOOST_REQUIRE(index.mayContain(blocks.back(), voyageMmsi));
+	BOOST_REQUIRE(!index.mayContain(0, voyageMmsi));
+
+	mapped.close();
+	index.close();
+	std::remove(logPath.c_str());
+	std::remove(indexPath.c_str());
+}
+
+BOOST_AUTO_TEST_CASE( timeExtractor ) {
+	NmeaTimeExtractor extractor;
+	int64_t timestamp;
+
+	// No date yet, GGA alone has no time
+	BOOST_REQUIRE(
+			!extractor.extract(
+					"$GPGGA,123520,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*4D",
+					timestamp));
+	BOOST_REQUIRE(!extractor.hasDate());
+
+	BOOST_REQUIRE(
+			extractor.extract("$GPZDA,160012.71,11,03,2004,-1,00*7D", timestamp));
+	BOOST_REQUIRE_EQUAL(timestamp, 1079020812710LL);
+
+	BOOST_REQUIRE(
+			extractor.extract(
+					"$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A",
+					timestamp));
+	BOOST_REQUIRE_EQUAL(timestamp, 764426119000LL);
+	BOOST_REQUIRE(
+			extractor.extract(
+					"$GPGGA,123520,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*4D",
+					timestamp));
+	BOOST_REQUIRE_EQUAL(timestamp, 764426120000LL);
+
+	// GGA after midnight rolls the carried date over
+	BOOST_REQUIRE(
+			extractor.extract("$GPZDA,235958,31,12,2023,00,00*4A", timestamp));
+	BOOST_REQUIRE_EQUAL(timestamp, 1704067198000LL);
+	BOOST_REQUIRE(
+			extractor.extract(
+					"$GPGGA,000005,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*4F",
+					timestamp));
+	BOOST_REQUIRE_EQUAL(timestamp, 1704067205000LL);
+
+	// TAG block time wins, in seconds or milliseconds
+	BOOST_REQUIRE(
+			extractor.extract(
+					"\\s:rcv1,c:1700000000*6C\\!AIVDM,1,1,,A,13u?etPv2;0n:dDPwUM1U1Cb069D,0*23",
+					timestamp));
+	BOOST_REQUIRE_EQUAL(timestamp, 1700000000000LL);
+	BOOST_REQUIRE(
+			extractor.extract("\\c:1700000000123*6F\\$GPZDA,235958,31,12,2023,00,00*4A",
+					timestamp));
+	BOOST_REQUIRE_EQUAL(timestamp, 1700000000123LL);
+
+	// Bad checksum and sentences without time
+	BOOST_REQUIRE(
+			!extractor.extract("$GPZDA,235958,31,12,2023,00,00*4B", timestamp));
+	BOOST_REQUIRE(
+			!extractor.extract("!AIVDM,1,1,,A,13u?etPv2;0n:dDPwUM1U1Cb069D,0*23",
+					timestamp));
+	BOOST_REQUIRE_EQUAL(extractor.reference(), 1700000000123LL);
+
+	// The sentence starts after the receive time, TAG blocks are kept
+	BOOST_REQUIRE_EQUAL(
+			NmeaTimeExtractor::sentence("1461168010.5;\t$HEHDT,274.07,T*03"),
+			"$HEHDT,274.07,T*03");
+	BOOST_REQUIRE_EQUAL(
+			NmeaTimeExtractor::sentence("\\c:1700000000*6C\\$HEHDT,274.07,T*03"),
+			"\\c:1700000000*6C\\$HEHDT,274.07,T*03");
+	BOOST_REQUIRE_EQUAL(NmeaTimeExtractor::sentence("123 $HEHDT,274.07,T*03"),
+			"123 $HEHDT,274.07,T*03");
+
+	extractor.reset();
+	BOOST_REQUIRE(!extractor.hasDate());
+}
+
+BOOST_AUTO_TEST_CASE( timeIndex ) {
+	const std::string logPath = "test.libNmeaParser.time.log";
+	const std::string indexPath = "test.libNmeaParser.time.idx";
+
+	// One ZDA then a GGA every 10 s for two hours, 2016-04-20 from 16:00
+	const int64_t start = 1461168000000LL;
+	char buffer[NmeaWriter::maxSentenceSize];
+	std::string log;
+	std::vector<uint64_t> offsets;
+	log.append(buffer,
+			NmeaWriter::writeZDA(buffer, sizeof(buffer), "GP",
+					boost::posix_time::time_duration(16, 0, 0), 20, 4, 2016, 0,
+					0));
+	for (int i = 1; i < 720; ++i)
+	{
+		offsets.push_back(log.size());
+		log.append(buffer,
+				NmeaWriter::writeGGA(buffer, sizeof(buffer), "GP",
+						boost::posix_time::time_duration(16, 0, i * 10),
+						-12.0422, -77.1424,
+						Nmea_GPSQualityIndicator_GPSFixDifferential, 9, 0.9,
+						24.9, 10.6, 0.0, ""));
+		log += "!AIVDM,1,1,,A,13u?etPv2;0n:dDPwUM1U1Cb069D,0*23\r\n";
+	}
+	const std::size_t half = offsets[359];
+
+	// Logger still writing, the last line is not complete
+	std::FILE* f = std::fopen(logPath.c_str(), "wb");
+	BOOST_REQUIRE(f != nullptr);
+	std::fwrite(log.data(), half + 10, 1, f);
+	std::fflush(f);
+
+	NmeaMappedFile mapped;
+	BOOST_REQUIRE(mapped.open(logPath));
+	NmeaTimeIndex index(60000);
+	BOOST_REQUIRE_EQUAL(index.update(mapped), 60U);
+	BOOST_REQUIRE_EQUAL(index.indexedSize(), half);
+	BOOST_REQUIRE_EQUAL(index.entries()[0].offset, 0U);
+	BOOST_REQUIRE_EQUAL(index.entries()[0].timestamp, start);
+	BOOST_REQUIRE_EQUAL(index.entries()[1].offset, offsets[5]);
+	BOOST_REQUIRE_EQUAL(index.entries()[1].timestamp, start + 60000);
+
+	std::fwrite(log.data() + half + 10, log.size() - half - 10, 1, f);
+	std::fclose(f);
+	BOOST_REQUIRE(mapped.refresh());
+	BOOST_REQUIRE_EQUAL(mapped.size(), log.size());
+	BOOST_REQUIRE_EQUAL(index.update(mapped), 60U);
+	BOOST_REQUIRE_EQUAL(index.update(mapped), 0U);
+	BOOST_REQUIRE_EQUAL(index.indexedSize(), log.size());
+
+	// Between index points and on a point
+	BOOST_REQUIRE_EQUAL(index.seek(mapped, start + 4321000), offsets[432]);
+	BOOST_REQUIRE_EQUAL(index.seek(mapped, start + 4320000), offsets[431]);
+	BOOST_REQUIRE_EQUAL(index.seek(mapped, start + 3600000), offsets[359]);
+	BOOST_REQUIRE_EQUAL(index.seek(mapped, start - 1000), 0U);
+	BOOST_REQUIRE_EQUAL(index.seek(mapped, start + 7200000), log.size());
+
+	BOOST_REQUIRE(index.save(indexPath));
+	NmeaTimeIndex loaded;
+	BOOST_REQUIRE(loaded.load(indexPath));
+	BOOST_REQUIRE_EQUAL(loaded.entries().size(), 120U);
+	BOOST_REQUIRE_EQUAL(loaded.indexedSize(), log.size());
+	BOOST_REQUIRE_EQUAL(loaded.seek(mapped, start + 4321000), offsets[432]);
+	BOOST_REQUIRE_EQUAL(loaded.update(mapped), 0U);
+	BOOST_REQUIRE(!loaded.load(logPath));
+
+	// A count larger than the file is rejected before allocating, the index is kept
+	std::FILE* corrupt = std::fopen(indexPath.c_str(), "r+b");
+	BOOST_REQUIRE(corrupt != nullptr);
+	const uint64_t count = 1ULL << 60;
+	BOOST_REQUIRE_EQUAL(std::fseek(corrupt, 40, SEEK_SET), 0);
+	BOOST_REQUIRE_EQUAL(std::fwrite(&count, sizeof(count), 1, corrupt), 1U);
+	std::fclose(corrupt);
+	BOOST_REQUIRE(!loaded.load(indexPath));
+	BOOST_REQUIRE_EQUAL(loaded.entries().size(), 120U);
+
+	mapped.close();
+	std::remove(logPath.c_str());
+	std::remove(indexPath.c_str());
+}
+
+BOOST_AUTO_TEST_CASE( logMerger ) {
+	const std::string paths[] = { "test.libNmeaParser.gps.log",
+			"test.libNmeaParser.ais.log", "test.libNmeaParser.wind.log" };
+	const int64_t start = 1461168000000LL;
+	const std::string ais = "!AIVDM,1,1,,A,13u?etPv2;0n:dDPwUM1U1Cb069D,0*23";
+	char buffer[NmeaWriter::maxSentenceSize];
+
+	// GPS port: ZDA and GGA, preceded by a line without time
+	std::string logs[3];
+	logs[0] = ais + "\r\n$GPZDA,160000.00,20,04,2016,00,00*62\r\n";
+	for (int i = 1; i <= 2; ++i)
+	{
+		logs[0].append(buffer,
+				NmeaWriter::writeGGA(buffer, sizeof(buffer), "GP",
+						boost::posix_time::time_duration(16, 0, i * 10),
+						-12.0422, -77.1424,
+						Nmea_GPSQualityIndicator_GPSFixDifferential, 9, 0.9,
+						24.9, 10.6, 0.0, ""));
+		if (i == 1)
+		{
+			logs[0] += "$HEHDT,274.07,T\r\n\r\n";
+		}
+	}
+	// AIS port: TAG blocks
+	logs[1] = "\\c:1461168005*51\\" + ais + "\n\\c:1461168012*57\\" + ais
+			+ "\n\\c:1461168030*57\\" + ais + "\n";
+	// Wind port: receive times from the logger
+	logs[2] = "1461168000.000 $IIMWV,045.0,R,10.5,N,A*08\n"
+			"1461168010.5 $IIMWV,046.0,R,10.4,N,A*0A\n"
+			"1461168020 $IIMWV,047.0,R,10.6,N,A*09";
+
+	// Chunks smaller than the files to go through read ahead and release
+	NmeaLogMerger merger(64);
+	for (int i = 0; i < 3; ++i)
+	{
+		std::FILE* f = std::fopen(paths[i].c_str(), "wb");
+		BOOST_REQUIRE(f != nullptr);
+		std::fwrite(logs[i].data(), logs[i].size(), 1, f);
+		std::fclose(f);
+		BOOST_REQUIRE(merger.add(paths[i]));
+	}
+	BOOST_REQUIRE(!merger.add("test.libNmeaParser.missing.log"));
+	BOOST_REQUIRE_EQUAL(merger.sourceCount(), 3U);
+
+	const std::size_t sources[] = { 0, 0, 2, 1, 0, 0, 2, 1, 0, 2, 1 };
+	const int64_t times[] = { 0, 0, 0, 5000, 10000, 10000, 10500, 12000, 20000,
+			20000, 30000 };
+	NmeaMergedLine line;
+	for (int i = 0; i < 11; ++i)
+	{
+		BOOST_REQUIRE(merger.next(line));
+		BOOST_REQUIRE_EQUAL(line.source, sources[i]);
+		BOOST_REQUIRE_EQUAL(line.timestamp, start + times[i]);
+		if (line.source == 2)
+		{
+			// The parser gets the sentence without the receive time
+			BOOST_REQUIRE(line.line != line.sentence);
+			BOOST_REQUIRE_EQUAL(line.sentence.substr(0, 7), "$IIMWV,");
+			double windAngle;
+			Nmea_AngleReference reference;
+			double windSpeed;
+			char windSpeedUnits;
+			char status;
+			BOOST_REQUIRE(
+					NmeaParser::parseMWV(line.sentence.to_string(), windAngle,
+							reference, windSpeed, windSpeedUnits, status).none());
+		}
+		else
+		{
+			BOOST_REQUIRE(line.line == line.sentence);
+		}
+	}
+	BOOST_REQUIRE(!merger.next(line));
+	BOOST_REQUIRE(!merger.add(paths[0]));
+
+	// Line views and offsets point into the sources
+	merger.close();
+	BOOST_REQUIRE(merger.add(paths[0]));
+	BOOST_REQUIRE(merger.next(line));
+	BOOST_REQUIRE(line.line == ais);
+	BOOST_REQUIRE(!line.timed);
+	BOOST_REQUIRE(merger.next(line));
+	BOOST_REQUIRE(line.timed);
+	BOOST_REQUIRE_EQUAL(line.offset, ais.size() + 2);
+	merger.next(line);
+	BOOST_REQUIRE(merger.next(line));
+	BOOST_REQUIRE(line.line == "$HEHDT,274.07,T");
+	BOOST_REQUIRE_EQUAL(line.timestamp, start + 10000);
+
+	merger.close();
+	for (int i = 0; i < 3; ++i)
+	{
+		std::remove(paths[i].c_str());
+	}
+}
+
+BOOST_AUTO_TEST_CASE( replay ) {
+	const std::string logPath = "test.libNmeaParser.replay.log";
+
+	// 11 lines 20 ms apart, 200 ms of log
+	std::string log;
+	for (int i = 0; i <= 10; ++i)
+	{
+		log += "\\c:" + std::to_string(1461168000000LL + i * 20)
+				+ "\\$HEHDT,274.07,T\n";
+	}
+	std::FILE* f = std::fopen(logPath.c_str(), "wb");
+	BOOST_REQUIRE(f != nullptr);
+	std::fwrite(log.data(), log.size(), 1, f);
+	std::fclose(f);
+
+	// Loopback receiver on a free port
+	const int receiver = ::socket(AF_INET, SOCK_DGRAM, 0);
+	BOOST_REQUIRE(receiver >= 0);
+	struct sockaddr_in address = sockaddr_in();
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	BOOST_REQUIRE_EQUAL(
+			::bind(receiver, reinterpret_cast<struct sockaddr*>(&address),
+					sizeof(address)), 0);
+	socklen_t addressLength = sizeof(address);
+	BOOST_REQUIRE_EQUAL(
+			::getsockname(receiver,
+					reinterpret_cast<struct sockaddr*>(&address),
+					&addressLength), 0);
+
+	// The pseudo terminal hands data to the slave asynchronously
+	auto readSlave = [](int fd)
+	{
+		std::string data;
+		char chunk[4096];
+		struct pollfd ready = { fd, POLLIN, 0 };
+		while (::poll(&ready, 1, 200) > 0)
+		{
+			const ssize_t length = ::read(fd, chunk, sizeof(chunk));
+			if (length <= 0)
+			{
+				break;
+			}
+			data.append(chunk, length);
+		}
+		return data;
+	};
+
+	NmeaReplay replay;
+	BOOST_REQUIRE(!replay.openUdp("not an address", 10110));
+	BOOST_REQUIRE(replay.openUdp("127.0.0.1", ntohs(address.sin_port)));
+	std::string ptyName;
+	BOOST_REQUIRE(replay.openPty(ptyName));
+	const int slave = ::open(ptyName.c_str(), O_RDONLY | O_NOCTTY | O_NONBLOCK);
+	BOOST_REQUIRE(slave >= 0);
+	std::vector<int64_t> times;
+	replay.setCallback([&times](boost::string_ref line, int64_t timestamp)
+	{
+		BOOST_REQUIRE(line == "\\c:" + std::to_string(timestamp) + "\\$HEHDT,274.07,T");
+		times.push_back(timestamp);
+	});
+
+	// Twice the recorded rate, 100 ms
+	replay.setSpeed(2.0);
+	NmeaLogMerger merger;
+	BOOST_REQUIRE(merger.add(logPath));
+	const std::chrono::steady_clock::time_point start =
+			std::chrono::steady_clock::now();
+	BOOST_REQUIRE_EQUAL(replay.replay(merger), 11U);
+	const double elapsed = std::chrono::duration<double, std::milli>(
+			std::chrono::steady_clock::now() - start).count();
+	BOOST_REQUIRE_GE(elapsed, 100.0);
+	BOOST_REQUIRE_LT(elapsed, 1000.0);
+	BOOST_REQUIRE_EQUAL(times.size(), 11U);
+	BOOST_REQUIRE_EQUAL(times.back() - times.front(), 200);
+
+	NmeaReplayStatistics statistics = replay.statistics();
+	BOOST_REQUIRE_EQUAL(statistics.lines, 11U);
+	BOOST_REQUIRE_EQUAL(statistics.scheduled, 11U);
+	BOOST_REQUIRE_EQUAL(statistics.dropped, 0U);
+	BOOST_REQUIRE_GT(replay.jitterPercentile(50), 0);
+	BOOST_REQUIRE_LE(replay.jitterPercentile(50), replay.jitterPercentile(100));
+	BOOST_REQUIRE_LE(replay.jitterPercentile(100),
+			std::max<int64_t>(statistics.maxJitter + 1000, 10000000));
+
+	// Every sink got every line, with CR LF
+	char buffer[512];
+	for (int i = 0; i < 11; ++i)
+	{
+		const ssize_t length = ::recv(receiver, buffer, sizeof(buffer),
+				MSG_DONTWAIT);
+		BOOST_REQUIRE_EQUAL(length, 34);
+		BOOST_REQUIRE_EQUAL(std::string(buffer + length - 2, 2), "\r\n");
+	}
+	BOOST_REQUIRE_EQUAL(readSlave(slave).size(), 11U * 34);
+
+	// As fast as possible, stopped from the callback
+	replay.resetStatistics();
+	replay.setSpeed(0.0);
+	replay.setCallback([&replay](boost::string_ref, int64_t timestamp)
+	{
+		if (timestamp == 1461168000100LL)
+		{
+			replay.stop();
+		}
+	});
+	NmeaLogMerger again;
+	BOOST_REQUIRE(again.add(logPath));
+	BOOST_REQUIRE_EQUAL(replay.replay(again), 6U);
+	BOOST_REQUIRE_EQUAL(replay.statistics().scheduled, 0U);
+	BOOST_REQUIRE_EQUAL(replay.jitterPercentile(99), 0);
+	BOOST_REQUIRE_EQUAL(replay.replay(again), 5U);
+	readSlave(slave);
+	while (::recv(receiver, buffer, sizeof(buffer), MSG_DONTWAIT) > 0)
+	{
+	}
+
+	// Receive times written by a logger are not sent
+	f = std::fopen(logPath.c_str(), "wb");
+	BOOST_REQUIRE(f != nullptr);
+	std::fputs("1461168000.000 $IIMWV,045.0,R,10.5,N,A*08\n"
+			"1461168000.010 $IIMWV,046.0,R,10.4,N,A*0A\n", f);
+	std::fclose(f);
+	replay.setCallback([](boost::string_ref line, int64_t)
+	{
+		BOOST_REQUIRE_EQUAL(line.substr(0, 7), "$IIMWV,");
+	});
+	NmeaLogMerger stamped;
+	BOOST_REQUIRE(stamped.add(logPath));
+	BOOST_REQUIRE_EQUAL(replay.replay(stamped), 2U);
+	BOOST_REQUIRE_EQUAL(readSlave(slave),
+			"$IIMWV,045.0,R,10.5,N,A*08\r\n$IIMWV,046.0,R,10.4,N,A*0A\r\n");
+	BOOST_REQUIRE_EQUAL(
+			::recv(receiver, buffer, sizeof(buffer), MSG_DONTWAIT), 28);
+	BOOST_REQUIRE_EQUAL(std::string(buffer, 28),
+			"$IIMWV,045.0,R,10.5,N,A*08\r\n");
+
+	// A slave not reading fills the pseudo terminal, it still gets whole lines
+	log.clear();
+	for (int i = 0; i < 20000; ++i)
+	{
+		log += "$HEHDT," + std::to_string(i) + ",T\n";
+	}
+	f = std::fopen(logPath.c_str(), "wb");
+	BOOST_REQUIRE(f != nullptr);
+	std::fwrite(log.data(), log.size(), 1, f);
+	std::fclose(f);
+	replay.setCallback(NmeaReplay::Callback());
+	NmeaLogMerger flood;
+	BOOST_REQUIRE(flood.add(logPath));
+	BOOST_REQUIRE_EQUAL(replay.replay(flood), 20000U);
+	std::string received = readSlave(slave);
+	BOOST_REQUIRE(!received.empty());
+
+	// The next line first finishes the one the full terminal cut
+	f = std::fopen(logPath.c_str(), "wb");
+	BOOST_REQUIRE(f != nullptr);
+	std::fputs("$HEHDT,20000,T\n", f);
+	std::fclose(f);
+	NmeaLogMerger after;
+	BOOST_REQUIRE(after.add(logPath));
+	BOOST_REQUIRE_EQUAL(replay.replay(after), 1U);
+	received += readSlave(slave);
+	int last = -1;
+	std::size_t lines = 0;
+	std::size_t begin = 0;
+	for (std::size_t end = received.find("\r\n"); end != std::string::npos;
+			end = received.find("\r\n", begin))
+	{
+		const std::string sentence = received.substr(begin, end - begin);
+		BOOST_REQUIRE_EQUAL(sentence.compare(0, 7, "$HEHDT,"), 0);
+		BOOST_REQUIRE_EQUAL(sentence.substr(sentence.size() - 2), ",T");
+		const int index = std::stoi(sentence.substr(7));
+		BOOST_REQUIRE_GT(index, last);
+		last = index;
+		++lines;
+		begin = end + 2;
+	}
+	BOOST_REQUIRE_EQUAL(begin, received.size());
+	BOOST_REQUIRE_EQUAL(last, 20000);
+	BOOST_REQUIRE_LT(lines, 20001U);
+
+	replay.close();
+	::close(slave);
+	::close(receiver);
+	std::remove(logPath.c_str());
+}
+
+BOOST_AUTO_TEST_CASE( gzipReader ) {
+	const std::string gzPath = "test.libNmeaParser.nmea.gz";
+	const std::string bgzfPath = "test.libNmeaParser.bgzf.gz";
+	const std::string plainPath = "test.libNmeaParser.plain.log";
+
+	// About 400 KB of lines, the last one without terminator
+	std::string log;
+	for (int i = 0; i < 8000; ++i)
+	{
+		log += "!AIVDM,1,1,,A,13u?etPv2;0n:dDPwUM1U1Cb069D,0*23 "
+				+ std::to_string(i) + "\r\n";
+	}
+	log += "$HEHDT,274.07,T";
+
+	// Two gzip members
+	gzFile gz = gzopen(gzPath.c_str(), "wb");
+	BOOST_REQUIRE(gz != nullptr);
+	gzwrite(gz, log.data(), log.size() / 2);
+	gzclose(gz);
+	gz = gzopen(gzPath.c_str(), "ab");
+	BOOST_REQUIRE(gz != nullptr);
+	gzwrite(gz, log.data() + log.size() / 2, log.size() - log.size() / 2);
+	gzclose(gz);
+
+	// BGZF: 60000 byte blocks, then the empty end of file block
+	std::FILE* f = std::fopen(bgzfPath.c_str(), "wb");
+	BOOST_REQUIRE(f != nullptr);
+	for (std::size_t offset = 0; offset <= log.size(); offset += 60000)
+	{
+		const std::size_t size = std::min<std::size_t>(60000,
+				log.size() - offset);
+		std::vector<unsigned char> block(18 + compressBound(size) + 8);
+		z_stream stream = z_stream();
+		BOOST_REQUIRE_EQUAL(
+				deflateInit2(&stream, 6, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY),
+				Z_OK);
+		stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(log.data()
+				+ offset));
+		stream.avail_in = size;
+		stream.next_out = block.data() + 18;
+		stream.avail_out = block.size() - 26;
+		BOOST_REQUIRE_EQUAL(deflate(&stream, Z_FINISH), Z_STREAM_END);
+		const std::size_t blockSize = 18 + stream.total_out + 8;
+		deflateEnd(&stream);
+
+		const unsigned char header[18] = { 0x1f, 0x8b, 8, 4, 0, 0, 0, 0, 0, 0xff,
+				6, 0, 'B', 'C', 2, 0, static_cast<unsigned char>(blockSize - 1),
+				static_cast<unsigned char>((blockSize - 1) >> 8) };
+		std::memcpy(block.data(), header, sizeof(header));
+		const uLong crc = crc32(0, reinterpret_cast<const Bytef*>(log.data()
+				+ offset), size);
+		for (int i = 0; i < 4; ++i)
+		{
+			block[blockSize - 8 + i] = crc >> (8 * i);
+			block[blockSize - 4 + i] = size >> (8 * i);
+		}
+		std::fwrite(block.data(), blockSize, 1, f);
+		if (size == 0)
+		{
+			break;
+		}
+	}
+	std::fclose(f);
+
+	f = std::fopen(plainPath.c_str(), "wb");
+	BOOST_REQUIRE(f != nullptr);
+	std::fwrite(log.data(), log.size(), 1, f);
+	std::fclose(f);
+
+	// Chunks smaller than lines and blocks to go through the ring
+	const std::string paths[] = { gzPath, bgzfPath, plainPath };
+	for (int p = 0; p < 3; ++p)
+	{
+		NmeaGzipReader reader(3, 100000);
+		BOOST_REQUIRE(reader.open(paths[p]));
+		BOOST_REQUIRE_EQUAL(reader.blocked(), p == 1);
+
+		std::string read;
+		boost::string_ref line;
+		int lines = 0;
+		while (reader.next(line))
+		{
+			read.append(line.data(), line.size());
+			read += "\r\n";
+			++lines;
+		}
+		BOOST_REQUIRE(!reader.failed());
+		BOOST_REQUIRE_EQUAL(lines, 8001);
+		BOOST_REQUIRE(read == log + "\r\n");
+		BOOST_REQUIRE(!reader.next(line));
+	}
+
+	// Truncated stream, and a block with a bad CRC
+	f = std::fopen(gzPath.c_str(), "r+b");
+	BOOST_REQUIRE(f != nullptr);
+	std::fseek(f, 0, SEEK_END);
+	BOOST_REQUIRE_EQUAL(::ftruncate(fileno(f), std::ftell(f) - 1000), 0);
+	std::fclose(f);
+	f = std::fopen(bgzfPath.c_str(), "r+b");
+	BOOST_REQUIRE(f != nullptr);
+	std::fseek(f, 1000, SEEK_SET);
+	std::fputc(0, f);
+	std::fclose(f);
+	for (int p = 0; p < 2; ++p)
+	{
+		NmeaGzipReader reader(2, 100000);
+		BOOST_REQUIRE(reader.open(paths[p]));
+		boost::string_ref line;
+		while (reader.next(line))
+		{
+		}
+		BOOST_REQUIRE(reader.failed());
+	}
+
+	// Closing with workers still ahead of the reader
+	NmeaGzipReader reader(2, 100000);
+	BOOST_REQUIRE(reader.open(plainPath));
+	boost::string_ref line;
+	BOOST_REQUIRE(reader.next(line));
+	reader.close();
+	BOOST_REQUIRE(!reader.next(line));
+	BOOST_REQUIRE(!reader.open("test.libNmeaParser.missing.gz"));
+
+	for (int p = 0; p < 3; ++p)
+	{
+		std::remove(paths[p].c_str());
+	}
+}
+
+BOOST_AUTO_TEST_CASE( pcapReader ) {
+	const std::string pcapPath = "test.libNmeaParser.pcap";
+	const std::string pcapngPath = "test.libNmeaParser.pcapng";
+
+	// IPv4 UDP from 192.168.1.10:60001 to 239.192.0.1
+	const auto udp = [](const std::string& payload, uint16_t port,
+			uint16_t fragment)
+	{
+		const std::size_t total = 28 + payload.size();
+		const unsigned char header[28] = { 0x45, 0, static_cast<unsigned char>(
+				total >> 8), static_cast<unsigned char>(total), 0, 0,
+				static_cast<unsigned char>(fragment >> 8),
+				static_cast<unsigned char>(fragment), 1, 17, 0, 0, 192, 168, 1, 10,
+				239, 192, 0, 1, 0xEA, 0x61, static_cast<unsigned char>(port >> 8),
+				static_cast<unsigned char>(port), static_cast<unsigned char>(
+						(total - 20) >> 8), static_cast<unsigned char>(total - 20),
+				0, 0 };
+		return std::string(reinterpret_cast<const char*>(header), 28) + payload;
+	};
+	const std::string ethernet("\x01\x00\x5e\x40\x00\x01\x00\x11\x22\x33\x44\x55\x08\x00", 14);
+	const std::string vlan("\x01\x00\x5e\x40\x00\x01\x00\x11\x22\x33\x44\x55\x81\x00\x00\x05\x08\x00", 18);
+	const std::string udpbc = std::string("UdPbC", 6)
+			+ "\\s:GP0001,n:1*16\\$GPZDA,160000.00,20,04,2016,00,00*62\r\n"
+			+ "!AIVDM,1,1,,A,13u?etPv2;0n:dDPwUM1U1Cb069D,0*23\r\n";
+	const std::string raw = "$HEHDT,274.07,T*19\r\n";
+	std::vector<std::string> frames;
+	frames.push_back(ethernet + udp(udpbc, 60001, 0));
+	frames.push_back(vlan + udp(raw, 10110, 0));
+	frames.push_back(ethernet + udp(std::string("RaUdP\0\1\2\3", 9), 60001, 0));
+	frames.push_back(ethernet + udp("\x12\x34\x01\x00", 53, 0));
+	frames.push_back(ethernet + udp(raw, 10110, 0x2000));
+	frames.push_back(std::string("\x01\x00\x5e\x40\x00\x01\x00\x11\x22\x33\x44\x55\x86\xdd", 14) + raw);
+	// IPv4 total length shorter than the IP and UDP headers
+	std::string lying = udp(raw, 10110, 0);
+	lying[2] = 0;
+	lying[3] = 20;
+	frames.push_back(ethernet + lying);
+	// Captured up to the UDP header only
+	frames.push_back(ethernet + udp(raw, 10110, 0).substr(0, 28));
+
+	// Little endian pcap with microseconds
+	std::string pcap("\xd4\xc3\xb2\xa1\x02\x00\x04\x00\0\0\0\0\0\0\0\0\xff\xff\0\0\x01\0\0\0", 24);
+	for (std::size_t i = 0; i < frames.size(); ++i)
+	{
+		const uint32_t record[4] = { 1461168000, static_cast<uint32_t>(i * 1000),
+				static_cast<uint32_t>(frames[i].size()),
+				static_cast<uint32_t>(frames[i].size()) };
+		pcap.append(reinterpret_cast<const char*>(record), sizeof(record));
+		pcap += frames[i];
+	}
+	std::FILE* f = std::fopen(pcapPath.c_str(), "wb");
+	BOOST_REQUIRE(f != nullptr);
+	std::fwrite(pcap.data(), pcap.size(), 1, f);
+	std::fclose(f);
+
+	NmeaPcapReader reader;
+	BOOST_REQUIRE(reader.open(pcapPath));
+	NmeaCapturedLine line;
+	BOOST_REQUIRE(reader.next(line));
+	BOOST_REQUIRE(line.line == "\\s:GP0001,n:1*16\\$GPZDA,160000.00,20,04,2016,00,00*62");
+	BOOST_REQUIRE(line.udpbc);
+	BOOST_REQUIRE_EQUAL(line.timestamp, 1461168000000000LL);
+	BOOST_REQUIRE_EQUAL(line.sourceAddress, 0xC0A8010AU);
+	BOOST_REQUIRE_EQUAL(line.destinationAddress, 0xEFC00001U);
+	BOOST_REQUIRE_EQUAL(line.sourcePort, 60001);
+	BOOST_REQUIRE_EQUAL(line.destinationPort, 60001);
+	BOOST_REQUIRE(reader.next(line));
+	int totalLines;
+	int lineCount;
+	int sequenceIdentifier;
+	char aisChannel;
+	std::string encodedData;
+	int fillBits;
+	BOOST_REQUIRE_EQUAL(
+			NmeaParser::parseVDM(line.line.to_string(), totalLines, lineCount,
+					sequenceIdentifier, aisChannel, encodedData, fillBits),
+			0b100UL);
+	BOOST_REQUIRE_EQUAL(AISMessageView(encodedData).mmsi(), 265547250U);
+	BOOST_REQUIRE(reader.next(line));
+	BOOST_REQUIRE(line.line == "$HEHDT,274.07,T*19");
+	BOOST_REQUIRE(!line.udpbc);
+	BOOST_REQUIRE_EQUAL(line.timestamp, 1461168000001000LL);
+	BOOST_REQUIRE(!reader.next(line));
+	BOOST_REQUIRE_EQUAL(reader.statistics().packets, 8U);
+	BOOST_REQUIRE_EQUAL(reader.statistics().datagrams, 2U);
+	BOOST_REQUIRE_EQUAL(reader.statistics().skipped, 6U);
+
+	// Port filter
+	BOOST_REQUIRE(reader.open(pcapPath));
+	reader.setPort(10110);
+	BOOST_REQUIRE(reader.next(line));
+	BOOST_REQUIRE_EQUAL(line.destinationPort, 10110);
+	BOOST_REQUIRE(!reader.next(line));
+	reader.setPort(0);
+
+	// pcapng, nanosecond interface, Linux cooked v2 link layer
+	std::string pcapng("\x0a\x0d\x0d\x0a\x1c\0\0\0\x4d\x3c\x2b\x1a\x01\0\0\0\xff\xff\xff\xff\xff\xff\xff\xff\x1c\0\0\0", 28);
+	pcapng += std::string("\x01\0\0\0\x20\0\0\0\x14\x01\0\0\0\0\0\0\x09\0\x01\0\x09\0\0\0\0\0\0\0\x20\0\0\0", 32);
+	const std::string sll2 = std::string("\x08\x00\0\0\0\0\0\x02\x00\x01\x06\x00\x11\x22\x33\x44\x55\x00\x00\x00", 20)
+			+ udp(raw + raw, 10110, 0);
+	const uint64_t nanoseconds = 1461168000123456789ULL;
+	const uint32_t packet[7] = { 6, static_cast<uint32_t>(32 + ((sll2.size() + 3) & ~3U)), 0,
+			static_cast<uint32_t>(nanoseconds >> 32), static_cast<uint32_t>(nanoseconds),
+			static_cast<uint32_t>(sll2.size()), static_cast<uint32_t>(sll2.size()) };
+	pcapng.append(reinterpret_cast<const char*>(packet), sizeof(packet));
+	pcapng += sll2 + std::string((4 - sll2.size() % 4) % 4, '\0');
+	pcapng.append(reinterpret_cast<const char*>(packet + 1), 4);
+	f = std::fopen(pcapngPath.c_str(), "wb");
+	BOOST_REQUIRE(f != nullptr);
+	std::fwrite(pcapng.data(), pcapng.size(), 1, f);
+	std::fclose(f);
+
+	BOOST_REQUIRE(reader.open(pcapngPath));
+	BOOST_REQUIRE(reader.next(line));
+	BOOST_REQUIRE(line.line == "$HEHDT,274.07,T*19");
+	BOOST_REQUIRE_EQUAL(line.timestamp, 1461168000123456LL);
+	BOOST_REQUIRE(reader.next(line));
+	BOOST_REQUIRE(!reader.next(line));
+	BOOST_REQUIRE_EQUAL(reader.statistics().datagrams, 1U);
+
+	// Binary resolution of 2^-50 s is refused
+	pcapng[48] = static_cast<char>(0x80 | 50);
+	f = std::fopen(pcapngPath.c_str(), "wb");
+	BOOST_REQUIRE(f != nullptr);
+	std::fwrite(pcapng.data(), pcapng.size(), 1, f);
+	std::fclose(f);
+	BOOST_REQUIRE(reader.open(pcapngPath));
+	BOOST_REQUIRE(!reader.next(line));
+
+	BOOST_REQUIRE(!reader.open("test.libNmeaParser.missing.pcap"));
+	BOOST_REQUIRE(!reader.next(line));
+	std::remove(pcapPath.c_str());
+	std::remove(pcapngPath.c_str());
+}
+
+BOOST_AUTO_TEST_CASE( sharedRing ) {
+	const std::string name = "/test.libNmeaParser.ring";
+
+	NmeaSharedRingReader reader;
+	BOOST_REQUIRE(!reader.open(name));
+
+	NmeaSharedRingWriter writer;
+	BOOST_REQUIRE(writer.create(name, 8, 256));
+	BOOST_REQUIRE(reader.open(name));
+	NmeaSharedRecord record;
+	BOOST_REQUIRE(!reader.next(record));
+
+	AISPositionReportClassA report = AISPositionReportClassA();
+	report.mmsi = 760000001;
+	report.longitude = -77.2f;
+	report.latitude = -12.05f;
+	BOOST_REQUIRE(writer.publish(report, 1461168000000LL));
+	NmeaOwnShipSnapshot snapshot = NmeaOwnShipSnapshot();
+	snapshot.value[Nmea_OwnShipField_Latitude] = -12.0422;
+	snapshot.version = 7;
+	BOOST_REQUIRE(writer.publish(snapshot));
+	BOOST_REQUIRE_EQUAL(reader.pending(), 2U);
+
+	BOOST_REQUIRE(reader.next(record));
+	BOOST_REQUIRE_EQUAL(record.sequence, 0U);
+	BOOST_REQUIRE_EQUAL(record.type, uint32_t(NmeaSharedRecord_PositionReportClassA));
+	BOOST_REQUIRE_EQUAL(record.timestamp, 1461168000000LL);
+	AISPositionReportClassA received;
+	BOOST_REQUIRE(!record.get(snapshot));
+	BOOST_REQUIRE(record.get(received));
+	BOOST_REQUIRE_EQUAL(received.mmsi, 760000001U);
+	BOOST_REQUIRE_EQUAL(received.latitude, -12.05f);
+	BOOST_REQUIRE(reader.next(record));
+	NmeaOwnShipSnapshot receivedSnapshot;
+	BOOST_REQUIRE(record.get(receivedSnapshot));
+	BOOST_REQUIRE_EQUAL(receivedSnapshot.value[Nmea_OwnShipField_Latitude], -12.0422);
+	BOOST_REQUIRE_EQUAL(receivedSnapshot.version, 7U);
+	BOOST_REQUIRE(!reader.next(record));
+
+	// Too large for a slot
+	const std::vector<char> large(300);
+	BOOST_REQUIRE(!writer.publish(NmeaSharedRecord_User, large.data(), large.size()));
+
+	// 20 records on 8 slots, the reader is overrun
+	for (uint32_t i = 0; i < 20; ++i)
+	{
+		BOOST_REQUIRE(writer.publish(NmeaSharedRecord_User, &i, sizeof(i), i));
+	}
+	BOOST_REQUIRE_EQUAL(writer.published(), 22U);
+	BOOST_REQUIRE(reader.next(record));
+	BOOST_REQUIRE_EQUAL(record.sequence, 14U);
+	BOOST_REQUIRE_EQUAL(record.timestamp, 12);
+	BOOST_REQUIRE_EQUAL(record.size, 4U);
+	BOOST_REQUIRE_EQUAL(reader.overruns(), 12U);
+	BOOST_REQUIRE_EQUAL(reader.pending(), 7U);
+
+	// Another process sees the same records
+	const pid_t child = ::fork();
+	BOOST_REQUIRE(child >= 0);
+	if (child == 0)
+	{
+		NmeaSharedRingReader other;
+		int read = 0;
+		if (other.open(name))
+		{
+			other.rewind();
+			NmeaSharedRecord r;
+			while (other.next(r) && r.sequence == 14U + read)
+			{
+				++read;
+			}
+		}
+		::_exit(read == 8 ? 0 : 1);
+	}
+	int status;
+	BOOST_REQUIRE_EQUAL(::waitpid(child, &status, 0), child);
+	BOOST_REQUIRE(WIFEXITED(status));
+	BOOST_REQUIRE_EQUAL(WEXITSTATUS(status), 0);
+
+	// Readers keep a closed ring, a new one starts empty
+	writer.close();
+	BOOST_REQUIRE_EQUAL(reader.pending(), 7U);
+	BOOST_REQUIRE(writer.create(name, 8, 64));
+	BOOST_REQUIRE(!writer.publish(NmeaSharedRecord_User, large.data(), 100));
+	NmeaSharedRingReader fresh;
+	BOOST_REQUIRE(fresh.open(name));
+	fresh.rewind();
+	BOOST_REQUIRE(!fresh.next(record));
+
+	reader.close();
+	fresh.close();
+	writer.close();
+	BOOST_REQUIRE(NmeaSharedRingWriter::remove(name));
+	BOOST_REQUIRE(!NmeaSharedRingWriter::remove(name));
+}
+
+BOOST_AUTO_TEST_CASE( dispatcher ) {
+	// Handles GGA, HDT, AIS types 1 to 3 and 5, and the rest as text
+	class DispatchRecorder: public NmeaDispatcher<DispatchRecorder>
+	{
+	public:
+		DispatchRecorder() :
+				latitude(0), heading(0), voyageMmsi(0), other(0)
+		{
+		}
+
+		void onGGA(const NmeaGGAView& view)
+		{
+			latitude = view.latitude;
+		}
+
+		void onHDT(const NmeaHDTView& view)
+		{
+			heading = view.headingDegreesTrue;
+		}
+
+		void onAISPositionReportClassA(const AISPositionReportClassA& data)
+		{
+			mmsis.push_back(data.mmsi);
+		}
+
+		void onAISStaticAndVoyageRelatedData(
+				const AISStaticAndVoyageRelatedData& data)
+		{
+			voyageMmsi = data.mmsi;
+		}
+
+		void onOther(const std::string&)
+		{
+			++other;
+		}
+
+		double latitude;
+		double heading;
+		std::vector<uint> mmsis;
+		uint voyageMmsi;
+		int other;
+	};
+
+	// No handler method
+	class DispatchNothing: public NmeaDispatcher<DispatchNothing>
+	{
+	};
+
+	DispatchRecorder recorder;
+
+	BOOST_REQUIRE(recorder.dispatch(
+			"$GPGGA,165702,1151.0742,S,07718.6472,W,1,09,00.9,24.9,M,10.6,M,,*49"));
+	BOOST_REQUIRE_CLOSE(recorder.latitude, -11.85123667, 0.0001);
+	BOOST_REQUIRE_EQUAL(recorder.parsed(), 1U);
+
+	// No onRMC nor onTrack: not parsed, not given to onOther
+	BOOST_REQUIRE(!recorder.dispatch(
+			"$GPRMC,160618.00,A,1202.5313983,S,07708.5478298,W,0.10,166.87,200416,1.4,W,A,S*56"));
+	BOOST_REQUIRE(!recorder.dispatch("!INTTD,01,01,,0PP10Eg@wwP74@0,0*2F"));
+	BOOST_REQUIRE_EQUAL(recorder.parsed(), 1U);
+
+	BOOST_REQUIRE(recorder.dispatch(
+			"\\s:rcv1,c:1700000000*5D\\$HEHDT,274.07,T*03"));
+	BOOST_REQUIRE_EQUAL(recorder.heading, 274.07);
+
+	BOOST_REQUIRE(recorder.dispatch(
+			"!AIVDM,1,1,,A,13u?etPv2;0n:dDPwUM1U1Cb069D,0*23"));
+	BOOST_REQUIRE_EQUAL(recorder.mmsis.size(), 1U);
+	BOOST_REQUIRE_EQUAL(recorder.mmsis[0], AISMessageView("13u?etPv2;0n").mmsi());
+	BOOST_REQUIRE(!recorder.ownVessel());
+
+	// Two fragments, the message is handled with the last one
+	BOOST_REQUIRE(!recorder.dispatch(
+			"!AIVDM,2,1,3,A,58wt8Ui`g??r21`7S=:22058<v05Htp000000015>8OA;0skeQ8823mDm3kP,0*1A"));
+	BOOST_REQUIRE(recorder.dispatch("!AIVDM,2,2,3,A,00000000000,2*23"));
+	BOOST_REQUIRE_EQUAL(recorder.voyageMmsi, AISMessageView("58wt8Ui`g??r").mmsi());
+	BOOST_REQUIRE(!recorder.dispatch("!AIVDM,2,2,3,A,00000000000,2*23"));
+
+	BOOST_REQUIRE(recorder.dispatch("$PRDID,-10.00,+37.50,100.00*7E"));
+	BOOST_REQUIRE(recorder.dispatch("garbage"));
+	BOOST_REQUIRE_EQUAL(recorder.other, 2);
+	BOOST_REQUIRE_EQUAL(recorder.sentences(), 10U);
+	BOOST_REQUIRE_EQUAL(recorder.parsed(), 6U);
+
+	DispatchNothing nothing;
+	BOOST_REQUIRE(!nothing.dispatch(
+			"$GPGGA,165702,1151.0742,S,07718.6472,W,1,09,00.9,24.9,M,10.6,M,,*49"));
+	BOOST_REQUIRE(!nothing.dispatch(
+			"!AIVDM,1,1,,A,13u?etPv2;0n:dDPwUM1U1Cb069D,0*23"));
+	BOOST_REQUIRE_EQUAL(nothing.sentences(), 2U);
+	BOOST_REQUIRE_EQUAL(nothing.parsed(), 0U);
+}